@@ -0,0 +1,35 @@
+#version 330 core
+
+// Places the entities a GpuCuller let through like objshader.vert, each instance reading its entity's world matrix from a buffer
+layout(location = 0) in vec3 apos;
+layout(location = 1) in vec3 vertex_normal;
+layout(location = 2) in vec2 atex;
+// Index of the entity the instance draws, written by the culling shader
+layout(location = 5) in uint entity;
+
+// Pass values to frag shader
+out vec2 tex_coord;
+out vec3 norm_coord;
+out vec3 frag_pos;
+
+// World matrices of the entities, four texels each, one per column
+uniform samplerBuffer entity_transforms;
+uniform mat4 projection;
+uniform mat4 view;
+
+// Computed the same way in every program placing vertices like this one, so a shading pass can test the pre-pass depth for equality
+invariant gl_Position;
+
+void main() {
+	int texel = int(entity) * 4;
+	mat4 transform = mat4(
+		texelFetch(entity_transforms, texel),
+		texelFetch(entity_transforms, texel + 1),
+		texelFetch(entity_transforms, texel + 2),
+		texelFetch(entity_transforms, texel + 3));
+
+	gl_Position = projection * view * transform * vec4(apos, 1.0);
+	tex_coord = atex;
+	norm_coord = mat3(transpose(inverse(transform))) * vertex_normal;
+	frag_pos = vec3(transform * vec4(apos, 1.0));
+}
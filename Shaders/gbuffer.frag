@@ -0,0 +1,30 @@
+#version 330 core
+// Writes the surface of a textured object into the G-buffer, lit later by deferred_lighting.frag
+uniform sampler2D tex0;
+
+// Specular of the main point light, the lighting pass uses it for every light on the surface like the forward shaders
+uniform float plight_spec_str;
+uniform float plight_spec_phong;
+
+in vec2 tex_coord;
+in vec3 norm_coord;
+in vec3 frag_pos;
+
+// Albedo and specular strength, then the octahedral normal, the phong exponent over 256 and whether the pixel is covered
+layout(location = 0) out vec4 albedo_spec;
+layout(location = 1) out vec4 normal_phong;
+
+// Folds a unit vector onto an octahedron and unfolds that into a square, so a normal fits in two values
+vec2 encodeNormal(vec3 n) {
+	n /= abs(n.x) + abs(n.y) + abs(n.z);
+	if (n.z < 0.0)
+		n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+	return n.xy * 0.5 + 0.5;
+}
+
+void main() {
+	vec4 pixel_color = texture(tex0, tex_coord);
+
+	albedo_spec = vec4(pixel_color.rgb, clamp(plight_spec_str, 0.0, 1.0));
+	normal_phong = vec4(encodeNormal(normalize(norm_coord)), clamp(plight_spec_phong / 256.0, 0.0, 1.0), 1.0);
+}
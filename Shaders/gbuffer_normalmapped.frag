@@ -0,0 +1,50 @@
+#version 330 core
+// Writes the surface of a decaled, normal mapped object into the G-buffer, lit later by deferred_lighting.frag
+uniform sampler2D tex0;
+uniform sampler2D tex1;
+uniform sampler2D norm_tex;
+
+// Specular of the main point light, the lighting pass uses it for every light on the surface like the forward shaders
+uniform float plight_spec_str;
+uniform float plight_spec_phong;
+
+in vec2 tex_coord;
+in vec3 norm_coord;
+in vec3 frag_pos;
+in mat3 TBN;
+
+// Albedo and specular strength, then the octahedral normal, the phong exponent over 256 and whether the pixel is covered
+layout(location = 0) out vec4 albedo_spec;
+layout(location = 1) out vec4 normal_phong;
+
+// Folds a unit vector onto an octahedron and unfolds that into a square, so a normal fits in two values
+vec2 encodeNormal(vec3 n) {
+	n /= abs(n.x) + abs(n.y) + abs(n.z);
+	if (n.z < 0.0)
+		n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+	return n.xy * 0.5 + 0.5;
+}
+
+void main() {
+	vec4 pixel_color;
+	vec4 color0 = texture(tex0, tex_coord);
+	vec4 color1 = texture(tex1, tex_coord);
+
+	// Use the pixel color of the textures in the greater texture slot numbers first if it is not transparent
+	if (color1.a > 0.1)
+		// Blend the texture with the one below
+		pixel_color = color1 * color1.a + color0 * (1 - color1.a);
+	else
+		pixel_color = color0;
+
+	// If the pixel value is too transparent, do not render it
+	if (pixel_color.a < 0.1)
+		discard;
+
+	// Calculate normal direction
+	vec3 normal = texture(norm_tex, tex_coord).rgb;
+	normal = normalize(TBN * normal);
+
+	albedo_spec = vec4(pixel_color.rgb, clamp(plight_spec_str, 0.0, 1.0));
+	normal_phong = vec4(encodeNormal(normal), clamp(plight_spec_phong / 256.0, 0.0, 1.0), 1.0);
+}
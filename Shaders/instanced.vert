@@ -0,0 +1,48 @@
+#version 330 core
+
+// Retrieve the vertices, normals, and tex_coords
+layout(location = 0) in vec3 apos;
+layout(location = 1) in vec3 vertex_normal;
+layout(location = 2) in vec2 atex;
+
+// Retrieve the position and heading of the instance
+layout(location = 5) in vec3 instance_pos;
+layout(location = 6) in vec3 instance_dir;
+
+// Pass values to frag shader
+out vec2 tex_coord;
+out vec3 norm_coord;
+out vec3 frag_pos;
+
+// Turns and scales the model so it faces along +Z, shared by every instance
+uniform mat4 transform;
+// Seconds the instances are moved back along their heading, to draw them between simulation steps
+uniform float rewind;
+uniform mat4 projection;
+uniform mat4 view;
+
+// Computed the same way in every program placing vertices like this one, so a shading pass can test the pre-pass depth for equality
+invariant gl_Position;
+
+void main() {
+
+	// Build a basis facing along the heading of the instance, keeping it upright
+	vec3 forward = length(instance_dir) > 0.0001 ? normalize(instance_dir) : vec3(0.0, 0.0, 1.0);
+	vec3 side = cross(vec3(0.0, 1.0, 0.0), forward);
+	side = length(side) > 0.0001 ? normalize(side) : vec3(1.0, 0.0, 0.0);
+	vec3 up = cross(forward, side);
+	vec3 pos = instance_pos - instance_dir * rewind;
+	mat4 instance_transform = mat4(vec4(side, 0.0), vec4(up, 0.0), vec4(forward, 0.0), vec4(pos, 1.0)) * transform;
+
+	gl_Position = projection * view * instance_transform * vec4(apos, 1.0);
+
+	// Pass value for tex_coord to fragment shader
+	tex_coord = atex;
+
+	// The base transform is expected to scale uniformly, so the normal can skip the inverse transpose
+	norm_coord = mat3(instance_transform) * vertex_normal;
+
+	// Pass value for frag_pos to fragment shader
+	frag_pos = vec3(instance_transform * vec4(apos, 1.0));
+
+}
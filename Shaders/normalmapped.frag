@@ -14,15 +14,50 @@ uniform float plight_spec_str;
 uniform float plight_spec_phong;
 uniform float linear;
 uniform float quadratic;
+// Slot of the point shadow atlas the light's shadows are in, -1 if it has none, and how far they reach
+uniform int plight_shadow_slot;
+uniform float plight_shadow_range;
 
 uniform float dlight_intensity;
 uniform vec3 dlight_dir;
 uniform vec3 dlight_color;
-uniform vec3 dlight_amb_str;
-uniform vec3 dlight_amb_color;
+uniform float dlight_amb_str;
 uniform float dlight_spec_str;
 uniform float dlight_spec_phong;
 
+// Light of the skybox from every side as 9 spherical harmonics, convolved with the cosine lobe and divided by pi
+uniform vec3 sky_sh[9];
+
+// Point lights binned into the froxels of the camera by LightClusters, must match light_clusters.h and light.h
+#define CLUSTER_TILES_X 16
+#define CLUSTER_TILES_Y 16
+#define CLUSTER_SLICES 24
+#define POINT_LIGHT_CUTOFF 0.05
+// Three texels per light, position and linear factor, color and quadratic factor, then shadow slot and range
+uniform samplerBuffer cluster_lights;
+// Offset into cluster_indices and count of every cluster's lights
+uniform usamplerBuffer cluster_grid;
+uniform usamplerBuffer cluster_indices;
+uniform vec3 cluster_forward;
+// Scale and bias turning the log of a view depth into a slice
+uniform vec2 cluster_depth;
+uniform vec2 cluster_tile_scale;
+
+// Depth of the scene seen from the direction light in cascades along the view, must match shadow_map.h
+#define SHADOW_CASCADES 4
+uniform sampler2DArrayShadow shadow_map;
+// Cascades in use, none until the shadow map is passed
+uniform int shadow_cascades;
+uniform vec3 shadow_forward;
+uniform mat4 shadow_matrices[SHADOW_CASCADES];
+// View depth each cascade reaches to, and the world size of its texels
+uniform vec4 shadow_splits;
+uniform vec4 shadow_texel_sizes;
+
+// Six face shadow maps of the point lights that cast shadows, six layers per slot, must match light.h
+#define POINT_SHADOW_NEAR 0.1
+uniform sampler2DArrayShadow point_shadow_maps;
+
 in vec2 tex_coord;
 in vec3 norm_coord;
 in vec3 frag_pos;
@@ -30,6 +65,99 @@ in mat3 TBN;
 
 out vec4 FragColor; //Returns a color, vec4 means RGBA
 
+// Fraction of a point light reaching the fragment, looked up in the face of the light's shadow map it is in, slot -1 casts none
+float pointShadow(int slot, vec3 light_pos, float range, vec3 normal) {
+	vec3 to_frag = frag_pos - light_pos;
+	float dist = length(to_frag);
+	if (slot < 0 || dist >= range)
+		return 1.0;
+
+	// Looking up a little out along the normal, by about a texel at that distance, keeps surfaces from shadowing themselves
+	float texel = 2.0 * dist / float(textureSize(point_shadow_maps, 0).x);
+	to_frag += normal * texel * 1.5;
+
+	// Pick the face along the axis the fragment is furthest along, the same way cube maps do
+	vec3 axis_dist = abs(to_frag);
+	int face;
+	float major;
+	vec2 uv;
+	if (axis_dist.x >= axis_dist.y && axis_dist.x >= axis_dist.z) {
+		face = to_frag.x > 0.0 ? 0 : 1;
+		major = axis_dist.x;
+		uv = vec2(to_frag.x > 0.0 ? -to_frag.z : to_frag.z, -to_frag.y);
+	}
+	else if (axis_dist.y >= axis_dist.z) {
+		face = to_frag.y > 0.0 ? 2 : 3;
+		major = axis_dist.y;
+		uv = vec2(to_frag.x, to_frag.y > 0.0 ? to_frag.z : -to_frag.z);
+	}
+	else {
+		face = to_frag.z > 0.0 ? 4 : 5;
+		major = axis_dist.z;
+		uv = vec2(to_frag.z > 0.0 ? to_frag.x : -to_frag.x, -to_frag.y);
+	}
+
+	// The depth the face's projection gives a point that far along its axis
+	float depth = (range + POINT_SHADOW_NEAR - 2.0 * range * POINT_SHADOW_NEAR / major) / (range - POINT_SHADOW_NEAR) * 0.5 + 0.5;
+	return texture(point_shadow_maps, vec4(uv / major * 0.5 + 0.5, float(slot * 6 + face), depth));
+}
+
+// Adds up the point lights of the fragment's cluster, with no ambient and the specular of the main point light
+vec3 clusteredLights(vec3 normal, vec3 viewDir) {
+	float view_depth = max(dot(frag_pos - camera_pos, cluster_forward), 1e-4);
+	int slice = clamp(int(log(view_depth) * cluster_depth.x + cluster_depth.y), 0, CLUSTER_SLICES - 1);
+	ivec2 tile = clamp(ivec2(gl_FragCoord.xy * cluster_tile_scale), ivec2(0), ivec2(CLUSTER_TILES_X - 1, CLUSTER_TILES_Y - 1));
+	uvec2 cluster = texelFetch(cluster_grid, (slice * CLUSTER_TILES_Y + tile.y) * CLUSTER_TILES_X + tile.x).xy;
+
+	vec3 lit = vec3(0.0);
+	for (uint i = 0u; i < cluster.y; i++) {
+		int light = int(texelFetch(cluster_indices, int(cluster.x + i)).x);
+		vec4 pos_linear = texelFetch(cluster_lights, light * 3);
+		vec4 color_quadratic = texelFetch(cluster_lights, light * 3 + 1);
+		vec4 shadow = texelFetch(cluster_lights, light * 3 + 2);
+
+		vec3 to_light = pos_linear.xyz - frag_pos;
+		float light_dist = length(to_light);
+		vec3 light_dir = to_light / light_dist;
+		// The attenuation is brought down to reach 0 at the light's radius, so leaving its clusters shows no edge
+		float falloff = 1.0 / (1.0 + pos_linear.w * light_dist + color_quadratic.w * light_dist * light_dist);
+		falloff = max(falloff - POINT_LIGHT_CUTOFF, 0.0) / (1.0 - POINT_LIGHT_CUTOFF);
+		falloff *= pointShadow(int(shadow.x), pos_linear.xyz, shadow.y, normal);
+		float light_spec = pow(max(dot(reflect(-light_dir, normal), viewDir), 0.0), plight_spec_phong) * plight_spec_str;
+		lit += (max(dot(normal, light_dir), 0.0) + light_spec) * color_quadratic.rgb * falloff;
+	}
+	return lit;
+}
+
+// Light the skybox sheds on a surface facing along normal, from the 9 harmonics, must match sky_lighting.cpp
+vec3 skyIrradiance(vec3 n) {
+	return sky_sh[0] * 0.282095
+		+ (sky_sh[1] * n.y + sky_sh[2] * n.z + sky_sh[3] * n.x) * 0.488603
+		+ (sky_sh[4] * n.x * n.y + sky_sh[5] * n.y * n.z + sky_sh[7] * n.x * n.z) * 1.092548
+		+ sky_sh[6] * 0.315392 * (3.0 * n.z * n.z - 1.0)
+		+ sky_sh[8] * 0.546274 * (n.x * n.x - n.y * n.y);
+}
+
+// Fraction of the direction light reaching the fragment, filtered over 3x3 lookups of the cascade it falls in
+float directionShadow(vec3 normal) {
+	float view_depth = dot(frag_pos - camera_pos, shadow_forward);
+	int cascade = 0;
+	while (cascade < shadow_cascades && view_depth > shadow_splits[cascade])
+		cascade++;
+	if (cascade >= shadow_cascades)
+		return 1.0;
+
+	// Looking up a little out along the normal keeps surfaces from shadowing themselves at grazing angles
+	vec3 pos = frag_pos + normal * shadow_texel_sizes[cascade] * 1.5;
+	vec3 coord = (shadow_matrices[cascade] * vec4(pos, 1.0)).xyz * 0.5 + 0.5;
+	vec2 texel = 1.0 / vec2(textureSize(shadow_map, 0).xy);
+	float lit = 0.0;
+	for (int y = -1; y <= 1; y++)
+		for (int x = -1; x <= 1; x++)
+			lit += texture(shadow_map, vec4(coord.xy + vec2(x, y) * texel, float(cascade), coord.z));
+	return lit / 9.0;
+}
+
 void main() {
 	vec4 pixel_color;
 	vec4 color0 = texture(tex0, tex_coord);
@@ -71,7 +199,7 @@ void main() {
 
 	// Calculate ambient light and adjust by the intensity
 	vec3 ambientCol = plight_amb_str * plight_amb_color * intensity;
-	vec3 dlight_ambient = dlight_amb_str * dlight_amb_color * dlight_i;
+	vec3 dlight_ambient = dlight_amb_str * skyIrradiance(normal) * dlight_i;
 
 	// Calculate specular
 	vec3 viewDir = normalize(camera_pos - frag_pos);
@@ -85,7 +213,20 @@ void main() {
 	vec3 dlight_spec = pow(max(dot(reflect(-dlight_dir, normal), viewDir), 0.1f), dlight_spec_phong)
 		* dlight_spec_str * dlight_color * dlight_i;
 
-	FragColor = (vec4(specCol + diffuse + ambientCol, 1.0)
+	// Whatever stands between the fragment and the direction light shades it
+	float shadow = directionShadow(normalize(norm_coord));
+	dlight_diffuse *= shadow;
+	dlight_spec *= shadow;
+
+	// And whatever stands between it and the main point light
+	float plight_shadow = pointShadow(plight_shadow_slot, plight_pos, plight_shadow_range, normalize(norm_coord));
+	diffuse *= plight_shadow;
+	specCol *= plight_shadow;
+
+	// Only the lights whose radius reaches the fragment's cluster are added up
+	vec3 extra = clusteredLights(normal, viewDir);
+
+	FragColor = (vec4(specCol + diffuse + ambientCol + extra, 1.0)
 		+ vec4(dlight_spec + dlight_diffuse + dlight_ambient, 1.0))
 		* pixel_color;
 }
\ No newline at end of file
@@ -17,6 +17,9 @@ uniform mat4 transform;
 uniform mat4 projection; 
 uniform mat4 view;
 
+// Computed the same way in every program placing vertices like this one, so a shading pass can test the pre-pass depth for equality
+invariant gl_Position;
+
 void main() {
 
 	// Convert aPos to a vec4 and assign it to special variable gl_Position
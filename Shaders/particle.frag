@@ -0,0 +1,18 @@
+#version 330 core
+
+// Returns a Color
+out vec4 FragColor;
+
+in float fade;
+
+uniform vec4 color;
+
+void main() {
+	// Round the point off into a soft disc
+	vec2 offset = gl_PointCoord * 2.0 - 1.0;
+	float distance2 = dot(offset, offset);
+	if (distance2 > 1.0)
+		discard;
+
+	FragColor = vec4(color.rgb, color.a * fade * (1.0 - distance2));
+}
@@ -0,0 +1,32 @@
+#version 330 core
+
+// Retrieve the state of the particle
+layout(location = 0) in vec4 pos_life;
+layout(location = 1) in vec4 vel_size;
+
+// Pass how faded out the particle is to the frag shader
+out float fade;
+
+uniform mat4 projection;
+uniform mat4 view;
+// Height of the viewport in pixels, to size the points in world units
+uniform float viewport_height;
+// Particles fade out over their last seconds of life
+uniform float fade_time;
+
+void main() {
+	// Dead particles are put outside of the clip volume so they are dropped before rasterizing
+	if (pos_life.w <= 0.0) {
+		gl_Position = vec4(0.0, 0.0, 2.0, 1.0);
+		gl_PointSize = 1.0;
+		fade = 0.0;
+		return;
+	}
+
+	gl_Position = projection * view * vec4(pos_life.xyz, 1.0);
+
+	// Scale the diameter by the projection, which also works for orthographic projections where w is 1
+	gl_PointSize = clamp(vel_size.w * projection[1][1] * viewport_height / (2.0 * gl_Position.w), 1.0, 64.0);
+
+	fade = clamp(pos_life.w / fade_time, 0.0, 1.0);
+}
@@ -0,0 +1,9 @@
+#version 330 core
+// Places the vertices in the world, the geometry shader projects them onto each face of the light
+layout(location = 0) in vec3 apos;
+
+uniform mat4 transform;
+
+void main() {
+	gl_Position = transform * vec4(apos, 1.0);
+}
@@ -0,0 +1,30 @@
+#version 330 core
+// Fades the scene to the color of the water with the distance light travels through it
+uniform sampler2D scene_color;
+uniform sampler2D scene_depth;
+
+// Turns a pixel's depth back into its position seen from the camera
+uniform mat4 inverse_projection;
+
+uniform vec3 fog_color;
+uniform float fog_density;
+
+out vec4 FragColor;
+
+void main() {
+	ivec2 pixel = ivec2(gl_FragCoord.xy);
+	vec4 color = texelFetch(scene_color, pixel, 0);
+	float depth = texelFetch(scene_depth, pixel, 0).r;
+
+	// The skybox is the water itself, so only surfaces are fogged
+	if (depth >= 1.0) {
+		FragColor = color;
+		return;
+	}
+
+	vec2 screen_size = vec2(textureSize(scene_depth, 0));
+	vec4 view = inverse_projection * vec4(gl_FragCoord.xy / screen_size * 2.0 - 1.0, depth * 2.0 - 1.0, 1.0);
+	float dist = length(view.xyz / view.w);
+	float fog = 1.0 - exp(-fog_density * dist);
+	FragColor = vec4(mix(color.rgb, fog_color, fog), color.a);
+}
@@ -0,0 +1,23 @@
+#version 330 core
+// The first person view's night vision, the brightness of the scene amplified in green with a grain that changes every frame
+uniform sampler2D scene_color;
+
+uniform float noise_strength;
+uniform float time;
+
+out vec4 FragColor;
+
+// Cheap hash of a pixel and a frame to a value between 0 and 1
+float grain(vec2 pixel, float seed) {
+	return fract(sin(dot(pixel + seed, vec2(12.9898, 78.233))) * 43758.5453);
+}
+
+void main() {
+	vec3 color = texelFetch(scene_color, ivec2(gl_FragCoord.xy), 0).rgb;
+	float brightness = dot(color, vec3(0.299, 0.587, 0.114));
+
+	// Amplified so dim surfaces stand out, then saturated towards white like a phosphor screen
+	brightness = 1.0 - exp(-brightness * 3.0);
+	brightness += (grain(gl_FragCoord.xy, fract(time) * 100.0) - 0.5) * noise_strength;
+	FragColor = vec4(vec3(0.1, 1.0, 0.2) * clamp(brightness, 0.0, 1.0), 1.0);
+}
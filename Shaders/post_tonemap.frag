@@ -0,0 +1,15 @@
+#version 330 core
+// Brings the scene's light down to the range of the screen, rolling off the highlights instead of clipping them
+uniform sampler2D scene_color;
+
+uniform float exposure;
+
+out vec4 FragColor;
+
+void main() {
+	vec3 color = texelFetch(scene_color, ivec2(gl_FragCoord.xy), 0).rgb * exposure;
+
+	// Fitted ACES filmic curve, close to linear in the shadows and mid tones
+	color = clamp(color * (2.51 * color + 0.03) / (color * (2.43 * color + 0.59) + 0.14), 0.0, 1.0);
+	FragColor = vec4(color, 1.0);
+}
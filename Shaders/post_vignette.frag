@@ -0,0 +1,14 @@
+#version 330 core
+// Darkens the corners of the screen, like looking out of a porthole
+uniform sampler2D scene_color;
+
+uniform float vignette_strength;
+
+out vec4 FragColor;
+
+void main() {
+	vec3 color = texelFetch(scene_color, ivec2(gl_FragCoord.xy), 0).rgb;
+	vec2 from_center = gl_FragCoord.xy / vec2(textureSize(scene_color, 0)) - 0.5;
+	float shade = 1.0 - vignette_strength * smoothstep(0.2, 0.75, length(from_center));
+	FragColor = vec4(color * shade, 1.0);
+}
@@ -0,0 +1,4 @@
+#version 330 core
+// Shadow casters only write their depth, which happens without any output
+void main() {
+}
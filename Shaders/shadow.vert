@@ -0,0 +1,15 @@
+#version 330 core
+// Only places the vertices, shadow casters need nothing else to write their depth
+layout(location = 0) in vec3 apos;
+
+uniform mat4 transform;
+// View and projection of a cascade of the shadow map
+uniform mat4 projection;
+uniform mat4 view;
+
+// Computed the same way in every program placing vertices like this one, so a shading pass can test the pre-pass depth for equality
+invariant gl_Position;
+
+void main() {
+	gl_Position = projection * view * transform * vec4(apos, 1.0);
+}
@@ -3,11 +3,13 @@
 // Returns a Color
 out vec4 FragColor;
 
-in vec3 texCoords;
+in vec4 far_point;
 // Cubemap
 uniform samplerCube skybox;
+uniform vec3 camera_pos;
 
 void main() {
-	// Calls the texture function to get the color
-	FragColor = texture(skybox, texCoords);
-}
\ No newline at end of file
+	// The view ray runs from the camera to the point on the far plane
+	vec3 direction = far_point.xyz / far_point.w - camera_pos;
+	FragColor = texture(skybox, direction);
+}
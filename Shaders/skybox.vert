@@ -1,23 +1,16 @@
 #version 330 core
+// Covers the screen with one triangle at the far plane, so the sky is only shaded where nothing was drawn in front of it
 
-// Vertex position of the Skybox
-layout(location = 0) in vec3 aPos;
+// Inverse of the camera's projection and view, turning a point of the screen back into the world
+uniform mat4 inverse_view_projection;
 
-// Cubemap
-out vec3 texCoords;
-
-// Creates a projection variable where the projection matrix will be assigned
-uniform mat4 projection;
-
-// Creates a view variable where the view matrix will be assigned
-uniform mat4 view;
+// Point on the far plane the pixel looks at, before the divide by w so it stays exact across the triangle
+out vec4 far_point;
 
 void main() {
-	vec4 pos = projection * view * vec4(aPos, 1.0); // Multiplies the projection matrix with the view and multiplies it with the position
-
-	// Directly writes onto the view space
-	gl_Position = vec4(pos.x, pos.y, pos.w, pos.w);
+	vec2 pos = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2) * 2.0 - 1.0;
+	far_point = inverse_view_projection * vec4(pos, 1.0, 1.0);
 
-	// Assign the texcoord with the vertex position directly
-	texCoords = aPos;
-}
\ No newline at end of file
+	// At a depth of 1, which only passes where the depth buffer was left cleared
+	gl_Position = vec4(pos, 1.0, 1.0);
+}
@@ -0,0 +1,346 @@
+#include "aabb_tree.h"
+
+#include <cassert>
+
+// How many times the displacement of a moving proxy its enlarged box is stretched by
+static const float displacement_multiplier = 2.f;
+
+AABBTree::AABBTree(): root(NULL_NODE), free_list(NULL_NODE), proxy_count(0) {}
+
+// Takes a node from the free list, growing the node pool when it is empty
+int AABBTree::allocateNode() {
+    if (free_list == NULL_NODE) {
+        size_t old_size = nodes.size();
+        nodes.resize(old_size == 0 ? 16 : old_size * 2);
+        // Chain the new nodes into the free list
+        for (size_t i = old_size; i < nodes.size(); i++) {
+            nodes[i].parent = (i + 1 < nodes.size()) ? (int) i + 1 : NULL_NODE;
+            nodes[i].height = -1;
+        }
+        free_list = (int) old_size;
+    }
+
+    int node = free_list;
+    free_list = nodes[node].parent;
+    nodes[node].parent = NULL_NODE;
+    nodes[node].child1 = NULL_NODE;
+    nodes[node].child2 = NULL_NODE;
+    nodes[node].height = 0;
+    nodes[node].user_data = 0;
+    return node;
+}
+
+// Returns a node to the free list
+void AABBTree::freeNode(int node) {
+    nodes[node].parent = free_list;
+    nodes[node].height = -1;
+    free_list = node;
+}
+
+// Adds a box to the tree, returns the id of its proxy leaf
+int AABBTree::createProxy(const AABB& box, uint32_t user_data) {
+    int proxy = allocateNode();
+    glm::vec3 margin(AABB_TREE_MARGIN);
+    nodes[proxy].box = AABB(box.min - margin, box.max + margin);
+    nodes[proxy].user_data = user_data;
+    insertLeaf(proxy);
+    proxy_count++;
+    return proxy;
+}
+
+// Removes a proxy from the tree
+void AABBTree::destroyProxy(int proxy) {
+    assert(nodes[proxy].isLeaf());
+    removeLeaf(proxy);
+    freeNode(proxy);
+    proxy_count--;
+}
+
+// Updates the box of a proxy, only reinserting it when it leaves its enlarged box
+bool AABBTree::moveProxy(int proxy, const AABB& box, glm::vec3 displacement) {
+    if (nodes[proxy].box.contains(box))
+        return false;
+
+    removeLeaf(proxy);
+
+    // Enlarge the box, and stretch it further in the direction it is moving so it stays inside for longer
+    glm::vec3 margin(AABB_TREE_MARGIN);
+    AABB fat_box(box.min - margin, box.max + margin);
+    glm::vec3 stretch = displacement_multiplier * displacement;
+    fat_box.min += glm::min(stretch, glm::vec3(0.f));
+    fat_box.max += glm::max(stretch, glm::vec3(0.f));
+    nodes[proxy].box = fat_box;
+
+    insertLeaf(proxy);
+    return true;
+}
+
+// Inserts a leaf next to the sibling that makes the tree grow the least in surface area
+void AABBTree::insertLeaf(int leaf) {
+    if (root == NULL_NODE) {
+        root = leaf;
+        nodes[root].parent = NULL_NODE;
+        return;
+    }
+
+    // Descend towards the cheapest sibling using the surface area heuristic
+    AABB leaf_box = nodes[leaf].box;
+    int index = root;
+    while (!nodes[index].isLeaf()) {
+        int child1 = nodes[index].child1;
+        int child2 = nodes[index].child2;
+
+        float area = nodes[index].box.getSurfaceArea();
+        float combined_area = AABB::merge(nodes[index].box, leaf_box).getSurfaceArea();
+
+        // Cost of making a new parent for this node and the new leaf
+        float cost = 2.f * combined_area;
+        // Minimum cost of pushing the leaf further down the tree
+        float inheritance_cost = 2.f * (combined_area - area);
+
+        float cost1 = AABB::merge(leaf_box, nodes[child1].box).getSurfaceArea() + inheritance_cost;
+        if (!nodes[child1].isLeaf())
+            cost1 -= nodes[child1].box.getSurfaceArea();
+        float cost2 = AABB::merge(leaf_box, nodes[child2].box).getSurfaceArea() + inheritance_cost;
+        if (!nodes[child2].isLeaf())
+            cost2 -= nodes[child2].box.getSurfaceArea();
+
+        if (cost < cost1 && cost < cost2)
+            break;
+        index = (cost1 < cost2) ? child1 : child2;
+    }
+    int sibling = index;
+
+    // Create a new parent for the sibling and the leaf
+    int old_parent = nodes[sibling].parent;
+    int new_parent = allocateNode();
+    nodes[new_parent].parent = old_parent;
+    nodes[new_parent].box = AABB::merge(leaf_box, nodes[sibling].box);
+    nodes[new_parent].height = nodes[sibling].height + 1;
+    nodes[new_parent].child1 = sibling;
+    nodes[new_parent].child2 = leaf;
+    nodes[sibling].parent = new_parent;
+    nodes[leaf].parent = new_parent;
+
+    if (old_parent != NULL_NODE) {
+        if (nodes[old_parent].child1 == sibling)
+            nodes[old_parent].child1 = new_parent;
+        else
+            nodes[old_parent].child2 = new_parent;
+    }
+    else
+        root = new_parent;
+
+    refitAncestors(nodes[leaf].parent);
+}
+
+// Detaches a leaf from the tree, its sibling takes the place of their parent
+void AABBTree::removeLeaf(int leaf) {
+    if (leaf == root) {
+        root = NULL_NODE;
+        return;
+    }
+
+    int parent = nodes[leaf].parent;
+    int grand_parent = nodes[parent].parent;
+    int sibling = (nodes[parent].child1 == leaf) ? nodes[parent].child2 : nodes[parent].child1;
+
+    if (grand_parent != NULL_NODE) {
+        if (nodes[grand_parent].child1 == parent)
+            nodes[grand_parent].child1 = sibling;
+        else
+            nodes[grand_parent].child2 = sibling;
+        nodes[sibling].parent = grand_parent;
+        freeNode(parent);
+        refitAncestors(grand_parent);
+    }
+    else {
+        root = sibling;
+        nodes[sibling].parent = NULL_NODE;
+        freeNode(parent);
+    }
+}
+
+// Walks up from a node refitting boxes and heights, rebalancing every node along the way
+void AABBTree::refitAncestors(int node) {
+    while (node != NULL_NODE) {
+        node = balance(node);
+
+        int child1 = nodes[node].child1;
+        int child2 = nodes[node].child2;
+        nodes[node].height = 1 + std::max(nodes[child1].height, nodes[child2].height);
+        nodes[node].box = AABB::merge(nodes[child1].box, nodes[child2].box);
+
+        node = nodes[node].parent;
+    }
+}
+
+// Rotates the taller child of a node up if the node is unbalanced, returns the node now in its place
+int AABBTree::balance(int a) {
+    if (nodes[a].isLeaf() || nodes[a].height < 2)
+        return a;
+
+    int b = nodes[a].child1;
+    int c = nodes[a].child2;
+    int difference = nodes[c].height - nodes[b].height;
+
+    // Promote the taller child, it becomes the parent of a and a keeps the shorter grand child
+    if (difference > 1 || difference < -1) {
+        int up = (difference > 1) ? c : b;
+        int other = (difference > 1) ? b : c;
+        int f = nodes[up].child1;
+        int g = nodes[up].child2;
+
+        // Swap a and up
+        nodes[up].child1 = a;
+        nodes[up].parent = nodes[a].parent;
+        nodes[a].parent = up;
+
+        if (nodes[up].parent != NULL_NODE) {
+            if (nodes[nodes[up].parent].child1 == a)
+                nodes[nodes[up].parent].child1 = up;
+            else
+                nodes[nodes[up].parent].child2 = up;
+        }
+        else
+            root = up;
+
+        // Keep the taller grand child under up and hand the shorter one to a
+        int keep = (nodes[f].height > nodes[g].height) ? f : g;
+        int give = (keep == f) ? g : f;
+        nodes[up].child2 = keep;
+        if (difference > 1) {
+            nodes[a].child2 = give;
+            nodes[a].child1 = other;
+        }
+        else {
+            nodes[a].child1 = give;
+            nodes[a].child2 = other;
+        }
+        nodes[give].parent = a;
+
+        nodes[a].box = AABB::merge(nodes[other].box, nodes[give].box);
+        nodes[up].box = AABB::merge(nodes[a].box, nodes[keep].box);
+        nodes[a].height = 1 + std::max(nodes[other].height, nodes[give].height);
+        nodes[up].height = 1 + std::max(nodes[a].height, nodes[keep].height);
+        return up;
+    }
+    return a;
+}
+
+// Calls callback with the user data of every proxy whose box may be inside the frustum
+void AABBTree::queryFrustum(const Frustum& frustum, const std::function<void(uint32_t)>& callback) const {
+    int stack[AABB_TREE_STACK_SIZE];
+    int stack_size = 0;
+    if (root != NULL_NODE)
+        stack[stack_size++] = root;
+
+    while (stack_size > 0) {
+        const AABBTreeNode& node = nodes[stack[--stack_size]];
+        if (!frustum.intersects(node.box))
+            continue;
+        if (node.isLeaf())
+            callback(node.user_data);
+        else {
+            assert(stack_size + 2 <= AABB_TREE_STACK_SIZE);
+            stack[stack_size++] = node.child1;
+            stack[stack_size++] = node.child2;
+        }
+    }
+}
+
+// Calls callback with the user data of every proxy whose box touches the sphere
+void AABBTree::querySphere(glm::vec3 center, float radius, const std::function<void(uint32_t)>& callback) const {
+    int stack[AABB_TREE_STACK_SIZE];
+    int stack_size = 0;
+    if (root != NULL_NODE)
+        stack[stack_size++] = root;
+
+    while (stack_size > 0) {
+        const AABBTreeNode& node = nodes[stack[--stack_size]];
+        if (!node.box.overlaps(center, radius))
+            continue;
+        if (node.isLeaf())
+            callback(node.user_data);
+        else {
+            assert(stack_size + 2 <= AABB_TREE_STACK_SIZE);
+            stack[stack_size++] = node.child1;
+            stack[stack_size++] = node.child2;
+        }
+    }
+}
+
+// Calls callback with the user data of every proxy whose box overlaps another box
+void AABBTree::queryAABB(const AABB& box, const std::function<void(uint32_t)>& callback) const {
+    int stack[AABB_TREE_STACK_SIZE];
+    int stack_size = 0;
+    if (root != NULL_NODE)
+        stack[stack_size++] = root;
+
+    while (stack_size > 0) {
+        const AABBTreeNode& node = nodes[stack[--stack_size]];
+        if (!node.box.overlaps(box))
+            continue;
+        if (node.isLeaf())
+            callback(node.user_data);
+        else {
+            assert(stack_size + 2 <= AABB_TREE_STACK_SIZE);
+            stack[stack_size++] = node.child1;
+            stack[stack_size++] = node.child2;
+        }
+    }
+}
+
+// Walks the proxies whose boxes the ray passes through, calling callback with the user data and current max distance
+void AABBTree::rayCast(glm::vec3 origin, glm::vec3 direction, float max_distance,
+    const std::function<float(uint32_t, float)>& callback) const {
+    glm::vec3 inv_direction = 1.f / direction;
+    int stack[AABB_TREE_STACK_SIZE];
+    int stack_size = 0;
+    if (root != NULL_NODE)
+        stack[stack_size++] = root;
+
+    while (stack_size > 0) {
+        const AABBTreeNode& node = nodes[stack[--stack_size]];
+        float enter;
+        if (!node.box.intersectRay(origin, inv_direction, max_distance, enter))
+            continue;
+        if (node.isLeaf())
+            max_distance = std::min(max_distance, callback(node.user_data, max_distance));
+        else {
+            assert(stack_size + 2 <= AABB_TREE_STACK_SIZE);
+            // Visit the nearer child first so hits shorten the ray as early as possible
+            float enter1 = FLT_MAX, enter2 = FLT_MAX;
+            if (!nodes[node.child1].box.intersectRay(origin, inv_direction, max_distance, enter1))
+                enter1 = FLT_MAX;
+            if (!nodes[node.child2].box.intersectRay(origin, inv_direction, max_distance, enter2))
+                enter2 = FLT_MAX;
+            // The stack is last in first out, so the nearer child is pushed last
+            if (enter1 > enter2) {
+                stack[stack_size++] = node.child1;
+                stack[stack_size++] = node.child2;
+            }
+            else {
+                stack[stack_size++] = node.child2;
+                stack[stack_size++] = node.child1;
+            }
+        }
+    }
+}
+
+// Number of levels of the tree
+int AABBTree::getHeight() const {
+    return root == NULL_NODE ? 0 : nodes[root].height + 1;
+}
+
+// Sum of the surface areas of the inner nodes relative to the root, lower means cheaper queries
+float AABBTree::getAreaRatio() const {
+    if (root == NULL_NODE)
+        return 0.f;
+
+    float total_area = 0.f;
+    for (const AABBTreeNode& node : nodes)
+        if (node.height > 0)
+            total_area += node.box.getSurfaceArea();
+    return total_area / nodes[root].box.getSurfaceArea();
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "bounds.h"
+
+// Marks the absence of a node in the tree
+#define NULL_NODE -1
+// Distance the boxes stored in the tree are grown by, so objects can move a little without the tree changing
+#define AABB_TREE_MARGIN 0.5f
+// Deepest traversal a query supports, far beyond the height of a balanced tree of millions of proxies
+#define AABB_TREE_STACK_SIZE 256
+
+// A node of the tree, leaves hold the user's boxes and inner nodes the boxes enclosing their two children
+struct AABBTreeNode {
+    AABB box;
+    uint32_t user_data;
+    int parent;     // Doubles as the next free node while the node is unused
+    int child1;
+    int child2;
+    int height;     // 0 for leaves, -1 for unused nodes
+
+    inline bool isLeaf() const {
+        return child1 == NULL_NODE;
+    }
+};
+
+// Bounding volume hierarchy of boxes that is updated incrementally as they move
+// Leaves store enlarged boxes so small movements need no update, and the tree is rebalanced with rotations on every change
+class AABBTree {
+public:
+    AABBTree();
+
+    // Adds a box to the tree, returns the id of its proxy leaf
+    int createProxy(const AABB& box, uint32_t user_data);
+
+    // Removes a proxy from the tree
+    void destroyProxy(int proxy);
+
+    // Updates the box of a proxy, only reinserting it when it leaves its enlarged box
+    // displacement predicts where the box is moving so the enlarged box is stretched in that direction, returns true if the tree changed
+    bool moveProxy(int proxy, const AABB& box, glm::vec3 displacement = glm::vec3(0.f));
+
+    inline uint32_t getUserData(int proxy) const {
+        return nodes[proxy].user_data;
+    }
+
+    // Gets the enlarged box stored for a proxy
+    inline const AABB& getFatAABB(int proxy) const {
+        return nodes[proxy].box;
+    }
+
+    // Calls callback with the user data of every proxy whose box may be inside the frustum
+    void queryFrustum(const Frustum& frustum, const std::function<void(uint32_t)>& callback) const;
+
+    // Calls callback with the user data of every proxy whose box touches the sphere
+    void querySphere(glm::vec3 center, float radius, const std::function<void(uint32_t)>& callback) const;
+
+    // Calls callback with the user data of every proxy whose box overlaps another box
+    void queryAABB(const AABB& box, const std::function<void(uint32_t)>& callback) const;
+
+    // Walks the proxies whose boxes the ray passes through, calling callback with the user data and current max distance
+    // callback returns the distance of its own hit to shorten the ray, or the max distance it was given to keep it
+    void rayCast(glm::vec3 origin, glm::vec3 direction, float max_distance,
+        const std::function<float(uint32_t, float)>& callback) const;
+
+    // Number of levels of the tree
+    int getHeight() const;
+
+    // Number of proxies in the tree
+    inline int getProxyCount() const {
+        return proxy_count;
+    }
+
+    // Sum of the surface areas of the inner nodes relative to the root, lower means cheaper queries
+    float getAreaRatio() const;
+
+private:
+    std::vector<AABBTreeNode> nodes;
+    int root;
+    int free_list;
+    int proxy_count;
+
+    int allocateNode();
+    void freeNode(int node);
+    void insertLeaf(int leaf);
+    void removeLeaf(int leaf);
+    int balance(int node);
+    void refitAncestors(int node);
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "common.h"
+#include "model.h"
+#include "texture.h"
+
+// Loads each mesh and texture once however many scenes, materials and entities refer to it
+class AssetCache {
+public:
+    // Gets the mesh loaded from an obj file path, loading it on first use
+    inline VertexAttribs& getMesh(const std::string& path) {
+        std::unique_ptr<VertexAttribs>& mesh = meshes[path];
+        if (!mesh)
+            mesh.reset(new VertexAttribs(path.c_str()));
+        return *mesh;
+    }
+
+    // Gets the texture loaded from an image path, loading it on first use
+    // Materials take copies of it, which refer to the same texture and can bind it to their own tex_unit
+    inline Texture& getTexture(const std::string& path) {
+        std::unique_ptr<Texture>& texture = textures[path];
+        if (!texture)
+            texture.reset(new Texture(path.c_str()));
+        return *texture;
+    }
+
+    inline size_t getMeshCount() {
+        return meshes.size();
+    }
+
+    inline size_t getTextureCount() {
+        return textures.size();
+    }
+
+private:
+    std::unordered_map<std::string, std::unique_ptr<VertexAttribs>> meshes;
+    std::unordered_map<std::string, std::unique_ptr<Texture>> textures;
+};
@@ -0,0 +1,468 @@
+#include "asset_pack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "startup_timeline.h"
+
+// Matches shorter than this are not worth encoding, and LZ4 blocks end with literals that no match may reach into
+#define LZ4_MIN_MATCH 4
+#define LZ4_LAST_LITERALS 5
+#define LZ4_MATCH_START_LIMIT 12
+#define LZ4_MAX_OFFSET 65535
+#define LZ4_HASH_BITS 16
+
+static const unsigned char* mapping = nullptr;
+static size_t mapping_size = 0;
+static const PackHeader* header = nullptr;
+static const PackEntry* entries = nullptr;
+static const char* names = nullptr;
+#ifdef _WIN32
+static HANDLE file_handle = INVALID_HANDLE_VALUE;
+static HANDLE mapping_handle = NULL;
+#endif
+
+// Maps a whole file read only, false if it can not be opened or is empty
+static bool mapFile(const std::string& path) {
+#ifdef _WIN32
+    file_handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, NULL);
+    if (file_handle == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file_handle, &size) || size.QuadPart == 0) {
+        CloseHandle(file_handle);
+        file_handle = INVALID_HANDLE_VALUE;
+        return false;
+    }
+    mapping_handle = CreateFileMappingA(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping_handle)
+        mapping = (const unsigned char*) MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+    if (!mapping) {
+        if (mapping_handle)
+            CloseHandle(mapping_handle);
+        CloseHandle(file_handle);
+        mapping_handle = NULL;
+        file_handle = INVALID_HANDLE_VALUE;
+        return false;
+    }
+    mapping_size = (size_t) size.QuadPart;
+#else
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0)
+        return false;
+    struct stat info;
+    if (fstat(file, &info) != 0 || info.st_size == 0) {
+        ::close(file);
+        return false;
+    }
+    // The mapping keeps the file alive on its own
+    void* view = mmap(nullptr, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    ::close(file);
+    if (view == MAP_FAILED)
+        return false;
+    mapping = (const unsigned char*) view;
+    mapping_size = (size_t) info.st_size;
+#endif
+    return true;
+}
+
+static void unmapFile() {
+    if (!mapping)
+        return;
+#ifdef _WIN32
+    UnmapViewOfFile(mapping);
+    CloseHandle(mapping_handle);
+    CloseHandle(file_handle);
+    mapping_handle = NULL;
+    file_handle = INVALID_HANDLE_VALUE;
+#else
+    munmap((void*) mapping, mapping_size);
+#endif
+    mapping = nullptr;
+    mapping_size = 0;
+}
+
+// Checks the mapped pack and points the header, entries and names into it
+static bool bindPack(const std::string& path) {
+    if (mapping_size < sizeof(PackHeader) || memcmp(mapping, PACK_MAGIC, 4) != 0) {
+        std::cout << path << " is not an asset pack\n";
+        return false;
+    }
+    header = (const PackHeader*) mapping;
+    if (header->version != PACK_VERSION) {
+        std::cout << path << " is version " << header->version << " of the asset pack format, expected " << PACK_VERSION << '\n';
+        return false;
+    }
+
+    uint64_t names_offset = sizeof(PackHeader) + (uint64_t) header->entry_count * sizeof(PackEntry);
+    if (names_offset + header->names_size > mapping_size || header->names_size == 0 || mapping[names_offset + header->names_size - 1] != '\0') {
+        std::cout << path << " is corrupt, its table of contents is out of bounds\n";
+        return false;
+    }
+    entries = (const PackEntry*) (mapping + sizeof(PackHeader));
+    names = (const char*) (mapping + names_offset);
+
+    for (uint32_t i = 0; i < header->entry_count; i++) {
+        const PackEntry& entry = entries[i];
+        bool valid = entry.name < header->names_size && entry.codec <= PACK_CODEC_LZ4 &&
+            entry.offset <= mapping_size && entry.stored_size <= mapping_size - entry.offset &&
+            (entry.codec != PACK_CODEC_NONE || entry.stored_size == entry.size);
+        if (!valid) {
+            std::cout << path << " is corrupt, entry " << i << " is out of bounds\n";
+            return false;
+        }
+        if (i > 0 && strcmp(names + entries[i - 1].name, names + entry.name) >= 0) {
+            std::cout << path << " is corrupt, its entries are not sorted\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+// Gets a path the way the pack names it, with forward slashes and no leading ./
+static std::string normalizePath(const char* path) {
+    std::string name(path);
+    std::replace(name.begin(), name.end(), '\\', '/');
+    while (name.compare(0, 2, "./") == 0)
+        name.erase(0, 2);
+    return name;
+}
+
+// Finds the entry of an asset by binary search over the sorted entries
+static const PackEntry* findEntry(const std::string& name) {
+    const PackEntry* first = entries;
+    const PackEntry* last = entries + header->entry_count;
+    const PackEntry* entry = std::lower_bound(first, last, name, [](const PackEntry& e, const std::string& n) {
+        return strcmp(names + e.name, n.c_str()) < 0;
+    });
+    if (entry == last || name != names + entry->name)
+        return nullptr;
+    return entry;
+}
+
+// Decodes an LZ4 block, false if it is malformed or does not fill the output exactly
+static bool decompressLZ4(const unsigned char* src, size_t src_size, unsigned char* dst, size_t dst_size) {
+    size_t in = 0, out = 0;
+    while (in < src_size) {
+        unsigned token = src[in++];
+
+        // Literals, with 255 bytes extending their length
+        size_t literals = token >> 4;
+        if (literals == 15) {
+            unsigned char extra;
+            do {
+                if (in >= src_size)
+                    return false;
+                extra = src[in++];
+                literals += extra;
+            } while (extra == 255);
+        }
+        if (literals > src_size - in || literals > dst_size - out)
+            return false;
+        memcpy(dst + out, src + in, literals);
+        in += literals;
+        out += literals;
+
+        // The last sequence has no match
+        if (in == src_size)
+            break;
+
+        if (src_size - in < 2)
+            return false;
+        size_t offset = src[in] | (src[in + 1] << 8);
+        in += 2;
+        if (offset == 0 || offset > out)
+            return false;
+
+        size_t length = token & 15;
+        if (length == 15) {
+            unsigned char extra;
+            do {
+                if (in >= src_size)
+                    return false;
+                extra = src[in++];
+                length += extra;
+            } while (extra == 255);
+        }
+        length += LZ4_MIN_MATCH;
+        if (length > dst_size - out)
+            return false;
+
+        // Matches closer than their length repeat the bytes they are copying, so they are copied a period at a time
+        for (size_t copied = 0; copied < length; ) {
+            size_t chunk = std::min(offset, length - copied);
+            memcpy(dst + out + copied, dst + out + copied - offset, chunk);
+            copied += chunk;
+        }
+        out += length;
+    }
+    return out == dst_size;
+}
+
+// Writes a length past what fits in a token as a run of 255 bytes and the remainder
+static void writeLength(std::vector<unsigned char>& out, size_t length) {
+    while (length >= 255) {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back((unsigned char) length);
+}
+
+// Writes literals followed by a match, or only the literals at the end of the block when length is 0
+static void writeSequence(std::vector<unsigned char>& out, const unsigned char* literals, size_t literal_count, size_t offset, size_t length) {
+    size_t match_code = length ? length - LZ4_MIN_MATCH : 0;
+    out.push_back((unsigned char) ((std::min<size_t>(literal_count, 15) << 4) | std::min<size_t>(match_code, 15)));
+    if (literal_count >= 15)
+        writeLength(out, literal_count - 15);
+    out.insert(out.end(), literals, literals + literal_count);
+    if (!length)
+        return;
+    out.push_back((unsigned char) (offset & 0xFF));
+    out.push_back((unsigned char) (offset >> 8));
+    if (match_code >= 15)
+        writeLength(out, match_code - 15);
+}
+
+// Encodes an LZ4 block with a greedy single probe hash table, which is enough for OBJ and GLSL text
+static void compressLZ4(const unsigned char* src, size_t size, std::vector<unsigned char>& out) {
+    out.clear();
+    out.reserve(size + size / 255 + 16);
+    size_t anchor = 0;
+
+    if (size > LZ4_MATCH_START_LIMIT) {
+        // Positions are stored plus one so 0 marks an empty slot
+        std::vector<uint32_t> table(1 << LZ4_HASH_BITS, 0);
+        size_t match_start_limit = size - LZ4_MATCH_START_LIMIT;
+        size_t match_end_limit = size - LZ4_LAST_LITERALS;
+        size_t pos = 0;
+        while (pos <= match_start_limit) {
+            uint32_t sequence;
+            memcpy(&sequence, src + pos, 4);
+            uint32_t hash = (sequence * 2654435761u) >> (32 - LZ4_HASH_BITS);
+            size_t candidate = table[hash];
+            table[hash] = (uint32_t) pos + 1;
+            if (candidate == 0 || pos - (candidate - 1) > LZ4_MAX_OFFSET || memcmp(src + candidate - 1, src + pos, 4) != 0) {
+                pos++;
+                continue;
+            }
+
+            size_t match = candidate - 1;
+            size_t length = LZ4_MIN_MATCH;
+            while (pos + length < match_end_limit && src[match + length] == src[pos + length])
+                length++;
+            writeSequence(out, src + anchor, pos - anchor, pos - match, length);
+            pos += length;
+            anchor = pos;
+        }
+    }
+    writeSequence(out, src + anchor, size - anchor, 0, 0);
+}
+
+// Reads a whole loose file into a blob's storage
+static bool readLooseFile(const char* path, AssetBlob& blob) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+        return false;
+    std::streamoff size = file.tellg();
+    blob.storage.resize(size > 0 ? (size_t) size : 0);
+    file.seekg(0);
+    file.read((char*) blob.storage.data(), blob.storage.size());
+    blob.data = blob.storage.data();
+    blob.size = blob.storage.size();
+    blob.bytes_read = blob.size;
+    return true;
+}
+
+// Maps a pack, false if it does not exist or is not a valid pack
+bool AssetPack::open(const std::string& path) {
+    shutdown();
+    StartupScope step("Map asset pack", path);
+    if (!mapFile(path))
+        return false;
+    if (!bindPack(path)) {
+        shutdown();
+        return false;
+    }
+    step.bytes_read = sizeof(PackHeader) + header->entry_count * sizeof(PackEntry) + header->names_size;
+    return true;
+}
+
+// Unmaps the pack, blobs sliced from it must no longer be used
+void AssetPack::shutdown() {
+    unmapFile();
+    header = nullptr;
+    entries = nullptr;
+    names = nullptr;
+}
+
+bool AssetPack::isOpen() {
+    return header != nullptr;
+}
+
+uint32_t AssetPack::getEntryCount() {
+    return header ? header->entry_count : 0;
+}
+
+// Gets the bytes of an asset from the pack or its loose file, false if neither has it
+bool AssetPack::load(const char* path, AssetBlob& blob) {
+    blob.storage.clear();
+    const PackEntry* entry = header ? findEntry(normalizePath(path)) : nullptr;
+    if (!entry)
+        return readLooseFile(path, blob);
+
+    const unsigned char* stored = mapping + entry->offset;
+    blob.bytes_read = entry->stored_size;
+    if (entry->codec == PACK_CODEC_NONE) {
+        blob.data = stored;
+        blob.size = (size_t) entry->size;
+        return true;
+    }
+
+    blob.storage.resize((size_t) entry->size);
+    if (!decompressLZ4(stored, (size_t) entry->stored_size, blob.storage.data(), blob.storage.size())) {
+        std::cout << "The asset pack's copy of " << path << " is corrupt\n";
+        blob.storage.clear();
+        return readLooseFile(path, blob);
+    }
+    blob.data = blob.storage.data();
+    blob.size = blob.storage.size();
+    return true;
+}
+
+// Lists every file under a directory, with paths starting from it
+static void listFiles(const std::string& directory, std::vector<std::string>& files) {
+#ifdef _WIN32
+    WIN32_FIND_DATAA found;
+    HANDLE search = FindFirstFileA((directory + "/*").c_str(), &found);
+    if (search == INVALID_HANDLE_VALUE)
+        return;
+    do {
+        std::string name = found.cFileName;
+        if (name == "." || name == "..")
+            continue;
+        if (found.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+            listFiles(directory + "/" + name, files);
+        else
+            files.push_back(directory + "/" + name);
+    } while (FindNextFileA(search, &found));
+    FindClose(search);
+#else
+    DIR* dir = opendir(directory.c_str());
+    if (!dir)
+        return;
+    while (dirent* found = readdir(dir)) {
+        std::string name = found->d_name;
+        if (name == "." || name == "..")
+            continue;
+        std::string path = directory + "/" + name;
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0)
+            continue;
+        if (S_ISDIR(info.st_mode))
+            listFiles(path, files);
+        else if (S_ISREG(info.st_mode))
+            files.push_back(path);
+    }
+    closedir(dir);
+#endif
+}
+
+// Packs every file under the directories into a new pack, compressing the entries LZ4 shrinks enough unless compress is false
+bool AssetPack::build(const std::string& path, const std::vector<std::string>& directories, bool compress) {
+    std::vector<std::string> files;
+    for (const std::string& directory : directories)
+        listFiles(normalizePath(directory.c_str()), files);
+    std::sort(files.begin(), files.end());
+    files.erase(std::unique(files.begin(), files.end()), files.end());
+    if (files.empty()) {
+        std::cout << "Found no assets to pack\n";
+        return false;
+    }
+
+    // Read and compress every file, compression is only kept when it saves at least an eighth
+    std::vector<std::vector<unsigned char>> blobs(files.size());
+    std::vector<PackEntry> pack_entries(files.size());
+    std::string pack_names;
+    std::vector<unsigned char> compressed;
+    for (size_t i = 0; i < files.size(); i++) {
+        AssetBlob blob;
+        if (!readLooseFile(files[i].c_str(), blob)) {
+            std::cout << "Could not read " << files[i] << '\n';
+            return false;
+        }
+        PackEntry& entry = pack_entries[i];
+        entry.name = (uint32_t) pack_names.size();
+        entry.size = blob.size;
+        pack_names += files[i];
+        pack_names += '\0';
+
+        if (compress)
+            compressLZ4(blob.data, blob.size, compressed);
+        if (compress && compressed.size() < blob.size - blob.size / 8) {
+            entry.codec = PACK_CODEC_LZ4;
+            blobs[i].swap(compressed);
+        } else {
+            entry.codec = PACK_CODEC_NONE;
+            blobs[i].swap(blob.storage);
+        }
+        entry.stored_size = blobs[i].size();
+    }
+
+    PackHeader pack_header;
+    memcpy(pack_header.magic, PACK_MAGIC, 4);
+    pack_header.version = PACK_VERSION;
+    pack_header.entry_count = (uint32_t) files.size();
+    pack_header.names_size = (uint32_t) pack_names.size();
+
+    // Lay the blobs out after the table of contents, each on the alignment
+    uint64_t offset = sizeof(PackHeader) + files.size() * sizeof(PackEntry) + pack_names.size();
+    for (PackEntry& entry : pack_entries) {
+        offset = (offset + PACK_ALIGNMENT - 1) / PACK_ALIGNMENT * PACK_ALIGNMENT;
+        entry.offset = offset;
+        offset += entry.stored_size;
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        std::cout << "Could not write the asset pack " << path << '\n';
+        return false;
+    }
+    out.write((const char*) &pack_header, sizeof(pack_header));
+    out.write((const char*) pack_entries.data(), pack_entries.size() * sizeof(PackEntry));
+    out.write(pack_names.data(), pack_names.size());
+    uint64_t written = sizeof(PackHeader) + files.size() * sizeof(PackEntry) + pack_names.size();
+    static const char padding[PACK_ALIGNMENT] = {};
+    uint64_t stored_total = 0, size_total = 0;
+    for (size_t i = 0; i < files.size(); i++) {
+        out.write(padding, (std::streamsize) (pack_entries[i].offset - written));
+        out.write((const char*) blobs[i].data(), blobs[i].size());
+        written = pack_entries[i].offset + blobs[i].size();
+        stored_total += pack_entries[i].stored_size;
+        size_total += pack_entries[i].size;
+
+        std::cout << files[i] << ": " << pack_entries[i].size << " bytes";
+        if (pack_entries[i].codec == PACK_CODEC_LZ4)
+            std::cout << ", " << pack_entries[i].stored_size << " compressed";
+        std::cout << '\n';
+    }
+    if (!out) {
+        std::cout << "Could not write the asset pack " << path << '\n';
+        return false;
+    }
+    std::cout << "Packed " << files.size() << " assets, " << size_total << " bytes stored in " << stored_total << ", into " << path << '\n';
+    return true;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+// Identifies asset packs and the layout version they were written with
+#define PACK_MAGIC "GXPK"
+#define PACK_VERSION 1
+// Every blob starts on a multiple of this many bytes from the start of the pack
+#define PACK_ALIGNMENT 64
+
+// How an entry's bytes are stored in the pack
+enum PackCodec {
+    PACK_CODEC_NONE,
+    PACK_CODEC_LZ4      // An LZ4 block, decompressed into the blob's own storage when it is read
+};
+
+// Start of a pack, followed by its entries sorted by name, then the null terminated names, then the blobs
+struct PackHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t entry_count;
+    uint32_t names_size;
+};
+
+struct PackEntry {
+    uint32_t name;          // Offset of the asset's path in the names, with forward slashes
+    uint32_t codec;
+    uint64_t offset;        // Offset of the blob from the start of the pack
+    uint64_t stored_size;
+    uint64_t size;
+};
+
+// The bytes of an asset, either a slice of the mapped pack or a buffer they were decompressed or read into
+class AssetBlob {
+public:
+    const unsigned char* data;
+    size_t size;
+    // Bytes read from the pack or the file to get the asset, less than size when it was compressed
+    uint64_t bytes_read;
+    std::vector<unsigned char> storage;
+
+    AssetBlob(): data(nullptr), size(0), bytes_read(0) {}
+
+    // Data may point into storage, so blobs are not copied
+    AssetBlob(const AssetBlob&) = delete;
+    AssetBlob& operator=(const AssetBlob&) = delete;
+};
+
+// Lets parsers that take streams read a blob in place
+class AssetStreamBuf: public std::streambuf {
+public:
+    AssetStreamBuf(const AssetBlob& blob) {
+        char* begin = (char*) blob.data;
+        setg(begin, begin, begin + blob.size);
+    }
+};
+
+// Meshes, textures and shaders packed into one file, which is mapped once and read from in place
+// Every asset is looked up in the pack first and read from its loose file when the pack is missing or does not have it
+class AssetPack {
+public:
+    // Maps a pack, false if it does not exist or is not a valid pack
+    static bool open(const std::string& path);
+
+    // Unmaps the pack, blobs sliced from it must no longer be used
+    static void shutdown();
+
+    static bool isOpen();
+
+    static uint32_t getEntryCount();
+
+    // Gets the bytes of an asset from the pack or its loose file, false if neither has it
+    static bool load(const char* path, AssetBlob& blob);
+
+    // Packs every file under the directories into a new pack, compressing the entries LZ4 shrinks enough unless compress is false
+    static bool build(const std::string& path, const std::vector<std::string>& directories, bool compress = true);
+};
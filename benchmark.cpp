@@ -0,0 +1,1107 @@
+#include "benchmark.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "aabb_tree.h"
+#include "boids.h"
+#include "boids_gpu.h"
+#include "bounds.h"
+#include "collision.h"
+#include "entity.h"
+#include "gbuffer.h"
+#include "gl_stats.h"
+#include "light_clusters.h"
+#include "particles.h"
+#include "profiler.h"
+#include "shadow_map.h"
+#include "point_shadows.h"
+#include "depth_prepass.h"
+#include "occlusion.h"
+#include "gpu_culling.h"
+#include "shader.h"
+#include "stress_scene.h"
+#include "thread_pool.h"
+#include "timing.h"
+
+// Starts a new row of results
+void BenchmarkReport::beginRow() {
+    rows.emplace_back();
+}
+
+// Sets a column of the current row
+void BenchmarkReport::set(const std::string& column, double value) {
+    std::ostringstream out;
+    out << value;
+    set(column, out.str());
+}
+
+// Sets a column of the current row
+void BenchmarkReport::set(const std::string& column, const std::string& value) {
+    if (std::find(columns.begin(), columns.end(), column) == columns.end())
+        columns.push_back(column);
+    rows.back()[column] = value;
+}
+
+// Writes the header and every row as CSV
+void BenchmarkReport::write(std::ostream& out) {
+    for (size_t i = 0; i < columns.size(); i++)
+        out << (i ? "," : "") << columns[i];
+    out << '\n';
+    for (auto& row : rows) {
+        for (size_t i = 0; i < columns.size(); i++) {
+            auto value = row.find(columns[i]);
+            out << (i ? "," : "") << (value != row.end() ? value->second : "");
+        }
+        out << '\n';
+    }
+}
+
+/* AABB TREE */
+
+// Moves boxes around a cube world, updating a tree of them and querying it like the renderer and gameplay code would
+static void benchAABBTree(BenchmarkReport& report, const Settings&) {
+    static const int counts[] = {10000, 25000, 50000, 100000};
+    static const int frames = 120;
+    static const float world_size = 400.f;
+    static const float dt = 1.f / 60.f;
+
+    for (int count : counts) {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> position(-world_size / 2, world_size / 2);
+        std::uniform_real_distribution<float> velocity(-5.f, 5.f);
+        std::uniform_real_distribution<float> size(0.5f, 2.f);
+
+        std::vector<AABB> boxes(count);
+        std::vector<glm::vec3> velocities(count);
+        for (int i = 0; i < count; i++) {
+            glm::vec3 center(position(rng), position(rng), position(rng));
+            glm::vec3 extents(size(rng) / 2);
+            boxes[i] = AABB(center - extents, center + extents);
+            velocities[i] = glm::vec3(velocity(rng), velocity(rng), velocity(rng));
+        }
+
+        // Build by inserting every box
+        AABBTree tree;
+        std::vector<int> proxies(count);
+        Stopwatch build_time;
+        for (int i = 0; i < count; i++)
+            proxies[i] = tree.createProxy(boxes[i], i);
+        double build_ms = build_time.getMilliseconds();
+
+        // A camera in the middle of the world turning around, and a light moving with it
+        glm::mat4 projection = glm::perspective(glm::radians(60.f), 1.f, 0.1f, 100.f);
+        double refit_ms = 0, frustum_ms = 0, linear_frustum_ms = 0, sphere_ms = 0, linear_sphere_ms = 0, ray_ms = 0;
+        long long reinserted = 0, frustum_found = 0, linear_found = 0, sphere_found = 0, linear_sphere_found = 0, ray_hits = 0;
+
+        for (int frame = 0; frame < frames; frame++) {
+            for (int i = 0; i < count; i++) {
+                glm::vec3 displacement = velocities[i] * dt;
+                boxes[i].min += displacement;
+                boxes[i].max += displacement;
+            }
+
+            Stopwatch refit_time;
+            for (int i = 0; i < count; i++)
+                reinserted += tree.moveProxy(proxies[i], boxes[i], velocities[i] * dt);
+            refit_ms += refit_time.getMilliseconds();
+
+            float angle = glm::radians(frame * 3.f);
+            glm::vec3 eye(0.f);
+            glm::vec3 forward(std::cos(angle), 0.f, std::sin(angle));
+            Frustum frustum(projection * glm::lookAt(eye, eye + forward, glm::vec3(0, 1, 0)));
+
+            Stopwatch frustum_time;
+            tree.queryFrustum(frustum, [&](uint32_t) { frustum_found++; });
+            frustum_ms += frustum_time.getMilliseconds();
+
+            Stopwatch linear_frustum_time;
+            for (int i = 0; i < count; i++)
+                linear_found += frustum.intersects(boxes[i]);
+            linear_frustum_ms += linear_frustum_time.getMilliseconds();
+
+            glm::vec3 light_pos = forward * 20.f;
+            Stopwatch sphere_time;
+            tree.querySphere(light_pos, 30.f, [&](uint32_t) { sphere_found++; });
+            sphere_ms += sphere_time.getMilliseconds();
+
+            Stopwatch linear_sphere_time;
+            for (int i = 0; i < count; i++)
+                linear_sphere_found += boxes[i].overlaps(light_pos, 30.f);
+            linear_sphere_ms += linear_sphere_time.getMilliseconds();
+
+            // Fan of rays from the camera, each looking for the nearest box it hits
+            Stopwatch ray_time;
+            for (int ray = 0; ray < 100; ray++) {
+                float ray_angle = angle + glm::radians(ray * 3.6f);
+                glm::vec3 direction(std::cos(ray_angle), 0.05f, std::sin(ray_angle));
+                glm::vec3 inv_direction = 1.f / direction;
+                bool hit = false;
+                tree.rayCast(eye, direction, world_size, [&](uint32_t index, float max) {
+                    float distance;
+                    if (!boxes[index].intersectRay(eye, inv_direction, max, distance))
+                        return max;
+                    hit = true;
+                    return distance;
+                });
+                ray_hits += hit;
+            }
+            ray_ms += ray_time.getMilliseconds();
+        }
+
+        report.beginRow();
+        report.set("entities", count);
+        report.set("build_ms", build_ms);
+        report.set("refit_ms", refit_ms / frames);
+        report.set("reinserted_per_frame", (double) reinserted / frames);
+        report.set("frustum_tree_ms", frustum_ms / frames);
+        report.set("frustum_linear_ms", linear_frustum_ms / frames);
+        report.set("frustum_candidates", (double) frustum_found / frames);
+        report.set("frustum_visible", (double) linear_found / frames);
+        report.set("sphere_tree_ms", sphere_ms / frames);
+        report.set("sphere_linear_ms", linear_sphere_ms / frames);
+        report.set("sphere_candidates", (double) sphere_found / frames);
+        report.set("sphere_touching", (double) linear_sphere_found / frames);
+        report.set("raycast_100_ms", ray_ms / frames);
+        report.set("ray_hits", (double) ray_hits / frames);
+        report.set("tree_height", tree.getHeight());
+        report.set("area_ratio", tree.getAreaRatio());
+    }
+}
+
+/* COLLISION */
+
+// Moves spheres, capsules and boxes around a cube world at the simulation rate, finding their contacts every step
+static void benchCollision(BenchmarkReport& report, const Settings&) {
+    static const int counts[] = {1000, 2500, 5000, 10000};
+    static const int steps = 240;
+    // Brute force is quadratic, so it is only run to check the grid on the smaller scenes
+    static const int max_brute_force_count = 2500;
+
+    ThreadPool pool;
+    for (int count : counts) {
+        // Keep the number of neighbours of each body the same as the scene grows
+        float world_size = 6.f * std::cbrt((float) count);
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> position(-world_size / 2, world_size / 2);
+        std::uniform_real_distribution<float> velocity(-8.f, 8.f);
+        std::uniform_real_distribution<float> size(0.5f, 2.f);
+        std::uniform_real_distribution<float> angle(0.f, 360.f);
+
+        CollisionWorld world(4.f);
+        std::vector<glm::vec3> positions(count), rotations(count), scales(count), velocities(count);
+        AABB unit_box(glm::vec3(-0.5f), glm::vec3(0.5f));
+        for (int i = 0; i < count; i++) {
+            positions[i] = glm::vec3(position(rng), position(rng), position(rng));
+            rotations[i] = glm::vec3(angle(rng), angle(rng), angle(rng));
+            scales[i] = glm::vec3(size(rng), size(rng), size(rng));
+            velocities[i] = glm::vec3(velocity(rng), velocity(rng), velocity(rng));
+            world.addBody((ColliderShape) (i % 3), unit_box, i);
+        }
+
+        double contacts_ms = 0;
+        long long pairs = 0, contacts = 0, began = 0;
+        for (int step = 0; step < steps; step++) {
+            // Bounce off the walls of the world
+            for (int i = 0; i < count; i++) {
+                positions[i] += velocities[i] * (float) SIM_STEP;
+                for (int axis = 0; axis < 3; axis++)
+                    if (std::abs(positions[i][axis]) > world_size / 2 && positions[i][axis] * velocities[i][axis] > 0.f)
+                        velocities[i][axis] = -velocities[i][axis];
+                world.setTransform(i, composeTransform(positions[i], rotations[i], scales[i]));
+            }
+
+            Stopwatch contacts_time;
+            world.findContacts(pool);
+            contacts_ms += contacts_time.getMilliseconds();
+
+            pairs += world.getPairsTested();
+            contacts += world.contacts.size();
+            for (const Contact& contact : world.contacts)
+                began += contact.began;
+        }
+
+        report.beginRow();
+        report.set("bodies", count);
+        report.set("threads", pool.getThreadCount());
+        report.set("step_ms", contacts_ms / steps);
+        report.set("pairs_per_step", (double) pairs / steps);
+        report.set("pairs_per_second", pairs / (contacts_ms / 1000.0));
+        report.set("contacts_per_step", (double) contacts / steps);
+        report.set("began_per_step", (double) began / steps);
+
+        if (count <= max_brute_force_count) {
+            size_t grid_contacts = world.contacts.size();
+            Stopwatch brute_force_time;
+            world.findContactsBruteForce();
+            report.set("brute_force_step_ms", brute_force_time.getMilliseconds());
+            report.set("brute_force_matches", world.contacts.size() == grid_contacts ? "yes" : "no");
+        }
+    }
+}
+
+/* BOIDS */
+
+// Grows the region with the school so the fish have about as many neighbours at every count
+static BoidSettings scaledBoidSettings(int count, float& scale) {
+    BoidSettings boid_settings;
+    scale = std::cbrt(count / 50000.f);
+    boid_settings.region_min *= glm::vec3(scale, 1.f, scale);
+    boid_settings.region_max *= glm::vec3(scale, 1.f, scale);
+    return boid_settings;
+}
+
+// Gets where a player swimming in circles through the school is on a step
+static glm::vec3 circlingPlayer(int step, float scale) {
+    float angle = step * (float) SIM_STEP;
+    return glm::vec3(std::cos(angle) * 20.f * scale, -20.f, std::sin(angle) * 20.f * scale);
+}
+
+// Steps schools of 5k to 50k fish at the simulation rate, updating four fish at a time with SIMD and one at a time
+static void benchBoids(BenchmarkReport& report, const Settings&) {
+    static const int counts[] = {5000, 10000, 25000, 50000};
+    static const int steps = 120;
+
+    ThreadPool pool;
+    for (int count : counts) {
+        for (int vectorized = 1; vectorized >= 0; vectorized--) {
+            float scale;
+            BoidSettings boid_settings = scaledBoidSettings(count, scale);
+            FishSchool school(count, boid_settings);
+            school.vectorized = vectorized != 0;
+            std::vector<InstanceData> instances(count);
+
+            double step_ms = 0, write_ms = 0;
+            long long neighbors = 0;
+            for (int step = 0; step < steps; step++) {
+                Stopwatch step_time;
+                school.step((float) SIM_STEP, circlingPlayer(step, scale), pool);
+                step_ms += step_time.getMilliseconds();
+                neighbors += (long long) (school.getAverageNeighbors() * count);
+
+                Stopwatch write_time;
+                school.writeInstances(instances.data(), pool);
+                write_ms += write_time.getMilliseconds();
+            }
+
+            report.beginRow();
+            report.set("fish", count);
+            report.set("simd", vectorized ? "yes" : "no");
+            report.set("threads", pool.getThreadCount());
+            report.set("step_ms", step_ms / steps);
+            report.set("write_instances_ms", write_ms / steps);
+            report.set("steps_per_second", steps / (step_ms / 1000.0));
+            report.set("neighbors_per_fish", (double) neighbors / steps / count);
+            report.set("fits_60hz", step_ms / steps <= 1000.0 / 60.0 ? "yes" : "no");
+        }
+    }
+}
+
+/* GL STATS */
+
+// Adds the GL calls and uploads per frame since the last call to the current row, along with the live GL objects
+static void reportGLStats(BenchmarkReport& report, int frames) {
+    if (!GLStats::isEnabled())
+        return;
+
+    GLStats::endFrame();
+    report.set("gl_calls_per_frame", (double) GLStats::getCalls() / frames);
+    report.set("gl_upload_bytes_per_frame", (double) GLStats::getUploadedBytes() / frames);
+    report.set("gl_buffers", (double) GLStats::getLiveCount(GL_RESOURCE_BUFFER));
+    report.set("gl_buffer_bytes", (double) GLStats::getLiveBytes(GL_RESOURCE_BUFFER));
+    report.set("gl_textures", (double) GLStats::getLiveCount(GL_RESOURCE_TEXTURE));
+    report.set("gl_texture_bytes", (double) GLStats::getLiveBytes(GL_RESOURCE_TEXTURE));
+    report.set("gl_vertex_arrays", (double) GLStats::getLiveCount(GL_RESOURCE_VERTEX_ARRAY));
+    report.set("gl_programs", (double) GLStats::getLiveCount(GL_RESOURCE_PROGRAM));
+    report.set("gl_warnings", (double) GLStats::getWarningCount());
+}
+
+// Color and depth buffers the size of the window that GPU benchmarks draw into, bound while it exists
+struct OffscreenTarget {
+    // The depth is a texture so GPU culling can build its pyramid from it
+    GLuint framebuffer, color_buffer, depth_texture;
+
+    OffscreenTarget() {
+        glGenFramebuffers(1, &framebuffer);
+        glGenRenderbuffers(1, &color_buffer);
+        glGenTextures(1, &depth_texture);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, color_buffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, SCREEN_WT, SCREEN_HT);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, color_buffer);
+        glBindTexture(GL_TEXTURE_2D, depth_texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, SCREEN_WT, SCREEN_HT, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depth_texture, 0);
+        glViewport(0, 0, SCREEN_WT, SCREEN_HT);
+        glEnable(GL_DEPTH_TEST);
+    }
+
+    ~OffscreenTarget() {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glDeleteFramebuffers(1, &framebuffer);
+        glDeleteRenderbuffers(1, &color_buffer);
+        glDeleteTextures(1, &depth_texture);
+    }
+};
+
+/* GPU BOIDS */
+
+// Largest distance between a fish of the CPU school and the same fish of the GPU school
+static float maxFishError(const FishSchool& school, GpuFishSchool& gpu_school) {
+    std::vector<GpuFish> gpu_fish;
+    gpu_school.readBack(gpu_fish);
+    float error = 0.f;
+    for (size_t i = 0; i < school.pos_x.size(); i++) {
+        glm::vec3 pos(school.pos_x[i], school.pos_y[i], school.pos_z[i]);
+        error = std::max(error, glm::length(pos - glm::vec3(gpu_fish[school.ids[i]].pos)));
+    }
+    return error;
+}
+
+// Checks the compute shader school against the CPU one, then steps both at 10k to 1M fish
+static void benchBoidsGpu(BenchmarkReport& report, const Settings&) {
+    static const int counts[] = {10000, 100000, 1000000};
+    static const int check_steps = 10;
+
+    if (!GLAD_GL_VERSION_4_3) {
+        std::cout << "Compute shaders need OpenGL 4.3\n";
+        return;
+    }
+
+    ThreadPool pool;
+    for (int count : counts) {
+        float scale;
+        BoidSettings boid_settings = scaledBoidSettings(count, scale);
+        // A million fish take a while on the CPU, so fewer steps are timed
+        int steps = count >= 1000000 ? 10 : 60;
+
+        // Both schools start from the same fish, and neighbours are summed in a different order on the GPU,
+        // so they drift apart by rounding until fish start to fall on different sides of a radius
+        FishSchool school(count, boid_settings);
+        school.vectorized = false;
+        GpuFishSchool gpu_school(school);
+        float first_step_error = 0.f;
+        for (int step = 0; step < check_steps; step++) {
+            school.step((float) SIM_STEP, circlingPlayer(step, scale), pool);
+            gpu_school.step((float) SIM_STEP, circlingPlayer(step, scale));
+            if (step == 0)
+                first_step_error = maxFishError(school, gpu_school);
+        }
+        float check_error = maxFishError(school, gpu_school);
+
+        school.vectorized = true;
+        Stopwatch cpu_time;
+        for (int step = 0; step < steps; step++)
+            school.step((float) SIM_STEP, circlingPlayer(step, scale), pool);
+        double cpu_ms = cpu_time.getMilliseconds() / steps;
+
+        // Steps are only queued by the driver, wait for the GPU to finish them before stopping the clock
+        glFinish();
+        GLStats::endFrame();
+        Stopwatch gpu_time;
+        for (int step = 0; step < steps; step++)
+            gpu_school.step((float) SIM_STEP, circlingPlayer(step, scale));
+        glFinish();
+        double gpu_ms = gpu_time.getMilliseconds() / steps;
+
+        report.beginRow();
+        report.set("fish", count);
+        report.set("renderer", (const char*) glGetString(GL_RENDERER));
+        report.set("threads", pool.getThreadCount());
+        report.set("cpu_step_ms", cpu_ms);
+        report.set("gpu_step_ms", gpu_ms);
+        report.set("speedup", cpu_ms / gpu_ms);
+        report.set("max_error_1_step", first_step_error);
+        report.set("max_error_10_steps", check_error);
+        report.set("gpu_fits_60hz", gpu_ms <= 1000.0 / 60.0 ? "yes" : "no");
+        reportGLStats(report, steps);
+    }
+}
+
+/* PARTICLES */
+
+// Updates and draws 100k to 1M particles into a 750x750 target, timing both on the GPU with timer queries
+static void benchParticles(BenchmarkReport& report, const Settings&) {
+    static const int counts[] = {100000, 250000, 1000000};
+    static const int frames = 60;
+    // GPU time the particles may take per frame
+    static const double budget_ms = 2.0;
+
+    if (!GLAD_GL_VERSION_4_3) {
+        std::cout << "Compute shaders need OpenGL 4.3\n";
+        return;
+    }
+
+    // Render into an offscreen target the size of the window
+    OffscreenTarget target;
+
+    ParticleShader shader("Shaders/particle.vert", "Shaders/particle.frag");
+    // First person cameras start out facing +Z
+    FirstPersonCamera camera(glm::vec3(0.f, -20.f, -20.f), glm::vec3(0.f, -20.f, 0.f), 60.f, 0.1f, 100.f);
+    GLuint queries[2];
+    glGenQueries(2, queries);
+
+    for (int count : counts) {
+        // Marine snow filling the view, the heaviest use of particles in the scene
+        ParticleSettings particle_settings;
+        particle_settings.acceleration = glm::vec3(0.f, -0.2f, 0.f);
+        particle_settings.drag = 0.5f;
+        particle_settings.wobble = 0.1f;
+        particle_settings.surface_y = 1e30f;
+        particle_settings.wrap_size = glm::vec3(40.f);
+        particle_settings.min_life = particle_settings.max_life = 1e30f;
+        particle_settings.min_size = 0.04f, particle_settings.max_size = 0.1f;
+        particle_settings.color = glm::vec4(0.9f, 0.95f, 1.f, 0.35f);
+        ParticleSystem particles(count, particle_settings);
+        particles.emitBurst(count, glm::vec3(0.f, -20.f, 0.f), particle_settings.wrap_size * 0.5f, glm::vec3(0.f), 0.1f);
+
+        // Only the timed frames count towards the GL stats
+        GLStats::endFrame();
+        GLuint64 update_ns = 0, draw_ns = 0;
+        double frame_ms = 0;
+        for (int frame = 0; frame < frames; frame++) {
+            Stopwatch frame_time;
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+            glBeginQuery(GL_TIME_ELAPSED, queries[0]);
+            particles.update((float) SIM_STEP, glm::vec3(0.f, -20.f, 0.f));
+            glEndQuery(GL_TIME_ELAPSED);
+
+            glBeginQuery(GL_TIME_ELAPSED, queries[1]);
+            shader.render(particles, camera);
+            glEndQuery(GL_TIME_ELAPSED);
+
+            // Waits for the frame to finish, which is fine since only the GPU time is reported
+            GLuint64 elapsed;
+            glGetQueryObjectui64v(queries[0], GL_QUERY_RESULT, &elapsed);
+            update_ns += elapsed;
+            glGetQueryObjectui64v(queries[1], GL_QUERY_RESULT, &elapsed);
+            draw_ns += elapsed;
+            frame_ms += frame_time.getMilliseconds();
+        }
+
+        double update_ms = update_ns / 1e6 / frames;
+        double draw_ms = draw_ns / 1e6 / frames;
+        report.beginRow();
+        report.set("particles", count);
+        report.set("renderer", (const char*) glGetString(GL_RENDERER));
+        report.set("resolution", std::to_string(SCREEN_WT) + "x" + std::to_string(SCREEN_HT));
+        report.set("gpu_update_ms", update_ms);
+        report.set("gpu_draw_ms", draw_ms);
+        report.set("gpu_total_ms", update_ms + draw_ms);
+        // Software renderers can defer drawing past the end of its query, the wall time of the whole frame always counts it
+        report.set("frame_ms", frame_ms / frames);
+        report.set("within_2ms", update_ms + draw_ms <= budget_ms ? "yes" : "no");
+        reportGLStats(report, frames);
+    }
+
+    glDeleteQueries(2, queries);
+}
+
+/* STRESS SCENES */
+
+// Bundled meshes stress scenes are made of, with the texture each is drawn with
+static const char* stress_mesh_paths[] {"3D/crab.obj", "3D/lobster.obj", "3D/shark.obj", "3D/fish.obj", "3D/bomb.obj", "3D/player_submarine.obj"};
+static const char* stress_texture_paths[] {"3D/crab.jpg", "3D/lobster.jpg", "3D/shark.jpg", "3D/fish.jpg", "3D/bomb.png", "3D/player_submarine_decal.png"};
+static const int stress_mesh_count = 6;
+
+// Meshes, textures and shader loaded once and shared by every scene of the stress benchmark
+struct StressAssets {
+    std::vector<std::unique_ptr<VertexAttribs>> meshes;
+    std::vector<std::unique_ptr<Texture>> textures;
+    // Materials hold non-owning copies of the textures, and must not move once entities refer to them
+    std::vector<std::vector<Texture>> materials;
+    TexLightingShader shader;
+    LightClusters clusters;
+    // Only made by the benchmarks that light deferred
+    std::unique_ptr<DeferredRenderer> deferred;
+    // Only made by the benchmarks that cast shadows
+    std::unique_ptr<CascadedShadowMap> shadow_map;
+    std::unique_ptr<ShadowShader> shadow_shader;
+    std::unique_ptr<PointShadowAtlas> point_shadows;
+    std::unique_ptr<PointShadowShader> point_shadow_shader;
+    // Only made by the benchmarks that draw the depth before shading
+    std::unique_ptr<DepthPrepass> prepass;
+    // Only made by the benchmarks that cull occluded entities, with the shader that checks the ones culled against the depth drawn
+    std::unique_ptr<OcclusionCuller> occlusion;
+    std::unique_ptr<ShadowShader> occlusion_check_shader;
+    // Only made by the benchmarks that cull and draw the entities on the GPU
+    std::unique_ptr<GpuCuller> gpu_culler;
+    std::unique_ptr<CulledShader> culled_shader;
+    // Whether to count the fragments shaded and the pixels covered, which reads the depth back after every frame
+    bool count_overdraw;
+
+    StressAssets(): shader("Shaders/objshader.vert", "Shaders/objshader.frag"), count_overdraw(false) {
+        materials.reserve(stress_mesh_count);
+        for (int i = 0; i < stress_mesh_count; i++) {
+            meshes.emplace_back(new VertexAttribs(stress_mesh_paths[i]));
+            textures.emplace_back(new Texture(stress_texture_paths[i]));
+            materials.push_back(std::vector<Texture> {*textures.back()});
+        }
+    }
+};
+
+// Ways a stress scene can be lit
+enum RenderPath {
+    RENDER_FORWARD,     // Lit as it is drawn, every fragment looping over every light
+    RENDER_CLUSTERED,   // Lit as it is drawn, every fragment looping over the lights of its cluster
+    RENDER_DEFERRED     // Drawn into a G-buffer, then every pixel lit once with the lights of its cluster
+};
+static const char* render_path_names[] = {"forward", "clustered", "deferred"};
+
+// Generates a scene from some of the meshes and draws it along its camera path, adding a row of its timings
+static void runStressScene(BenchmarkReport& report, const char* sweep, const StressSceneSettings& scene_settings,
+    const std::vector<int>& mesh_indices, StressAssets& assets, ThreadPool& pool, GLuint query, RenderPath path = RENDER_CLUSTERED) {
+    static const int frames = 60;
+
+    EntityStore entities;
+    std::vector<StressMesh> meshes;
+    for (int index : mesh_indices)
+        meshes.push_back({entities.addMesh(*assets.meshes[index]), entities.addMaterial(assets.materials[index])});
+    StressScene scene(scene_settings);
+    scene.generate(entities, meshes);
+    entities.updateTransforms(pool);
+    if (assets.gpu_culler)
+        assets.gpu_culler->upload(entities);
+    GLint depth_texture = 0;
+    glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME, &depth_texture);
+
+    // Lit like the real scene, by a light from the surface and a point light in the middle
+    PerspectiveCamera camera(glm::vec3(0.f), glm::vec3(0.f, 0.f, 1.f), 60.f, 0.1f, scene.getViewDistance());
+    PointLight center_light(1.f, scene_settings.center, glm::vec3(1.f), 0.1f, 0.3f, 80.f);
+    DirectionLight dlight(glm::vec3(0.f, 10.f, 0.f), glm::vec3(1.f), 0.4f, glm::vec3(1.f), 0.7f, 40.f, 0.25f);
+    // There is no skybox, so the sky lights every side with the light's ambient color
+    SkyLighting sky;
+    sky.setFlat(dlight.ambient_color);
+    assets.shader.setSkyLighting(sky);
+    if (assets.culled_shader)
+        assets.culled_shader->setSkyLighting(sky);
+    if (assets.deferred)
+        assets.deferred->lighting_shader.setSkyLighting(sky);
+
+    std::vector<uint32_t> visible;
+    std::vector<DrawPacket> packets;
+    std::vector<PointLight*> shadow_lights;
+    double cull_ms = 0, cluster_ms = 0, shadow_ms = 0, point_shadow_ms = 0, submit_ms = 0, frame_ms = 0;
+    uint64_t point_shadows_drawn = 0, point_shadows_cached = 0;
+    uint64_t shaded_fragments = 0, covered_pixels = 0;
+    std::vector<uint32_t> frustum_visible;
+    std::vector<DrawPacket> check_packet(1);
+    uint64_t occluders = 0, occluder_triangles = 0, occluded = 0, false_culls = 0;
+    double occlusion_raster_ms = 0, occlusion_test_ms = 0;
+    uint64_t gpu_outside = 0, gpu_first_drawn = 0, gpu_occluded = 0, gpu_disoccluded = 0;
+    std::vector<float> depths;
+    GLuint samples_query;
+    glGenQueries(1, &samples_query);
+    uint64_t shadow_draws[SHADOW_CASCADES] = {};
+    double shadow_gpu_ms[SHADOW_CASCADES] = {};
+    GLuint64 gpu_ns = 0;
+    uint64_t visible_total = 0, triangles_drawn = 0, lights_in_view = 0, light_indices = 0;
+
+    // Only the timed frames count towards the GL stats
+    GLStats::endFrame();
+    for (int frame = 0; frame < frames; frame++) {
+        // The frames are spread over one whole trip around the path
+        scene.placeCamera(camera, scene_settings.path_period * frame / frames);
+
+        Stopwatch frame_time;
+        Stopwatch stage_time;
+        entities.updateTransforms(pool);
+        if (!assets.gpu_culler)
+            entities.cull(camera.getFrustum(), visible);
+        if (assets.occlusion) {
+            if (assets.occlusion_check_shader)
+                frustum_visible = visible;
+            assets.occlusion->begin(camera);
+            assets.occlusion->cull(entities, visible, pool);
+            occluders += assets.occlusion->getOccluderCount();
+            occluder_triangles += assets.occlusion->getTriangleCount();
+            occluded += assets.occlusion->getCulledCount();
+            occlusion_raster_ms += assets.occlusion->getRasterMilliseconds();
+            occlusion_test_ms += assets.occlusion->getTestMilliseconds();
+        }
+        if (!assets.gpu_culler)
+            entities.buildDrawPackets(visible, packets);
+        cull_ms += stage_time.getMilliseconds();
+
+        // Lights get their shadow slots before they are binned, since the clusters carry the slots to the shaders
+        if (assets.point_shadows) {
+            stage_time.restart();
+            scene.placeLights(scene_settings.path_period * frame / frames);
+            shadow_lights.clear();
+            for (PointLight& light : scene.lights)
+                shadow_lights.push_back(&light);
+            assets.point_shadows->update(shadow_lights, camera.camera_pos, entities, *assets.point_shadow_shader);
+            assets.point_shadows->bind();
+            point_shadow_ms += stage_time.getMilliseconds();
+            point_shadows_drawn += assets.point_shadows->getDrawnCount();
+            point_shadows_cached += assets.point_shadows->getCachedCount();
+        }
+
+        stage_time.restart();
+        assets.clusters.cull_lights = path != RENDER_FORWARD;
+        assets.clusters.update(scene.lights, camera);
+        assets.clusters.bind();
+        if (path == RENDER_DEFERRED)
+            assets.deferred->lighting_shader.setLightClusters(assets.clusters);
+        else
+            assets.shader.setLightClusters(assets.clusters);
+        if (assets.culled_shader)
+            assets.culled_shader->setLightClusters(assets.clusters);
+        cluster_ms += stage_time.getMilliseconds();
+
+        if (assets.shadow_map) {
+            stage_time.restart();
+            CascadedShadowMap& shadow_map = *assets.shadow_map;
+            shadow_map.update(dlight, camera);
+            shadow_map.render(entities, *assets.shadow_shader);
+            shadow_map.bind();
+            assets.shader.setShadowMap(shadow_map);
+            if (assets.culled_shader)
+                assets.culled_shader->setShadowMap(shadow_map);
+            if (assets.deferred)
+                assets.deferred->lighting_shader.setShadowMap(shadow_map);
+            shadow_ms += stage_time.getMilliseconds();
+
+            // GPU times come back two frames late, so the first two frames have none
+            for (int cascade = 0; cascade < SHADOW_CASCADES; cascade++) {
+                shadow_draws[cascade] += shadow_map.getDrawCount(cascade);
+                if (frame >= 2)
+                    shadow_gpu_ms[cascade] += shadow_map.getGpuMilliseconds(cascade);
+            }
+        }
+
+        stage_time.restart();
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        glBeginQuery(GL_TIME_ELAPSED, query);
+        if (path == RENDER_DEFERRED)
+            assets.deferred->gbuffer.beginGeometry();
+        if (assets.prepass) {
+            glm::mat4 view = camera.getViewMatrix();
+            glm::mat4 projection = camera.getProjectionMatrix();
+            assets.prepass->beginDepth();
+            assets.prepass->shader.render(entities, packets, view, projection);
+            assets.prepass->beginShading();
+        }
+        if (assets.count_overdraw)
+            glBeginQuery(GL_SAMPLES_PASSED, samples_query);
+        if (path == RENDER_DEFERRED)
+            assets.deferred->geometry_shader.render(entities, packets, camera, center_light, dlight);
+        else if (assets.gpu_culler) {
+            // The counters come back a few frames late, the first frames have none
+            GpuCuller& culler = *assets.gpu_culler;
+            culler.cull(0, camera);
+            assets.culled_shader->render(entities, culler, 0, camera, center_light, dlight);
+            culler.buildPyramid((GLuint) depth_texture, SCREEN_WT, SCREEN_HT);
+            culler.cull(1, camera);
+            assets.culled_shader->render(entities, culler, 1, camera, center_light, dlight);
+            const GpuCullCounters& counters = culler.getCounters();
+            gpu_outside += counters.frustum_culled;
+            gpu_first_drawn += counters.first_drawn;
+            gpu_occluded += counters.first_occluded - counters.second_drawn;
+            gpu_disoccluded += counters.second_drawn;
+        }
+        else
+            assets.shader.render(entities, packets, camera, center_light, dlight);
+        if (assets.count_overdraw)
+            glEndQuery(GL_SAMPLES_PASSED);
+        if (assets.prepass)
+            assets.prepass->endShading();
+        if (path == RENDER_DEFERRED) {
+            assets.deferred->gbuffer.endGeometry();
+            assets.deferred->lighting_shader.render(assets.deferred->gbuffer, camera, center_light, dlight);
+        }
+        glEndQuery(GL_TIME_ELAPSED);
+        submit_ms += stage_time.getMilliseconds();
+
+        // Waits for the frame to finish, so the wall time covers the GPU's work too
+        GLuint64 elapsed;
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+        gpu_ns += elapsed;
+        frame_ms += frame_time.getMilliseconds();
+
+        // Every fragment that passed the depth test was shaded, and every pixel with a depth in front of the far plane is covered
+        if (assets.count_overdraw) {
+            GLuint64 samples;
+            glGetQueryObjectui64v(samples_query, GL_QUERY_RESULT, &samples);
+            shaded_fragments += samples;
+            depths.resize(SCREEN_WT * SCREEN_HT);
+            glReadPixels(0, 0, SCREEN_WT, SCREEN_HT, GL_DEPTH_COMPONENT, GL_FLOAT, depths.data());
+            for (float depth : depths)
+                covered_pixels += depth < 1.f;
+        }
+
+        // Every entity the culler hid is drawn against the depth of the frame, it was wrongly culled if any of its pixels are in front
+        if (assets.occlusion && assets.occlusion_check_shader) {
+            glm::mat4 view = camera.getViewMatrix();
+            glm::mat4 projection = camera.getProjectionMatrix();
+            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            glDepthMask(GL_FALSE);
+            for (uint32_t entity : frustum_visible) {
+                if (entities.flags[entity] & ENTITY_VISIBLE)
+                    continue;
+                check_packet[0].entity = entity;
+                glBeginQuery(GL_SAMPLES_PASSED, samples_query);
+                assets.occlusion_check_shader->render(entities, check_packet, view, projection);
+                glEndQuery(GL_SAMPLES_PASSED);
+                GLuint64 samples;
+                glGetQueryObjectui64v(samples_query, GL_QUERY_RESULT, &samples);
+                false_culls += samples > 0;
+            }
+            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            glDepthMask(GL_TRUE);
+        }
+
+        visible_total += visible.size();
+        lights_in_view += assets.clusters.getLightCount();
+        light_indices += assets.clusters.getIndexCount();
+        for (uint32_t entity : visible)
+            triangles_drawn += entities.meshes[entities.mesh_ids[entity]]->count / 3;
+    }
+
+    report.beginRow();
+    report.set("sweep", sweep);
+    report.set("path", render_path_names[path]);
+    report.set("depth_prepass", assets.prepass ? "on" : "off");
+    report.set("culling", assets.gpu_culler ? "gpu" : "cpu");
+    report.set("seed", scene_settings.seed);
+    report.set("camera_path", StressScene::getCameraPathName(scene_settings.camera_path));
+    report.set("mesh", mesh_indices.size() == 1 ? stress_mesh_paths[mesh_indices[0]] : "all");
+    report.set("copies_per_mesh", scene_settings.copies_per_mesh);
+    report.set("entities", scene.entity_count);
+    report.set("lights", (double) scene.lights.size());
+    report.set("lights_in_view", (double) lights_in_view / frames);
+    report.set("lights_per_cluster", (double) light_indices / frames / CLUSTER_COUNT);
+    report.set("scene_triangles", (double) scene.triangle_count);
+    report.set("visible_entities", (double) visible_total / frames);
+    report.set("drawn_triangles", (double) triangles_drawn / frames);
+    report.set("cull_ms", cull_ms / frames);
+    report.set("cluster_ms", cluster_ms / frames);
+    if (assets.shadow_map) {
+        report.set("shadow_ms", shadow_ms / frames);
+        for (int cascade = 0; cascade < SHADOW_CASCADES; cascade++) {
+            std::string index = std::to_string(cascade);
+            report.set("cascade" + index + "_draws", (double) shadow_draws[cascade] / frames);
+            report.set("cascade" + index + "_gpu_ms", shadow_gpu_ms[cascade] / (frames - 2));
+        }
+    }
+    if (assets.point_shadows) {
+        report.set("shadowed_lights", scene_settings.shadowed_lights);
+        report.set("point_shadow_ms", point_shadow_ms / frames);
+        report.set("point_shadows_drawn", (double) point_shadows_drawn / frames);
+        report.set("point_shadows_cached", (double) point_shadows_cached / frames);
+    }
+    if (assets.count_overdraw) {
+        report.set("shaded_fragments", (double) shaded_fragments / frames);
+        report.set("covered_pixels", (double) covered_pixels / frames);
+        report.set("overdraw", covered_pixels ? (double) shaded_fragments / covered_pixels : 0.0);
+    }
+    if (assets.occlusion) {
+        report.set("occluders", (double) occluders / frames);
+        report.set("occluder_triangles", (double) occluder_triangles / frames);
+        report.set("occluded_entities", (double) occluded / frames);
+        report.set("occlusion_raster_ms", occlusion_raster_ms / frames);
+        report.set("occlusion_test_ms", occlusion_test_ms / frames);
+        if (assets.occlusion_check_shader)
+            report.set("false_culls", (double) false_culls / frames);
+    }
+    if (assets.gpu_culler) {
+        report.set("gpu_outside", (double) gpu_outside / frames);
+        report.set("gpu_first_drawn", (double) gpu_first_drawn / frames);
+        report.set("gpu_occluded", (double) gpu_occluded / frames);
+        report.set("gpu_disoccluded", (double) gpu_disoccluded / frames);
+    }
+    report.set("submit_ms", submit_ms / frames);
+    report.set("gpu_ms", gpu_ns / 1e6 / frames);
+    report.set("frame_ms", frame_ms / frames);
+    reportGLStats(report, frames);
+    glDeleteQueries(1, &samples_query);
+}
+
+// Draws generated scenes of a growing number of entities, lights and triangles at 750x750 to see where each stops scaling
+static void benchStress(BenchmarkReport& report, const Settings& settings) {
+    StressSceneSettings scene_settings;
+    scene_settings.seed = settings.scene_seed;
+    if (!StressScene::parseCameraPath(settings.camera_path, scene_settings.camera_path))
+        std::cout << "Unknown camera path " << settings.camera_path << ", using orbit\n";
+    int max_copies = settings.stress_copies;
+    int max_lights = settings.stress_lights;
+
+    OffscreenTarget target;
+    StressAssets assets;
+    ThreadPool pool;
+    GLuint query;
+    glGenQueries(1, &query);
+
+    std::vector<int> all_meshes;
+    for (int i = 0; i < stress_mesh_count; i++)
+        all_meshes.push_back(i);
+
+    // Entities double with a few lights
+    scene_settings.light_count = std::min(8, max_lights);
+    for (int copies = 1; copies <= max_copies; copies *= 2) {
+        scene_settings.copies_per_mesh = copies;
+        runStressScene(report, "entities", scene_settings, all_meshes, assets, pool, query);
+    }
+
+    // Lights double in a scene of fixed size
+    scene_settings.copies_per_mesh = std::min(16, max_copies);
+    for (int lights = 0; lights <= max_lights; lights = lights ? lights * 2 : 1) {
+        scene_settings.light_count = lights;
+        runStressScene(report, "lights", scene_settings, all_meshes, assets, pool, query);
+    }
+
+    // The same number of entities made of one mesh at a time, so only the triangles change
+    scene_settings.copies_per_mesh = std::min(64, max_copies);
+    scene_settings.light_count = std::min(8, max_lights);
+    for (int i = 0; i < stress_mesh_count; i++)
+        runStressScene(report, "triangles", scene_settings, std::vector<int> {i}, assets, pool, query);
+
+    glDeleteQueries(1, &query);
+}
+
+// Lights the same scene forward, clustered forward and deferred as its lights double, to see where each path pays off
+static void benchDeferred(BenchmarkReport& report, const Settings& settings) {
+    static const RenderPath paths[] = {RENDER_FORWARD, RENDER_CLUSTERED, RENDER_DEFERRED};
+
+    StressSceneSettings scene_settings;
+    scene_settings.seed = settings.scene_seed;
+    if (!StressScene::parseCameraPath(settings.camera_path, scene_settings.camera_path))
+        std::cout << "Unknown camera path " << settings.camera_path << ", using orbit\n";
+    scene_settings.copies_per_mesh = std::min(16, settings.stress_copies);
+
+    OffscreenTarget target;
+    StressAssets assets;
+    assets.deferred.reset(new DeferredRenderer());
+    ThreadPool pool;
+    GLuint query;
+    glGenQueries(1, &query);
+
+    std::vector<int> all_meshes;
+    for (int i = 0; i < stress_mesh_count; i++)
+        all_meshes.push_back(i);
+
+    for (int lights = 1; lights <= settings.stress_lights; lights *= 4) {
+        scene_settings.light_count = lights;
+        for (RenderPath path : paths)
+            runStressScene(report, "lights", scene_settings, all_meshes, assets, pool, query, path);
+    }
+
+    glDeleteQueries(1, &query);
+}
+
+// Casts the sun's shadows over generated scenes of a growing number of entities, to see how the cost of each cascade follows them
+static void benchShadows(BenchmarkReport& report, const Settings& settings) {
+    StressSceneSettings scene_settings;
+    scene_settings.seed = settings.scene_seed;
+    if (!StressScene::parseCameraPath(settings.camera_path, scene_settings.camera_path))
+        std::cout << "Unknown camera path " << settings.camera_path << ", using orbit\n";
+    scene_settings.light_count = std::min(8, settings.stress_lights);
+
+    OffscreenTarget target;
+    StressAssets assets;
+    assets.shadow_map.reset(new CascadedShadowMap());
+    assets.shadow_shader.reset(new ShadowShader("Shaders/shadow.vert", "Shaders/shadow.frag"));
+    ThreadPool pool;
+    GLuint query;
+    glGenQueries(1, &query);
+
+    std::vector<int> all_meshes;
+    for (int i = 0; i < stress_mesh_count; i++)
+        all_meshes.push_back(i);
+
+    for (int copies = 1; copies <= settings.stress_copies; copies *= 2) {
+        scene_settings.copies_per_mesh = copies;
+        runStressScene(report, "entities", scene_settings, all_meshes, assets, pool, query);
+    }
+
+    // Then point lights casting shadows among 16 copies of every mesh, first standing still so their maps are drawn once and reused,
+    // then swaying so every map is drawn again every frame, with more lights than the atlas has slots for at the end
+    assets.point_shadows.reset(new PointShadowAtlas());
+    assets.point_shadow_shader.reset(new PointShadowShader("Shaders/point_shadow.vert", "Shaders/shadow.frag", "Shaders/point_shadow.geom"));
+    scene_settings.copies_per_mesh = 16;
+    scene_settings.light_count = 2 * assets.point_shadows->getSlotCount();
+    for (int moving = 0; moving < 2; moving++) {
+        scene_settings.light_sway = moving ? 2.f : 0.f;
+        for (int shadowed = 1; shadowed <= scene_settings.light_count; shadowed *= 2) {
+            scene_settings.shadowed_lights = shadowed;
+            runStressScene(report, moving ? "moving_point_lights" : "still_point_lights", scene_settings, all_meshes, assets, pool, query);
+        }
+    }
+
+    glDeleteQueries(1, &query);
+}
+
+// Draws generated scenes of a growing number of entities with and without a depth pre-pass, counting how many times each covered pixel is shaded
+static void benchPrepass(BenchmarkReport& report, const Settings& settings) {
+    StressSceneSettings scene_settings;
+    scene_settings.seed = settings.scene_seed;
+    if (!StressScene::parseCameraPath(settings.camera_path, scene_settings.camera_path))
+        std::cout << "Unknown camera path " << settings.camera_path << ", using orbit\n";
+    scene_settings.light_count = std::min(64, settings.stress_lights);
+
+    OffscreenTarget target;
+    StressAssets assets;
+    assets.count_overdraw = true;
+    // Handed to the assets for the runs with the pre-pass only
+    std::unique_ptr<DepthPrepass> prepass(new DepthPrepass());
+    ThreadPool pool;
+    GLuint query;
+    glGenQueries(1, &query);
+
+    std::vector<int> all_meshes;
+    for (int i = 0; i < stress_mesh_count; i++)
+        all_meshes.push_back(i);
+
+    for (int copies = 1; copies <= settings.stress_copies; copies *= 4) {
+        scene_settings.copies_per_mesh = copies;
+        runStressScene(report, "entities", scene_settings, all_meshes, assets, pool, query);
+        assets.prepass = std::move(prepass);
+        runStressScene(report, "entities", scene_settings, all_meshes, assets, pool, query);
+        prepass = std::move(assets.prepass);
+    }
+
+    glDeleteQueries(1, &query);
+}
+
+// Draws generated scenes of a growing number of entities with and without culling the ones hidden behind others on the CPU,
+// then draws every entity culled against the depth of the frame to count the ones that were visible after all
+static void benchOcclusion(BenchmarkReport& report, const Settings& settings) {
+    StressSceneSettings scene_settings;
+    scene_settings.seed = settings.scene_seed;
+    if (!StressScene::parseCameraPath(settings.camera_path, scene_settings.camera_path))
+        std::cout << "Unknown camera path " << settings.camera_path << ", using orbit\n";
+    scene_settings.light_count = std::min(8, settings.stress_lights);
+
+    OffscreenTarget target;
+    StressAssets assets;
+    assets.occlusion_check_shader.reset(new ShadowShader("Shaders/shadow.vert", "Shaders/shadow.frag"));
+    // Handed to the assets for the runs with occlusion culling only
+    std::unique_ptr<OcclusionCuller> occlusion(new OcclusionCuller());
+    ThreadPool pool;
+    GLuint query;
+    glGenQueries(1, &query);
+
+    std::vector<int> all_meshes;
+    for (int i = 0; i < stress_mesh_count; i++)
+        all_meshes.push_back(i);
+
+    for (int copies = 1; copies <= settings.stress_copies; copies *= 4) {
+        scene_settings.copies_per_mesh = copies;
+        runStressScene(report, "entities", scene_settings, all_meshes, assets, pool, query);
+        assets.occlusion = std::move(occlusion);
+        runStressScene(report, "entities", scene_settings, all_meshes, assets, pool, query);
+        occlusion = std::move(assets.occlusion);
+    }
+
+    glDeleteQueries(1, &query);
+}
+
+// Draws generated scenes of a growing number of entities culled on the CPU and drawn one by one, then culled on the GPU and drawn
+// with indirect draws, to see the CPU time of the frame stay flat as the entities grow
+static void benchGpuCulling(BenchmarkReport& report, const Settings& settings) {
+    if (!GLAD_GL_VERSION_4_3) {
+        std::cout << "Culling on the GPU needs OpenGL 4.3\n";
+        return;
+    }
+    StressSceneSettings scene_settings;
+    scene_settings.seed = settings.scene_seed;
+    if (!StressScene::parseCameraPath(settings.camera_path, scene_settings.camera_path))
+        std::cout << "Unknown camera path " << settings.camera_path << ", using orbit\n";
+    scene_settings.light_count = std::min(8, settings.stress_lights);
+
+    OffscreenTarget target;
+    StressAssets assets;
+    // Handed to the assets for the runs culled on the GPU only
+    std::unique_ptr<GpuCuller> gpu_culler(new GpuCuller());
+    assets.culled_shader.reset(new CulledShader("Shaders/culled.vert", "Shaders/objshader.frag"));
+    ThreadPool pool;
+    GLuint query;
+    glGenQueries(1, &query);
+
+    std::vector<int> all_meshes;
+    for (int i = 0; i < stress_mesh_count; i++)
+        all_meshes.push_back(i);
+
+    for (int copies = 1; copies <= settings.stress_copies; copies *= 4) {
+        scene_settings.copies_per_mesh = copies;
+        runStressScene(report, "entities", scene_settings, all_meshes, assets, pool, query);
+        assets.gpu_culler = std::move(gpu_culler);
+        runStressScene(report, "entities", scene_settings, all_meshes, assets, pool, query);
+        gpu_culler = std::move(assets.gpu_culler);
+    }
+
+    glDeleteQueries(1, &query);
+}
+
+// Every benchmark that can be run with --bench
+static const Benchmark benchmarks[] = {
+    {"aabb_tree", "Dynamic AABB tree refit and queries over 10k to 100k moving boxes", benchAABBTree, false},
+    {"collision", "Uniform grid collision detection over 1k to 10k moving spheres, capsules and boxes", benchCollision, false},
+    {"boids", "Flocking of 5k to 50k fish, four at a time with SIMD and one at a time", benchBoids, false},
+    {"boids_gpu", "Compute shader flocking checked against the CPU, then timed against it at 10k to 1M fish", benchBoidsGpu, true},
+    {"particles", "GPU time to update and draw 100k to 1M particles at 750x750", benchParticles, true},
+    {"stress", "Generated scenes of growing entity, light and triangle counts drawn at 750x750", benchStress, true},
+    {"deferred", "Forward, clustered forward and deferred lighting of one scene at 1 to 1024 lights", benchDeferred, true},
+    {"shadows", "Cascaded shadows of generated scenes of a growing entity count, then point light shadows, still and moving", benchShadows, true},
+    {"prepass", "Overdraw and time of generated scenes of a growing entity count with and without a depth pre-pass", benchPrepass, true},
+    {"occlusion", "Culled entities, cost and false culls of CPU occlusion culling over generated scenes of a growing entity count", benchOcclusion, true},
+    {"gpu_culling", "CPU and GPU time of generated scenes of a growing entity count culled on the CPU, then on the GPU with indirect draws", benchGpuCulling, true},
+};
+
+// Runs the benchmark named in the settings and prints or saves its report, returns false if there is no such benchmark
+bool runBenchmark(const Settings& settings) {
+    for (const Benchmark& benchmark : benchmarks) {
+        if (settings.bench_name != benchmark.name)
+            continue;
+
+        // GPU benchmarks render into a window that is never shown
+        GLFWwindow* window = NULL;
+        if (benchmark.needs_gl) {
+            if (!glfwInit())
+                return false;
+            glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+            window = glfwCreateWindow(64, 64, benchmark.name, NULL, NULL);
+            if (!window) {
+                std::cout << "Could not create an OpenGL context for " << benchmark.name << '\n';
+                glfwTerminate();
+                return false;
+            }
+            glfwMakeContextCurrent(window);
+            gladLoadGL();
+            GLStats::install();
+            // The benchmarks time the GPU with queries of their own, which the profiler's would nest inside
+            PROFILE_GPU_TIMING(false);
+        }
+
+        std::cout << "Running " << benchmark.name << ": " << benchmark.description << '\n';
+        BenchmarkReport report;
+        benchmark.run(report, settings);
+
+        if (window) {
+            glfwDestroyWindow(window);
+            glfwTerminate();
+        }
+
+        report.write(std::cout);
+        if (!settings.bench_out.empty()) {
+            std::ofstream out(settings.bench_out, std::ios::trunc);
+            report.write(out);
+        }
+        return true;
+    }
+
+    std::cout << "Unknown benchmark " << settings.bench_name << ", available benchmarks are:\n";
+    for (const Benchmark& benchmark : benchmarks)
+        std::cout << "  " << benchmark.name << ": " << benchmark.description << '\n';
+    return false;
+}
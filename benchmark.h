@@ -0,0 +1,37 @@
+#pragma once
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "settings.h"
+
+// Rows of named results from a benchmark, written out as CSV with a column for every name used
+class BenchmarkReport {
+public:
+    std::vector<std::string> columns;
+    std::vector<std::map<std::string, std::string>> rows;
+
+    // Starts a new row of results
+    void beginRow();
+
+    // Sets a column of the current row
+    void set(const std::string& column, double value);
+    void set(const std::string& column, const std::string& value);
+
+    // Writes the header and every row as CSV
+    void write(std::ostream& out);
+};
+
+// A benchmark that can be selected by name from the command line
+struct Benchmark {
+    const char* name;
+    const char* description;
+    void (*run)(BenchmarkReport& report, const Settings& settings);
+    // Whether the benchmark needs an OpenGL context, which is made in a hidden window before it runs
+    bool needs_gl;
+};
+
+// Runs the benchmark named in the settings and prints or saves its report, returns false if there is no such benchmark
+bool runBenchmark(const Settings& settings);
@@ -0,0 +1,441 @@
+#include "boids.h"
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+
+#include <glm/gtc/constants.hpp>
+
+#include "profiler.h"
+
+// SSE2 is part of every x64 processor, other targets fall back to updating one fish at a time
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BOIDS_SSE2 1
+#include <emmintrin.h>
+#else
+#define BOIDS_SSE2 0
+#endif
+
+// Number of fish below which a pass over the school is not split between threads
+static const size_t parallel_grain = 1024;
+
+// Sums over the neighbours of one fish
+struct NeighborSums {
+    float count;
+    glm::vec3 position;
+    glm::vec3 velocity;
+    glm::vec3 separation;
+
+    NeighborSums(): count(0.f), position(0.f), velocity(0.f), separation(0.f) {}
+};
+
+// Position and velocity arrays of the sorted fish, in the order x, y, z, vx, vy, vz
+typedef const float* FishArrays[6];
+
+// Adds the fish within radius of a point to the sums, out of the ranges given as pairs of begin and end indices
+static void sumNeighbors(const FishArrays& fish, const uint32_t* ranges, int range_count, glm::vec3 point,
+    float radius2, float separation_radius2, NeighborSums& sums) {
+    const float *x = fish[0], *y = fish[1], *z = fish[2];
+    for (int r = 0; r < range_count; r++) {
+        for (size_t j = ranges[r * 2], end = ranges[r * 2 + 1]; j < end; j++) {
+            float dx = x[j] - point.x, dy = y[j] - point.y, dz = z[j] - point.z;
+            float distance2 = dx * dx + dy * dy + dz * dz;
+            // The fish itself is at distance 0
+            if (distance2 >= radius2 || distance2 <= 0.f)
+                continue;
+
+            sums.count += 1.f;
+            sums.position += glm::vec3(x[j], y[j], z[j]);
+            sums.velocity += glm::vec3(fish[3][j], fish[4][j], fish[5][j]);
+            // Push away harder from closer fish
+            if (distance2 < separation_radius2)
+                sums.separation -= glm::vec3(dx, dy, dz) * (1.f / distance2);
+        }
+    }
+}
+
+// Scatters count fish with random headings through the region of the settings
+FishSchool::FishSchool(size_t count, const BoidSettings& settings, uint32_t seed):
+    settings(settings), vectorized(true), bucket_mask(0), neighbor_total(0) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+    glm::vec3 size = settings.region_max - settings.region_min;
+
+    pos_x.resize(count), pos_y.resize(count), pos_z.resize(count);
+    vel_x.resize(count), vel_y.resize(count), vel_z.resize(count);
+    ids.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        ids[i] = (uint32_t) i;
+        pos_x[i] = settings.region_min.x + unit(rng) * size.x;
+        pos_y[i] = settings.region_min.y + unit(rng) * size.y;
+        pos_z[i] = settings.region_min.z + unit(rng) * size.z;
+
+        // Mostly level headings, like a school swimming along
+        float heading = unit(rng) * glm::two_pi<float>();
+        float speed = glm::mix(settings.min_speed, settings.max_speed, unit(rng));
+        vel_x[i] = std::cos(heading) * speed;
+        vel_y[i] = (unit(rng) - 0.5f) * speed * 0.2f;
+        vel_z[i] = std::sin(heading) * speed;
+    }
+
+    // Fish share cells, so as many buckets as fish keeps most buckets holding a single cell
+    uint32_t bucket_count = 16;
+    while (bucket_count < count)
+        bucket_count *= 2;
+    bucket_mask = bucket_count - 1;
+    bucket_starts.resize(bucket_count + 1);
+}
+
+// Sorts the fish into the buckets of the spatial hash
+void FishSchool::buildHash(ThreadPool& pool) {
+    size_t count = size();
+    buckets.resize(count);
+    order.resize(count);
+    sorted_pos_x.resize(count), sorted_pos_y.resize(count), sorted_pos_z.resize(count);
+    sorted_vel_x.resize(count), sorted_vel_y.resize(count), sorted_vel_z.resize(count);
+    sorted_ids.resize(count);
+
+    pool.parallelFor(count, parallel_grain, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+            buckets[i] = getBucket(getCell(pos_x[i]), getCell(pos_y[i]), getCell(pos_z[i]));
+    });
+
+    // Counting sort by bucket, the arrays come out of the last step nearly sorted already
+    std::fill(bucket_starts.begin(), bucket_starts.end(), 0);
+    for (size_t i = 0; i < count; i++)
+        bucket_starts[buckets[i] + 1]++;
+    for (size_t b = 1; b < bucket_starts.size(); b++)
+        bucket_starts[b] += bucket_starts[b - 1];
+    std::vector<uint32_t> next(bucket_starts.begin(), bucket_starts.end() - 1);
+    for (size_t i = 0; i < count; i++)
+        order[next[buckets[i]]++] = (uint32_t) i;
+
+    pool.parallelFor(count, parallel_grain, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            uint32_t fish = order[i];
+            sorted_pos_x[i] = pos_x[fish];
+            sorted_pos_y[i] = pos_y[fish];
+            sorted_pos_z[i] = pos_z[fish];
+            sorted_vel_x[i] = vel_x[fish];
+            sorted_vel_y[i] = vel_y[fish];
+            sorted_vel_z[i] = vel_z[fish];
+            sorted_ids[i] = ids[fish];
+        }
+    });
+}
+
+// Gets the ranges of sorted fish in the buckets of the cells from low to high, as pairs of begin and end indices
+int FishSchool::getBlockRanges(glm::ivec3 low, glm::ivec3 high, uint32_t* ranges) {
+    // Several cells can hash to the same bucket, so each bucket is added once. The bits of seen filter out most buckets
+    // not added yet before looking through the ones that were
+    uint32_t nearby[27];
+    uint64_t seen = 0;
+    int range_count = 0;
+    for (int x = low.x; x <= high.x; x++) {
+        for (int y = low.y; y <= high.y; y++) {
+            for (int z = low.z; z <= high.z; z++) {
+                uint32_t bucket = getBucket(x, y, z);
+                uint32_t begin = bucket_starts[bucket], end = bucket_starts[bucket + 1];
+                if (begin == end)
+                    continue;
+                uint64_t bit = 1ull << (bucket & 63);
+                if ((seen & bit) && std::find(nearby, nearby + range_count, bucket) != nearby + range_count)
+                    continue;
+                seen |= bit;
+                nearby[range_count] = bucket;
+                ranges[range_count * 2] = begin;
+                ranges[range_count * 2 + 1] = end;
+                range_count++;
+            }
+        }
+    }
+    return range_count;
+}
+
+// Applies the flocking rules to one of the sorted fish, returns the number of neighbours it has
+long long FishSchool::updateFish(size_t i, float dt, glm::vec3 avoid_pos) {
+    const BoidSettings& s = settings;
+    FishArrays fish = {sorted_pos_x.data(), sorted_pos_y.data(), sorted_pos_z.data(),
+        sorted_vel_x.data(), sorted_vel_y.data(), sorted_vel_z.data()};
+    glm::vec3 pos(sorted_pos_x[i], sorted_pos_y[i], sorted_pos_z[i]);
+    glm::vec3 vel(sorted_vel_x[i], sorted_vel_y[i], sorted_vel_z[i]);
+
+    // Cells are twice as wide as the neighbour radius, so the neighbours are all in the two cells along each axis
+    // that the radius around the fish reaches into
+    glm::ivec3 low = getLowCell(pos);
+    uint32_t ranges[16];
+    int range_count = getBlockRanges(low, low + 1, ranges);
+
+    NeighborSums sums;
+    sumNeighbors(fish, ranges, range_count, pos, s.neighbor_radius * s.neighbor_radius,
+        s.separation_radius * s.separation_radius, sums);
+
+    // Separation, alignment and cohesion
+    glm::vec3 steer = sums.separation * s.separation_weight;
+    if (sums.count > 0.f) {
+        steer += (sums.velocity / sums.count - vel) * s.alignment_weight;
+        steer += (sums.position / sums.count - pos) * s.cohesion_weight;
+    }
+
+    // Flee the player, harder the closer it is
+    glm::vec3 from_player = pos - avoid_pos;
+    float player_distance = glm::length(from_player);
+    if (player_distance < s.avoid_radius && player_distance > 0.f)
+        steer += from_player / player_distance * (1.f - player_distance / s.avoid_radius) * s.avoid_weight;
+
+    // Rise away from the seafloor
+    float height = pos.y - s.floor_y;
+    if (height < s.floor_margin)
+        steer.y += (1.f - std::max(height, 0.f) / s.floor_margin) * s.floor_weight;
+
+    // Turn back towards the region when outside of it
+    steer += (glm::clamp(pos, s.region_min, s.region_max) - pos) * s.region_weight;
+
+    float steer_length = glm::length(steer);
+    if (steer_length > s.max_acceleration)
+        steer *= s.max_acceleration / steer_length;
+    vel += steer * dt;
+
+    float speed = glm::length(vel);
+    if (speed > s.max_speed)
+        vel *= s.max_speed / speed;
+    else if (speed < s.min_speed)
+        vel = speed > 0.f ? vel * (s.min_speed / speed) : glm::vec3(s.min_speed, 0.f, 0.f);
+    pos += vel * dt;
+
+    // Fish never go through the seafloor, whatever the rules say
+    if (pos.y < s.floor_y) {
+        pos.y = s.floor_y;
+        vel.y = std::abs(vel.y);
+    }
+
+    pos_x[i] = pos.x, pos_y[i] = pos.y, pos_z[i] = pos.z;
+    vel_x[i] = vel.x, vel_y[i] = vel.y, vel_z[i] = vel.z;
+    return (long long) sums.count;
+}
+
+// Applies the flocking rules to a range of the sorted fish, returns the number of neighbours found
+long long FishSchool::updateRange(size_t begin, size_t end, float dt, glm::vec3 avoid_pos) {
+    long long neighbors = 0;
+    size_t i = begin;
+#if BOIDS_SSE2
+    // The fish of a cell are next to each other in the sorted arrays, so they are run four at a time against the cells
+    // that the radius around any of the four reaches into, at most the 3x3x3 cells around theirs
+    if (vectorized) {
+        while (i < end) {
+            int cell_x = getCell(sorted_pos_x[i]), cell_y = getCell(sorted_pos_y[i]), cell_z = getCell(sorted_pos_z[i]);
+            size_t cell_end = i + 1;
+            while (cell_end < end && getCell(sorted_pos_x[cell_end]) == cell_x && getCell(sorted_pos_y[cell_end]) == cell_y
+                && getCell(sorted_pos_z[cell_end]) == cell_z)
+                cell_end++;
+
+            // A fish alone in its cell only needs the cells its own radius reaches into
+            if (cell_end - i == 1) {
+                neighbors += updateFish(i++, dt, avoid_pos);
+                continue;
+            }
+
+            for (; i < cell_end; i += 4) {
+                size_t count = std::min(cell_end - i, (size_t) 4);
+                glm::ivec3 low = getLowCell(glm::vec3(sorted_pos_x[i], sorted_pos_y[i], sorted_pos_z[i]));
+                glm::ivec3 high = low;
+                for (size_t j = i + 1; j < i + count; j++) {
+                    glm::ivec3 fish_low = getLowCell(glm::vec3(sorted_pos_x[j], sorted_pos_y[j], sorted_pos_z[j]));
+                    low = glm::min(low, fish_low);
+                    high = glm::max(high, fish_low);
+                }
+
+                uint32_t ranges[54];
+                int range_count = getBlockRanges(low, high + 1, ranges);
+                neighbors += updateFour(i, count, ranges, range_count, dt, avoid_pos);
+            }
+            i = cell_end;
+        }
+    }
+#endif
+    for (; i < end; i++)
+        neighbors += updateFish(i, dt, avoid_pos);
+    return neighbors;
+}
+
+#if BOIDS_SSE2
+// Picks the lanes of a where the mask is set and those of b elsewhere
+static inline __m128 select(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// Applies the flocking rules to up to four sorted fish from first on, one fish per lane, returns the number of neighbours found
+// The ranges hold the neighbours of all of them. Each candidate is tested against the four fish at once, rather than a fish
+// against four candidates, as the buckets hold too few fish to fill the lanes
+long long FishSchool::updateFour(size_t first, size_t count, const uint32_t* ranges, int range_count, float dt, glm::vec3 avoid_pos) {
+    const BoidSettings& s = settings;
+    const float *x = sorted_pos_x.data(), *y = sorted_pos_y.data(), *z = sorted_pos_z.data();
+    const float *vx = sorted_vel_x.data(), *vy = sorted_vel_y.data(), *vz = sorted_vel_z.data();
+
+    __m128 pos_x4, pos_y4, pos_z4, vel_x4, vel_y4, vel_z4;
+    if (count == 4) {
+        pos_x4 = _mm_loadu_ps(x + first), pos_y4 = _mm_loadu_ps(y + first), pos_z4 = _mm_loadu_ps(z + first);
+        vel_x4 = _mm_loadu_ps(vx + first), vel_y4 = _mm_loadu_ps(vy + first), vel_z4 = _mm_loadu_ps(vz + first);
+    } else {
+        // Lanes past the last fish repeat it, and their results are not stored
+        size_t lanes[4];
+        for (size_t lane = 0; lane < 4; lane++)
+            lanes[lane] = first + std::min(lane, count - 1);
+        pos_x4 = _mm_setr_ps(x[lanes[0]], x[lanes[1]], x[lanes[2]], x[lanes[3]]);
+        pos_y4 = _mm_setr_ps(y[lanes[0]], y[lanes[1]], y[lanes[2]], y[lanes[3]]);
+        pos_z4 = _mm_setr_ps(z[lanes[0]], z[lanes[1]], z[lanes[2]], z[lanes[3]]);
+        vel_x4 = _mm_setr_ps(vx[lanes[0]], vx[lanes[1]], vx[lanes[2]], vx[lanes[3]]);
+        vel_y4 = _mm_setr_ps(vy[lanes[0]], vy[lanes[1]], vy[lanes[2]], vy[lanes[3]]);
+        vel_z4 = _mm_setr_ps(vz[lanes[0]], vz[lanes[1]], vz[lanes[2]], vz[lanes[3]]);
+    }
+    __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.f);
+    __m128 radius2 = _mm_set1_ps(s.neighbor_radius * s.neighbor_radius);
+    __m128 separation_radius2 = _mm_set1_ps(s.separation_radius * s.separation_radius);
+    __m128 neighbor_count = zero, sum_x = zero, sum_y = zero, sum_z = zero;
+    __m128 sum_vx = zero, sum_vy = zero, sum_vz = zero, sep_x = zero, sep_y = zero, sep_z = zero;
+
+    for (int r = 0; r < range_count; r++) {
+        for (size_t j = ranges[r * 2], end = ranges[r * 2 + 1]; j < end; j++) {
+            __m128 fx = _mm_set1_ps(x[j]), fy = _mm_set1_ps(y[j]), fz = _mm_set1_ps(z[j]);
+            __m128 dx = _mm_sub_ps(fx, pos_x4), dy = _mm_sub_ps(fy, pos_y4), dz = _mm_sub_ps(fz, pos_z4);
+            __m128 distance2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+            // The fish itself is at distance 0
+            __m128 not_self = _mm_cmpgt_ps(distance2, zero);
+            __m128 in_range = _mm_and_ps(_mm_cmplt_ps(distance2, radius2), not_self);
+            if (_mm_movemask_ps(in_range) == 0)
+                continue;
+
+            neighbor_count = _mm_add_ps(neighbor_count, _mm_and_ps(in_range, one));
+            sum_x = _mm_add_ps(sum_x, _mm_and_ps(in_range, fx));
+            sum_y = _mm_add_ps(sum_y, _mm_and_ps(in_range, fy));
+            sum_z = _mm_add_ps(sum_z, _mm_and_ps(in_range, fz));
+            sum_vx = _mm_add_ps(sum_vx, _mm_and_ps(in_range, _mm_set1_ps(vx[j])));
+            sum_vy = _mm_add_ps(sum_vy, _mm_and_ps(in_range, _mm_set1_ps(vy[j])));
+            sum_vz = _mm_add_ps(sum_vz, _mm_and_ps(in_range, _mm_set1_ps(vz[j])));
+
+            // Masked out lanes may divide by zero, the mask clears whatever that gives
+            __m128 too_close = _mm_and_ps(_mm_cmplt_ps(distance2, separation_radius2), not_self);
+            __m128 inverse = _mm_and_ps(too_close, _mm_div_ps(one, distance2));
+            sep_x = _mm_sub_ps(sep_x, _mm_mul_ps(dx, inverse));
+            sep_y = _mm_sub_ps(sep_y, _mm_mul_ps(dy, inverse));
+            sep_z = _mm_sub_ps(sep_z, _mm_mul_ps(dz, inverse));
+        }
+    }
+
+    // Separation, alignment and cohesion, fish without neighbours only separate
+    __m128 weight = _mm_set1_ps(s.separation_weight);
+    __m128 steer_x = _mm_mul_ps(sep_x, weight), steer_y = _mm_mul_ps(sep_y, weight), steer_z = _mm_mul_ps(sep_z, weight);
+    __m128 has_neighbors = _mm_cmpgt_ps(neighbor_count, zero);
+    weight = _mm_set1_ps(s.alignment_weight);
+    steer_x = _mm_add_ps(steer_x, _mm_and_ps(has_neighbors, _mm_mul_ps(_mm_sub_ps(_mm_div_ps(sum_vx, neighbor_count), vel_x4), weight)));
+    steer_y = _mm_add_ps(steer_y, _mm_and_ps(has_neighbors, _mm_mul_ps(_mm_sub_ps(_mm_div_ps(sum_vy, neighbor_count), vel_y4), weight)));
+    steer_z = _mm_add_ps(steer_z, _mm_and_ps(has_neighbors, _mm_mul_ps(_mm_sub_ps(_mm_div_ps(sum_vz, neighbor_count), vel_z4), weight)));
+    weight = _mm_set1_ps(s.cohesion_weight);
+    steer_x = _mm_add_ps(steer_x, _mm_and_ps(has_neighbors, _mm_mul_ps(_mm_sub_ps(_mm_div_ps(sum_x, neighbor_count), pos_x4), weight)));
+    steer_y = _mm_add_ps(steer_y, _mm_and_ps(has_neighbors, _mm_mul_ps(_mm_sub_ps(_mm_div_ps(sum_y, neighbor_count), pos_y4), weight)));
+    steer_z = _mm_add_ps(steer_z, _mm_and_ps(has_neighbors, _mm_mul_ps(_mm_sub_ps(_mm_div_ps(sum_z, neighbor_count), pos_z4), weight)));
+
+    // Flee the player, harder the closer it is
+    __m128 from_x = _mm_sub_ps(pos_x4, _mm_set1_ps(avoid_pos.x));
+    __m128 from_y = _mm_sub_ps(pos_y4, _mm_set1_ps(avoid_pos.y));
+    __m128 from_z = _mm_sub_ps(pos_z4, _mm_set1_ps(avoid_pos.z));
+    __m128 player_distance = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(from_x, from_x), _mm_mul_ps(from_y, from_y)),
+        _mm_mul_ps(from_z, from_z)));
+    __m128 avoid_radius = _mm_set1_ps(s.avoid_radius);
+    __m128 fleeing = _mm_and_ps(_mm_cmplt_ps(player_distance, avoid_radius), _mm_cmpgt_ps(player_distance, zero));
+    __m128 flee = _mm_mul_ps(_mm_sub_ps(one, _mm_div_ps(player_distance, avoid_radius)), _mm_set1_ps(s.avoid_weight));
+    steer_x = _mm_add_ps(steer_x, _mm_and_ps(fleeing, _mm_mul_ps(_mm_div_ps(from_x, player_distance), flee)));
+    steer_y = _mm_add_ps(steer_y, _mm_and_ps(fleeing, _mm_mul_ps(_mm_div_ps(from_y, player_distance), flee)));
+    steer_z = _mm_add_ps(steer_z, _mm_and_ps(fleeing, _mm_mul_ps(_mm_div_ps(from_z, player_distance), flee)));
+
+    // Rise away from the seafloor
+    __m128 floor_y = _mm_set1_ps(s.floor_y), floor_margin = _mm_set1_ps(s.floor_margin);
+    __m128 height = _mm_sub_ps(pos_y4, floor_y);
+    __m128 rise = _mm_mul_ps(_mm_sub_ps(one, _mm_div_ps(_mm_max_ps(height, zero), floor_margin)), _mm_set1_ps(s.floor_weight));
+    steer_y = _mm_add_ps(steer_y, _mm_and_ps(_mm_cmplt_ps(height, floor_margin), rise));
+
+    // Turn back towards the region when outside of it
+    weight = _mm_set1_ps(s.region_weight);
+    __m128 back_x = _mm_sub_ps(_mm_min_ps(_mm_max_ps(pos_x4, _mm_set1_ps(s.region_min.x)), _mm_set1_ps(s.region_max.x)), pos_x4);
+    __m128 back_y = _mm_sub_ps(_mm_min_ps(_mm_max_ps(pos_y4, _mm_set1_ps(s.region_min.y)), _mm_set1_ps(s.region_max.y)), pos_y4);
+    __m128 back_z = _mm_sub_ps(_mm_min_ps(_mm_max_ps(pos_z4, _mm_set1_ps(s.region_min.z)), _mm_set1_ps(s.region_max.z)), pos_z4);
+    steer_x = _mm_add_ps(steer_x, _mm_mul_ps(back_x, weight));
+    steer_y = _mm_add_ps(steer_y, _mm_mul_ps(back_y, weight));
+    steer_z = _mm_add_ps(steer_z, _mm_mul_ps(back_z, weight));
+
+    __m128 max_acceleration = _mm_set1_ps(s.max_acceleration);
+    __m128 steer_length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(steer_x, steer_x), _mm_mul_ps(steer_y, steer_y)),
+        _mm_mul_ps(steer_z, steer_z)));
+    __m128 scale = select(_mm_cmpgt_ps(steer_length, max_acceleration), _mm_div_ps(max_acceleration, steer_length), one);
+    __m128 step = _mm_set1_ps(dt);
+    vel_x4 = _mm_add_ps(vel_x4, _mm_mul_ps(_mm_mul_ps(steer_x, scale), step));
+    vel_y4 = _mm_add_ps(vel_y4, _mm_mul_ps(_mm_mul_ps(steer_y, scale), step));
+    vel_z4 = _mm_add_ps(vel_z4, _mm_mul_ps(_mm_mul_ps(steer_z, scale), step));
+
+    // Fish that stopped dead set off along x at the least speed
+    __m128 max_speed = _mm_set1_ps(s.max_speed), min_speed = _mm_set1_ps(s.min_speed);
+    __m128 speed = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(vel_x4, vel_x4), _mm_mul_ps(vel_y4, vel_y4)),
+        _mm_mul_ps(vel_z4, vel_z4)));
+    __m128 too_fast = _mm_cmpgt_ps(speed, max_speed);
+    __m128 too_slow = _mm_andnot_ps(too_fast, _mm_cmplt_ps(speed, min_speed));
+    __m128 stopped = _mm_and_ps(too_slow, _mm_cmpeq_ps(speed, zero));
+    scale = select(too_fast, _mm_div_ps(max_speed, speed), select(too_slow, _mm_div_ps(min_speed, speed), one));
+    vel_x4 = select(stopped, min_speed, _mm_mul_ps(vel_x4, scale));
+    vel_y4 = select(stopped, zero, _mm_mul_ps(vel_y4, scale));
+    vel_z4 = select(stopped, zero, _mm_mul_ps(vel_z4, scale));
+    pos_x4 = _mm_add_ps(pos_x4, _mm_mul_ps(vel_x4, step));
+    pos_y4 = _mm_add_ps(pos_y4, _mm_mul_ps(vel_y4, step));
+    pos_z4 = _mm_add_ps(pos_z4, _mm_mul_ps(vel_z4, step));
+
+    // Fish never go through the seafloor, whatever the rules say
+    __m128 below = _mm_cmplt_ps(pos_y4, floor_y);
+    pos_y4 = select(below, floor_y, pos_y4);
+    vel_y4 = select(below, _mm_andnot_ps(_mm_set1_ps(-0.f), vel_y4), vel_y4);
+
+    float counts[4];
+    _mm_storeu_ps(counts, neighbor_count);
+    if (count == 4) {
+        _mm_storeu_ps(&pos_x[first], pos_x4), _mm_storeu_ps(&pos_y[first], pos_y4), _mm_storeu_ps(&pos_z[first], pos_z4);
+        _mm_storeu_ps(&vel_x[first], vel_x4), _mm_storeu_ps(&vel_y[first], vel_y4), _mm_storeu_ps(&vel_z[first], vel_z4);
+        return (long long) counts[0] + (long long) counts[1] + (long long) counts[2] + (long long) counts[3];
+    }
+
+    float results[6][4];
+    _mm_storeu_ps(results[0], pos_x4), _mm_storeu_ps(results[1], pos_y4), _mm_storeu_ps(results[2], pos_z4);
+    _mm_storeu_ps(results[3], vel_x4), _mm_storeu_ps(results[4], vel_y4), _mm_storeu_ps(results[5], vel_z4);
+    long long neighbors = 0;
+    for (size_t lane = 0; lane < count; lane++) {
+        size_t i = first + lane;
+        pos_x[i] = results[0][lane], pos_y[i] = results[1][lane], pos_z[i] = results[2][lane];
+        vel_x[i] = results[3][lane], vel_y[i] = results[4][lane], vel_z[i] = results[5][lane];
+        neighbors += (long long) counts[lane];
+    }
+    return neighbors;
+}
+#endif
+
+// Advances every fish by one step of dt seconds, avoiding a player at avoid_pos
+void FishSchool::step(float dt, glm::vec3 avoid_pos, ThreadPool& pool) {
+    PROFILE_SCOPE("Fish step");
+    buildHash(pool);
+    // Ids do not change during the step, so their sorted copy simply becomes the current one
+    ids.swap(sorted_ids);
+
+    // Every fish reads the sorted copies of the last step and writes its own new state, so the ranges need no locking
+    std::atomic<long long> neighbors(0);
+    pool.parallelFor(size(), parallel_grain, [this, dt, avoid_pos, &neighbors](size_t begin, size_t end) {
+        neighbors += updateRange(begin, end, dt, avoid_pos);
+    });
+    neighbor_total = neighbors;
+}
+
+// Writes the position and heading of every fish for the instanced renderer
+void FishSchool::writeInstances(InstanceData* instances, ThreadPool& pool) {
+    PROFILE_SCOPE("Write fish instances");
+    pool.parallelFor(size(), parallel_grain * 4, [this, instances](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            instances[i].pos = glm::vec3(pos_x[i], pos_y[i], pos_z[i]);
+            instances[i].dir = glm::vec3(vel_x[i], vel_y[i], vel_z[i]);
+        }
+    });
+}
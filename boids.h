@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common.h"
+#include "instancing.h"
+#include "thread_pool.h"
+
+// Tuning of the flocking rules of a school
+struct BoidSettings {
+    // Distance within which fish align with and move towards each other
+    float neighbor_radius;
+    // Distance within which fish push away from each other
+    float separation_radius;
+    float min_speed;
+    float max_speed;
+    // Largest change in velocity per second the rules can cause
+    float max_acceleration;
+
+    float separation_weight;
+    float alignment_weight;
+    float cohesion_weight;
+    // Strength of the push away from the player and the distance it starts at
+    float avoid_weight;
+    float avoid_radius;
+    // Strength of the push up from the seafloor and the distance above it that it starts at
+    float floor_weight;
+    float floor_margin;
+    float floor_y;
+    // Region the school is steered back into when fish stray out of it
+    glm::vec3 region_min;
+    glm::vec3 region_max;
+    float region_weight;
+
+    BoidSettings():
+        neighbor_radius(2.5f), separation_radius(1.f), min_speed(2.f), max_speed(6.f), max_acceleration(12.f),
+        separation_weight(1.5f), alignment_weight(1.f), cohesion_weight(0.6f),
+        avoid_weight(20.f), avoid_radius(8.f), floor_weight(8.f), floor_margin(4.f), floor_y(-50.f),
+        region_min(-60.f, -48.f, -60.f), region_max(60.f, -2.f, 60.f), region_weight(2.f) {}
+};
+
+// Flock of fish stored as arrays of each coordinate so the flocking rules can be run for four fish at a time
+class FishSchool {
+public:
+    BoidSettings settings;
+    // Position and velocity of each fish, kept sorted by grid cell after every step
+    std::vector<float> pos_x, pos_y, pos_z;
+    std::vector<float> vel_x, vel_y, vel_z;
+    // Index each fish had when the school was created, moved along with it when the arrays are sorted
+    std::vector<uint32_t> ids;
+    // Whether four fish are updated at a time with SIMD instructions, otherwise they are updated one at a time
+    bool vectorized;
+
+    // Scatters count fish with random headings through the region of the settings
+    FishSchool(size_t count, const BoidSettings& settings = BoidSettings(), uint32_t seed = 1234);
+
+    inline size_t size() {
+        return pos_x.size();
+    }
+
+    // Advances every fish by one step of dt seconds, avoiding a player at avoid_pos
+    void step(float dt, glm::vec3 avoid_pos, ThreadPool& pool);
+
+    // Writes the position and heading of every fish for the instanced renderer
+    void writeInstances(InstanceData* instances, ThreadPool& pool);
+
+    // Average number of neighbours of a fish on the last step
+    inline float getAverageNeighbors() {
+        return size() ? (float) neighbor_total / size() : 0.f;
+    }
+
+private:
+    // Copies of the arrays sorted by cell, read by the step while it writes the arrays above
+    std::vector<float> sorted_pos_x, sorted_pos_y, sorted_pos_z;
+    std::vector<float> sorted_vel_x, sorted_vel_y, sorted_vel_z;
+    std::vector<uint32_t> sorted_ids;
+    // Bucket of the spatial hash each fish is in, and where each bucket's fish start in the sorted arrays
+    std::vector<uint32_t> buckets;
+    std::vector<uint32_t> bucket_starts;
+    std::vector<uint32_t> order;
+    uint32_t bucket_mask;
+    long long neighbor_total;
+
+    // Gets the bucket of the grid cell a point is in
+    inline uint32_t getBucket(int x, int y, int z) {
+        return (((uint32_t) x * 73856093u) ^ ((uint32_t) y * 19349663u) ^ ((uint32_t) z * 83492791u)) & bucket_mask;
+    }
+
+    // Gets the grid cell a coordinate is in, cells are twice as wide as the neighbour radius
+    inline int getCell(float coordinate) {
+        return (int) std::floor(coordinate / (settings.neighbor_radius * 2.f));
+    }
+
+    // Gets the lowest of the cells the neighbour radius around a point reaches into along each axis
+    inline glm::ivec3 getLowCell(glm::vec3 pos) {
+        return glm::ivec3(getCell(pos.x - settings.neighbor_radius), getCell(pos.y - settings.neighbor_radius),
+            getCell(pos.z - settings.neighbor_radius));
+    }
+
+    // Sorts the fish into the buckets of the spatial hash
+    void buildHash(ThreadPool& pool);
+
+    // Gets the ranges of sorted fish in the buckets of the cells from low to high, at most 3x3x3 cells, as pairs of begin and
+    // end indices, returns the number of ranges
+    int getBlockRanges(glm::ivec3 low, glm::ivec3 high, uint32_t* ranges);
+
+    // Applies the flocking rules to one of the sorted fish, returns the number of neighbours it has
+    long long updateFish(size_t i, float dt, glm::vec3 avoid_pos);
+
+    // Applies the flocking rules to a range of the sorted fish, returns the number of neighbours found
+    long long updateRange(size_t begin, size_t end, float dt, glm::vec3 avoid_pos);
+
+    // Applies the flocking rules to up to four sorted fish from first on with SIMD instructions, their neighbours all in the
+    // ranges given, returns the number of neighbours found, only built for SSE2 targets
+    long long updateFour(size_t first, size_t count, const uint32_t* ranges, int range_count, float dt, glm::vec3 avoid_pos);
+};
@@ -0,0 +1,122 @@
+#include "boids_gpu.h"
+
+#include <algorithm>
+
+#include "profiler.h"
+#include "startup_timeline.h"
+
+// Invocations per work group, must match local_size_x in the shaders
+static const size_t group_size = 256;
+
+// Copies the fish of a school, fish i of the GPU school is the fish with id i in the CPU school
+GpuFishSchool::GpuFishSchool(const FishSchool& school):
+    settings(school.settings), current(0), count(school.pos_x.size()),
+    bin_shader("Shaders/boids_bin.comp"), update_shader("Shaders/boids_update.comp") {
+    // The CPU school keeps its fish sorted by cell, put them back in the order they were created
+    std::vector<GpuFish> fish(count);
+    for (size_t i = 0; i < count; i++) {
+        GpuFish& f = fish[school.ids[i]];
+        f.pos = glm::vec4(school.pos_x[i], school.pos_y[i], school.pos_z[i], 1.f);
+        f.vel = glm::vec4(school.vel_x[i], school.vel_y[i], school.vel_z[i], 0.f);
+    }
+
+    // Same number of buckets as the CPU school, so both hash cells to the same buckets
+    uint32_t bucket_count = 16;
+    while (bucket_count < count)
+        bucket_count *= 2;
+    bucket_mask = bucket_count - 1;
+
+    // Buffers can not be empty, so an empty school still gets room for one fish
+    size_t fish_size = std::max(count, (size_t) 1) * sizeof(GpuFish);
+    double upload_start = StartupTimeline::now();
+    glGenBuffers(2, fish_buffers);
+    for (int i = 0; i < 2; i++) {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, fish_buffers[i]);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, fish_size, i == current ? fish.data() : NULL, GL_DYNAMIC_COPY);
+    }
+    glGenBuffers(1, &heads_buffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, heads_buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, bucket_count * sizeof(GLint), NULL, GL_DYNAMIC_COPY);
+    glGenBuffers(1, &next_buffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, next_buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, std::max(count, (size_t) 1) * sizeof(GLint), NULL, GL_DYNAMIC_COPY);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    StartupTimeline::record("Upload fish buffers", "", upload_start, fish_size,
+        fish_size * 2 + (bucket_count + std::max(count, (size_t) 1)) * sizeof(GLint));
+
+    // Settings that never change are passed once
+    float cell_size = settings.neighbor_radius * 2.f;
+    bin_shader.setUint("fish_count", (GLuint) count);
+    bin_shader.setUint("bucket_mask", bucket_mask);
+    bin_shader.setFloat("cell_size", cell_size);
+
+    update_shader.setUint("fish_count", (GLuint) count);
+    update_shader.setUint("bucket_mask", bucket_mask);
+    update_shader.setFloat("cell_size", cell_size);
+    update_shader.setFloat("neighbor_radius", settings.neighbor_radius);
+    update_shader.setFloat("separation_radius", settings.separation_radius);
+    update_shader.setFloat("min_speed", settings.min_speed);
+    update_shader.setFloat("max_speed", settings.max_speed);
+    update_shader.setFloat("max_acceleration", settings.max_acceleration);
+    update_shader.setFloat("separation_weight", settings.separation_weight);
+    update_shader.setFloat("alignment_weight", settings.alignment_weight);
+    update_shader.setFloat("cohesion_weight", settings.cohesion_weight);
+    update_shader.setFloat("avoid_weight", settings.avoid_weight);
+    update_shader.setFloat("avoid_radius", settings.avoid_radius);
+    update_shader.setFloat("floor_weight", settings.floor_weight);
+    update_shader.setFloat("floor_margin", settings.floor_margin);
+    update_shader.setFloat("floor_y", settings.floor_y);
+    update_shader.setVec3("region_min", settings.region_min);
+    update_shader.setVec3("region_max", settings.region_max);
+    update_shader.setFloat("region_weight", settings.region_weight);
+    glUseProgram(0);
+}
+
+// Deconstructor to free the buffers
+GpuFishSchool::~GpuFishSchool() {
+    glDeleteBuffers(2, fish_buffers);
+    glDeleteBuffers(1, &heads_buffer);
+    glDeleteBuffers(1, &next_buffer);
+}
+
+// Advances every fish by one step of dt seconds, avoiding a player at avoid_pos
+void GpuFishSchool::step(float dt, glm::vec3 avoid_pos) {
+    PROFILE_GPU_SCOPE("Fish compute");
+    if (count == 0)
+        return;
+
+    // Empty every bucket, then link each fish into its bucket's list
+    GLint empty = -1;
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, heads_buffer);
+    glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32I, GL_RED_INTEGER, GL_INT, &empty);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, fish_buffers[current]);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, fish_buffers[1 - current]);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, heads_buffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, next_buffer);
+    bin_shader.dispatch(count, group_size);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    // Every fish reads the last step's buffer and writes its own state to the other one
+    update_shader.setFloat("dt", dt);
+    update_shader.setVec3("avoid_pos", avoid_pos);
+    update_shader.dispatch(count, group_size);
+
+    // The next step reads the new state as storage, and the renderer reads it as instance attributes
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+    glUseProgram(0);
+    current = 1 - current;
+}
+
+// Copies the fish back from the GPU, which stalls until every step is done, so only for comparing with the CPU school
+void GpuFishSchool::readBack(std::vector<GpuFish>& fish) {
+    fish.resize(count);
+    if (count == 0)
+        return;
+
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, fish_buffers[current]);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, count * sizeof(GpuFish), fish.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+
+#include "common.h"
+#include "boids.h"
+#include "shader.h"
+
+// State of one fish as laid out in the shader storage buffers, padded to vec4s for std430
+struct GpuFish {
+    glm::vec4 pos;
+    glm::vec4 vel;
+};
+
+// Same flocking as FishSchool, run by compute shaders on state that never leaves the GPU
+// Each step reads one buffer of fish and writes the other, and the one written last can be drawn straight from
+class GpuFishSchool {
+public:
+    BoidSettings settings;
+
+    // Copies the fish of a school, fish i of the GPU school is the fish with id i in the CPU school
+    GpuFishSchool(const FishSchool& school);
+
+    // Deconstructor to free the buffers
+    ~GpuFishSchool();
+
+    inline size_t size() {
+        return count;
+    }
+
+    // Advances every fish by one step of dt seconds, avoiding a player at avoid_pos
+    void step(float dt, glm::vec3 avoid_pos);
+
+    // Gets the buffer holding the fish as of the last step, as an array of GpuFish
+    inline GLuint getCurrentBuffer() {
+        return fish_buffers[current];
+    }
+
+    // Copies the fish back from the GPU, which stalls until every step is done, so only for comparing with the CPU school
+    void readBack(std::vector<GpuFish>& fish);
+
+private:
+    // Fish read and written by the steps, current is the one written last
+    GLuint fish_buffers[2];
+    int current;
+    // First fish of each bucket of the spatial hash, and the next fish in the same bucket after each fish
+    GLuint heads_buffer;
+    GLuint next_buffer;
+    size_t count;
+    uint32_t bucket_mask;
+
+    ComputeShader bin_shader;
+    ComputeShader update_shader;
+};
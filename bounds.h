@@ -0,0 +1,131 @@
+#pragma once
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include <glm/glm.hpp>
+
+// Axis aligned bounding box
+struct AABB {
+    glm::vec3 min;
+    glm::vec3 max;
+
+    AABB(): min(FLT_MAX), max(-FLT_MAX) {}
+    AABB(glm::vec3 min, glm::vec3 max): min(min), max(max) {}
+
+    // Whether the box does not contain any point yet
+    inline bool isEmpty() const {
+        return min.x > max.x || min.y > max.y || min.z > max.z;
+    }
+
+    inline glm::vec3 getCenter() const {
+        return (min + max) * 0.5f;
+    }
+
+    // Gets the half size of the box along each axis
+    inline glm::vec3 getExtents() const {
+        return (max - min) * 0.5f;
+    }
+
+    // Surface area of the box, used as the cost of a node when building trees of boxes
+    inline float getSurfaceArea() const {
+        glm::vec3 size = max - min;
+        return 2.f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    // Grows the box to include a point
+    inline void expand(glm::vec3 point) {
+        min = glm::min(min, point);
+        max = glm::max(max, point);
+    }
+
+    // Gets the smallest box that contains both boxes
+    static inline AABB merge(const AABB& a, const AABB& b) {
+        return AABB(glm::min(a.min, b.min), glm::max(a.max, b.max));
+    }
+
+    inline bool contains(const AABB& other) const {
+        return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z &&
+            max.x >= other.max.x && max.y >= other.max.y && max.z >= other.max.z;
+    }
+
+    inline bool overlaps(const AABB& other) const {
+        return min.x <= other.max.x && max.x >= other.min.x &&
+            min.y <= other.max.y && max.y >= other.min.y &&
+            min.z <= other.max.z && max.z >= other.min.z;
+    }
+
+    // Gets the distance along a ray at which it enters the box, clamped to 0 when it starts inside
+    // inv_direction is 1 / direction of the ray, returns false if the ray misses the box within max_distance
+    inline bool intersectRay(glm::vec3 origin, glm::vec3 inv_direction, float max_distance, float& distance) const {
+        glm::vec3 t1 = (min - origin) * inv_direction;
+        glm::vec3 t2 = (max - origin) * inv_direction;
+        glm::vec3 t_near = glm::min(t1, t2);
+        glm::vec3 t_far = glm::max(t1, t2);
+        float enter = std::max(std::max(t_near.x, t_near.y), std::max(t_near.z, 0.f));
+        float exit = std::min(std::min(t_far.x, t_far.y), std::min(t_far.z, max_distance));
+        distance = enter;
+        return enter <= exit;
+    }
+
+    // Whether the box touches a sphere
+    inline bool overlaps(glm::vec3 center, float radius) const {
+        glm::vec3 closest = glm::clamp(center, min, max);
+        glm::vec3 offset = center - closest;
+        return glm::dot(offset, offset) <= radius * radius;
+    }
+};
+
+// Gets the axis aligned box that encloses a box after it is transformed by a matrix
+inline AABB transformAABB(const AABB& box, const glm::mat4& matrix) {
+    glm::vec3 center = glm::vec3(matrix * glm::vec4(box.getCenter(), 1.f));
+    glm::vec3 extents = box.getExtents();
+    // The new extents are the sum of the absolute values of each rotated and scaled axis
+    glm::vec3 new_extents =
+        glm::abs(glm::vec3(matrix[0])) * extents.x +
+        glm::abs(glm::vec3(matrix[1])) * extents.y +
+        glm::abs(glm::vec3(matrix[2])) * extents.z;
+    return AABB(center - new_extents, center + new_extents);
+}
+
+// The six planes bounding the volume a camera can see, each stored as a normal pointing inwards and a distance
+struct Frustum {
+    glm::vec4 planes[6];
+
+    Frustum() {}
+
+    // Extracts the planes from a combined projection and view matrix
+    Frustum(const glm::mat4& view_projection) {
+        glm::mat4 m = glm::transpose(view_projection);
+        planes[0] = m[3] + m[0]; // Left
+        planes[1] = m[3] - m[0]; // Right
+        planes[2] = m[3] + m[1]; // Bottom
+        planes[3] = m[3] - m[1]; // Top
+        planes[4] = m[3] + m[2]; // Near
+        planes[5] = m[3] - m[2]; // Far
+        for (int i = 0; i < 6; i++)
+            planes[i] /= glm::length(glm::vec3(planes[i]));
+    }
+
+    // Whether any part of a box may be inside the frustum
+    inline bool intersects(const AABB& box) const {
+        glm::vec3 center = box.getCenter();
+        glm::vec3 extents = box.getExtents();
+        for (int i = 0; i < 6; i++) {
+            glm::vec3 normal = glm::vec3(planes[i]);
+            float radius = glm::dot(extents, glm::abs(normal));
+            if (glm::dot(normal, center) + planes[i].w < -radius)
+                return false;
+        }
+        return true;
+    }
+
+    // Whether any part of a sphere may be inside the frustum
+    inline bool intersects(glm::vec3 center, float radius) const {
+        for (int i = 0; i < 6; i++)
+            if (glm::dot(glm::vec3(planes[i]), center) + planes[i].w < -radius)
+                return false;
+        return true;
+    }
+};
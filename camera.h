@@ -1,6 +1,8 @@
 #pragma once
 #include <glm/glm.hpp>
 
+#include "bounds.h"
+
 // Abstract base camera class that contains common attributes of different camera classes
 class Camera {
 public:
@@ -30,6 +32,11 @@ public:
 
     // Abstract method for getting the projection matrix of this camera instance's settings
     virtual inline glm::mat4 getProjectionMatrix() = 0;
+
+    // Gets the volume this camera can see, for culling what is outside of it
+    inline Frustum getFrustum() {
+        return Frustum(getProjectionMatrix() * getViewMatrix());
+    }
 };
 
 // Represents a base class for perspective cameras
@@ -0,0 +1,597 @@
+#include "collision.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <mutex>
+
+#include "profiler.h"
+
+// Number of body pairs below which the cells are not split between threads
+static const size_t parallel_grain = 64;
+// Number of cells above which queries of a box test every body instead of walking the grid
+static const int max_query_cells = 4096;
+// Lengths below which directions are treated as zero
+static const float epsilon = 1e-6f;
+
+/* SHAPES */
+
+// Gets the world space box enclosing the shape
+AABB Collider::getBounds() const {
+    glm::vec3 extents;
+    switch (shape) {
+        case COLLIDER_SPHERE:
+            extents = glm::vec3(radius);
+            break;
+        case COLLIDER_CAPSULE:
+            extents = glm::abs(axes[0]) * half_extents.x + glm::vec3(radius);
+            break;
+        default:
+            extents = glm::abs(axes[0]) * half_extents.x + glm::abs(axes[1]) * half_extents.y + glm::abs(axes[2]) * half_extents.z;
+            break;
+    }
+    return AABB(center - extents, center + extents);
+}
+
+// Fits a collider of a shape to the local bounds of a mesh placed by a world matrix
+Collider makeCollider(ColliderShape shape, const AABB& local_bounds, const glm::mat4& world) {
+    Collider collider;
+    collider.shape = shape;
+    collider.center = glm::vec3(world * glm::vec4(local_bounds.getCenter(), 1.f));
+
+    // The matrix's columns are the rotated axes scaled by the scale of the model
+    glm::vec3 local_extents = local_bounds.getExtents();
+    glm::vec3 extents;
+    for (int i = 0; i < 3; i++) {
+        glm::vec3 axis = glm::vec3(world[i]);
+        float length = glm::length(axis);
+        collider.axes[i] = length > epsilon ? axis / length : glm::vec3(0.f);
+        extents[i] = local_extents[i] * length;
+    }
+    collider.half_extents = extents;
+    collider.radius = 0.f;
+
+    if (shape == COLLIDER_SPHERE)
+        collider.radius = std::max(extents.x, std::max(extents.y, extents.z));
+    else if (shape == COLLIDER_CAPSULE) {
+        // Run the segment along the longest side, the radius covers the wider of the other two
+        int longest = (extents.x >= extents.y && extents.x >= extents.z) ? 0 : (extents.y >= extents.z ? 1 : 2);
+        glm::vec3 axis = collider.axes[longest];
+        collider.radius = std::max(extents[(longest + 1) % 3], extents[(longest + 2) % 3]);
+        collider.half_extents = glm::vec3(std::max(extents[longest] - collider.radius, 0.f), 0.f, 0.f);
+        collider.axes[longest] = collider.axes[0];
+        collider.axes[0] = axis;
+    }
+    return collider;
+}
+
+/* NARROWPHASE */
+
+// Gets the point of segment pq closest to a point
+static glm::vec3 closestOnSegment(glm::vec3 p, glm::vec3 q, glm::vec3 point) {
+    glm::vec3 segment = q - p;
+    float length2 = glm::dot(segment, segment);
+    if (length2 < epsilon)
+        return p;
+    float t = glm::clamp(glm::dot(point - p, segment) / length2, 0.f, 1.f);
+    return p + segment * t;
+}
+
+// Gets the closest points between segments p1q1 and p2q2
+static void closestBetweenSegments(glm::vec3 p1, glm::vec3 q1, glm::vec3 p2, glm::vec3 q2, glm::vec3& c1, glm::vec3& c2) {
+    glm::vec3 d1 = q1 - p1, d2 = q2 - p2, r = p1 - p2;
+    float a = glm::dot(d1, d1), e = glm::dot(d2, d2), f = glm::dot(d2, r);
+    float s, t;
+    if (a < epsilon && e < epsilon) {
+        s = t = 0.f;
+    }
+    else if (a < epsilon) {
+        s = 0.f;
+        t = glm::clamp(f / e, 0.f, 1.f);
+    }
+    else {
+        float c = glm::dot(d1, r);
+        if (e < epsilon) {
+            t = 0.f;
+            s = glm::clamp(-c / a, 0.f, 1.f);
+        }
+        else {
+            // Closest points of the infinite lines, clamped to the first segment then the second
+            float b = glm::dot(d1, d2);
+            float denominator = a * e - b * b;
+            s = denominator > epsilon ? glm::clamp((b * f - c * e) / denominator, 0.f, 1.f) : 0.f;
+            t = (b * s + f) / e;
+            if (t < 0.f) {
+                t = 0.f;
+                s = glm::clamp(-c / a, 0.f, 1.f);
+            }
+            else if (t > 1.f) {
+                t = 1.f;
+                s = glm::clamp((b - c) / a, 0.f, 1.f);
+            }
+        }
+    }
+    c1 = p1 + d1 * s;
+    c2 = p2 + d2 * t;
+}
+
+// Tests two spheres, the base of every test involving spheres and capsules
+static bool collideSpheres(glm::vec3 center_a, float radius_a, glm::vec3 center_b, float radius_b, Contact& contact) {
+    glm::vec3 offset = center_b - center_a;
+    float distance2 = glm::dot(offset, offset);
+    float radii = radius_a + radius_b;
+    if (distance2 > radii * radii)
+        return false;
+
+    float distance = std::sqrt(distance2);
+    contact.normal = distance > epsilon ? offset / distance : glm::vec3(0.f, 1.f, 0.f);
+    contact.depth = radii - distance;
+    return true;
+}
+
+// Tests a sphere against a box
+static bool collideSphereBox(glm::vec3 center, float radius, const Collider& box, Contact& contact) {
+    glm::vec3 offset = center - box.center;
+    glm::vec3 local(glm::dot(offset, box.axes[0]), glm::dot(offset, box.axes[1]), glm::dot(offset, box.axes[2]));
+    glm::vec3 clamped = glm::clamp(local, -box.half_extents, box.half_extents);
+
+    if (clamped != local) {
+        glm::vec3 closest = box.center + box.axes[0] * clamped.x + box.axes[1] * clamped.y + box.axes[2] * clamped.z;
+        glm::vec3 to_box = closest - center;
+        float distance2 = glm::dot(to_box, to_box);
+        if (distance2 > radius * radius)
+            return false;
+        float distance = std::sqrt(distance2);
+        contact.normal = distance > epsilon ? to_box / distance : glm::vec3(0.f, 1.f, 0.f);
+        contact.depth = radius - distance;
+        return true;
+    }
+
+    // The center is inside the box, push it out through the nearest face
+    glm::vec3 face_distance = box.half_extents - glm::abs(local);
+    int axis = (face_distance.x <= face_distance.y && face_distance.x <= face_distance.z) ? 0 : (face_distance.y <= face_distance.z ? 1 : 2);
+    contact.normal = box.axes[axis] * (local[axis] > 0.f ? -1.f : 1.f);
+    contact.depth = radius + face_distance[axis];
+    return true;
+}
+
+// Gets the point of a segment closest to a box by alternating between the two closest points
+static glm::vec3 closestOnSegmentToBox(glm::vec3 p, glm::vec3 q, const Collider& box) {
+    glm::vec3 point = closestOnSegment(p, q, box.center);
+    for (int i = 0; i < 3; i++) {
+        glm::vec3 offset = point - box.center;
+        glm::vec3 local(glm::dot(offset, box.axes[0]), glm::dot(offset, box.axes[1]), glm::dot(offset, box.axes[2]));
+        local = glm::clamp(local, -box.half_extents, box.half_extents);
+        glm::vec3 on_box = box.center + box.axes[0] * local.x + box.axes[1] * local.y + box.axes[2] * local.z;
+        point = closestOnSegment(p, q, on_box);
+    }
+    return point;
+}
+
+// Tests two boxes with the separating axis test, the contact normal is the axis they overlap the least along
+static bool collideBoxes(const Collider& a, const Collider& b, Contact& contact) {
+    glm::vec3 offset = b.center - a.center;
+    float min_overlap = FLT_MAX;
+
+    // The face axes of both boxes then the cross products of each pair of their edges
+    glm::vec3 axes[15];
+    for (int i = 0; i < 3; i++) {
+        axes[i] = a.axes[i];
+        axes[3 + i] = b.axes[i];
+        for (int j = 0; j < 3; j++)
+            axes[6 + i * 3 + j] = glm::cross(a.axes[i], b.axes[j]);
+    }
+
+    for (int i = 0; i < 15; i++) {
+        glm::vec3 axis = axes[i];
+        float length = glm::length(axis);
+        // Parallel edges give no axis, the face axes cover that case
+        if (length < epsilon)
+            continue;
+        axis /= length;
+
+        float radius_a = a.half_extents.x * std::abs(glm::dot(a.axes[0], axis)) +
+            a.half_extents.y * std::abs(glm::dot(a.axes[1], axis)) + a.half_extents.z * std::abs(glm::dot(a.axes[2], axis));
+        float radius_b = b.half_extents.x * std::abs(glm::dot(b.axes[0], axis)) +
+            b.half_extents.y * std::abs(glm::dot(b.axes[1], axis)) + b.half_extents.z * std::abs(glm::dot(b.axes[2], axis));
+        float distance = glm::dot(offset, axis);
+        float overlap = radius_a + radius_b - std::abs(distance);
+        if (overlap < 0.f)
+            return false;
+        if (overlap < min_overlap) {
+            min_overlap = overlap;
+            contact.normal = distance < 0.f ? -axis : axis;
+        }
+    }
+    contact.depth = min_overlap;
+    return true;
+}
+
+// Tests two colliders for overlap, filling contact's normal and depth if they do
+bool collide(const Collider& a, const Collider& b, Contact& contact) {
+    // Each pair of shapes is handled once, with the simpler shape first
+    if (a.shape > b.shape) {
+        if (!collide(b, a, contact))
+            return false;
+        contact.normal = -contact.normal;
+        return true;
+    }
+
+    glm::vec3 point_a, point_b;
+    switch (a.shape * 3 + b.shape) {
+        case COLLIDER_SPHERE * 3 + COLLIDER_SPHERE:
+            return collideSpheres(a.center, a.radius, b.center, b.radius, contact);
+
+        case COLLIDER_SPHERE * 3 + COLLIDER_CAPSULE:
+            point_b = closestOnSegment(b.getStart(), b.getEnd(), a.center);
+            return collideSpheres(a.center, a.radius, point_b, b.radius, contact);
+
+        case COLLIDER_SPHERE * 3 + COLLIDER_BOX:
+            return collideSphereBox(a.center, a.radius, b, contact);
+
+        case COLLIDER_CAPSULE * 3 + COLLIDER_CAPSULE:
+            closestBetweenSegments(a.getStart(), a.getEnd(), b.getStart(), b.getEnd(), point_a, point_b);
+            return collideSpheres(point_a, a.radius, point_b, b.radius, contact);
+
+        case COLLIDER_CAPSULE * 3 + COLLIDER_BOX:
+            point_a = closestOnSegmentToBox(a.getStart(), a.getEnd(), b);
+            return collideSphereBox(point_a, a.radius, b, contact);
+
+        default:
+            return collideBoxes(a, b, contact);
+    }
+}
+
+/* SWEPT TESTS */
+
+// Gets when a ray from origin along displacement first enters a sphere, a ray starting inside does not hit it
+static bool raySphere(glm::vec3 origin, glm::vec3 displacement, glm::vec3 center, float radius, float& time, glm::vec3& normal) {
+    glm::vec3 offset = origin - center;
+    float b = glm::dot(offset, displacement);
+    float c = glm::dot(offset, offset) - radius * radius;
+    // Starting inside or moving away
+    if (c <= 0.f || b >= 0.f)
+        return false;
+
+    float a = glm::dot(displacement, displacement);
+    float discriminant = b * b - a * c;
+    if (discriminant < 0.f)
+        return false;
+    time = (-b - std::sqrt(discriminant)) / a;
+    if (time > 1.f)
+        return false;
+    normal = (offset + displacement * time) / radius;
+    return true;
+}
+
+// Gets when a ray first enters a capsule, testing the cylinder around the segment then the spheres at its ends
+static bool rayCapsule(glm::vec3 origin, glm::vec3 displacement, glm::vec3 p, glm::vec3 q, float radius, float& time, glm::vec3& normal) {
+    glm::vec3 closest = closestOnSegment(p, q, origin);
+    if (glm::dot(origin - closest, origin - closest) <= radius * radius)
+        return false;
+
+    bool hit = false;
+    time = FLT_MAX;
+    glm::vec3 segment = q - p;
+    float length = glm::length(segment);
+    if (length > epsilon) {
+        // Remove the parts along the segment to test against an infinite cylinder
+        glm::vec3 axis = segment / length;
+        glm::vec3 offset = origin - p;
+        float offset_along = glm::dot(offset, axis);
+        float displacement_along = glm::dot(displacement, axis);
+        glm::vec3 radial_offset = offset - axis * offset_along;
+        glm::vec3 radial_displacement = displacement - axis * displacement_along;
+
+        float a = glm::dot(radial_displacement, radial_displacement);
+        float b = glm::dot(radial_offset, radial_displacement);
+        float c = glm::dot(radial_offset, radial_offset) - radius * radius;
+        float discriminant = b * b - a * c;
+        if (a > epsilon && c > 0.f && b < 0.f && discriminant >= 0.f) {
+            float t = (-b - std::sqrt(discriminant)) / a;
+            float along = offset_along + displacement_along * t;
+            if (t <= 1.f && along >= 0.f && along <= length) {
+                hit = true;
+                time = t;
+                normal = (radial_offset + radial_displacement * t) / radius;
+            }
+        }
+    }
+
+    float end_time;
+    glm::vec3 end_normal;
+    if (raySphere(origin, displacement, p, radius, end_time, end_normal) && end_time < time) {
+        hit = true;
+        time = end_time;
+        normal = end_normal;
+    }
+    if (raySphere(origin, displacement, q, radius, end_time, end_normal) && end_time < time) {
+        hit = true;
+        time = end_time;
+        normal = end_normal;
+    }
+    return hit;
+}
+
+// Gets when a ray first enters a box grown by a margin, which is conservative around the grown box's edges and corners
+static bool rayBox(glm::vec3 origin, glm::vec3 displacement, const Collider& box, float margin, float& time, glm::vec3& normal) {
+    glm::vec3 offset = origin - box.center;
+    glm::vec3 extents = box.half_extents + glm::vec3(margin);
+    float enter = 0.f, exit = 1.f;
+    int enter_axis = -1;
+    float enter_sign = 0.f;
+
+    for (int i = 0; i < 3; i++) {
+        float local_origin = glm::dot(offset, box.axes[i]);
+        float local_displacement = glm::dot(displacement, box.axes[i]);
+        if (std::abs(local_displacement) < epsilon) {
+            if (std::abs(local_origin) > extents[i])
+                return false;
+            continue;
+        }
+
+        float t1 = (-extents[i] - local_origin) / local_displacement;
+        float t2 = (extents[i] - local_origin) / local_displacement;
+        if (t1 > t2)
+            std::swap(t1, t2);
+        if (t1 > enter) {
+            enter = t1;
+            enter_axis = i;
+            enter_sign = local_displacement > 0.f ? -1.f : 1.f;
+        }
+        exit = std::min(exit, t2);
+        if (enter > exit)
+            return false;
+    }
+
+    // No entering face means the ray started inside
+    if (enter_axis < 0)
+        return false;
+    time = enter;
+    normal = box.axes[enter_axis] * enter_sign;
+    return true;
+}
+
+// Sweeps a sphere along a displacement against a collider, a sphere starting inside it does not hit it
+bool sweepSphere(glm::vec3 center, float radius, glm::vec3 displacement, const Collider& target, float& time, glm::vec3& normal) {
+    switch (target.shape) {
+        case COLLIDER_SPHERE:
+            return raySphere(center, displacement, target.center, target.radius + radius, time, normal);
+        case COLLIDER_CAPSULE:
+            return rayCapsule(center, displacement, target.getStart(), target.getEnd(), target.radius + radius, time, normal);
+        default:
+            return rayBox(center, displacement, target, radius, time, normal);
+    }
+}
+
+/* WORLD */
+
+// Hashes the coordinates of a grid cell
+static inline uint32_t hashCell(glm::ivec3 cell) {
+    return ((uint32_t) cell.x * 73856093u) ^ ((uint32_t) cell.y * 19349663u) ^ ((uint32_t) cell.z * 83492791u);
+}
+
+// Packs the ids of a pair of bodies, the lower id first
+static inline uint64_t pairKey(uint32_t a, uint32_t b) {
+    return ((uint64_t) std::min(a, b) << 32) | std::max(a, b);
+}
+
+CollisionWorld::CollisionWorld(float cell_size): cell_size(cell_size), pairs_tested(0) {}
+
+// Adds a body that fits a shape to the local bounds of a mesh, returns its index
+uint32_t CollisionWorld::addBody(ColliderShape shape, const AABB& local_bounds, uint32_t user_data) {
+    shapes.push_back(shape);
+    this->local_bounds.push_back(local_bounds);
+    this->user_data.push_back(user_data);
+    colliders.push_back(makeCollider(shape, local_bounds, glm::mat4(1.f)));
+    bounds.push_back(colliders.back().getBounds());
+    return size() - 1;
+}
+
+// Buckets every body into the cells its bounds cover
+void CollisionWorld::buildGrid(ThreadPool& pool) {
+    uint32_t count = size();
+    std::vector<uint32_t> entry_offsets(count + 1);
+
+    pool.parallelFor(count, parallel_grain * 16, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+            bounds[i] = colliders[i].getBounds();
+    });
+
+    // Count the cells of each body to know where its entries go
+    entry_offsets[0] = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        glm::ivec3 cells = getCell(bounds[i].max) - getCell(bounds[i].min) + 1;
+        entry_offsets[i + 1] = entry_offsets[i] + cells.x * cells.y * cells.z;
+    }
+
+    cell_entries.resize(entry_offsets[count]);
+    pool.parallelFor(count, parallel_grain * 16, [this, &entry_offsets](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            glm::ivec3 low = getCell(bounds[i].min), high = getCell(bounds[i].max);
+            uint64_t* entry = &cell_entries[entry_offsets[i]];
+            for (int x = low.x; x <= high.x; x++)
+                for (int y = low.y; y <= high.y; y++)
+                    for (int z = low.z; z <= high.z; z++)
+                        *entry++ = ((uint64_t) hashCell(glm::ivec3(x, y, z)) << 32) | i;
+        }
+    });
+
+    // Cells that hash the same share a bucket, a body in several of them is only kept once
+    std::sort(cell_entries.begin(), cell_entries.end());
+    cell_entries.erase(std::unique(cell_entries.begin(), cell_entries.end()), cell_entries.end());
+
+    // Only cells holding more than one body can have pairs
+    cell_starts.clear();
+    for (size_t start = 0; start < cell_entries.size();) {
+        size_t end = start + 1;
+        while (end < cell_entries.size() && (cell_entries[end] >> 32) == (cell_entries[start] >> 32))
+            end++;
+        if (end - start > 1) {
+            cell_starts.push_back((uint32_t) start);
+            cell_starts.push_back((uint32_t) end);
+        }
+        start = end;
+    }
+}
+
+// Runs the narrowphase on every body pair of a range of cells
+void CollisionWorld::testCells(size_t begin, size_t end, std::vector<Contact>& found, long long& tested) {
+    for (size_t cell = begin; cell < end; cell++) {
+        uint32_t start = cell_starts[cell * 2], stop = cell_starts[cell * 2 + 1];
+        uint32_t hash = (uint32_t) (cell_entries[start] >> 32);
+
+        for (uint32_t i = start; i < stop; i++) {
+            uint32_t a = (uint32_t) cell_entries[i];
+            for (uint32_t j = i + 1; j < stop; j++) {
+                uint32_t b = (uint32_t) cell_entries[j];
+                if (!bounds[a].overlaps(bounds[b]))
+                    continue;
+
+                // Pairs sharing several cells are only tested in the cell holding the low corner of their overlap
+                glm::vec3 overlap_min = glm::max(bounds[a].min, bounds[b].min);
+                if (hashCell(getCell(overlap_min)) != hash)
+                    continue;
+
+                tested++;
+                Contact contact;
+                if (collide(colliders[a], colliders[b], contact)) {
+                    contact.a = a;
+                    contact.b = b;
+                    contact.began = false;
+                    found.push_back(contact);
+                }
+            }
+        }
+    }
+}
+
+// Finds every pair of touching bodies, testing the cells of the grid in parallel
+void CollisionWorld::findContacts(ThreadPool& pool) {
+    PROFILE_SCOPE("Find contacts");
+    buildGrid(pool);
+
+    // Each chunk gathers its contacts on its own and adds them to the list once it is done
+    std::mutex contacts_mutex;
+    contacts.clear();
+    pairs_tested = 0;
+    pool.parallelFor(cell_starts.size() / 2, parallel_grain, [this, &contacts_mutex](size_t begin, size_t end) {
+        std::vector<Contact> found;
+        long long tested = 0;
+        testCells(begin, end, found, tested);
+
+        std::lock_guard<std::mutex> lock(contacts_mutex);
+        contacts.insert(contacts.end(), found.begin(), found.end());
+        pairs_tested += tested;
+    });
+
+    finishContacts();
+}
+
+// Same as findContacts but tests every pair of bodies, for comparison
+void CollisionWorld::findContactsBruteForce() {
+    contacts.clear();
+    pairs_tested = 0;
+    for (uint32_t i = 0; i < size(); i++)
+        bounds[i] = colliders[i].getBounds();
+
+    for (uint32_t a = 0; a < size(); a++) {
+        for (uint32_t b = a + 1; b < size(); b++) {
+            if (!bounds[a].overlaps(bounds[b]))
+                continue;
+            pairs_tested++;
+            Contact contact;
+            if (collide(colliders[a], colliders[b], contact)) {
+                contact.a = a;
+                contact.b = b;
+                contact.began = false;
+                contacts.push_back(contact);
+            }
+        }
+    }
+
+    finishContacts();
+}
+
+// Sorts the found contacts and flags the ones that were not touching on the previous call
+void CollisionWorld::finishContacts() {
+    // Threads finish in any order, sorting keeps the results the same from run to run
+    std::sort(contacts.begin(), contacts.end(), [](const Contact& x, const Contact& y) {
+        return x.a < y.a || (x.a == y.a && x.b < y.b);
+    });
+
+    std::vector<uint64_t> pairs(contacts.size());
+    for (size_t i = 0; i < contacts.size(); i++) {
+        pairs[i] = pairKey(contacts[i].a, contacts[i].b);
+        contacts[i].began = !std::binary_search(previous_pairs.begin(), previous_pairs.end(), pairs[i]);
+    }
+    previous_pairs.swap(pairs);
+}
+
+// Lists the bodies whose bounds as of the last findContacts overlap a box, once each
+void CollisionWorld::gatherBodies(const AABB& box, std::vector<uint32_t>& found) {
+    found.clear();
+    glm::ivec3 low = getCell(box.min), high = getCell(box.max);
+    glm::ivec3 cells = high - low + 1;
+
+    if (cells.x * cells.y * cells.z > max_query_cells) {
+        for (uint32_t i = 0; i < size(); i++)
+            if (bounds[i].overlaps(box))
+                found.push_back(i);
+        return;
+    }
+
+    for (int x = low.x; x <= high.x; x++) {
+        for (int y = low.y; y <= high.y; y++) {
+            for (int z = low.z; z <= high.z; z++) {
+                uint64_t key = (uint64_t) hashCell(glm::ivec3(x, y, z)) << 32;
+                auto entry = std::lower_bound(cell_entries.begin(), cell_entries.end(), key);
+                for (; entry != cell_entries.end() && (*entry >> 32) == (key >> 32); ++entry) {
+                    uint32_t body = (uint32_t) *entry;
+                    if (bounds[body].overlaps(box))
+                        found.push_back(body);
+                }
+            }
+        }
+    }
+    std::sort(found.begin(), found.end());
+    found.erase(std::unique(found.begin(), found.end()), found.end());
+}
+
+// Finds the bodies touching one body, whose collider may have changed since the last findContacts
+void CollisionWorld::findBodyContacts(uint32_t body, std::vector<Contact>& found) {
+    PROFILE_SCOPE("Find body contacts");
+    found.clear();
+    std::vector<uint32_t> candidates;
+    gatherBodies(colliders[body].getBounds(), candidates);
+    for (uint32_t other : candidates) {
+        Contact contact;
+        if (other != body && collide(colliders[body], colliders[other], contact)) {
+            contact.a = body;
+            contact.b = other;
+            contact.began = false;
+            found.push_back(contact);
+        }
+    }
+}
+
+// Sweeps a sphere through the world, returns false if it reaches the end of its displacement without hitting a body
+bool CollisionWorld::sweepSphere(glm::vec3 center, float radius, glm::vec3 displacement, uint32_t ignore_body, SweepHit& hit) {
+    PROFILE_SCOPE("Sweep sphere");
+    AABB swept(glm::min(center, center + displacement) - radius, glm::max(center, center + displacement) + radius);
+    std::vector<uint32_t> candidates;
+    gatherBodies(swept, candidates);
+
+    bool found = false;
+    hit.time = FLT_MAX;
+    for (uint32_t body : candidates) {
+        float time;
+        glm::vec3 normal;
+        if (body != ignore_body && ::sweepSphere(center, radius, displacement, colliders[body], time, normal) && time < hit.time) {
+            found = true;
+            hit.body = body;
+            hit.time = time;
+            hit.normal = normal;
+        }
+    }
+    return found;
+}
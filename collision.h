@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common.h"
+#include "bounds.h"
+#include "thread_pool.h"
+
+// Shapes a collider can take, in the order the narrowphase dispatches pairs in
+enum ColliderShape : uint8_t {
+    COLLIDER_SPHERE,
+    COLLIDER_CAPSULE,
+    COLLIDER_BOX
+};
+
+// A convex shape in world space
+struct Collider {
+    ColliderShape shape;
+    // Center of the sphere or box, or midpoint of the capsule's segment
+    glm::vec3 center;
+    // Unit axes of the box, the capsule's segment runs along the first one
+    glm::vec3 axes[3];
+    // Half sizes of the box along its axes, the capsule only uses x as the half length of its segment
+    glm::vec3 half_extents;
+    // Radius of the sphere or capsule
+    float radius;
+
+    // Gets the endpoints of the capsule's segment
+    inline glm::vec3 getStart() const {
+        return center - axes[0] * half_extents.x;
+    }
+
+    inline glm::vec3 getEnd() const {
+        return center + axes[0] * half_extents.x;
+    }
+
+    // Gets the world space box enclosing the shape
+    AABB getBounds() const;
+};
+
+// Fits a collider of a shape to the local bounds of a mesh placed by a world matrix
+Collider makeCollider(ColliderShape shape, const AABB& local_bounds, const glm::mat4& world);
+
+// Two bodies touching, the normal points from a to b and depth is how far they overlap along it
+struct Contact {
+    uint32_t a;
+    uint32_t b;
+    glm::vec3 normal;
+    float depth;
+    // Whether the bodies were not touching on the previous call to findContacts
+    bool began;
+};
+
+// The first thing a moving sphere hits, time is the fraction of the displacement travelled before touching
+struct SweepHit {
+    uint32_t body;
+    float time;
+    glm::vec3 normal;
+};
+
+// Tests two colliders for overlap, filling contact's normal and depth if they do
+bool collide(const Collider& a, const Collider& b, Contact& contact);
+
+// Sweeps a sphere along a displacement against a collider, a sphere starting inside it does not hit it
+bool sweepSphere(glm::vec3 center, float radius, glm::vec3 displacement, const Collider& target, float& time, glm::vec3& normal);
+
+// Set of colliders, found touching each other through a spatial hash of uniform grid cells
+class CollisionWorld {
+public:
+    // Per body attributes, body i's attributes are at index i of each array
+    std::vector<Collider> colliders;
+    std::vector<ColliderShape> shapes;
+    std::vector<AABB> local_bounds;
+    std::vector<uint32_t> user_data;
+    // World bounds of the bodies as of the last findContacts
+    std::vector<AABB> bounds;
+
+    // Contacts found by the last findContacts, sorted by body
+    std::vector<Contact> contacts;
+
+    // Size of the grid cells, best set to about twice the size of a typical body
+    float cell_size;
+
+    CollisionWorld(float cell_size = 8.f);
+
+    // Adds a body that fits a shape to the local bounds of a mesh, returns its index
+    uint32_t addBody(ColliderShape shape, const AABB& local_bounds, uint32_t user_data);
+
+    // Places a body, refitting its collider to its local bounds under the matrix
+    inline void setTransform(uint32_t body, const glm::mat4& world) {
+        colliders[body] = makeCollider(shapes[body], local_bounds[body], world);
+    }
+
+    inline uint32_t size() {
+        return (uint32_t) colliders.size();
+    }
+
+    // Finds every pair of touching bodies, testing the cells of the grid in parallel
+    void findContacts(ThreadPool& pool);
+
+    // Same as findContacts but tests every pair of bodies, for comparison
+    void findContactsBruteForce();
+
+    // Finds the bodies touching one body, whose collider may have changed since the last findContacts
+    void findBodyContacts(uint32_t body, std::vector<Contact>& found);
+
+    // Sweeps a sphere through the world, returns false if it reaches the end of its displacement without hitting a body
+    bool sweepSphere(glm::vec3 center, float radius, glm::vec3 displacement, uint32_t ignore_body, SweepHit& hit);
+
+    // Number of pairs given to the narrowphase by the last findContacts
+    inline long long getPairsTested() {
+        return pairs_tested;
+    }
+
+private:
+    // Grid cell hash and body of every cell a body's bounds cover, sorted so each cell's bodies are adjacent
+    std::vector<uint64_t> cell_entries;
+    // Start of each cell's run of entries, with the end of the last run appended
+    std::vector<uint32_t> cell_starts;
+    // Pairs touching as of the previous call, to tell which contacts began
+    std::vector<uint64_t> previous_pairs;
+    long long pairs_tested;
+
+    // Gets the cell a point is in
+    inline glm::ivec3 getCell(glm::vec3 point) const {
+        return glm::ivec3(glm::floor(point / cell_size));
+    }
+
+    // Buckets every body into the cells its bounds cover
+    void buildGrid(ThreadPool& pool);
+
+    // Lists the bodies whose bounds as of the last findContacts overlap a box, once each
+    void gatherBodies(const AABB& box, std::vector<uint32_t>& found);
+
+    // Runs the narrowphase on every body pair of a range of cells
+    void testCells(size_t begin, size_t end, std::vector<Contact>& found, long long& tested);
+
+    // Sorts the found contacts and flags the ones that were not touching on the previous call
+    void finishContacts();
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "common.h"
+#include "shader.h"
+
+// Draws the depth of the opaque surfaces before they are shaded, so the shading pass runs its fragment shader once per pixel,
+// on the nearest surface, instead of for every surface drawn over it
+// The depth is drawn from the meshes' position only streams, and the shading pass tests against it for equality without writing it
+struct DepthPrepass {
+    ShadowShader shader;
+    // Places the instances like instanced.vert
+    ShadowShader instanced_shader;
+
+    DepthPrepass():
+        shader("Shaders/shadow.vert", "Shaders/shadow.frag"),
+        instanced_shader("Shaders/instanced.vert", "Shaders/shadow.frag") {}
+
+    // Turns color writes off while the depth is drawn
+    inline void beginDepth() {
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    }
+
+    // Turns color writes back on and only lets through the fragments at the depth drawn, which is left as it is
+    inline void beginShading() {
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        glDepthFunc(GL_EQUAL);
+        glDepthMask(GL_FALSE);
+    }
+
+    // Goes back to the usual depth test
+    inline void endShading() {
+        glDepthFunc(GL_LESS);
+        glDepthMask(GL_TRUE);
+    }
+};
@@ -0,0 +1,223 @@
+#include "entity.h"
+
+#include <algorithm>
+
+#include "profiler.h"
+
+// Number of entities below which a pass over the arrays is not split between threads
+static const size_t parallel_grain = 2048;
+
+// Registers a mesh that entities can be drawn with, returns its id
+uint32_t EntityStore::addMesh(VertexAttribs& mesh) {
+    meshes.push_back(&mesh);
+    return (uint32_t) meshes.size() - 1;
+}
+
+// Registers a set of textures that entities can be drawn with, returns its id
+uint32_t EntityStore::addMaterial(std::vector<Texture>& textures) {
+    materials.push_back({&textures});
+    return (uint32_t) materials.size() - 1;
+}
+
+// Grows the arrays to hold count entities, so creating that many allocates nothing
+void EntityStore::reserve(size_t count) {
+    positions.reserve(count);
+    rotations.reserve(count);
+    scales.reserve(count);
+    world_matrices.reserve(count);
+    bounds.reserve(count);
+    mesh_ids.reserve(count);
+    material_ids.reserve(count);
+    flags.reserve(count);
+    proxies.reserve(count);
+    index_to_slot.reserve(count);
+    slot_to_index.reserve(count);
+    slot_generations.reserve(count);
+}
+
+// Adds an entity to the store
+EntityHandle EntityStore::create(uint32_t mesh_id, uint32_t material_id, glm::vec3 pos, glm::vec3 rot, glm::vec3 scale) {
+    uint32_t index = size();
+    uint32_t slot;
+    if (!free_slots.empty()) {
+        slot = free_slots.back();
+        free_slots.pop_back();
+    }
+    else {
+        slot = (uint32_t) slot_to_index.size();
+        slot_to_index.push_back(0);
+        slot_generations.push_back(0);
+    }
+    slot_to_index[slot] = index;
+    index_to_slot.push_back(slot);
+
+    positions.push_back(pos);
+    rotations.push_back(rot);
+    scales.push_back(scale);
+    world_matrices.push_back(glm::mat4(1.f));
+    bounds.push_back(AABB());
+    mesh_ids.push_back(mesh_id);
+    material_ids.push_back(material_id);
+    flags.push_back(ENTITY_DIRTY);
+    proxies.push_back(NULL_NODE);
+
+    return {slot, slot_generations[slot]};
+}
+
+// Removes an entity by moving the last entity into its place, invalidating indices but not handles
+void EntityStore::destroy(EntityHandle handle) {
+    if (!isValid(handle))
+        return;
+
+    uint32_t index = slot_to_index[handle.slot];
+    uint32_t last = size() - 1;
+    if (proxies[index] != NULL_NODE)
+        tree.destroyProxy(proxies[index]);
+
+    if (index != last) {
+        positions[index] = positions[last];
+        rotations[index] = rotations[last];
+        scales[index] = scales[last];
+        world_matrices[index] = world_matrices[last];
+        bounds[index] = bounds[last];
+        mesh_ids[index] = mesh_ids[last];
+        material_ids[index] = material_ids[last];
+        flags[index] = flags[last];
+        proxies[index] = proxies[last];
+        index_to_slot[index] = index_to_slot[last];
+        slot_to_index[index_to_slot[index]] = index;
+    }
+
+    positions.pop_back();
+    rotations.pop_back();
+    scales.pop_back();
+    world_matrices.pop_back();
+    bounds.pop_back();
+    mesh_ids.pop_back();
+    material_ids.pop_back();
+    flags.pop_back();
+    proxies.pop_back();
+    index_to_slot.pop_back();
+
+    // Bumping the generation makes every outstanding handle to the slot invalid
+    slot_generations[handle.slot]++;
+    free_slots.push_back(handle.slot);
+}
+
+// Whether a handle still refers to an entity
+bool EntityStore::isValid(EntityHandle handle) {
+    return handle.slot < slot_generations.size() && slot_generations[handle.slot] == handle.generation;
+}
+
+// Recomputes the world matrix and world bounds of every entity whose transform changed, then refits the tree
+void EntityStore::updateTransforms(ThreadPool& pool) {
+    PROFILE_SCOPE("Update transforms");
+    pool.parallelFor(size(), parallel_grain, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            if (!(flags[i] & ENTITY_DIRTY))
+                continue;
+            world_matrices[i] = composeTransform(positions[i], rotations[i], scales[i]);
+            bounds[i] = transformAABB(meshes[mesh_ids[i]]->bounds, world_matrices[i]);
+            flags[i] = (flags[i] & ~ENTITY_DIRTY) | ENTITY_MOVED;
+        }
+    });
+
+    // Only entities that left their enlarged boxes change the tree, the rest are skipped by moveProxy
+    for (uint32_t i = 0; i < size(); i++) {
+        if (!(flags[i] & ENTITY_MOVED))
+            continue;
+        if (proxies[i] == NULL_NODE)
+            proxies[i] = tree.createProxy(bounds[i], index_to_slot[i]);
+        else {
+            glm::vec3 displacement = bounds[i].getCenter() - tree.getFatAABB(proxies[i]).getCenter();
+            tree.moveProxy(proxies[i], bounds[i], displacement);
+        }
+        flags[i] &= ~ENTITY_MOVED;
+    }
+}
+
+// Flags the entities that may be seen through the frustum and lists their indices in visible, using the tree
+void EntityStore::cull(const Frustum& frustum, std::vector<uint32_t>& visible) {
+    PROFILE_SCOPE("Cull");
+    for (uint32_t& entity_flags : flags)
+        entity_flags &= ~ENTITY_VISIBLE;
+
+    // The tree tests enlarged boxes, so the entities it finds are tested again against their exact bounds
+    visible.clear();
+    tree.queryFrustum(frustum, [this, &frustum, &visible](uint32_t slot) {
+        uint32_t index = slot_to_index[slot];
+        if (!(flags[index] & ENTITY_HIDDEN) && frustum.intersects(bounds[index])) {
+            flags[index] |= ENTITY_VISIBLE;
+            visible.push_back(index);
+        }
+    });
+}
+
+// Same as cull but tests every entity instead of walking the tree, for comparison
+void EntityStore::cullLinear(const Frustum& frustum, ThreadPool& pool, std::vector<uint32_t>& visible) {
+    // Flag the visible entities in parallel, then gather them in order in a single pass
+    pool.parallelFor(size(), parallel_grain, [this, &frustum](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            if (!(flags[i] & ENTITY_HIDDEN) && frustum.intersects(bounds[i]))
+                flags[i] |= ENTITY_VISIBLE;
+            else
+                flags[i] &= ~ENTITY_VISIBLE;
+        }
+    });
+
+    visible.clear();
+    for (uint32_t i = 0; i < size(); i++)
+        if (flags[i] & ENTITY_VISIBLE)
+            visible.push_back(i);
+}
+
+// Lists the entities that are not hidden and may be inside a frustum, leaving the flags of the last cull as they are
+void EntityStore::queryFrustum(const Frustum& frustum, std::vector<uint32_t>& found) {
+    found.clear();
+    tree.queryFrustum(frustum, [this, &frustum, &found](uint32_t slot) {
+        uint32_t index = slot_to_index[slot];
+        if (!(flags[index] & ENTITY_HIDDEN) && frustum.intersects(bounds[index]))
+            found.push_back(index);
+    });
+}
+
+// Lists the indices of the entities whose bounds touch a sphere
+void EntityStore::querySphere(glm::vec3 center, float radius, std::vector<uint32_t>& found) {
+    found.clear();
+    tree.querySphere(center, radius, [this, center, radius, &found](uint32_t slot) {
+        uint32_t index = slot_to_index[slot];
+        if (bounds[index].overlaps(center, radius))
+            found.push_back(index);
+    });
+}
+
+// Finds the nearest entity whose bounds a ray hits within max_distance, returns false if there is none
+bool EntityStore::rayCast(glm::vec3 origin, glm::vec3 direction, float max_distance, uint32_t& hit_index, float& hit_distance) {
+    glm::vec3 inv_direction = 1.f / direction;
+    bool hit = false;
+    tree.rayCast(origin, direction, max_distance, [&](uint32_t slot, float max) {
+        uint32_t index = slot_to_index[slot];
+        float enter;
+        if (!bounds[index].intersectRay(origin, inv_direction, max, enter))
+            return max;
+        hit = true;
+        hit_index = index;
+        hit_distance = enter;
+        return enter;
+    });
+    return hit;
+}
+
+// Creates a draw packet for each listed entity, sorted so that entities sharing materials and meshes are adjacent
+void EntityStore::buildDrawPackets(const std::vector<uint32_t>& visible, std::vector<DrawPacket>& packets) {
+    PROFILE_SCOPE("Build draw packets");
+    packets.resize(visible.size());
+    for (size_t i = 0; i < visible.size(); i++) {
+        uint32_t entity = visible[i];
+        packets[i].key = ((uint64_t) material_ids[entity] << 32) | mesh_ids[entity];
+        packets[i].entity = entity;
+    }
+    std::sort(packets.begin(), packets.end(), [](const DrawPacket& a, const DrawPacket& b) {
+        return a.key < b.key || (a.key == b.key && a.entity < b.entity);
+    });
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common.h"
+#include "aabb_tree.h"
+#include "bounds.h"
+#include "model.h"
+#include "texture.h"
+#include "thread_pool.h"
+
+// Bit flags describing the state of an entity
+enum EntityFlags : uint32_t {
+    ENTITY_DIRTY = 1 << 0,      // Transform changed since the world matrix and bounds were last updated
+    ENTITY_VISIBLE = 1 << 1,    // Passed the last culling pass
+    ENTITY_HIDDEN = 1 << 2,     // Skipped by culling and never drawn
+    ENTITY_MOVED = 1 << 3       // World bounds changed since the entity's proxy in the tree was last updated
+};
+
+// Stable reference to an entity that stays valid while other entities are created and destroyed
+struct EntityHandle {
+    uint32_t slot;
+    uint32_t generation;
+};
+
+// The textures an entity is drawn with, shared by every entity using the material
+struct Material {
+    std::vector<Texture>* textures;
+};
+
+// One draw of an entity, sorted by key so draws sharing a material and mesh are submitted together
+struct DrawPacket {
+    uint64_t key;
+    uint32_t entity;
+};
+
+// Builds the same transformation matrix as Model3D::getTransformationMatrix without going through glm::rotate
+inline glm::mat4 composeTransform(glm::vec3 pos, glm::vec3 rot, glm::vec3 scale) {
+    float sx = std::sin(glm::radians(rot.x)), cx = std::cos(glm::radians(rot.x));
+    float sy = std::sin(glm::radians(rot.y)), cy = std::cos(glm::radians(rot.y));
+    float sz = std::sin(glm::radians(rot.z)), cz = std::cos(glm::radians(rot.z));
+
+    // Columns of scale * rotate x * rotate y * rotate z
+    glm::mat4 matrix;
+    matrix[0] = glm::vec4(scale.x * cy * cz, scale.y * (cx * sz + sx * sy * cz), scale.z * (sx * sz - cx * sy * cz), 0.f);
+    matrix[1] = glm::vec4(-scale.x * cy * sz, scale.y * (cx * cz - sx * sy * sz), scale.z * (sx * cz + cx * sy * sz), 0.f);
+    matrix[2] = glm::vec4(scale.x * sy, -scale.y * sx * cy, scale.z * cx * cy, 0.f);
+    matrix[3] = glm::vec4(pos, 1.f);
+    return matrix;
+}
+
+// Stores every entity of the scene as parallel arrays, entity i's attributes are at index i of each array
+class EntityStore {
+public:
+    // Per entity attributes, rotations are XYZ euler angles in degrees like Model3D
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> rotations;
+    std::vector<glm::vec3> scales;
+    std::vector<glm::mat4> world_matrices;
+    std::vector<AABB> bounds;
+    std::vector<uint32_t> mesh_ids;
+    std::vector<uint32_t> material_ids;
+    std::vector<uint32_t> flags;
+    // Proxy of each entity in the tree, NULL_NODE until its bounds are first computed
+    std::vector<int> proxies;
+
+    // Hierarchy over the world bounds of the entities, leaves hold the slots of the entities' handles
+    AABBTree tree;
+
+    // Resources referenced by the mesh and material ids, owned elsewhere
+    std::vector<VertexAttribs*> meshes;
+    std::vector<Material> materials;
+
+    // Registers a mesh that entities can be drawn with, returns its id
+    uint32_t addMesh(VertexAttribs& mesh);
+
+    // Registers a set of textures that entities can be drawn with, returns its id
+    uint32_t addMaterial(std::vector<Texture>& textures);
+
+    // Grows the arrays to hold count entities, so creating that many allocates nothing
+    void reserve(size_t count);
+
+    // Adds an entity to the store
+    EntityHandle create(uint32_t mesh_id, uint32_t material_id, glm::vec3 pos, glm::vec3 rot, glm::vec3 scale);
+
+    // Removes an entity by moving the last entity into its place, invalidating indices but not handles
+    void destroy(EntityHandle handle);
+
+    // Whether a handle still refers to an entity
+    bool isValid(EntityHandle handle);
+
+    // Gets the current index of an entity in the arrays
+    inline uint32_t indexOf(EntityHandle handle) {
+        return slot_to_index[handle.slot];
+    }
+
+    // Gets the current index of the entity whose handle uses a slot, such as those stored in the tree
+    inline uint32_t indexOfSlot(uint32_t slot) {
+        return slot_to_index[slot];
+    }
+
+    // Gets the handle of the entity at an index
+    inline EntityHandle handleOf(uint32_t index) {
+        uint32_t slot = index_to_slot[index];
+        return {slot, slot_generations[slot]};
+    }
+
+    inline uint32_t size() {
+        return (uint32_t) positions.size();
+    }
+
+    // Changes the transform of the entity at an index, its world matrix is updated on the next updateTransforms
+    inline void setTransform(uint32_t index, glm::vec3 pos, glm::vec3 rot, glm::vec3 scale) {
+        positions[index] = pos;
+        rotations[index] = rot;
+        scales[index] = scale;
+        flags[index] |= ENTITY_DIRTY;
+    }
+
+    // Moves the entity at an index, its world matrix is updated on the next updateTransforms
+    inline void setPosition(uint32_t index, glm::vec3 pos) {
+        positions[index] = pos;
+        flags[index] |= ENTITY_DIRTY;
+    }
+
+    // Recomputes the world matrix and world bounds of every entity whose transform changed, then refits the tree
+    void updateTransforms(ThreadPool& pool);
+
+    // Flags the entities that may be seen through the frustum and lists their indices in visible, using the tree
+    void cull(const Frustum& frustum, std::vector<uint32_t>& visible);
+
+    // Same as cull but tests every entity instead of walking the tree, for comparison
+    void cullLinear(const Frustum& frustum, ThreadPool& pool, std::vector<uint32_t>& visible);
+
+    // Lists the entities that are not hidden and may be inside a frustum, leaving the flags of the last cull as they are
+    void queryFrustum(const Frustum& frustum, std::vector<uint32_t>& found);
+
+    // Lists the indices of the entities whose bounds touch a sphere
+    void querySphere(glm::vec3 center, float radius, std::vector<uint32_t>& found);
+
+    // Finds the nearest entity whose bounds a ray hits within max_distance, returns false if there is none
+    bool rayCast(glm::vec3 origin, glm::vec3 direction, float max_distance, uint32_t& hit_index, float& hit_distance);
+
+    // Creates a draw packet for each listed entity, sorted so that entities sharing materials and meshes are adjacent
+    void buildDrawPackets(const std::vector<uint32_t>& visible, std::vector<DrawPacket>& packets);
+
+private:
+    // Handles point at slots, which map to the entity's current index
+    std::vector<uint32_t> index_to_slot;
+    std::vector<uint32_t> slot_to_index;
+    std::vector<uint32_t> slot_generations;
+    std::vector<uint32_t> free_slots;
+};
@@ -0,0 +1,67 @@
+#include "gbuffer.h"
+
+#include <iostream>
+
+#include "profiler.h"
+
+GBuffer::GBuffer(int width, int height): width(width), height(height), output_framebuffer(0), blend_enabled(GL_FALSE) {
+    GLint bound_framebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &bound_framebuffer);
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+    // Every pixel is read back at its own position, so nothing is filtered or mipmapped
+    GLuint* textures[3] = {&albedo_spec, &normal_phong, &depth};
+    GLenum internal_formats[3] = {GL_RGBA8, GL_RGB10_A2, GL_DEPTH24_STENCIL8};
+    GLenum formats[3] = {GL_RGBA, GL_RGBA, GL_DEPTH_STENCIL};
+    GLenum types[3] = {GL_UNSIGNED_BYTE, GL_UNSIGNED_INT_2_10_10_10_REV, GL_UNSIGNED_INT_24_8};
+    GLenum attachments[3] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_DEPTH_STENCIL_ATTACHMENT};
+    for (int i = 0; i < 3; i++) {
+        glGenTextures(1, textures[i]);
+        glBindTexture(GL_TEXTURE_2D, *textures[i]);
+        glTexImage2D(GL_TEXTURE_2D, 0, internal_formats[i], width, height, 0, formats[i], types[i], NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, attachments[i], GL_TEXTURE_2D, *textures[i], 0);
+    }
+    GLenum draw_buffers[2] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1};
+    glDrawBuffers(2, draw_buffers);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        std::cout << "The G-buffer is incomplete, deferred shading will draw nothing\n";
+    glBindFramebuffer(GL_FRAMEBUFFER, bound_framebuffer);
+}
+
+// Deconstructor to free the framebuffer and its textures
+GBuffer::~GBuffer() {
+    GLuint textures[3] = {albedo_spec, normal_phong, depth};
+    glDeleteTextures(3, textures);
+    glDeleteFramebuffers(1, &framebuffer);
+}
+
+// Clears the G-buffer and draws into it, remembering the framebuffer the lighting pass draws into
+void GBuffer::beginGeometry() {
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &output_framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+    // The alpha channels hold data rather than coverage, so nothing may be blended into them
+    blend_enabled = glIsEnabled(GL_BLEND);
+    glDisable(GL_BLEND);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+}
+
+// Goes back to the framebuffer bound when the geometry pass began
+void GBuffer::endGeometry() {
+    glBindFramebuffer(GL_FRAMEBUFFER, output_framebuffer);
+    if (blend_enabled)
+        glEnable(GL_BLEND);
+}
+
+// Binds the albedo, normal and depth textures to units 0, 1 and 2
+void GBuffer::bindTextures() {
+    GLuint textures[3] = {albedo_spec, normal_phong, depth};
+    for (int i = 0; i < 3; i++) {
+        glActiveTexture(GL_TEXTURE0 + i);
+        glBindTexture(GL_TEXTURE_2D, textures[i]);
+    }
+}
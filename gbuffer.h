@@ -0,0 +1,50 @@
+#pragma once
+
+#include "common.h"
+#include "shader.h"
+
+// Surfaces of a frame drawn by the deferred path, for one lighting pass over the screen
+// Albedo and specular strength go in RGBA8, the octahedral normal and phong exponent in RGB10_A2, and the depth in its own texture
+class GBuffer {
+public:
+    GLuint framebuffer;
+    GLuint albedo_spec;
+    GLuint normal_phong;
+    GLuint depth;
+    int width, height;
+
+    GBuffer(int width = SCREEN_WT, int height = SCREEN_HT);
+
+    // Deconstructor to free the framebuffer and its textures
+    ~GBuffer();
+
+    // Clears the G-buffer and draws into it, remembering the framebuffer the lighting pass draws into
+    void beginGeometry();
+
+    // Goes back to the framebuffer bound when the geometry pass began
+    void endGeometry();
+
+    // Binds the albedo, normal and depth textures to units 0, 1 and 2
+    void bindTextures();
+
+private:
+    GLint output_framebuffer;
+    GLboolean blend_enabled;
+};
+
+// The G-buffer with the shaders that fill it and the one that lights it, the deferred alternative to the forward lit shaders
+// The geometry shaders take the same calls as the forward ones they stand in for
+struct DeferredRenderer {
+    GBuffer gbuffer;
+    TexLightingShader geometry_shader;
+    InstancedShader instanced_geometry_shader;
+    NormalMapShader normalmap_geometry_shader;
+    DeferredLightingShader lighting_shader;
+
+    DeferredRenderer(int width = SCREEN_WT, int height = SCREEN_HT):
+        gbuffer(width, height),
+        geometry_shader("Shaders/objshader.vert", "Shaders/gbuffer.frag"),
+        instanced_geometry_shader("Shaders/instanced.vert", "Shaders/gbuffer.frag"),
+        normalmap_geometry_shader("Shaders/normalmapped.vert", "Shaders/gbuffer_normalmapped.frag"),
+        lighting_shader("Shaders/fullscreen.vert", "Shaders/deferred_lighting.frag") {}
+};
@@ -0,0 +1,517 @@
+#include "gl_stats.h"
+
+#if GRAPHIX_GL_STATS
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "gl_stats_functions.h"
+
+// Index of each entry point in the counters
+enum GLEntryPoint {
+#define GL_STATS_ENTRY(name) GL_ENTRY_##name,
+    GL_STATS_FUNCTIONS(GL_STATS_ENTRY)
+#undef GL_STATS_ENTRY
+    GL_ENTRY_COUNT
+};
+
+static const char* entry_names[] = {
+#define GL_STATS_NAME(name) #name,
+    GL_STATS_FUNCTIONS(GL_STATS_NAME)
+#undef GL_STATS_NAME
+};
+
+static const char* resource_names[] = {"buffer", "texture", "vertex array", "shader", "program"};
+
+// Calls of the frame being counted and of the last finished frame
+static uint64_t calls[GL_ENTRY_COUNT];
+static uint64_t last_calls[GL_ENTRY_COUNT];
+static uint64_t uploaded_bytes = 0;
+static uint64_t last_uploaded_bytes = 0;
+
+// Live objects of each type by name, with the bytes they hold
+static std::unordered_map<GLuint, uint64_t> live[GL_RESOURCE_TYPE_COUNT];
+// Bytes of each face of every texture, textures with mipmaps hold a third more
+struct TextureSize {
+    uint64_t face_bytes[6];
+    bool mipmapped;
+};
+static std::unordered_map<GLuint, TextureSize> texture_sizes;
+// Shaders attached to each program, a program is sized by the source of its shaders
+static std::unordered_map<GLuint, std::vector<GLuint>> program_shaders;
+
+// Objects bound to each buffer target, and to each texture target of each texture unit
+static std::map<GLenum, GLuint> bound_buffers;
+static std::map<std::pair<GLenum, GLenum>, GLuint> bound_textures;
+static GLenum active_texture = GL_TEXTURE0;
+
+// Messages about objects deleted while not alive, only the first few are kept
+static const size_t max_warnings = 32;
+static std::vector<std::string> warnings;
+static uint64_t warning_count = 0;
+
+// Counts calls to an entry point before passing them on to the function gladLoadGL loaded
+template <int entry, typename Function>
+struct GLWrapper;
+
+template <int entry, typename Result, typename... Args>
+struct GLWrapper<entry, Result (APIENTRYP)(Args...)> {
+    static Result (APIENTRYP real)(Args...);
+
+    static Result APIENTRY call(Args... args) {
+        calls[entry]++;
+        return real(args...);
+    }
+
+    // Points a loaded function at the wrapper, functions the driver does not have are left unloaded
+    static void install(Result (APIENTRYP& function)(Args...)) {
+        real = function;
+        if (function)
+            function = &call;
+    }
+};
+
+template <int entry, typename Result, typename... Args>
+Result (APIENTRYP GLWrapper<entry, Result (APIENTRYP)(Args...)>::real)(Args...) = nullptr;
+
+// Calls an entry point through its counting wrapper
+#define GL_COUNTED(name) GLWrapper<GL_ENTRY_##name, decltype(glad_##name)>::call
+
+/* RESOURCE TRACKING */
+
+// Starts tracking newly made objects
+static void addObjects(GLResourceType type, GLsizei n, const GLuint* names) {
+    for (GLsizei i = 0; i < n; i++)
+        live[type][names[i]] = 0;
+}
+
+// Stops tracking deleted objects, warning about names that were not alive, 0 is silently ignored like GL does
+static void removeObjects(GLResourceType type, GLsizei n, const GLuint* names, const char* function) {
+    for (GLsizei i = 0; i < n; i++) {
+        if (names[i] == 0)
+            continue;
+        if (live[type].erase(names[i]) == 0) {
+            warning_count++;
+            if (warnings.size() < max_warnings)
+                warnings.push_back(std::string(function) + ": " + std::to_string(names[i]) + " is not a live " + resource_names[type]);
+        }
+        if (type == GL_RESOURCE_TEXTURE)
+            texture_sizes.erase(names[i]);
+    }
+}
+
+// Gets the binding target a texture image target belongs to, every cube map face belongs to the cube map
+static GLenum getTextureTarget(GLenum target) {
+    if (target >= GL_TEXTURE_CUBE_MAP_POSITIVE_X && target <= GL_TEXTURE_CUBE_MAP_NEGATIVE_Z)
+        return GL_TEXTURE_CUBE_MAP;
+    return target;
+}
+
+// Gets the bytes a pixel of a format and type takes up
+static uint64_t getPixelBytes(GLenum format, GLenum type) {
+    uint64_t components;
+    switch (format) {
+        case GL_RED: case GL_RED_INTEGER: case GL_DEPTH_COMPONENT: components = 1; break;
+        case GL_RG: case GL_RG_INTEGER: case GL_DEPTH_STENCIL: components = 2; break;
+        case GL_RGB: case GL_BGR: case GL_RGB_INTEGER: components = 3; break;
+        default: components = 4; break;
+    }
+    switch (type) {
+        case GL_UNSIGNED_BYTE: case GL_BYTE: return components;
+        case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT: return components * 2;
+        case GL_UNSIGNED_INT_24_8: return 4;
+        default: return components * 4;
+    }
+}
+
+// Gets the bytes a texel of a sized internal format takes up, for storage allocated without a format and type
+static uint64_t getInternalFormatBytes(GLenum internalformat) {
+    switch (internalformat) {
+        case GL_R8: return 1;
+        case GL_RG8: case GL_R16F: return 2;
+        case GL_RGB8: return 3;
+        case GL_RGBA16F: case GL_RG32F: return 8;
+        case GL_RGB32F: return 12;
+        case GL_RGBA32F: return 16;
+        default: return 4;
+    }
+}
+
+// Recounts the bytes held by a texture
+static void updateTextureBytes(GLuint texture) {
+    auto live_texture = live[GL_RESOURCE_TEXTURE].find(texture);
+    auto size = texture_sizes.find(texture);
+    if (live_texture == live[GL_RESOURCE_TEXTURE].end() || size == texture_sizes.end())
+        return;
+
+    uint64_t bytes = 0;
+    for (uint64_t face_bytes : size->second.face_bytes)
+        bytes += face_bytes;
+    live_texture->second = size->second.mipmapped ? bytes * 4 / 3 : bytes;
+}
+
+static void APIENTRY trackGenBuffers(GLsizei n, GLuint* buffers) {
+    GL_COUNTED(glGenBuffers)(n, buffers);
+    addObjects(GL_RESOURCE_BUFFER, n, buffers);
+}
+
+static void APIENTRY trackDeleteBuffers(GLsizei n, const GLuint* buffers) {
+    removeObjects(GL_RESOURCE_BUFFER, n, buffers, "glDeleteBuffers");
+    GL_COUNTED(glDeleteBuffers)(n, buffers);
+}
+
+static void APIENTRY trackBindBuffer(GLenum target, GLuint buffer) {
+    bound_buffers[target] = buffer;
+    GL_COUNTED(glBindBuffer)(target, buffer);
+}
+
+// Binding to an indexed target also binds to its generic target
+static void APIENTRY trackBindBufferBase(GLenum target, GLuint index, GLuint buffer) {
+    bound_buffers[target] = buffer;
+    GL_COUNTED(glBindBufferBase)(target, index, buffer);
+}
+
+static void APIENTRY trackBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+    auto buffer = live[GL_RESOURCE_BUFFER].find(bound_buffers[target]);
+    if (buffer != live[GL_RESOURCE_BUFFER].end())
+        buffer->second = (uint64_t) size;
+    // Allocating without data uploads nothing
+    if (data)
+        uploaded_bytes += (uint64_t) size;
+    GL_COUNTED(glBufferData)(target, size, data, usage);
+}
+
+static void APIENTRY trackBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) {
+    uploaded_bytes += (uint64_t) size;
+    GL_COUNTED(glBufferSubData)(target, offset, size, data);
+}
+
+static void APIENTRY trackGenTextures(GLsizei n, GLuint* textures) {
+    GL_COUNTED(glGenTextures)(n, textures);
+    addObjects(GL_RESOURCE_TEXTURE, n, textures);
+}
+
+static void APIENTRY trackDeleteTextures(GLsizei n, const GLuint* textures) {
+    removeObjects(GL_RESOURCE_TEXTURE, n, textures, "glDeleteTextures");
+    GL_COUNTED(glDeleteTextures)(n, textures);
+}
+
+static void APIENTRY trackActiveTexture(GLenum texture) {
+    active_texture = texture;
+    GL_COUNTED(glActiveTexture)(texture);
+}
+
+static void APIENTRY trackBindTexture(GLenum target, GLuint texture) {
+    bound_textures[std::make_pair(active_texture, target)] = texture;
+    GL_COUNTED(glBindTexture)(target, texture);
+}
+
+// Only the base level is counted, mipmap levels are added by glGenerateMipmap
+static void APIENTRY trackTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height,
+    GLint border, GLenum format, GLenum type, const void* pixels) {
+    uint64_t bytes = (uint64_t) width * height * getPixelBytes(format, type);
+    if (pixels)
+        uploaded_bytes += bytes;
+
+    if (level == 0) {
+        GLuint texture = bound_textures[std::make_pair(active_texture, getTextureTarget(target))];
+        TextureSize& size = texture_sizes[texture];
+        int face = target == getTextureTarget(target) ? 0 : (int) (target - GL_TEXTURE_CUBE_MAP_POSITIVE_X);
+        size.face_bytes[face] = bytes;
+        updateTextureBytes(texture);
+    }
+    GL_COUNTED(glTexImage2D)(target, level, internalformat, width, height, border, format, type, pixels);
+}
+
+// Every layer of an array texture is counted as part of its base level
+static void APIENTRY trackTexImage3D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height,
+    GLsizei depth, GLint border, GLenum format, GLenum type, const void* pixels) {
+    uint64_t bytes = (uint64_t) width * height * depth * getPixelBytes(format, type);
+    if (pixels)
+        uploaded_bytes += bytes;
+
+    if (level == 0) {
+        GLuint texture = bound_textures[std::make_pair(active_texture, target)];
+        texture_sizes[texture].face_bytes[0] = bytes;
+        updateTextureBytes(texture);
+    }
+    GL_COUNTED(glTexImage3D)(target, level, internalformat, width, height, depth, border, format, type, pixels);
+}
+
+// Immutable storage has every level allocated at once, so they are all counted in place of a mipmap third
+static void APIENTRY trackTexStorage2D(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height) {
+    uint64_t bytes = 0;
+    for (GLsizei level = 0; level < levels; level++)
+        bytes += (uint64_t) std::max(width >> level, 1) * std::max(height >> level, 1) * getInternalFormatBytes(internalformat);
+
+    GLuint texture = bound_textures[std::make_pair(active_texture, target)];
+    texture_sizes[texture].face_bytes[0] = bytes;
+    updateTextureBytes(texture);
+    GL_COUNTED(glTexStorage2D)(target, levels, internalformat, width, height);
+}
+
+static void APIENTRY trackGenerateMipmap(GLenum target) {
+    GLuint texture = bound_textures[std::make_pair(active_texture, target)];
+    texture_sizes[texture].mipmapped = true;
+    updateTextureBytes(texture);
+    GL_COUNTED(glGenerateMipmap)(target);
+}
+
+static void APIENTRY trackGenVertexArrays(GLsizei n, GLuint* arrays) {
+    GL_COUNTED(glGenVertexArrays)(n, arrays);
+    addObjects(GL_RESOURCE_VERTEX_ARRAY, n, arrays);
+}
+
+static void APIENTRY trackDeleteVertexArrays(GLsizei n, const GLuint* arrays) {
+    removeObjects(GL_RESOURCE_VERTEX_ARRAY, n, arrays, "glDeleteVertexArrays");
+    GL_COUNTED(glDeleteVertexArrays)(n, arrays);
+}
+
+static GLuint APIENTRY trackCreateShader(GLenum type) {
+    GLuint shader = GL_COUNTED(glCreateShader)(type);
+    if (shader)
+        live[GL_RESOURCE_SHADER][shader] = 0;
+    return shader;
+}
+
+static void APIENTRY trackDeleteShader(GLuint shader) {
+    removeObjects(GL_RESOURCE_SHADER, 1, &shader, "glDeleteShader");
+    GL_COUNTED(glDeleteShader)(shader);
+}
+
+// Shaders are sized by their source
+static void APIENTRY trackShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length) {
+    uint64_t bytes = 0;
+    for (GLsizei i = 0; i < count; i++)
+        bytes += length && length[i] >= 0 ? (uint64_t) length[i] : strlen(string[i]);
+    auto live_shader = live[GL_RESOURCE_SHADER].find(shader);
+    if (live_shader != live[GL_RESOURCE_SHADER].end())
+        live_shader->second = bytes;
+    GL_COUNTED(glShaderSource)(shader, count, string, length);
+}
+
+static GLuint APIENTRY trackCreateProgram() {
+    GLuint program = GL_COUNTED(glCreateProgram)();
+    if (program)
+        live[GL_RESOURCE_PROGRAM][program] = 0;
+    return program;
+}
+
+static void APIENTRY trackDeleteProgram(GLuint program) {
+    removeObjects(GL_RESOURCE_PROGRAM, 1, &program, "glDeleteProgram");
+    program_shaders.erase(program);
+    GL_COUNTED(glDeleteProgram)(program);
+}
+
+static void APIENTRY trackAttachShader(GLuint program, GLuint shader) {
+    program_shaders[program].push_back(shader);
+    GL_COUNTED(glAttachShader)(program, shader);
+}
+
+// Programs are sized by the source of their shaders once linked
+static void APIENTRY trackLinkProgram(GLuint program) {
+    auto live_program = live[GL_RESOURCE_PROGRAM].find(program);
+    if (live_program != live[GL_RESOURCE_PROGRAM].end()) {
+        live_program->second = 0;
+        for (GLuint shader : program_shaders[program]) {
+            auto live_shader = live[GL_RESOURCE_SHADER].find(shader);
+            if (live_shader != live[GL_RESOURCE_SHADER].end())
+                live_program->second += live_shader->second;
+        }
+    }
+    GL_COUNTED(glLinkProgram)(program);
+}
+
+// Uniforms count as uploads too
+static void APIENTRY trackUniform1f(GLint location, GLfloat v0) {
+    uploaded_bytes += sizeof(GLfloat);
+    GL_COUNTED(glUniform1f)(location, v0);
+}
+
+static void APIENTRY trackUniform1i(GLint location, GLint v0) {
+    uploaded_bytes += sizeof(GLint);
+    GL_COUNTED(glUniform1i)(location, v0);
+}
+
+static void APIENTRY trackUniform1ui(GLint location, GLuint v0) {
+    uploaded_bytes += sizeof(GLuint);
+    GL_COUNTED(glUniform1ui)(location, v0);
+}
+
+static void APIENTRY trackUniform2fv(GLint location, GLsizei count, const GLfloat* value) {
+    uploaded_bytes += count * 2 * sizeof(GLfloat);
+    GL_COUNTED(glUniform2fv)(location, count, value);
+}
+
+static void APIENTRY trackUniform2iv(GLint location, GLsizei count, const GLint* value) {
+    uploaded_bytes += count * 2 * sizeof(GLint);
+    GL_COUNTED(glUniform2iv)(location, count, value);
+}
+
+static void APIENTRY trackUniform3fv(GLint location, GLsizei count, const GLfloat* value) {
+    uploaded_bytes += count * 3 * sizeof(GLfloat);
+    GL_COUNTED(glUniform3fv)(location, count, value);
+}
+
+static void APIENTRY trackUniform4fv(GLint location, GLsizei count, const GLfloat* value) {
+    uploaded_bytes += count * 4 * sizeof(GLfloat);
+    GL_COUNTED(glUniform4fv)(location, count, value);
+}
+
+static void APIENTRY trackUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+    uploaded_bytes += count * 16 * sizeof(GLfloat);
+    GL_COUNTED(glUniformMatrix4fv)(location, count, transpose, value);
+}
+
+// Whether the build counts anything at all
+bool GLStats::isEnabled() {
+    return true;
+}
+
+// Wraps the loaded GL functions, call right after gladLoadGL
+void GLStats::install() {
+    // Every function glad loaded is counted, the ones the driver does not have stay null
+#define GL_STATS_INSTALL(name) GLWrapper<GL_ENTRY_##name, decltype(glad_##name)>::install(glad_##name);
+    GL_STATS_FUNCTIONS(GL_STATS_INSTALL)
+#undef GL_STATS_INSTALL
+
+    // Some also track objects and uploads on their way to the counting wrapper
+#define GL_STATS_TRACK(name, hook) if (glad_##name) glad_##name = hook;
+    GL_STATS_TRACK(glGenBuffers, trackGenBuffers)
+    GL_STATS_TRACK(glDeleteBuffers, trackDeleteBuffers)
+    GL_STATS_TRACK(glBindBuffer, trackBindBuffer)
+    GL_STATS_TRACK(glBindBufferBase, trackBindBufferBase)
+    GL_STATS_TRACK(glBufferData, trackBufferData)
+    GL_STATS_TRACK(glBufferSubData, trackBufferSubData)
+    GL_STATS_TRACK(glGenTextures, trackGenTextures)
+    GL_STATS_TRACK(glDeleteTextures, trackDeleteTextures)
+    GL_STATS_TRACK(glActiveTexture, trackActiveTexture)
+    GL_STATS_TRACK(glBindTexture, trackBindTexture)
+    GL_STATS_TRACK(glTexImage2D, trackTexImage2D)
+    GL_STATS_TRACK(glTexImage3D, trackTexImage3D)
+    GL_STATS_TRACK(glTexStorage2D, trackTexStorage2D)
+    GL_STATS_TRACK(glGenerateMipmap, trackGenerateMipmap)
+    GL_STATS_TRACK(glGenVertexArrays, trackGenVertexArrays)
+    GL_STATS_TRACK(glDeleteVertexArrays, trackDeleteVertexArrays)
+    GL_STATS_TRACK(glCreateShader, trackCreateShader)
+    GL_STATS_TRACK(glDeleteShader, trackDeleteShader)
+    GL_STATS_TRACK(glShaderSource, trackShaderSource)
+    GL_STATS_TRACK(glCreateProgram, trackCreateProgram)
+    GL_STATS_TRACK(glDeleteProgram, trackDeleteProgram)
+    GL_STATS_TRACK(glAttachShader, trackAttachShader)
+    GL_STATS_TRACK(glLinkProgram, trackLinkProgram)
+    GL_STATS_TRACK(glUniform1f, trackUniform1f)
+    GL_STATS_TRACK(glUniform1i, trackUniform1i)
+    GL_STATS_TRACK(glUniform1ui, trackUniform1ui)
+    GL_STATS_TRACK(glUniform2fv, trackUniform2fv)
+    GL_STATS_TRACK(glUniform2iv, trackUniform2iv)
+    GL_STATS_TRACK(glUniform3fv, trackUniform3fv)
+    GL_STATS_TRACK(glUniform4fv, trackUniform4fv)
+    GL_STATS_TRACK(glUniformMatrix4fv, trackUniformMatrix4fv)
+#undef GL_STATS_TRACK
+}
+
+// Moves the counts of the frame that just ended to the last frame's and starts counting a new one
+void GLStats::endFrame() {
+    std::copy(calls, calls + GL_ENTRY_COUNT, last_calls);
+    std::fill(calls, calls + GL_ENTRY_COUNT, 0);
+    last_uploaded_bytes = uploaded_bytes;
+    uploaded_bytes = 0;
+}
+
+// Calls made during the last frame
+uint64_t GLStats::getCalls() {
+    uint64_t total = 0;
+    for (uint64_t count : last_calls)
+        total += count;
+    return total;
+}
+
+// Bytes uploaded during the last frame
+uint64_t GLStats::getUploadedBytes() {
+    return last_uploaded_bytes;
+}
+
+// Live objects of a type
+uint64_t GLStats::getLiveCount(GLResourceType type) {
+    return live[type].size();
+}
+
+// Bytes of memory held by the live objects of a type
+uint64_t GLStats::getLiveBytes(GLResourceType type) {
+    uint64_t total = 0;
+    for (auto& object : live[type])
+        total += object.second;
+    return total;
+}
+
+// Objects deleted that were not alive
+uint64_t GLStats::getWarningCount() {
+    return warning_count;
+}
+
+// Writes the calls of the last frame per entry point, every live object and the warnings
+void GLStats::dump(std::ostream& out) {
+    out << "GL calls last frame: " << getCalls() << ", bytes uploaded: " << getUploadedBytes() << '\n';
+    std::vector<int> entries;
+    for (int i = 0; i < GL_ENTRY_COUNT; i++) {
+        if (last_calls[i])
+            entries.push_back(i);
+    }
+    std::sort(entries.begin(), entries.end(), [](int a, int b) { return last_calls[a] > last_calls[b]; });
+    for (int entry : entries)
+        out << "  " << entry_names[entry] << ": " << last_calls[entry] << '\n';
+
+    for (int type = 0; type < GL_RESOURCE_TYPE_COUNT; type++) {
+        out << "Live " << resource_names[type] << "s: " << getLiveCount((GLResourceType) type)
+            << ", bytes: " << getLiveBytes((GLResourceType) type) << '\n';
+        std::map<GLuint, uint64_t> sorted(live[type].begin(), live[type].end());
+        for (auto& object : sorted)
+            out << "  " << object.first << ": " << object.second << " bytes\n";
+    }
+
+    out << "Warnings: " << warning_count << '\n';
+    for (const std::string& warning : warnings)
+        out << "  " << warning << '\n';
+}
+
+#else
+
+// Without GRAPHIX_GL_STATS nothing is wrapped and every count stays at zero
+bool GLStats::isEnabled() {
+    return false;
+}
+
+void GLStats::install() {}
+
+void GLStats::endFrame() {}
+
+uint64_t GLStats::getCalls() {
+    return 0;
+}
+
+uint64_t GLStats::getUploadedBytes() {
+    return 0;
+}
+
+uint64_t GLStats::getLiveCount(GLResourceType) {
+    return 0;
+}
+
+uint64_t GLStats::getLiveBytes(GLResourceType) {
+    return 0;
+}
+
+uint64_t GLStats::getWarningCount() {
+    return 0;
+}
+
+void GLStats::dump(std::ostream& out) {
+    out << "GL stats are not built in, build with GRAPHIX_GL_STATS=1\n";
+}
+
+#endif
@@ -0,0 +1,49 @@
+#pragma once
+
+// GL calls are only counted in builds that define GRAPHIX_GL_STATS as 1, otherwise install leaves the GL functions alone
+#ifndef GRAPHIX_GL_STATS
+#define GRAPHIX_GL_STATS 0
+#endif
+
+#include <cstdint>
+#include <ostream>
+
+#include "common.h"
+
+// Kinds of GL objects whose lifetimes are tracked
+enum GLResourceType {
+    GL_RESOURCE_BUFFER,
+    GL_RESOURCE_TEXTURE,
+    GL_RESOURCE_VERTEX_ARRAY,
+    GL_RESOURCE_SHADER,
+    GL_RESOURCE_PROGRAM,
+    GL_RESOURCE_TYPE_COUNT
+};
+
+// Counts calls and uploaded bytes per frame by wrapping the function pointers loaded by gladLoadGL,
+// and keeps track of every live buffer, texture, vertex array, shader and program with its size
+class GLStats {
+public:
+    // Whether the build counts anything at all
+    static bool isEnabled();
+
+    // Wraps the loaded GL functions, call right after gladLoadGL
+    static void install();
+
+    // Moves the counts of the frame that just ended to the last frame's and starts counting a new one
+    static void endFrame();
+
+    // Calls made and bytes uploaded during the last frame
+    static uint64_t getCalls();
+    static uint64_t getUploadedBytes();
+
+    // Live objects of a type and the bytes of memory they hold
+    static uint64_t getLiveCount(GLResourceType type);
+    static uint64_t getLiveBytes(GLResourceType type);
+
+    // Objects deleted that were not alive, a sign of passing the wrong names to glDelete*
+    static uint64_t getWarningCount();
+
+    // Writes the calls of the last frame per entry point, every live object and the warnings
+    static void dump(std::ostream& out);
+};
@@ -0,0 +1,729 @@
+#pragma once
+
+// Every GL function pointer glad.h declares, in its order, so any entry point gladLoadGL can load is counted
+// Generated from the "GLAPI PFNGL...PROC glad_gl...;" lines of glad.h, regenerate it along with glad
+#define GL_STATS_FUNCTIONS(X) \
+    X(glCullFace) X(glFrontFace) X(glHint) X(glLineWidth) X(glPointSize) X(glPolygonMode) X(glScissor) \
+    X(glTexParameterf) X(glTexParameterfv) X(glTexParameteri) X(glTexParameteriv) X(glTexImage1D) X(glTexImage2D) \
+    X(glDrawBuffer) X(glClear) X(glClearColor) X(glClearStencil) X(glClearDepth) X(glStencilMask) X(glColorMask) \
+    X(glDepthMask) X(glDisable) X(glEnable) X(glFinish) X(glFlush) X(glBlendFunc) X(glLogicOp) X(glStencilFunc) \
+    X(glStencilOp) X(glDepthFunc) X(glPixelStoref) X(glPixelStorei) X(glReadBuffer) X(glReadPixels) X(glGetBooleanv) \
+    X(glGetDoublev) X(glGetError) X(glGetFloatv) X(glGetIntegerv) X(glGetString) X(glGetTexImage) \
+    X(glGetTexParameterfv) X(glGetTexParameteriv) X(glGetTexLevelParameterfv) X(glGetTexLevelParameteriv) \
+    X(glIsEnabled) X(glDepthRange) X(glViewport) X(glNewList) X(glEndList) X(glCallList) X(glCallLists) \
+    X(glDeleteLists) X(glGenLists) X(glListBase) X(glBegin) X(glBitmap) X(glColor3b) X(glColor3bv) X(glColor3d) \
+    X(glColor3dv) X(glColor3f) X(glColor3fv) X(glColor3i) X(glColor3iv) X(glColor3s) X(glColor3sv) X(glColor3ub) \
+    X(glColor3ubv) X(glColor3ui) X(glColor3uiv) X(glColor3us) X(glColor3usv) X(glColor4b) X(glColor4bv) X(glColor4d) \
+    X(glColor4dv) X(glColor4f) X(glColor4fv) X(glColor4i) X(glColor4iv) X(glColor4s) X(glColor4sv) X(glColor4ub) \
+    X(glColor4ubv) X(glColor4ui) X(glColor4uiv) X(glColor4us) X(glColor4usv) X(glEdgeFlag) X(glEdgeFlagv) X(glEnd) \
+    X(glIndexd) X(glIndexdv) X(glIndexf) X(glIndexfv) X(glIndexi) X(glIndexiv) X(glIndexs) X(glIndexsv) \
+    X(glNormal3b) X(glNormal3bv) X(glNormal3d) X(glNormal3dv) X(glNormal3f) X(glNormal3fv) X(glNormal3i) \
+    X(glNormal3iv) X(glNormal3s) X(glNormal3sv) X(glRasterPos2d) X(glRasterPos2dv) X(glRasterPos2f) \
+    X(glRasterPos2fv) X(glRasterPos2i) X(glRasterPos2iv) X(glRasterPos2s) X(glRasterPos2sv) X(glRasterPos3d) \
+    X(glRasterPos3dv) X(glRasterPos3f) X(glRasterPos3fv) X(glRasterPos3i) X(glRasterPos3iv) X(glRasterPos3s) \
+    X(glRasterPos3sv) X(glRasterPos4d) X(glRasterPos4dv) X(glRasterPos4f) X(glRasterPos4fv) X(glRasterPos4i) \
+    X(glRasterPos4iv) X(glRasterPos4s) X(glRasterPos4sv) X(glRectd) X(glRectdv) X(glRectf) X(glRectfv) X(glRecti) \
+    X(glRectiv) X(glRects) X(glRectsv) X(glTexCoord1d) X(glTexCoord1dv) X(glTexCoord1f) X(glTexCoord1fv) \
+    X(glTexCoord1i) X(glTexCoord1iv) X(glTexCoord1s) X(glTexCoord1sv) X(glTexCoord2d) X(glTexCoord2dv) \
+    X(glTexCoord2f) X(glTexCoord2fv) X(glTexCoord2i) X(glTexCoord2iv) X(glTexCoord2s) X(glTexCoord2sv) \
+    X(glTexCoord3d) X(glTexCoord3dv) X(glTexCoord3f) X(glTexCoord3fv) X(glTexCoord3i) X(glTexCoord3iv) \
+    X(glTexCoord3s) X(glTexCoord3sv) X(glTexCoord4d) X(glTexCoord4dv) X(glTexCoord4f) X(glTexCoord4fv) \
+    X(glTexCoord4i) X(glTexCoord4iv) X(glTexCoord4s) X(glTexCoord4sv) X(glVertex2d) X(glVertex2dv) X(glVertex2f) \
+    X(glVertex2fv) X(glVertex2i) X(glVertex2iv) X(glVertex2s) X(glVertex2sv) X(glVertex3d) X(glVertex3dv) \
+    X(glVertex3f) X(glVertex3fv) X(glVertex3i) X(glVertex3iv) X(glVertex3s) X(glVertex3sv) X(glVertex4d) \
+    X(glVertex4dv) X(glVertex4f) X(glVertex4fv) X(glVertex4i) X(glVertex4iv) X(glVertex4s) X(glVertex4sv) \
+    X(glClipPlane) X(glColorMaterial) X(glFogf) X(glFogfv) X(glFogi) X(glFogiv) X(glLightf) X(glLightfv) X(glLighti) \
+    X(glLightiv) X(glLightModelf) X(glLightModelfv) X(glLightModeli) X(glLightModeliv) X(glLineStipple) \
+    X(glMaterialf) X(glMaterialfv) X(glMateriali) X(glMaterialiv) X(glPolygonStipple) X(glShadeModel) X(glTexEnvf) \
+    X(glTexEnvfv) X(glTexEnvi) X(glTexEnviv) X(glTexGend) X(glTexGendv) X(glTexGenf) X(glTexGenfv) X(glTexGeni) \
+    X(glTexGeniv) X(glFeedbackBuffer) X(glSelectBuffer) X(glRenderMode) X(glInitNames) X(glLoadName) \
+    X(glPassThrough) X(glPopName) X(glPushName) X(glClearAccum) X(glClearIndex) X(glIndexMask) X(glAccum) \
+    X(glPopAttrib) X(glPushAttrib) X(glMap1d) X(glMap1f) X(glMap2d) X(glMap2f) X(glMapGrid1d) X(glMapGrid1f) \
+    X(glMapGrid2d) X(glMapGrid2f) X(glEvalCoord1d) X(glEvalCoord1dv) X(glEvalCoord1f) X(glEvalCoord1fv) \
+    X(glEvalCoord2d) X(glEvalCoord2dv) X(glEvalCoord2f) X(glEvalCoord2fv) X(glEvalMesh1) X(glEvalPoint1) \
+    X(glEvalMesh2) X(glEvalPoint2) X(glAlphaFunc) X(glPixelZoom) X(glPixelTransferf) X(glPixelTransferi) \
+    X(glPixelMapfv) X(glPixelMapuiv) X(glPixelMapusv) X(glCopyPixels) X(glDrawPixels) X(glGetClipPlane) \
+    X(glGetLightfv) X(glGetLightiv) X(glGetMapdv) X(glGetMapfv) X(glGetMapiv) X(glGetMaterialfv) X(glGetMaterialiv) \
+    X(glGetPixelMapfv) X(glGetPixelMapuiv) X(glGetPixelMapusv) X(glGetPolygonStipple) X(glGetTexEnvfv) \
+    X(glGetTexEnviv) X(glGetTexGendv) X(glGetTexGenfv) X(glGetTexGeniv) X(glIsList) X(glFrustum) X(glLoadIdentity) \
+    X(glLoadMatrixf) X(glLoadMatrixd) X(glMatrixMode) X(glMultMatrixf) X(glMultMatrixd) X(glOrtho) X(glPopMatrix) \
+    X(glPushMatrix) X(glRotated) X(glRotatef) X(glScaled) X(glScalef) X(glTranslated) X(glTranslatef) \
+    X(glDrawArrays) X(glDrawElements) X(glGetPointerv) X(glPolygonOffset) X(glCopyTexImage1D) X(glCopyTexImage2D) \
+    X(glCopyTexSubImage1D) X(glCopyTexSubImage2D) X(glTexSubImage1D) X(glTexSubImage2D) X(glBindTexture) \
+    X(glDeleteTextures) X(glGenTextures) X(glIsTexture) X(glArrayElement) X(glColorPointer) X(glDisableClientState) \
+    X(glEdgeFlagPointer) X(glEnableClientState) X(glIndexPointer) X(glInterleavedArrays) X(glNormalPointer) \
+    X(glTexCoordPointer) X(glVertexPointer) X(glAreTexturesResident) X(glPrioritizeTextures) X(glIndexub) \
+    X(glIndexubv) X(glPopClientAttrib) X(glPushClientAttrib) X(glDrawRangeElements) X(glTexImage3D) \
+    X(glTexSubImage3D) X(glCopyTexSubImage3D) X(glActiveTexture) X(glSampleCoverage) X(glCompressedTexImage3D) \
+    X(glCompressedTexImage2D) X(glCompressedTexImage1D) X(glCompressedTexSubImage3D) X(glCompressedTexSubImage2D) \
+    X(glCompressedTexSubImage1D) X(glGetCompressedTexImage) X(glClientActiveTexture) X(glMultiTexCoord1d) \
+    X(glMultiTexCoord1dv) X(glMultiTexCoord1f) X(glMultiTexCoord1fv) X(glMultiTexCoord1i) X(glMultiTexCoord1iv) \
+    X(glMultiTexCoord1s) X(glMultiTexCoord1sv) X(glMultiTexCoord2d) X(glMultiTexCoord2dv) X(glMultiTexCoord2f) \
+    X(glMultiTexCoord2fv) X(glMultiTexCoord2i) X(glMultiTexCoord2iv) X(glMultiTexCoord2s) X(glMultiTexCoord2sv) \
+    X(glMultiTexCoord3d) X(glMultiTexCoord3dv) X(glMultiTexCoord3f) X(glMultiTexCoord3fv) X(glMultiTexCoord3i) \
+    X(glMultiTexCoord3iv) X(glMultiTexCoord3s) X(glMultiTexCoord3sv) X(glMultiTexCoord4d) X(glMultiTexCoord4dv) \
+    X(glMultiTexCoord4f) X(glMultiTexCoord4fv) X(glMultiTexCoord4i) X(glMultiTexCoord4iv) X(glMultiTexCoord4s) \
+    X(glMultiTexCoord4sv) X(glLoadTransposeMatrixf) X(glLoadTransposeMatrixd) X(glMultTransposeMatrixf) \
+    X(glMultTransposeMatrixd) X(glBlendFuncSeparate) X(glMultiDrawArrays) X(glMultiDrawElements) \
+    X(glPointParameterf) X(glPointParameterfv) X(glPointParameteri) X(glPointParameteriv) X(glFogCoordf) \
+    X(glFogCoordfv) X(glFogCoordd) X(glFogCoorddv) X(glFogCoordPointer) X(glSecondaryColor3b) X(glSecondaryColor3bv) \
+    X(glSecondaryColor3d) X(glSecondaryColor3dv) X(glSecondaryColor3f) X(glSecondaryColor3fv) X(glSecondaryColor3i) \
+    X(glSecondaryColor3iv) X(glSecondaryColor3s) X(glSecondaryColor3sv) X(glSecondaryColor3ub) \
+    X(glSecondaryColor3ubv) X(glSecondaryColor3ui) X(glSecondaryColor3uiv) X(glSecondaryColor3us) \
+    X(glSecondaryColor3usv) X(glSecondaryColorPointer) X(glWindowPos2d) X(glWindowPos2dv) X(glWindowPos2f) \
+    X(glWindowPos2fv) X(glWindowPos2i) X(glWindowPos2iv) X(glWindowPos2s) X(glWindowPos2sv) X(glWindowPos3d) \
+    X(glWindowPos3dv) X(glWindowPos3f) X(glWindowPos3fv) X(glWindowPos3i) X(glWindowPos3iv) X(glWindowPos3s) \
+    X(glWindowPos3sv) X(glBlendColor) X(glBlendEquation) X(glGenQueries) X(glDeleteQueries) X(glIsQuery) \
+    X(glBeginQuery) X(glEndQuery) X(glGetQueryiv) X(glGetQueryObjectiv) X(glGetQueryObjectuiv) X(glBindBuffer) \
+    X(glDeleteBuffers) X(glGenBuffers) X(glIsBuffer) X(glBufferData) X(glBufferSubData) X(glGetBufferSubData) \
+    X(glMapBuffer) X(glUnmapBuffer) X(glGetBufferParameteriv) X(glGetBufferPointerv) X(glBlendEquationSeparate) \
+    X(glDrawBuffers) X(glStencilOpSeparate) X(glStencilFuncSeparate) X(glStencilMaskSeparate) X(glAttachShader) \
+    X(glBindAttribLocation) X(glCompileShader) X(glCreateProgram) X(glCreateShader) X(glDeleteProgram) \
+    X(glDeleteShader) X(glDetachShader) X(glDisableVertexAttribArray) X(glEnableVertexAttribArray) \
+    X(glGetActiveAttrib) X(glGetActiveUniform) X(glGetAttachedShaders) X(glGetAttribLocation) X(glGetProgramiv) \
+    X(glGetProgramInfoLog) X(glGetShaderiv) X(glGetShaderInfoLog) X(glGetShaderSource) X(glGetUniformLocation) \
+    X(glGetUniformfv) X(glGetUniformiv) X(glGetVertexAttribdv) X(glGetVertexAttribfv) X(glGetVertexAttribiv) \
+    X(glGetVertexAttribPointerv) X(glIsProgram) X(glIsShader) X(glLinkProgram) X(glShaderSource) X(glUseProgram) \
+    X(glUniform1f) X(glUniform2f) X(glUniform3f) X(glUniform4f) X(glUniform1i) X(glUniform2i) X(glUniform3i) \
+    X(glUniform4i) X(glUniform1fv) X(glUniform2fv) X(glUniform3fv) X(glUniform4fv) X(glUniform1iv) X(glUniform2iv) \
+    X(glUniform3iv) X(glUniform4iv) X(glUniformMatrix2fv) X(glUniformMatrix3fv) X(glUniformMatrix4fv) \
+    X(glValidateProgram) X(glVertexAttrib1d) X(glVertexAttrib1dv) X(glVertexAttrib1f) X(glVertexAttrib1fv) \
+    X(glVertexAttrib1s) X(glVertexAttrib1sv) X(glVertexAttrib2d) X(glVertexAttrib2dv) X(glVertexAttrib2f) \
+    X(glVertexAttrib2fv) X(glVertexAttrib2s) X(glVertexAttrib2sv) X(glVertexAttrib3d) X(glVertexAttrib3dv) \
+    X(glVertexAttrib3f) X(glVertexAttrib3fv) X(glVertexAttrib3s) X(glVertexAttrib3sv) X(glVertexAttrib4Nbv) \
+    X(glVertexAttrib4Niv) X(glVertexAttrib4Nsv) X(glVertexAttrib4Nub) X(glVertexAttrib4Nubv) X(glVertexAttrib4Nuiv) \
+    X(glVertexAttrib4Nusv) X(glVertexAttrib4bv) X(glVertexAttrib4d) X(glVertexAttrib4dv) X(glVertexAttrib4f) \
+    X(glVertexAttrib4fv) X(glVertexAttrib4iv) X(glVertexAttrib4s) X(glVertexAttrib4sv) X(glVertexAttrib4ubv) \
+    X(glVertexAttrib4uiv) X(glVertexAttrib4usv) X(glVertexAttribPointer) X(glUniformMatrix2x3fv) \
+    X(glUniformMatrix3x2fv) X(glUniformMatrix2x4fv) X(glUniformMatrix4x2fv) X(glUniformMatrix3x4fv) \
+    X(glUniformMatrix4x3fv) X(glColorMaski) X(glGetBooleani_v) X(glGetIntegeri_v) X(glEnablei) X(glDisablei) \
+    X(glIsEnabledi) X(glBeginTransformFeedback) X(glEndTransformFeedback) X(glBindBufferRange) X(glBindBufferBase) \
+    X(glTransformFeedbackVaryings) X(glGetTransformFeedbackVarying) X(glClampColor) X(glBeginConditionalRender) \
+    X(glEndConditionalRender) X(glVertexAttribIPointer) X(glGetVertexAttribIiv) X(glGetVertexAttribIuiv) \
+    X(glVertexAttribI1i) X(glVertexAttribI2i) X(glVertexAttribI3i) X(glVertexAttribI4i) X(glVertexAttribI1ui) \
+    X(glVertexAttribI2ui) X(glVertexAttribI3ui) X(glVertexAttribI4ui) X(glVertexAttribI1iv) X(glVertexAttribI2iv) \
+    X(glVertexAttribI3iv) X(glVertexAttribI4iv) X(glVertexAttribI1uiv) X(glVertexAttribI2uiv) X(glVertexAttribI3uiv) \
+    X(glVertexAttribI4uiv) X(glVertexAttribI4bv) X(glVertexAttribI4sv) X(glVertexAttribI4ubv) X(glVertexAttribI4usv) \
+    X(glGetUniformuiv) X(glBindFragDataLocation) X(glGetFragDataLocation) X(glUniform1ui) X(glUniform2ui) \
+    X(glUniform3ui) X(glUniform4ui) X(glUniform1uiv) X(glUniform2uiv) X(glUniform3uiv) X(glUniform4uiv) \
+    X(glTexParameterIiv) X(glTexParameterIuiv) X(glGetTexParameterIiv) X(glGetTexParameterIuiv) X(glClearBufferiv) \
+    X(glClearBufferuiv) X(glClearBufferfv) X(glClearBufferfi) X(glGetStringi) X(glIsRenderbuffer) \
+    X(glBindRenderbuffer) X(glDeleteRenderbuffers) X(glGenRenderbuffers) X(glRenderbufferStorage) \
+    X(glGetRenderbufferParameteriv) X(glIsFramebuffer) X(glBindFramebuffer) X(glDeleteFramebuffers) \
+    X(glGenFramebuffers) X(glCheckFramebufferStatus) X(glFramebufferTexture1D) X(glFramebufferTexture2D) \
+    X(glFramebufferTexture3D) X(glFramebufferRenderbuffer) X(glGetFramebufferAttachmentParameteriv) \
+    X(glGenerateMipmap) X(glBlitFramebuffer) X(glRenderbufferStorageMultisample) X(glFramebufferTextureLayer) \
+    X(glMapBufferRange) X(glFlushMappedBufferRange) X(glBindVertexArray) X(glDeleteVertexArrays) \
+    X(glGenVertexArrays) X(glIsVertexArray) X(glDrawArraysInstanced) X(glDrawElementsInstanced) X(glTexBuffer) \
+    X(glPrimitiveRestartIndex) X(glCopyBufferSubData) X(glGetUniformIndices) X(glGetActiveUniformsiv) \
+    X(glGetActiveUniformName) X(glGetUniformBlockIndex) X(glGetActiveUniformBlockiv) X(glGetActiveUniformBlockName) \
+    X(glUniformBlockBinding) X(glDrawElementsBaseVertex) X(glDrawRangeElementsBaseVertex) \
+    X(glDrawElementsInstancedBaseVertex) X(glMultiDrawElementsBaseVertex) X(glProvokingVertex) X(glFenceSync) \
+    X(glIsSync) X(glDeleteSync) X(glClientWaitSync) X(glWaitSync) X(glGetInteger64v) X(glGetSynciv) \
+    X(glGetInteger64i_v) X(glGetBufferParameteri64v) X(glFramebufferTexture) X(glTexImage2DMultisample) \
+    X(glTexImage3DMultisample) X(glGetMultisamplefv) X(glSampleMaski) X(glBindFragDataLocationIndexed) \
+    X(glGetFragDataIndex) X(glGenSamplers) X(glDeleteSamplers) X(glIsSampler) X(glBindSampler) \
+    X(glSamplerParameteri) X(glSamplerParameteriv) X(glSamplerParameterf) X(glSamplerParameterfv) \
+    X(glSamplerParameterIiv) X(glSamplerParameterIuiv) X(glGetSamplerParameteriv) X(glGetSamplerParameterIiv) \
+    X(glGetSamplerParameterfv) X(glGetSamplerParameterIuiv) X(glQueryCounter) X(glGetQueryObjecti64v) \
+    X(glGetQueryObjectui64v) X(glVertexAttribDivisor) X(glVertexAttribP1ui) X(glVertexAttribP1uiv) \
+    X(glVertexAttribP2ui) X(glVertexAttribP2uiv) X(glVertexAttribP3ui) X(glVertexAttribP3uiv) X(glVertexAttribP4ui) \
+    X(glVertexAttribP4uiv) X(glVertexP2ui) X(glVertexP2uiv) X(glVertexP3ui) X(glVertexP3uiv) X(glVertexP4ui) \
+    X(glVertexP4uiv) X(glTexCoordP1ui) X(glTexCoordP1uiv) X(glTexCoordP2ui) X(glTexCoordP2uiv) X(glTexCoordP3ui) \
+    X(glTexCoordP3uiv) X(glTexCoordP4ui) X(glTexCoordP4uiv) X(glMultiTexCoordP1ui) X(glMultiTexCoordP1uiv) \
+    X(glMultiTexCoordP2ui) X(glMultiTexCoordP2uiv) X(glMultiTexCoordP3ui) X(glMultiTexCoordP3uiv) \
+    X(glMultiTexCoordP4ui) X(glMultiTexCoordP4uiv) X(glNormalP3ui) X(glNormalP3uiv) X(glColorP3ui) X(glColorP3uiv) \
+    X(glColorP4ui) X(glColorP4uiv) X(glSecondaryColorP3ui) X(glSecondaryColorP3uiv) X(glMinSampleShading) \
+    X(glBlendEquationi) X(glBlendEquationSeparatei) X(glBlendFunci) X(glBlendFuncSeparatei) X(glDrawArraysIndirect) \
+    X(glDrawElementsIndirect) X(glUniform1d) X(glUniform2d) X(glUniform3d) X(glUniform4d) X(glUniform1dv) \
+    X(glUniform2dv) X(glUniform3dv) X(glUniform4dv) X(glUniformMatrix2dv) X(glUniformMatrix3dv) \
+    X(glUniformMatrix4dv) X(glUniformMatrix2x3dv) X(glUniformMatrix2x4dv) X(glUniformMatrix3x2dv) \
+    X(glUniformMatrix3x4dv) X(glUniformMatrix4x2dv) X(glUniformMatrix4x3dv) X(glGetUniformdv) \
+    X(glGetSubroutineUniformLocation) X(glGetSubroutineIndex) X(glGetActiveSubroutineUniformiv) \
+    X(glGetActiveSubroutineUniformName) X(glGetActiveSubroutineName) X(glUniformSubroutinesuiv) \
+    X(glGetUniformSubroutineuiv) X(glGetProgramStageiv) X(glPatchParameteri) X(glPatchParameterfv) \
+    X(glBindTransformFeedback) X(glDeleteTransformFeedbacks) X(glGenTransformFeedbacks) X(glIsTransformFeedback) \
+    X(glPauseTransformFeedback) X(glResumeTransformFeedback) X(glDrawTransformFeedback) \
+    X(glDrawTransformFeedbackStream) X(glBeginQueryIndexed) X(glEndQueryIndexed) X(glGetQueryIndexediv) \
+    X(glReleaseShaderCompiler) X(glShaderBinary) X(glGetShaderPrecisionFormat) X(glDepthRangef) X(glClearDepthf) \
+    X(glGetProgramBinary) X(glProgramBinary) X(glProgramParameteri) X(glUseProgramStages) X(glActiveShaderProgram) \
+    X(glCreateShaderProgramv) X(glBindProgramPipeline) X(glDeleteProgramPipelines) X(glGenProgramPipelines) \
+    X(glIsProgramPipeline) X(glGetProgramPipelineiv) X(glProgramUniform1i) X(glProgramUniform1iv) \
+    X(glProgramUniform1f) X(glProgramUniform1fv) X(glProgramUniform1d) X(glProgramUniform1dv) X(glProgramUniform1ui) \
+    X(glProgramUniform1uiv) X(glProgramUniform2i) X(glProgramUniform2iv) X(glProgramUniform2f) \
+    X(glProgramUniform2fv) X(glProgramUniform2d) X(glProgramUniform2dv) X(glProgramUniform2ui) \
+    X(glProgramUniform2uiv) X(glProgramUniform3i) X(glProgramUniform3iv) X(glProgramUniform3f) \
+    X(glProgramUniform3fv) X(glProgramUniform3d) X(glProgramUniform3dv) X(glProgramUniform3ui) \
+    X(glProgramUniform3uiv) X(glProgramUniform4i) X(glProgramUniform4iv) X(glProgramUniform4f) \
+    X(glProgramUniform4fv) X(glProgramUniform4d) X(glProgramUniform4dv) X(glProgramUniform4ui) \
+    X(glProgramUniform4uiv) X(glProgramUniformMatrix2fv) X(glProgramUniformMatrix3fv) X(glProgramUniformMatrix4fv) \
+    X(glProgramUniformMatrix2dv) X(glProgramUniformMatrix3dv) X(glProgramUniformMatrix4dv) \
+    X(glProgramUniformMatrix2x3fv) X(glProgramUniformMatrix3x2fv) X(glProgramUniformMatrix2x4fv) \
+    X(glProgramUniformMatrix4x2fv) X(glProgramUniformMatrix3x4fv) X(glProgramUniformMatrix4x3fv) \
+    X(glProgramUniformMatrix2x3dv) X(glProgramUniformMatrix3x2dv) X(glProgramUniformMatrix2x4dv) \
+    X(glProgramUniformMatrix4x2dv) X(glProgramUniformMatrix3x4dv) X(glProgramUniformMatrix4x3dv) \
+    X(glValidateProgramPipeline) X(glGetProgramPipelineInfoLog) X(glVertexAttribL1d) X(glVertexAttribL2d) \
+    X(glVertexAttribL3d) X(glVertexAttribL4d) X(glVertexAttribL1dv) X(glVertexAttribL2dv) X(glVertexAttribL3dv) \
+    X(glVertexAttribL4dv) X(glVertexAttribLPointer) X(glGetVertexAttribLdv) X(glViewportArrayv) \
+    X(glViewportIndexedf) X(glViewportIndexedfv) X(glScissorArrayv) X(glScissorIndexed) X(glScissorIndexedv) \
+    X(glDepthRangeArrayv) X(glDepthRangeIndexed) X(glGetFloati_v) X(glGetDoublei_v) \
+    X(glDrawArraysInstancedBaseInstance) X(glDrawElementsInstancedBaseInstance) \
+    X(glDrawElementsInstancedBaseVertexBaseInstance) X(glGetInternalformativ) X(glGetActiveAtomicCounterBufferiv) \
+    X(glBindImageTexture) X(glMemoryBarrier) X(glTexStorage1D) X(glTexStorage2D) X(glTexStorage3D) \
+    X(glDrawTransformFeedbackInstanced) X(glDrawTransformFeedbackStreamInstanced) X(glClearBufferData) \
+    X(glClearBufferSubData) X(glDispatchCompute) X(glDispatchComputeIndirect) X(glCopyImageSubData) \
+    X(glFramebufferParameteri) X(glGetFramebufferParameteriv) X(glGetInternalformati64v) X(glInvalidateTexSubImage) \
+    X(glInvalidateTexImage) X(glInvalidateBufferSubData) X(glInvalidateBufferData) X(glInvalidateFramebuffer) \
+    X(glInvalidateSubFramebuffer) X(glMultiDrawArraysIndirect) X(glMultiDrawElementsIndirect) \
+    X(glGetProgramInterfaceiv) X(glGetProgramResourceIndex) X(glGetProgramResourceName) X(glGetProgramResourceiv) \
+    X(glGetProgramResourceLocation) X(glGetProgramResourceLocationIndex) X(glShaderStorageBlockBinding) \
+    X(glTexBufferRange) X(glTexStorage2DMultisample) X(glTexStorage3DMultisample) X(glTextureView) \
+    X(glBindVertexBuffer) X(glVertexAttribFormat) X(glVertexAttribIFormat) X(glVertexAttribLFormat) \
+    X(glVertexAttribBinding) X(glVertexBindingDivisor) X(glDebugMessageControl) X(glDebugMessageInsert) \
+    X(glDebugMessageCallback) X(glGetDebugMessageLog) X(glPushDebugGroup) X(glPopDebugGroup) X(glObjectLabel) \
+    X(glGetObjectLabel) X(glObjectPtrLabel) X(glGetObjectPtrLabel) X(glBufferStorage) X(glClearTexImage) \
+    X(glClearTexSubImage) X(glBindBuffersBase) X(glBindBuffersRange) X(glBindTextures) X(glBindSamplers) \
+    X(glBindImageTextures) X(glBindVertexBuffers) X(glClipControl) X(glCreateTransformFeedbacks) \
+    X(glTransformFeedbackBufferBase) X(glTransformFeedbackBufferRange) X(glGetTransformFeedbackiv) \
+    X(glGetTransformFeedbacki_v) X(glGetTransformFeedbacki64_v) X(glCreateBuffers) X(glNamedBufferStorage) \
+    X(glNamedBufferData) X(glNamedBufferSubData) X(glCopyNamedBufferSubData) X(glClearNamedBufferData) \
+    X(glClearNamedBufferSubData) X(glMapNamedBuffer) X(glMapNamedBufferRange) X(glUnmapNamedBuffer) \
+    X(glFlushMappedNamedBufferRange) X(glGetNamedBufferParameteriv) X(glGetNamedBufferParameteri64v) \
+    X(glGetNamedBufferPointerv) X(glGetNamedBufferSubData) X(glCreateFramebuffers) X(glNamedFramebufferRenderbuffer) \
+    X(glNamedFramebufferParameteri) X(glNamedFramebufferTexture) X(glNamedFramebufferTextureLayer) \
+    X(glNamedFramebufferDrawBuffer) X(glNamedFramebufferDrawBuffers) X(glNamedFramebufferReadBuffer) \
+    X(glInvalidateNamedFramebufferData) X(glInvalidateNamedFramebufferSubData) X(glClearNamedFramebufferiv) \
+    X(glClearNamedFramebufferuiv) X(glClearNamedFramebufferfv) X(glClearNamedFramebufferfi) \
+    X(glBlitNamedFramebuffer) X(glCheckNamedFramebufferStatus) X(glGetNamedFramebufferParameteriv) \
+    X(glGetNamedFramebufferAttachmentParameteriv) X(glCreateRenderbuffers) X(glNamedRenderbufferStorage) \
+    X(glNamedRenderbufferStorageMultisample) X(glGetNamedRenderbufferParameteriv) X(glCreateTextures) \
+    X(glTextureBuffer) X(glTextureBufferRange) X(glTextureStorage1D) X(glTextureStorage2D) X(glTextureStorage3D) \
+    X(glTextureStorage2DMultisample) X(glTextureStorage3DMultisample) X(glTextureSubImage1D) X(glTextureSubImage2D) \
+    X(glTextureSubImage3D) X(glCompressedTextureSubImage1D) X(glCompressedTextureSubImage2D) \
+    X(glCompressedTextureSubImage3D) X(glCopyTextureSubImage1D) X(glCopyTextureSubImage2D) \
+    X(glCopyTextureSubImage3D) X(glTextureParameterf) X(glTextureParameterfv) X(glTextureParameteri) \
+    X(glTextureParameterIiv) X(glTextureParameterIuiv) X(glTextureParameteriv) X(glGenerateTextureMipmap) \
+    X(glBindTextureUnit) X(glGetTextureImage) X(glGetCompressedTextureImage) X(glGetTextureLevelParameterfv) \
+    X(glGetTextureLevelParameteriv) X(glGetTextureParameterfv) X(glGetTextureParameterIiv) \
+    X(glGetTextureParameterIuiv) X(glGetTextureParameteriv) X(glCreateVertexArrays) X(glDisableVertexArrayAttrib) \
+    X(glEnableVertexArrayAttrib) X(glVertexArrayElementBuffer) X(glVertexArrayVertexBuffer) \
+    X(glVertexArrayVertexBuffers) X(glVertexArrayAttribBinding) X(glVertexArrayAttribFormat) \
+    X(glVertexArrayAttribIFormat) X(glVertexArrayAttribLFormat) X(glVertexArrayBindingDivisor) X(glGetVertexArrayiv) \
+    X(glGetVertexArrayIndexediv) X(glGetVertexArrayIndexed64iv) X(glCreateSamplers) X(glCreateProgramPipelines) \
+    X(glCreateQueries) X(glGetQueryBufferObjecti64v) X(glGetQueryBufferObjectiv) X(glGetQueryBufferObjectui64v) \
+    X(glGetQueryBufferObjectuiv) X(glMemoryBarrierByRegion) X(glGetTextureSubImage) \
+    X(glGetCompressedTextureSubImage) X(glGetGraphicsResetStatus) X(glGetnCompressedTexImage) X(glGetnTexImage) \
+    X(glGetnUniformdv) X(glGetnUniformfv) X(glGetnUniformiv) X(glGetnUniformuiv) X(glReadnPixels) X(glGetnMapdv) \
+    X(glGetnMapfv) X(glGetnMapiv) X(glGetnPixelMapfv) X(glGetnPixelMapuiv) X(glGetnPixelMapusv) \
+    X(glGetnPolygonStipple) X(glGetnColorTable) X(glGetnConvolutionFilter) X(glGetnSeparableFilter) \
+    X(glGetnHistogram) X(glGetnMinmax) X(glTextureBarrier) X(glSpecializeShader) X(glMultiDrawArraysIndirectCount) \
+    X(glMultiDrawElementsIndirectCount) X(glPolygonOffsetClamp) X(glTbufferMask3DFX) X(glDebugMessageEnableAMD) \
+    X(glDebugMessageInsertAMD) X(glDebugMessageCallbackAMD) X(glGetDebugMessageLogAMD) X(glBlendFuncIndexedAMD) \
+    X(glBlendFuncSeparateIndexedAMD) X(glBlendEquationIndexedAMD) X(glBlendEquationSeparateIndexedAMD) \
+    X(glRenderbufferStorageMultisampleAdvancedAMD) X(glNamedRenderbufferStorageMultisampleAdvancedAMD) \
+    X(glFramebufferSamplePositionsfvAMD) X(glNamedFramebufferSamplePositionsfvAMD) X(glGetFramebufferParameterfvAMD) \
+    X(glGetNamedFramebufferParameterfvAMD) X(glUniform1i64NV) X(glUniform2i64NV) X(glUniform3i64NV) \
+    X(glUniform4i64NV) X(glUniform1i64vNV) X(glUniform2i64vNV) X(glUniform3i64vNV) X(glUniform4i64vNV) \
+    X(glUniform1ui64NV) X(glUniform2ui64NV) X(glUniform3ui64NV) X(glUniform4ui64NV) X(glUniform1ui64vNV) \
+    X(glUniform2ui64vNV) X(glUniform3ui64vNV) X(glUniform4ui64vNV) X(glGetUniformi64vNV) X(glGetUniformui64vNV) \
+    X(glProgramUniform1i64NV) X(glProgramUniform2i64NV) X(glProgramUniform3i64NV) X(glProgramUniform4i64NV) \
+    X(glProgramUniform1i64vNV) X(glProgramUniform2i64vNV) X(glProgramUniform3i64vNV) X(glProgramUniform4i64vNV) \
+    X(glProgramUniform1ui64NV) X(glProgramUniform2ui64NV) X(glProgramUniform3ui64NV) X(glProgramUniform4ui64NV) \
+    X(glProgramUniform1ui64vNV) X(glProgramUniform2ui64vNV) X(glProgramUniform3ui64vNV) X(glProgramUniform4ui64vNV) \
+    X(glVertexAttribParameteriAMD) X(glMultiDrawArraysIndirectAMD) X(glMultiDrawElementsIndirectAMD) \
+    X(glGenNamesAMD) X(glDeleteNamesAMD) X(glIsNameAMD) X(glQueryObjectParameteruiAMD) X(glGetPerfMonitorGroupsAMD) \
+    X(glGetPerfMonitorCountersAMD) X(glGetPerfMonitorGroupStringAMD) X(glGetPerfMonitorCounterStringAMD) \
+    X(glGetPerfMonitorCounterInfoAMD) X(glGenPerfMonitorsAMD) X(glDeletePerfMonitorsAMD) \
+    X(glSelectPerfMonitorCountersAMD) X(glBeginPerfMonitorAMD) X(glEndPerfMonitorAMD) \
+    X(glGetPerfMonitorCounterDataAMD) X(glSetMultisamplefvAMD) X(glTexStorageSparseAMD) X(glTextureStorageSparseAMD) \
+    X(glStencilOpValueAMD) X(glTessellationFactorAMD) X(glTessellationModeAMD) X(glElementPointerAPPLE) \
+    X(glDrawElementArrayAPPLE) X(glDrawRangeElementArrayAPPLE) X(glMultiDrawElementArrayAPPLE) \
+    X(glMultiDrawRangeElementArrayAPPLE) X(glGenFencesAPPLE) X(glDeleteFencesAPPLE) X(glSetFenceAPPLE) \
+    X(glIsFenceAPPLE) X(glTestFenceAPPLE) X(glFinishFenceAPPLE) X(glTestObjectAPPLE) X(glFinishObjectAPPLE) \
+    X(glBufferParameteriAPPLE) X(glFlushMappedBufferRangeAPPLE) X(glObjectPurgeableAPPLE) \
+    X(glObjectUnpurgeableAPPLE) X(glGetObjectParameterivAPPLE) X(glTextureRangeAPPLE) \
+    X(glGetTexParameterPointervAPPLE) X(glBindVertexArrayAPPLE) X(glDeleteVertexArraysAPPLE) \
+    X(glGenVertexArraysAPPLE) X(glIsVertexArrayAPPLE) X(glVertexArrayRangeAPPLE) X(glFlushVertexArrayRangeAPPLE) \
+    X(glVertexArrayParameteriAPPLE) X(glEnableVertexAttribAPPLE) X(glDisableVertexAttribAPPLE) \
+    X(glIsVertexAttribEnabledAPPLE) X(glMapVertexAttrib1dAPPLE) X(glMapVertexAttrib1fAPPLE) \
+    X(glMapVertexAttrib2dAPPLE) X(glMapVertexAttrib2fAPPLE) X(glPrimitiveBoundingBoxARB) X(glGetTextureHandleARB) \
+    X(glGetTextureSamplerHandleARB) X(glMakeTextureHandleResidentARB) X(glMakeTextureHandleNonResidentARB) \
+    X(glGetImageHandleARB) X(glMakeImageHandleResidentARB) X(glMakeImageHandleNonResidentARB) \
+    X(glUniformHandleui64ARB) X(glUniformHandleui64vARB) X(glProgramUniformHandleui64ARB) \
+    X(glProgramUniformHandleui64vARB) X(glIsTextureHandleResidentARB) X(glIsImageHandleResidentARB) \
+    X(glVertexAttribL1ui64ARB) X(glVertexAttribL1ui64vARB) X(glGetVertexAttribLui64vARB) \
+    X(glCreateSyncFromCLeventARB) X(glClampColorARB) X(glDispatchComputeGroupSizeARB) X(glDebugMessageControlARB) \
+    X(glDebugMessageInsertARB) X(glDebugMessageCallbackARB) X(glGetDebugMessageLogARB) X(glDrawBuffersARB) \
+    X(glBlendEquationiARB) X(glBlendEquationSeparateiARB) X(glBlendFunciARB) X(glBlendFuncSeparateiARB) \
+    X(glDrawArraysInstancedARB) X(glDrawElementsInstancedARB) X(glProgramStringARB) X(glBindProgramARB) \
+    X(glDeleteProgramsARB) X(glGenProgramsARB) X(glProgramEnvParameter4dARB) X(glProgramEnvParameter4dvARB) \
+    X(glProgramEnvParameter4fARB) X(glProgramEnvParameter4fvARB) X(glProgramLocalParameter4dARB) \
+    X(glProgramLocalParameter4dvARB) X(glProgramLocalParameter4fARB) X(glProgramLocalParameter4fvARB) \
+    X(glGetProgramEnvParameterdvARB) X(glGetProgramEnvParameterfvARB) X(glGetProgramLocalParameterdvARB) \
+    X(glGetProgramLocalParameterfvARB) X(glGetProgramivARB) X(glGetProgramStringARB) X(glIsProgramARB) \
+    X(glProgramParameteriARB) X(glFramebufferTextureARB) X(glFramebufferTextureLayerARB) \
+    X(glFramebufferTextureFaceARB) X(glSpecializeShaderARB) X(glUniform1i64ARB) X(glUniform2i64ARB) \
+    X(glUniform3i64ARB) X(glUniform4i64ARB) X(glUniform1i64vARB) X(glUniform2i64vARB) X(glUniform3i64vARB) \
+    X(glUniform4i64vARB) X(glUniform1ui64ARB) X(glUniform2ui64ARB) X(glUniform3ui64ARB) X(glUniform4ui64ARB) \
+    X(glUniform1ui64vARB) X(glUniform2ui64vARB) X(glUniform3ui64vARB) X(glUniform4ui64vARB) X(glGetUniformi64vARB) \
+    X(glGetUniformui64vARB) X(glGetnUniformi64vARB) X(glGetnUniformui64vARB) X(glProgramUniform1i64ARB) \
+    X(glProgramUniform2i64ARB) X(glProgramUniform3i64ARB) X(glProgramUniform4i64ARB) X(glProgramUniform1i64vARB) \
+    X(glProgramUniform2i64vARB) X(glProgramUniform3i64vARB) X(glProgramUniform4i64vARB) X(glProgramUniform1ui64ARB) \
+    X(glProgramUniform2ui64ARB) X(glProgramUniform3ui64ARB) X(glProgramUniform4ui64ARB) X(glProgramUniform1ui64vARB) \
+    X(glProgramUniform2ui64vARB) X(glProgramUniform3ui64vARB) X(glProgramUniform4ui64vARB) X(glColorTable) \
+    X(glColorTableParameterfv) X(glColorTableParameteriv) X(glCopyColorTable) X(glGetColorTable) \
+    X(glGetColorTableParameterfv) X(glGetColorTableParameteriv) X(glColorSubTable) X(glCopyColorSubTable) \
+    X(glConvolutionFilter1D) X(glConvolutionFilter2D) X(glConvolutionParameterf) X(glConvolutionParameterfv) \
+    X(glConvolutionParameteri) X(glConvolutionParameteriv) X(glCopyConvolutionFilter1D) X(glCopyConvolutionFilter2D) \
+    X(glGetConvolutionFilter) X(glGetConvolutionParameterfv) X(glGetConvolutionParameteriv) X(glGetSeparableFilter) \
+    X(glSeparableFilter2D) X(glGetHistogram) X(glGetHistogramParameterfv) X(glGetHistogramParameteriv) \
+    X(glGetMinmax) X(glGetMinmaxParameterfv) X(glGetMinmaxParameteriv) X(glHistogram) X(glMinmax) \
+    X(glResetHistogram) X(glResetMinmax) X(glMultiDrawArraysIndirectCountARB) X(glMultiDrawElementsIndirectCountARB) \
+    X(glVertexAttribDivisorARB) X(glCurrentPaletteMatrixARB) X(glMatrixIndexubvARB) X(glMatrixIndexusvARB) \
+    X(glMatrixIndexuivARB) X(glMatrixIndexPointerARB) X(glSampleCoverageARB) X(glActiveTextureARB) \
+    X(glClientActiveTextureARB) X(glMultiTexCoord1dARB) X(glMultiTexCoord1dvARB) X(glMultiTexCoord1fARB) \
+    X(glMultiTexCoord1fvARB) X(glMultiTexCoord1iARB) X(glMultiTexCoord1ivARB) X(glMultiTexCoord1sARB) \
+    X(glMultiTexCoord1svARB) X(glMultiTexCoord2dARB) X(glMultiTexCoord2dvARB) X(glMultiTexCoord2fARB) \
+    X(glMultiTexCoord2fvARB) X(glMultiTexCoord2iARB) X(glMultiTexCoord2ivARB) X(glMultiTexCoord2sARB) \
+    X(glMultiTexCoord2svARB) X(glMultiTexCoord3dARB) X(glMultiTexCoord3dvARB) X(glMultiTexCoord3fARB) \
+    X(glMultiTexCoord3fvARB) X(glMultiTexCoord3iARB) X(glMultiTexCoord3ivARB) X(glMultiTexCoord3sARB) \
+    X(glMultiTexCoord3svARB) X(glMultiTexCoord4dARB) X(glMultiTexCoord4dvARB) X(glMultiTexCoord4fARB) \
+    X(glMultiTexCoord4fvARB) X(glMultiTexCoord4iARB) X(glMultiTexCoord4ivARB) X(glMultiTexCoord4sARB) \
+    X(glMultiTexCoord4svARB) X(glGenQueriesARB) X(glDeleteQueriesARB) X(glIsQueryARB) X(glBeginQueryARB) \
+    X(glEndQueryARB) X(glGetQueryivARB) X(glGetQueryObjectivARB) X(glGetQueryObjectuivARB) \
+    X(glMaxShaderCompilerThreadsARB) X(glPointParameterfARB) X(glPointParameterfvARB) X(glGetGraphicsResetStatusARB) \
+    X(glGetnTexImageARB) X(glReadnPixelsARB) X(glGetnCompressedTexImageARB) X(glGetnUniformfvARB) \
+    X(glGetnUniformivARB) X(glGetnUniformuivARB) X(glGetnUniformdvARB) X(glGetnMapdvARB) X(glGetnMapfvARB) \
+    X(glGetnMapivARB) X(glGetnPixelMapfvARB) X(glGetnPixelMapuivARB) X(glGetnPixelMapusvARB) \
+    X(glGetnPolygonStippleARB) X(glGetnColorTableARB) X(glGetnConvolutionFilterARB) X(glGetnSeparableFilterARB) \
+    X(glGetnHistogramARB) X(glGetnMinmaxARB) X(glFramebufferSampleLocationsfvARB) \
+    X(glNamedFramebufferSampleLocationsfvARB) X(glEvaluateDepthValuesARB) X(glMinSampleShadingARB) \
+    X(glDeleteObjectARB) X(glGetHandleARB) X(glDetachObjectARB) X(glCreateShaderObjectARB) X(glShaderSourceARB) \
+    X(glCompileShaderARB) X(glCreateProgramObjectARB) X(glAttachObjectARB) X(glLinkProgramARB) \
+    X(glUseProgramObjectARB) X(glValidateProgramARB) X(glUniform1fARB) X(glUniform2fARB) X(glUniform3fARB) \
+    X(glUniform4fARB) X(glUniform1iARB) X(glUniform2iARB) X(glUniform3iARB) X(glUniform4iARB) X(glUniform1fvARB) \
+    X(glUniform2fvARB) X(glUniform3fvARB) X(glUniform4fvARB) X(glUniform1ivARB) X(glUniform2ivARB) \
+    X(glUniform3ivARB) X(glUniform4ivARB) X(glUniformMatrix2fvARB) X(glUniformMatrix3fvARB) X(glUniformMatrix4fvARB) \
+    X(glGetObjectParameterfvARB) X(glGetObjectParameterivARB) X(glGetInfoLogARB) X(glGetAttachedObjectsARB) \
+    X(glGetUniformLocationARB) X(glGetActiveUniformARB) X(glGetUniformfvARB) X(glGetUniformivARB) \
+    X(glGetShaderSourceARB) X(glNamedStringARB) X(glDeleteNamedStringARB) X(glCompileShaderIncludeARB) \
+    X(glIsNamedStringARB) X(glGetNamedStringARB) X(glGetNamedStringivARB) X(glBufferPageCommitmentARB) \
+    X(glNamedBufferPageCommitmentEXT) X(glNamedBufferPageCommitmentARB) X(glTexPageCommitmentARB) X(glTexBufferARB) \
+    X(glCompressedTexImage3DARB) X(glCompressedTexImage2DARB) X(glCompressedTexImage1DARB) \
+    X(glCompressedTexSubImage3DARB) X(glCompressedTexSubImage2DARB) X(glCompressedTexSubImage1DARB) \
+    X(glGetCompressedTexImageARB) X(glLoadTransposeMatrixfARB) X(glLoadTransposeMatrixdARB) \
+    X(glMultTransposeMatrixfARB) X(glMultTransposeMatrixdARB) X(glWeightbvARB) X(glWeightsvARB) X(glWeightivARB) \
+    X(glWeightfvARB) X(glWeightdvARB) X(glWeightubvARB) X(glWeightusvARB) X(glWeightuivARB) X(glWeightPointerARB) \
+    X(glVertexBlendARB) X(glBindBufferARB) X(glDeleteBuffersARB) X(glGenBuffersARB) X(glIsBufferARB) \
+    X(glBufferDataARB) X(glBufferSubDataARB) X(glGetBufferSubDataARB) X(glMapBufferARB) X(glUnmapBufferARB) \
+    X(glGetBufferParameterivARB) X(glGetBufferPointervARB) X(glVertexAttrib1dARB) X(glVertexAttrib1dvARB) \
+    X(glVertexAttrib1fARB) X(glVertexAttrib1fvARB) X(glVertexAttrib1sARB) X(glVertexAttrib1svARB) \
+    X(glVertexAttrib2dARB) X(glVertexAttrib2dvARB) X(glVertexAttrib2fARB) X(glVertexAttrib2fvARB) \
+    X(glVertexAttrib2sARB) X(glVertexAttrib2svARB) X(glVertexAttrib3dARB) X(glVertexAttrib3dvARB) \
+    X(glVertexAttrib3fARB) X(glVertexAttrib3fvARB) X(glVertexAttrib3sARB) X(glVertexAttrib3svARB) \
+    X(glVertexAttrib4NbvARB) X(glVertexAttrib4NivARB) X(glVertexAttrib4NsvARB) X(glVertexAttrib4NubARB) \
+    X(glVertexAttrib4NubvARB) X(glVertexAttrib4NuivARB) X(glVertexAttrib4NusvARB) X(glVertexAttrib4bvARB) \
+    X(glVertexAttrib4dARB) X(glVertexAttrib4dvARB) X(glVertexAttrib4fARB) X(glVertexAttrib4fvARB) \
+    X(glVertexAttrib4ivARB) X(glVertexAttrib4sARB) X(glVertexAttrib4svARB) X(glVertexAttrib4ubvARB) \
+    X(glVertexAttrib4uivARB) X(glVertexAttrib4usvARB) X(glVertexAttribPointerARB) X(glEnableVertexAttribArrayARB) \
+    X(glDisableVertexAttribArrayARB) X(glGetVertexAttribdvARB) X(glGetVertexAttribfvARB) X(glGetVertexAttribivARB) \
+    X(glGetVertexAttribPointervARB) X(glBindAttribLocationARB) X(glGetActiveAttribARB) X(glGetAttribLocationARB) \
+    X(glDepthRangeArraydvNV) X(glDepthRangeIndexeddNV) X(glWindowPos2dARB) X(glWindowPos2dvARB) X(glWindowPos2fARB) \
+    X(glWindowPos2fvARB) X(glWindowPos2iARB) X(glWindowPos2ivARB) X(glWindowPos2sARB) X(glWindowPos2svARB) \
+    X(glWindowPos3dARB) X(glWindowPos3dvARB) X(glWindowPos3fARB) X(glWindowPos3fvARB) X(glWindowPos3iARB) \
+    X(glWindowPos3ivARB) X(glWindowPos3sARB) X(glWindowPos3svARB) X(glDrawBuffersATI) X(glElementPointerATI) \
+    X(glDrawElementArrayATI) X(glDrawRangeElementArrayATI) X(glTexBumpParameterivATI) X(glTexBumpParameterfvATI) \
+    X(glGetTexBumpParameterivATI) X(glGetTexBumpParameterfvATI) X(glGenFragmentShadersATI) \
+    X(glBindFragmentShaderATI) X(glDeleteFragmentShaderATI) X(glBeginFragmentShaderATI) X(glEndFragmentShaderATI) \
+    X(glPassTexCoordATI) X(glSampleMapATI) X(glColorFragmentOp1ATI) X(glColorFragmentOp2ATI) \
+    X(glColorFragmentOp3ATI) X(glAlphaFragmentOp1ATI) X(glAlphaFragmentOp2ATI) X(glAlphaFragmentOp3ATI) \
+    X(glSetFragmentShaderConstantATI) X(glMapObjectBufferATI) X(glUnmapObjectBufferATI) X(glPNTrianglesiATI) \
+    X(glPNTrianglesfATI) X(glStencilOpSeparateATI) X(glStencilFuncSeparateATI) X(glNewObjectBufferATI) \
+    X(glIsObjectBufferATI) X(glUpdateObjectBufferATI) X(glGetObjectBufferfvATI) X(glGetObjectBufferivATI) \
+    X(glFreeObjectBufferATI) X(glArrayObjectATI) X(glGetArrayObjectfvATI) X(glGetArrayObjectivATI) \
+    X(glVariantArrayObjectATI) X(glGetVariantArrayObjectfvATI) X(glGetVariantArrayObjectivATI) \
+    X(glVertexAttribArrayObjectATI) X(glGetVertexAttribArrayObjectfvATI) X(glGetVertexAttribArrayObjectivATI) \
+    X(glVertexStream1sATI) X(glVertexStream1svATI) X(glVertexStream1iATI) X(glVertexStream1ivATI) \
+    X(glVertexStream1fATI) X(glVertexStream1fvATI) X(glVertexStream1dATI) X(glVertexStream1dvATI) \
+    X(glVertexStream2sATI) X(glVertexStream2svATI) X(glVertexStream2iATI) X(glVertexStream2ivATI) \
+    X(glVertexStream2fATI) X(glVertexStream2fvATI) X(glVertexStream2dATI) X(glVertexStream2dvATI) \
+    X(glVertexStream3sATI) X(glVertexStream3svATI) X(glVertexStream3iATI) X(glVertexStream3ivATI) \
+    X(glVertexStream3fATI) X(glVertexStream3fvATI) X(glVertexStream3dATI) X(glVertexStream3dvATI) \
+    X(glVertexStream4sATI) X(glVertexStream4svATI) X(glVertexStream4iATI) X(glVertexStream4ivATI) \
+    X(glVertexStream4fATI) X(glVertexStream4fvATI) X(glVertexStream4dATI) X(glVertexStream4dvATI) \
+    X(glNormalStream3bATI) X(glNormalStream3bvATI) X(glNormalStream3sATI) X(glNormalStream3svATI) \
+    X(glNormalStream3iATI) X(glNormalStream3ivATI) X(glNormalStream3fATI) X(glNormalStream3fvATI) \
+    X(glNormalStream3dATI) X(glNormalStream3dvATI) X(glClientActiveVertexStreamATI) X(glVertexBlendEnviATI) \
+    X(glVertexBlendEnvfATI) X(glEGLImageTargetTexStorageEXT) X(glEGLImageTargetTextureStorageEXT) \
+    X(glUniformBufferEXT) X(glGetUniformBufferSizeEXT) X(glGetUniformOffsetEXT) X(glBlendColorEXT) \
+    X(glBlendEquationSeparateEXT) X(glBlendFuncSeparateEXT) X(glBlendEquationEXT) X(glColorSubTableEXT) \
+    X(glCopyColorSubTableEXT) X(glLockArraysEXT) X(glUnlockArraysEXT) X(glConvolutionFilter1DEXT) \
+    X(glConvolutionFilter2DEXT) X(glConvolutionParameterfEXT) X(glConvolutionParameterfvEXT) \
+    X(glConvolutionParameteriEXT) X(glConvolutionParameterivEXT) X(glCopyConvolutionFilter1DEXT) \
+    X(glCopyConvolutionFilter2DEXT) X(glGetConvolutionFilterEXT) X(glGetConvolutionParameterfvEXT) \
+    X(glGetConvolutionParameterivEXT) X(glGetSeparableFilterEXT) X(glSeparableFilter2DEXT) X(glTangent3bEXT) \
+    X(glTangent3bvEXT) X(glTangent3dEXT) X(glTangent3dvEXT) X(glTangent3fEXT) X(glTangent3fvEXT) X(glTangent3iEXT) \
+    X(glTangent3ivEXT) X(glTangent3sEXT) X(glTangent3svEXT) X(glBinormal3bEXT) X(glBinormal3bvEXT) \
+    X(glBinormal3dEXT) X(glBinormal3dvEXT) X(glBinormal3fEXT) X(glBinormal3fvEXT) X(glBinormal3iEXT) \
+    X(glBinormal3ivEXT) X(glBinormal3sEXT) X(glBinormal3svEXT) X(glTangentPointerEXT) X(glBinormalPointerEXT) \
+    X(glCopyTexImage1DEXT) X(glCopyTexImage2DEXT) X(glCopyTexSubImage1DEXT) X(glCopyTexSubImage2DEXT) \
+    X(glCopyTexSubImage3DEXT) X(glCullParameterdvEXT) X(glCullParameterfvEXT) X(glLabelObjectEXT) \
+    X(glGetObjectLabelEXT) X(glInsertEventMarkerEXT) X(glPushGroupMarkerEXT) X(glPopGroupMarkerEXT) \
+    X(glDepthBoundsEXT) X(glMatrixLoadfEXT) X(glMatrixLoaddEXT) X(glMatrixMultfEXT) X(glMatrixMultdEXT) \
+    X(glMatrixLoadIdentityEXT) X(glMatrixRotatefEXT) X(glMatrixRotatedEXT) X(glMatrixScalefEXT) X(glMatrixScaledEXT) \
+    X(glMatrixTranslatefEXT) X(glMatrixTranslatedEXT) X(glMatrixFrustumEXT) X(glMatrixOrthoEXT) X(glMatrixPopEXT) \
+    X(glMatrixPushEXT) X(glClientAttribDefaultEXT) X(glPushClientAttribDefaultEXT) X(glTextureParameterfEXT) \
+    X(glTextureParameterfvEXT) X(glTextureParameteriEXT) X(glTextureParameterivEXT) X(glTextureImage1DEXT) \
+    X(glTextureImage2DEXT) X(glTextureSubImage1DEXT) X(glTextureSubImage2DEXT) X(glCopyTextureImage1DEXT) \
+    X(glCopyTextureImage2DEXT) X(glCopyTextureSubImage1DEXT) X(glCopyTextureSubImage2DEXT) X(glGetTextureImageEXT) \
+    X(glGetTextureParameterfvEXT) X(glGetTextureParameterivEXT) X(glGetTextureLevelParameterfvEXT) \
+    X(glGetTextureLevelParameterivEXT) X(glTextureImage3DEXT) X(glTextureSubImage3DEXT) \
+    X(glCopyTextureSubImage3DEXT) X(glBindMultiTextureEXT) X(glMultiTexCoordPointerEXT) X(glMultiTexEnvfEXT) \
+    X(glMultiTexEnvfvEXT) X(glMultiTexEnviEXT) X(glMultiTexEnvivEXT) X(glMultiTexGendEXT) X(glMultiTexGendvEXT) \
+    X(glMultiTexGenfEXT) X(glMultiTexGenfvEXT) X(glMultiTexGeniEXT) X(glMultiTexGenivEXT) X(glGetMultiTexEnvfvEXT) \
+    X(glGetMultiTexEnvivEXT) X(glGetMultiTexGendvEXT) X(glGetMultiTexGenfvEXT) X(glGetMultiTexGenivEXT) \
+    X(glMultiTexParameteriEXT) X(glMultiTexParameterivEXT) X(glMultiTexParameterfEXT) X(glMultiTexParameterfvEXT) \
+    X(glMultiTexImage1DEXT) X(glMultiTexImage2DEXT) X(glMultiTexSubImage1DEXT) X(glMultiTexSubImage2DEXT) \
+    X(glCopyMultiTexImage1DEXT) X(glCopyMultiTexImage2DEXT) X(glCopyMultiTexSubImage1DEXT) \
+    X(glCopyMultiTexSubImage2DEXT) X(glGetMultiTexImageEXT) X(glGetMultiTexParameterfvEXT) \
+    X(glGetMultiTexParameterivEXT) X(glGetMultiTexLevelParameterfvEXT) X(glGetMultiTexLevelParameterivEXT) \
+    X(glMultiTexImage3DEXT) X(glMultiTexSubImage3DEXT) X(glCopyMultiTexSubImage3DEXT) \
+    X(glEnableClientStateIndexedEXT) X(glDisableClientStateIndexedEXT) X(glGetFloatIndexedvEXT) \
+    X(glGetDoubleIndexedvEXT) X(glGetPointerIndexedvEXT) X(glEnableIndexedEXT) X(glDisableIndexedEXT) \
+    X(glIsEnabledIndexedEXT) X(glGetIntegerIndexedvEXT) X(glGetBooleanIndexedvEXT) X(glCompressedTextureImage3DEXT) \
+    X(glCompressedTextureImage2DEXT) X(glCompressedTextureImage1DEXT) X(glCompressedTextureSubImage3DEXT) \
+    X(glCompressedTextureSubImage2DEXT) X(glCompressedTextureSubImage1DEXT) X(glGetCompressedTextureImageEXT) \
+    X(glCompressedMultiTexImage3DEXT) X(glCompressedMultiTexImage2DEXT) X(glCompressedMultiTexImage1DEXT) \
+    X(glCompressedMultiTexSubImage3DEXT) X(glCompressedMultiTexSubImage2DEXT) X(glCompressedMultiTexSubImage1DEXT) \
+    X(glGetCompressedMultiTexImageEXT) X(glMatrixLoadTransposefEXT) X(glMatrixLoadTransposedEXT) \
+    X(glMatrixMultTransposefEXT) X(glMatrixMultTransposedEXT) X(glNamedBufferDataEXT) X(glNamedBufferSubDataEXT) \
+    X(glMapNamedBufferEXT) X(glUnmapNamedBufferEXT) X(glGetNamedBufferParameterivEXT) X(glGetNamedBufferPointervEXT) \
+    X(glGetNamedBufferSubDataEXT) X(glProgramUniform1fEXT) X(glProgramUniform2fEXT) X(glProgramUniform3fEXT) \
+    X(glProgramUniform4fEXT) X(glProgramUniform1iEXT) X(glProgramUniform2iEXT) X(glProgramUniform3iEXT) \
+    X(glProgramUniform4iEXT) X(glProgramUniform1fvEXT) X(glProgramUniform2fvEXT) X(glProgramUniform3fvEXT) \
+    X(glProgramUniform4fvEXT) X(glProgramUniform1ivEXT) X(glProgramUniform2ivEXT) X(glProgramUniform3ivEXT) \
+    X(glProgramUniform4ivEXT) X(glProgramUniformMatrix2fvEXT) X(glProgramUniformMatrix3fvEXT) \
+    X(glProgramUniformMatrix4fvEXT) X(glProgramUniformMatrix2x3fvEXT) X(glProgramUniformMatrix3x2fvEXT) \
+    X(glProgramUniformMatrix2x4fvEXT) X(glProgramUniformMatrix4x2fvEXT) X(glProgramUniformMatrix3x4fvEXT) \
+    X(glProgramUniformMatrix4x3fvEXT) X(glTextureBufferEXT) X(glMultiTexBufferEXT) X(glTextureParameterIivEXT) \
+    X(glTextureParameterIuivEXT) X(glGetTextureParameterIivEXT) X(glGetTextureParameterIuivEXT) \
+    X(glMultiTexParameterIivEXT) X(glMultiTexParameterIuivEXT) X(glGetMultiTexParameterIivEXT) \
+    X(glGetMultiTexParameterIuivEXT) X(glProgramUniform1uiEXT) X(glProgramUniform2uiEXT) X(glProgramUniform3uiEXT) \
+    X(glProgramUniform4uiEXT) X(glProgramUniform1uivEXT) X(glProgramUniform2uivEXT) X(glProgramUniform3uivEXT) \
+    X(glProgramUniform4uivEXT) X(glNamedProgramLocalParameters4fvEXT) X(glNamedProgramLocalParameterI4iEXT) \
+    X(glNamedProgramLocalParameterI4ivEXT) X(glNamedProgramLocalParametersI4ivEXT) \
+    X(glNamedProgramLocalParameterI4uiEXT) X(glNamedProgramLocalParameterI4uivEXT) \
+    X(glNamedProgramLocalParametersI4uivEXT) X(glGetNamedProgramLocalParameterIivEXT) \
+    X(glGetNamedProgramLocalParameterIuivEXT) X(glEnableClientStateiEXT) X(glDisableClientStateiEXT) \
+    X(glGetFloati_vEXT) X(glGetDoublei_vEXT) X(glGetPointeri_vEXT) X(glNamedProgramStringEXT) \
+    X(glNamedProgramLocalParameter4dEXT) X(glNamedProgramLocalParameter4dvEXT) X(glNamedProgramLocalParameter4fEXT) \
+    X(glNamedProgramLocalParameter4fvEXT) X(glGetNamedProgramLocalParameterdvEXT) \
+    X(glGetNamedProgramLocalParameterfvEXT) X(glGetNamedProgramivEXT) X(glGetNamedProgramStringEXT) \
+    X(glNamedRenderbufferStorageEXT) X(glGetNamedRenderbufferParameterivEXT) \
+    X(glNamedRenderbufferStorageMultisampleEXT) X(glNamedRenderbufferStorageMultisampleCoverageEXT) \
+    X(glCheckNamedFramebufferStatusEXT) X(glNamedFramebufferTexture1DEXT) X(glNamedFramebufferTexture2DEXT) \
+    X(glNamedFramebufferTexture3DEXT) X(glNamedFramebufferRenderbufferEXT) \
+    X(glGetNamedFramebufferAttachmentParameterivEXT) X(glGenerateTextureMipmapEXT) X(glGenerateMultiTexMipmapEXT) \
+    X(glFramebufferDrawBufferEXT) X(glFramebufferDrawBuffersEXT) X(glFramebufferReadBufferEXT) \
+    X(glGetFramebufferParameterivEXT) X(glNamedCopyBufferSubDataEXT) X(glNamedFramebufferTextureEXT) \
+    X(glNamedFramebufferTextureLayerEXT) X(glNamedFramebufferTextureFaceEXT) X(glTextureRenderbufferEXT) \
+    X(glMultiTexRenderbufferEXT) X(glVertexArrayVertexOffsetEXT) X(glVertexArrayColorOffsetEXT) \
+    X(glVertexArrayEdgeFlagOffsetEXT) X(glVertexArrayIndexOffsetEXT) X(glVertexArrayNormalOffsetEXT) \
+    X(glVertexArrayTexCoordOffsetEXT) X(glVertexArrayMultiTexCoordOffsetEXT) X(glVertexArrayFogCoordOffsetEXT) \
+    X(glVertexArraySecondaryColorOffsetEXT) X(glVertexArrayVertexAttribOffsetEXT) \
+    X(glVertexArrayVertexAttribIOffsetEXT) X(glEnableVertexArrayEXT) X(glDisableVertexArrayEXT) \
+    X(glEnableVertexArrayAttribEXT) X(glDisableVertexArrayAttribEXT) X(glGetVertexArrayIntegervEXT) \
+    X(glGetVertexArrayPointervEXT) X(glGetVertexArrayIntegeri_vEXT) X(glGetVertexArrayPointeri_vEXT) \
+    X(glMapNamedBufferRangeEXT) X(glFlushMappedNamedBufferRangeEXT) X(glNamedBufferStorageEXT) \
+    X(glClearNamedBufferDataEXT) X(glClearNamedBufferSubDataEXT) X(glNamedFramebufferParameteriEXT) \
+    X(glGetNamedFramebufferParameterivEXT) X(glProgramUniform1dEXT) X(glProgramUniform2dEXT) \
+    X(glProgramUniform3dEXT) X(glProgramUniform4dEXT) X(glProgramUniform1dvEXT) X(glProgramUniform2dvEXT) \
+    X(glProgramUniform3dvEXT) X(glProgramUniform4dvEXT) X(glProgramUniformMatrix2dvEXT) \
+    X(glProgramUniformMatrix3dvEXT) X(glProgramUniformMatrix4dvEXT) X(glProgramUniformMatrix2x3dvEXT) \
+    X(glProgramUniformMatrix2x4dvEXT) X(glProgramUniformMatrix3x2dvEXT) X(glProgramUniformMatrix3x4dvEXT) \
+    X(glProgramUniformMatrix4x2dvEXT) X(glProgramUniformMatrix4x3dvEXT) X(glTextureBufferRangeEXT) \
+    X(glTextureStorage1DEXT) X(glTextureStorage2DEXT) X(glTextureStorage3DEXT) X(glTextureStorage2DMultisampleEXT) \
+    X(glTextureStorage3DMultisampleEXT) X(glVertexArrayBindVertexBufferEXT) X(glVertexArrayVertexAttribFormatEXT) \
+    X(glVertexArrayVertexAttribIFormatEXT) X(glVertexArrayVertexAttribLFormatEXT) \
+    X(glVertexArrayVertexAttribBindingEXT) X(glVertexArrayVertexBindingDivisorEXT) \
+    X(glVertexArrayVertexAttribLOffsetEXT) X(glTexturePageCommitmentEXT) X(glVertexArrayVertexAttribDivisorEXT) \
+    X(glColorMaskIndexedEXT) X(glDrawArraysInstancedEXT) X(glDrawElementsInstancedEXT) X(glDrawRangeElementsEXT) \
+    X(glBufferStorageExternalEXT) X(glNamedBufferStorageExternalEXT) X(glFogCoordfEXT) X(glFogCoordfvEXT) \
+    X(glFogCoorddEXT) X(glFogCoorddvEXT) X(glFogCoordPointerEXT) X(glBlitFramebufferEXT) \
+    X(glRenderbufferStorageMultisampleEXT) X(glIsRenderbufferEXT) X(glBindRenderbufferEXT) \
+    X(glDeleteRenderbuffersEXT) X(glGenRenderbuffersEXT) X(glRenderbufferStorageEXT) \
+    X(glGetRenderbufferParameterivEXT) X(glIsFramebufferEXT) X(glBindFramebufferEXT) X(glDeleteFramebuffersEXT) \
+    X(glGenFramebuffersEXT) X(glCheckFramebufferStatusEXT) X(glFramebufferTexture1DEXT) X(glFramebufferTexture2DEXT) \
+    X(glFramebufferTexture3DEXT) X(glFramebufferRenderbufferEXT) X(glGetFramebufferAttachmentParameterivEXT) \
+    X(glGenerateMipmapEXT) X(glProgramParameteriEXT) X(glProgramEnvParameters4fvEXT) \
+    X(glProgramLocalParameters4fvEXT) X(glGetUniformuivEXT) X(glBindFragDataLocationEXT) X(glGetFragDataLocationEXT) \
+    X(glUniform1uiEXT) X(glUniform2uiEXT) X(glUniform3uiEXT) X(glUniform4uiEXT) X(glUniform1uivEXT) \
+    X(glUniform2uivEXT) X(glUniform3uivEXT) X(glUniform4uivEXT) X(glVertexAttribI1iEXT) X(glVertexAttribI2iEXT) \
+    X(glVertexAttribI3iEXT) X(glVertexAttribI4iEXT) X(glVertexAttribI1uiEXT) X(glVertexAttribI2uiEXT) \
+    X(glVertexAttribI3uiEXT) X(glVertexAttribI4uiEXT) X(glVertexAttribI1ivEXT) X(glVertexAttribI2ivEXT) \
+    X(glVertexAttribI3ivEXT) X(glVertexAttribI4ivEXT) X(glVertexAttribI1uivEXT) X(glVertexAttribI2uivEXT) \
+    X(glVertexAttribI3uivEXT) X(glVertexAttribI4uivEXT) X(glVertexAttribI4bvEXT) X(glVertexAttribI4svEXT) \
+    X(glVertexAttribI4ubvEXT) X(glVertexAttribI4usvEXT) X(glVertexAttribIPointerEXT) X(glGetVertexAttribIivEXT) \
+    X(glGetVertexAttribIuivEXT) X(glGetHistogramEXT) X(glGetHistogramParameterfvEXT) X(glGetHistogramParameterivEXT) \
+    X(glGetMinmaxEXT) X(glGetMinmaxParameterfvEXT) X(glGetMinmaxParameterivEXT) X(glHistogramEXT) X(glMinmaxEXT) \
+    X(glResetHistogramEXT) X(glResetMinmaxEXT) X(glIndexFuncEXT) X(glIndexMaterialEXT) X(glApplyTextureEXT) \
+    X(glTextureLightEXT) X(glTextureMaterialEXT) X(glGetUnsignedBytevEXT) X(glGetUnsignedBytei_vEXT) \
+    X(glDeleteMemoryObjectsEXT) X(glIsMemoryObjectEXT) X(glCreateMemoryObjectsEXT) X(glMemoryObjectParameterivEXT) \
+    X(glGetMemoryObjectParameterivEXT) X(glTexStorageMem2DEXT) X(glTexStorageMem2DMultisampleEXT) \
+    X(glTexStorageMem3DEXT) X(glTexStorageMem3DMultisampleEXT) X(glBufferStorageMemEXT) X(glTextureStorageMem2DEXT) \
+    X(glTextureStorageMem2DMultisampleEXT) X(glTextureStorageMem3DEXT) X(glTextureStorageMem3DMultisampleEXT) \
+    X(glNamedBufferStorageMemEXT) X(glTexStorageMem1DEXT) X(glTextureStorageMem1DEXT) X(glImportMemoryFdEXT) \
+    X(glImportMemoryWin32HandleEXT) X(glImportMemoryWin32NameEXT) X(glMultiDrawArraysEXT) X(glMultiDrawElementsEXT) \
+    X(glSampleMaskEXT) X(glSamplePatternEXT) X(glColorTableEXT) X(glGetColorTableEXT) \
+    X(glGetColorTableParameterivEXT) X(glGetColorTableParameterfvEXT) X(glPixelTransformParameteriEXT) \
+    X(glPixelTransformParameterfEXT) X(glPixelTransformParameterivEXT) X(glPixelTransformParameterfvEXT) \
+    X(glGetPixelTransformParameterivEXT) X(glGetPixelTransformParameterfvEXT) X(glPointParameterfEXT) \
+    X(glPointParameterfvEXT) X(glPolygonOffsetEXT) X(glPolygonOffsetClampEXT) X(glProvokingVertexEXT) \
+    X(glRasterSamplesEXT) X(glSecondaryColor3bEXT) X(glSecondaryColor3bvEXT) X(glSecondaryColor3dEXT) \
+    X(glSecondaryColor3dvEXT) X(glSecondaryColor3fEXT) X(glSecondaryColor3fvEXT) X(glSecondaryColor3iEXT) \
+    X(glSecondaryColor3ivEXT) X(glSecondaryColor3sEXT) X(glSecondaryColor3svEXT) X(glSecondaryColor3ubEXT) \
+    X(glSecondaryColor3ubvEXT) X(glSecondaryColor3uiEXT) X(glSecondaryColor3uivEXT) X(glSecondaryColor3usEXT) \
+    X(glSecondaryColor3usvEXT) X(glSecondaryColorPointerEXT) X(glGenSemaphoresEXT) X(glDeleteSemaphoresEXT) \
+    X(glIsSemaphoreEXT) X(glSemaphoreParameterui64vEXT) X(glGetSemaphoreParameterui64vEXT) X(glWaitSemaphoreEXT) \
+    X(glSignalSemaphoreEXT) X(glImportSemaphoreFdEXT) X(glImportSemaphoreWin32HandleEXT) \
+    X(glImportSemaphoreWin32NameEXT) X(glUseShaderProgramEXT) X(glActiveProgramEXT) X(glCreateShaderProgramEXT) \
+    X(glActiveShaderProgramEXT) X(glBindProgramPipelineEXT) X(glCreateShaderProgramvEXT) \
+    X(glDeleteProgramPipelinesEXT) X(glGenProgramPipelinesEXT) X(glGetProgramPipelineInfoLogEXT) \
+    X(glGetProgramPipelineivEXT) X(glIsProgramPipelineEXT) X(glUseProgramStagesEXT) X(glValidateProgramPipelineEXT) \
+    X(glFramebufferFetchBarrierEXT) X(glBindImageTextureEXT) X(glMemoryBarrierEXT) X(glStencilClearTagEXT) \
+    X(glActiveStencilFaceEXT) X(glTexSubImage1DEXT) X(glTexSubImage2DEXT) X(glTexImage3DEXT) X(glTexSubImage3DEXT) \
+    X(glFramebufferTextureLayerEXT) X(glTexBufferEXT) X(glTexParameterIivEXT) X(glTexParameterIuivEXT) \
+    X(glGetTexParameterIivEXT) X(glGetTexParameterIuivEXT) X(glClearColorIiEXT) X(glClearColorIuiEXT) \
+    X(glAreTexturesResidentEXT) X(glBindTextureEXT) X(glDeleteTexturesEXT) X(glGenTexturesEXT) X(glIsTextureEXT) \
+    X(glPrioritizeTexturesEXT) X(glTextureNormalEXT) X(glTexStorage1DEXT) X(glTexStorage2DEXT) X(glTexStorage3DEXT) \
+    X(glGetQueryObjecti64vEXT) X(glGetQueryObjectui64vEXT) X(glBeginTransformFeedbackEXT) \
+    X(glEndTransformFeedbackEXT) X(glBindBufferRangeEXT) X(glBindBufferOffsetEXT) X(glBindBufferBaseEXT) \
+    X(glTransformFeedbackVaryingsEXT) X(glGetTransformFeedbackVaryingEXT) X(glArrayElementEXT) X(glColorPointerEXT) \
+    X(glDrawArraysEXT) X(glEdgeFlagPointerEXT) X(glGetPointervEXT) X(glIndexPointerEXT) X(glNormalPointerEXT) \
+    X(glTexCoordPointerEXT) X(glVertexPointerEXT) X(glVertexAttribL1dEXT) X(glVertexAttribL2dEXT) \
+    X(glVertexAttribL3dEXT) X(glVertexAttribL4dEXT) X(glVertexAttribL1dvEXT) X(glVertexAttribL2dvEXT) \
+    X(glVertexAttribL3dvEXT) X(glVertexAttribL4dvEXT) X(glVertexAttribLPointerEXT) X(glGetVertexAttribLdvEXT) \
+    X(glBeginVertexShaderEXT) X(glEndVertexShaderEXT) X(glBindVertexShaderEXT) X(glGenVertexShadersEXT) \
+    X(glDeleteVertexShaderEXT) X(glShaderOp1EXT) X(glShaderOp2EXT) X(glShaderOp3EXT) X(glSwizzleEXT) \
+    X(glWriteMaskEXT) X(glInsertComponentEXT) X(glExtractComponentEXT) X(glGenSymbolsEXT) X(glSetInvariantEXT) \
+    X(glSetLocalConstantEXT) X(glVariantbvEXT) X(glVariantsvEXT) X(glVariantivEXT) X(glVariantfvEXT) \
+    X(glVariantdvEXT) X(glVariantubvEXT) X(glVariantusvEXT) X(glVariantuivEXT) X(glVariantPointerEXT) \
+    X(glEnableVariantClientStateEXT) X(glDisableVariantClientStateEXT) X(glBindLightParameterEXT) \
+    X(glBindMaterialParameterEXT) X(glBindTexGenParameterEXT) X(glBindTextureUnitParameterEXT) X(glBindParameterEXT) \
+    X(glIsVariantEnabledEXT) X(glGetVariantBooleanvEXT) X(glGetVariantIntegervEXT) X(glGetVariantFloatvEXT) \
+    X(glGetVariantPointervEXT) X(glGetInvariantBooleanvEXT) X(glGetInvariantIntegervEXT) X(glGetInvariantFloatvEXT) \
+    X(glGetLocalConstantBooleanvEXT) X(glGetLocalConstantIntegervEXT) X(glGetLocalConstantFloatvEXT) \
+    X(glVertexWeightfEXT) X(glVertexWeightfvEXT) X(glVertexWeightPointerEXT) X(glAcquireKeyedMutexWin32EXT) \
+    X(glReleaseKeyedMutexWin32EXT) X(glWindowRectanglesEXT) X(glImportSyncEXT) X(glFrameTerminatorGREMEDY) \
+    X(glStringMarkerGREMEDY) X(glImageTransformParameteriHP) X(glImageTransformParameterfHP) \
+    X(glImageTransformParameterivHP) X(glImageTransformParameterfvHP) X(glGetImageTransformParameterivHP) \
+    X(glGetImageTransformParameterfvHP) X(glMultiModeDrawArraysIBM) X(glMultiModeDrawElementsIBM) \
+    X(glFlushStaticDataIBM) X(glColorPointerListIBM) X(glSecondaryColorPointerListIBM) X(glEdgeFlagPointerListIBM) \
+    X(glFogCoordPointerListIBM) X(glIndexPointerListIBM) X(glNormalPointerListIBM) X(glTexCoordPointerListIBM) \
+    X(glVertexPointerListIBM) X(glBlendFuncSeparateINGR) X(glApplyFramebufferAttachmentCMAAINTEL) \
+    X(glSyncTextureINTEL) X(glUnmapTexture2DINTEL) X(glMapTexture2DINTEL) X(glVertexPointervINTEL) \
+    X(glNormalPointervINTEL) X(glColorPointervINTEL) X(glTexCoordPointervINTEL) X(glBeginPerfQueryINTEL) \
+    X(glCreatePerfQueryINTEL) X(glDeletePerfQueryINTEL) X(glEndPerfQueryINTEL) X(glGetFirstPerfQueryIdINTEL) \
+    X(glGetNextPerfQueryIdINTEL) X(glGetPerfCounterInfoINTEL) X(glGetPerfQueryDataINTEL) \
+    X(glGetPerfQueryIdByNameINTEL) X(glGetPerfQueryInfoINTEL) X(glBlendBarrierKHR) X(glDebugMessageControlKHR) \
+    X(glDebugMessageInsertKHR) X(glDebugMessageCallbackKHR) X(glGetDebugMessageLogKHR) X(glPushDebugGroupKHR) \
+    X(glPopDebugGroupKHR) X(glObjectLabelKHR) X(glGetObjectLabelKHR) X(glObjectPtrLabelKHR) \
+    X(glGetObjectPtrLabelKHR) X(glGetPointervKHR) X(glMaxShaderCompilerThreadsKHR) X(glGetGraphicsResetStatusKHR) \
+    X(glReadnPixelsKHR) X(glGetnUniformfvKHR) X(glGetnUniformivKHR) X(glGetnUniformuivKHR) \
+    X(glFramebufferParameteriMESA) X(glGetFramebufferParameterivMESA) X(glResizeBuffersMESA) X(glWindowPos2dMESA) \
+    X(glWindowPos2dvMESA) X(glWindowPos2fMESA) X(glWindowPos2fvMESA) X(glWindowPos2iMESA) X(glWindowPos2ivMESA) \
+    X(glWindowPos2sMESA) X(glWindowPos2svMESA) X(glWindowPos3dMESA) X(glWindowPos3dvMESA) X(glWindowPos3fMESA) \
+    X(glWindowPos3fvMESA) X(glWindowPos3iMESA) X(glWindowPos3ivMESA) X(glWindowPos3sMESA) X(glWindowPos3svMESA) \
+    X(glWindowPos4dMESA) X(glWindowPos4dvMESA) X(glWindowPos4fMESA) X(glWindowPos4fvMESA) X(glWindowPos4iMESA) \
+    X(glWindowPos4ivMESA) X(glWindowPos4sMESA) X(glWindowPos4svMESA) X(glBeginConditionalRenderNVX) \
+    X(glEndConditionalRenderNVX) X(glUploadGpuMaskNVX) X(glMulticastViewportArrayvNVX) \
+    X(glMulticastViewportPositionWScaleNVX) X(glMulticastScissorArrayvNVX) X(glAsyncCopyBufferSubDataNVX) \
+    X(glAsyncCopyImageSubDataNVX) X(glLGPUNamedBufferSubDataNVX) X(glLGPUCopyImageSubDataNVX) X(glLGPUInterlockNVX) \
+    X(glCreateProgressFenceNVX) X(glSignalSemaphoreui64NVX) X(glWaitSemaphoreui64NVX) \
+    X(glClientWaitSemaphoreui64NVX) X(glAlphaToCoverageDitherControlNV) X(glMultiDrawArraysIndirectBindlessNV) \
+    X(glMultiDrawElementsIndirectBindlessNV) X(glMultiDrawArraysIndirectBindlessCountNV) \
+    X(glMultiDrawElementsIndirectBindlessCountNV) X(glGetTextureHandleNV) X(glGetTextureSamplerHandleNV) \
+    X(glMakeTextureHandleResidentNV) X(glMakeTextureHandleNonResidentNV) X(glGetImageHandleNV) \
+    X(glMakeImageHandleResidentNV) X(glMakeImageHandleNonResidentNV) X(glUniformHandleui64NV) \
+    X(glUniformHandleui64vNV) X(glProgramUniformHandleui64NV) X(glProgramUniformHandleui64vNV) \
+    X(glIsTextureHandleResidentNV) X(glIsImageHandleResidentNV) X(glBlendParameteriNV) X(glBlendBarrierNV) \
+    X(glViewportPositionWScaleNV) X(glCreateStatesNV) X(glDeleteStatesNV) X(glIsStateNV) X(glStateCaptureNV) \
+    X(glGetCommandHeaderNV) X(glGetStageIndexNV) X(glDrawCommandsNV) X(glDrawCommandsAddressNV) \
+    X(glDrawCommandsStatesNV) X(glDrawCommandsStatesAddressNV) X(glCreateCommandListsNV) X(glDeleteCommandListsNV) \
+    X(glIsCommandListNV) X(glListDrawCommandsStatesClientNV) X(glCommandListSegmentsNV) X(glCompileCommandListNV) \
+    X(glCallCommandListNV) X(glBeginConditionalRenderNV) X(glEndConditionalRenderNV) X(glSubpixelPrecisionBiasNV) \
+    X(glConservativeRasterParameterfNV) X(glConservativeRasterParameteriNV) X(glCopyImageSubDataNV) \
+    X(glDepthRangedNV) X(glClearDepthdNV) X(glDepthBoundsdNV) X(glDrawTextureNV) X(glDrawVkImageNV) \
+    X(glGetVkProcAddrNV) X(glWaitVkSemaphoreNV) X(glSignalVkSemaphoreNV) X(glSignalVkFenceNV) \
+    X(glMapControlPointsNV) X(glMapParameterivNV) X(glMapParameterfvNV) X(glGetMapControlPointsNV) \
+    X(glGetMapParameterivNV) X(glGetMapParameterfvNV) X(glGetMapAttribParameterivNV) X(glGetMapAttribParameterfvNV) \
+    X(glEvalMapsNV) X(glGetMultisamplefvNV) X(glSampleMaskIndexedNV) X(glTexRenderbufferNV) X(glDeleteFencesNV) \
+    X(glGenFencesNV) X(glIsFenceNV) X(glTestFenceNV) X(glGetFenceivNV) X(glFinishFenceNV) X(glSetFenceNV) \
+    X(glFragmentCoverageColorNV) X(glProgramNamedParameter4fNV) X(glProgramNamedParameter4fvNV) \
+    X(glProgramNamedParameter4dNV) X(glProgramNamedParameter4dvNV) X(glGetProgramNamedParameterfvNV) \
+    X(glGetProgramNamedParameterdvNV) X(glCoverageModulationTableNV) X(glGetCoverageModulationTableNV) \
+    X(glCoverageModulationNV) X(glRenderbufferStorageMultisampleCoverageNV) X(glProgramVertexLimitNV) \
+    X(glFramebufferTextureEXT) X(glFramebufferTextureFaceEXT) X(glRenderGpuMaskNV) X(glMulticastBufferSubDataNV) \
+    X(glMulticastCopyBufferSubDataNV) X(glMulticastCopyImageSubDataNV) X(glMulticastBlitFramebufferNV) \
+    X(glMulticastFramebufferSampleLocationsfvNV) X(glMulticastBarrierNV) X(glMulticastWaitSyncNV) \
+    X(glMulticastGetQueryObjectivNV) X(glMulticastGetQueryObjectuivNV) X(glMulticastGetQueryObjecti64vNV) \
+    X(glMulticastGetQueryObjectui64vNV) X(glProgramLocalParameterI4iNV) X(glProgramLocalParameterI4ivNV) \
+    X(glProgramLocalParametersI4ivNV) X(glProgramLocalParameterI4uiNV) X(glProgramLocalParameterI4uivNV) \
+    X(glProgramLocalParametersI4uivNV) X(glProgramEnvParameterI4iNV) X(glProgramEnvParameterI4ivNV) \
+    X(glProgramEnvParametersI4ivNV) X(glProgramEnvParameterI4uiNV) X(glProgramEnvParameterI4uivNV) \
+    X(glProgramEnvParametersI4uivNV) X(glGetProgramLocalParameterIivNV) X(glGetProgramLocalParameterIuivNV) \
+    X(glGetProgramEnvParameterIivNV) X(glGetProgramEnvParameterIuivNV) X(glProgramSubroutineParametersuivNV) \
+    X(glGetProgramSubroutineParameteruivNV) X(glVertex2hNV) X(glVertex2hvNV) X(glVertex3hNV) X(glVertex3hvNV) \
+    X(glVertex4hNV) X(glVertex4hvNV) X(glNormal3hNV) X(glNormal3hvNV) X(glColor3hNV) X(glColor3hvNV) X(glColor4hNV) \
+    X(glColor4hvNV) X(glTexCoord1hNV) X(glTexCoord1hvNV) X(glTexCoord2hNV) X(glTexCoord2hvNV) X(glTexCoord3hNV) \
+    X(glTexCoord3hvNV) X(glTexCoord4hNV) X(glTexCoord4hvNV) X(glMultiTexCoord1hNV) X(glMultiTexCoord1hvNV) \
+    X(glMultiTexCoord2hNV) X(glMultiTexCoord2hvNV) X(glMultiTexCoord3hNV) X(glMultiTexCoord3hvNV) \
+    X(glMultiTexCoord4hNV) X(glMultiTexCoord4hvNV) X(glFogCoordhNV) X(glFogCoordhvNV) X(glSecondaryColor3hNV) \
+    X(glSecondaryColor3hvNV) X(glVertexWeighthNV) X(glVertexWeighthvNV) X(glVertexAttrib1hNV) X(glVertexAttrib1hvNV) \
+    X(glVertexAttrib2hNV) X(glVertexAttrib2hvNV) X(glVertexAttrib3hNV) X(glVertexAttrib3hvNV) X(glVertexAttrib4hNV) \
+    X(glVertexAttrib4hvNV) X(glVertexAttribs1hvNV) X(glVertexAttribs2hvNV) X(glVertexAttribs3hvNV) \
+    X(glVertexAttribs4hvNV) X(glGetInternalformatSampleivNV) X(glGetMemoryObjectDetachedResourcesuivNV) \
+    X(glResetMemoryObjectParameterNV) X(glTexAttachMemoryNV) X(glBufferAttachMemoryNV) X(glTextureAttachMemoryNV) \
+    X(glNamedBufferAttachMemoryNV) X(glBufferPageCommitmentMemNV) X(glTexPageCommitmentMemNV) \
+    X(glNamedBufferPageCommitmentMemNV) X(glTexturePageCommitmentMemNV) X(glDrawMeshTasksNV) \
+    X(glDrawMeshTasksIndirectNV) X(glMultiDrawMeshTasksIndirectNV) X(glMultiDrawMeshTasksIndirectCountNV) \
+    X(glGenOcclusionQueriesNV) X(glDeleteOcclusionQueriesNV) X(glIsOcclusionQueryNV) X(glBeginOcclusionQueryNV) \
+    X(glEndOcclusionQueryNV) X(glGetOcclusionQueryivNV) X(glGetOcclusionQueryuivNV) X(glProgramBufferParametersfvNV) \
+    X(glProgramBufferParametersIivNV) X(glProgramBufferParametersIuivNV) X(glGenPathsNV) X(glDeletePathsNV) \
+    X(glIsPathNV) X(glPathCommandsNV) X(glPathCoordsNV) X(glPathSubCommandsNV) X(glPathSubCoordsNV) \
+    X(glPathStringNV) X(glPathGlyphsNV) X(glPathGlyphRangeNV) X(glWeightPathsNV) X(glCopyPathNV) \
+    X(glInterpolatePathsNV) X(glTransformPathNV) X(glPathParameterivNV) X(glPathParameteriNV) X(glPathParameterfvNV) \
+    X(glPathParameterfNV) X(glPathDashArrayNV) X(glPathStencilFuncNV) X(glPathStencilDepthOffsetNV) \
+    X(glStencilFillPathNV) X(glStencilStrokePathNV) X(glStencilFillPathInstancedNV) \
+    X(glStencilStrokePathInstancedNV) X(glPathCoverDepthFuncNV) X(glCoverFillPathNV) X(glCoverStrokePathNV) \
+    X(glCoverFillPathInstancedNV) X(glCoverStrokePathInstancedNV) X(glGetPathParameterivNV) \
+    X(glGetPathParameterfvNV) X(glGetPathCommandsNV) X(glGetPathCoordsNV) X(glGetPathDashArrayNV) \
+    X(glGetPathMetricsNV) X(glGetPathMetricRangeNV) X(glGetPathSpacingNV) X(glIsPointInFillPathNV) \
+    X(glIsPointInStrokePathNV) X(glGetPathLengthNV) X(glPointAlongPathNV) X(glMatrixLoad3x2fNV) \
+    X(glMatrixLoad3x3fNV) X(glMatrixLoadTranspose3x3fNV) X(glMatrixMult3x2fNV) X(glMatrixMult3x3fNV) \
+    X(glMatrixMultTranspose3x3fNV) X(glStencilThenCoverFillPathNV) X(glStencilThenCoverStrokePathNV) \
+    X(glStencilThenCoverFillPathInstancedNV) X(glStencilThenCoverStrokePathInstancedNV) X(glPathGlyphIndexRangeNV) \
+    X(glPathGlyphIndexArrayNV) X(glPathMemoryGlyphIndexArrayNV) X(glProgramPathFragmentInputGenNV) \
+    X(glGetProgramResourcefvNV) X(glPathColorGenNV) X(glPathTexGenNV) X(glPathFogGenNV) X(glGetPathColorGenivNV) \
+    X(glGetPathColorGenfvNV) X(glGetPathTexGenivNV) X(glGetPathTexGenfvNV) X(glPixelDataRangeNV) \
+    X(glFlushPixelDataRangeNV) X(glPointParameteriNV) X(glPointParameterivNV) X(glPresentFrameKeyedNV) \
+    X(glPresentFrameDualFillNV) X(glGetVideoivNV) X(glGetVideouivNV) X(glGetVideoi64vNV) X(glGetVideoui64vNV) \
+    X(glPrimitiveRestartNV) X(glPrimitiveRestartIndexNV) X(glQueryResourceNV) X(glGenQueryResourceTagNV) \
+    X(glDeleteQueryResourceTagNV) X(glQueryResourceTagNV) X(glCombinerParameterfvNV) X(glCombinerParameterfNV) \
+    X(glCombinerParameterivNV) X(glCombinerParameteriNV) X(glCombinerInputNV) X(glCombinerOutputNV) \
+    X(glFinalCombinerInputNV) X(glGetCombinerInputParameterfvNV) X(glGetCombinerInputParameterivNV) \
+    X(glGetCombinerOutputParameterfvNV) X(glGetCombinerOutputParameterivNV) X(glGetFinalCombinerInputParameterfvNV) \
+    X(glGetFinalCombinerInputParameterivNV) X(glCombinerStageParameterfvNV) X(glGetCombinerStageParameterfvNV) \
+    X(glFramebufferSampleLocationsfvNV) X(glNamedFramebufferSampleLocationsfvNV) X(glResolveDepthValuesNV) \
+    X(glScissorExclusiveNV) X(glScissorExclusiveArrayvNV) X(glMakeBufferResidentNV) X(glMakeBufferNonResidentNV) \
+    X(glIsBufferResidentNV) X(glMakeNamedBufferResidentNV) X(glMakeNamedBufferNonResidentNV) \
+    X(glIsNamedBufferResidentNV) X(glGetBufferParameterui64vNV) X(glGetNamedBufferParameterui64vNV) \
+    X(glGetIntegerui64vNV) X(glUniformui64NV) X(glUniformui64vNV) X(glProgramUniformui64NV) \
+    X(glProgramUniformui64vNV) X(glBindShadingRateImageNV) X(glGetShadingRateImagePaletteNV) \
+    X(glGetShadingRateSampleLocationivNV) X(glShadingRateImageBarrierNV) X(glShadingRateImagePaletteNV) \
+    X(glShadingRateSampleOrderNV) X(glShadingRateSampleOrderCustomNV) X(glTextureBarrierNV) \
+    X(glTexImage2DMultisampleCoverageNV) X(glTexImage3DMultisampleCoverageNV) X(glTextureImage2DMultisampleNV) \
+    X(glTextureImage3DMultisampleNV) X(glTextureImage2DMultisampleCoverageNV) \
+    X(glTextureImage3DMultisampleCoverageNV) X(glCreateSemaphoresNV) X(glSemaphoreParameterivNV) \
+    X(glGetSemaphoreParameterivNV) X(glBeginTransformFeedbackNV) X(glEndTransformFeedbackNV) \
+    X(glTransformFeedbackAttribsNV) X(glBindBufferRangeNV) X(glBindBufferOffsetNV) X(glBindBufferBaseNV) \
+    X(glTransformFeedbackVaryingsNV) X(glActiveVaryingNV) X(glGetVaryingLocationNV) X(glGetActiveVaryingNV) \
+    X(glGetTransformFeedbackVaryingNV) X(glTransformFeedbackStreamAttribsNV) X(glBindTransformFeedbackNV) \
+    X(glDeleteTransformFeedbacksNV) X(glGenTransformFeedbacksNV) X(glIsTransformFeedbackNV) \
+    X(glPauseTransformFeedbackNV) X(glResumeTransformFeedbackNV) X(glDrawTransformFeedbackNV) X(glVDPAUInitNV) \
+    X(glVDPAUFiniNV) X(glVDPAURegisterVideoSurfaceNV) X(glVDPAURegisterOutputSurfaceNV) X(glVDPAUIsSurfaceNV) \
+    X(glVDPAUUnregisterSurfaceNV) X(glVDPAUGetSurfaceivNV) X(glVDPAUSurfaceAccessNV) X(glVDPAUMapSurfacesNV) \
+    X(glVDPAUUnmapSurfacesNV) X(glVDPAURegisterVideoSurfaceWithPictureStructureNV) X(glFlushVertexArrayRangeNV) \
+    X(glVertexArrayRangeNV) X(glVertexAttribL1i64NV) X(glVertexAttribL2i64NV) X(glVertexAttribL3i64NV) \
+    X(glVertexAttribL4i64NV) X(glVertexAttribL1i64vNV) X(glVertexAttribL2i64vNV) X(glVertexAttribL3i64vNV) \
+    X(glVertexAttribL4i64vNV) X(glVertexAttribL1ui64NV) X(glVertexAttribL2ui64NV) X(glVertexAttribL3ui64NV) \
+    X(glVertexAttribL4ui64NV) X(glVertexAttribL1ui64vNV) X(glVertexAttribL2ui64vNV) X(glVertexAttribL3ui64vNV) \
+    X(glVertexAttribL4ui64vNV) X(glGetVertexAttribLi64vNV) X(glGetVertexAttribLui64vNV) X(glVertexAttribLFormatNV) \
+    X(glBufferAddressRangeNV) X(glVertexFormatNV) X(glNormalFormatNV) X(glColorFormatNV) X(glIndexFormatNV) \
+    X(glTexCoordFormatNV) X(glEdgeFlagFormatNV) X(glSecondaryColorFormatNV) X(glFogCoordFormatNV) \
+    X(glVertexAttribFormatNV) X(glVertexAttribIFormatNV) X(glGetIntegerui64i_vNV) X(glAreProgramsResidentNV) \
+    X(glBindProgramNV) X(glDeleteProgramsNV) X(glExecuteProgramNV) X(glGenProgramsNV) X(glGetProgramParameterdvNV) \
+    X(glGetProgramParameterfvNV) X(glGetProgramivNV) X(glGetProgramStringNV) X(glGetTrackMatrixivNV) \
+    X(glGetVertexAttribdvNV) X(glGetVertexAttribfvNV) X(glGetVertexAttribivNV) X(glGetVertexAttribPointervNV) \
+    X(glIsProgramNV) X(glLoadProgramNV) X(glProgramParameter4dNV) X(glProgramParameter4dvNV) \
+    X(glProgramParameter4fNV) X(glProgramParameter4fvNV) X(glProgramParameters4dvNV) X(glProgramParameters4fvNV) \
+    X(glRequestResidentProgramsNV) X(glTrackMatrixNV) X(glVertexAttribPointerNV) X(glVertexAttrib1dNV) \
+    X(glVertexAttrib1dvNV) X(glVertexAttrib1fNV) X(glVertexAttrib1fvNV) X(glVertexAttrib1sNV) X(glVertexAttrib1svNV) \
+    X(glVertexAttrib2dNV) X(glVertexAttrib2dvNV) X(glVertexAttrib2fNV) X(glVertexAttrib2fvNV) X(glVertexAttrib2sNV) \
+    X(glVertexAttrib2svNV) X(glVertexAttrib3dNV) X(glVertexAttrib3dvNV) X(glVertexAttrib3fNV) X(glVertexAttrib3fvNV) \
+    X(glVertexAttrib3sNV) X(glVertexAttrib3svNV) X(glVertexAttrib4dNV) X(glVertexAttrib4dvNV) X(glVertexAttrib4fNV) \
+    X(glVertexAttrib4fvNV) X(glVertexAttrib4sNV) X(glVertexAttrib4svNV) X(glVertexAttrib4ubNV) \
+    X(glVertexAttrib4ubvNV) X(glVertexAttribs1dvNV) X(glVertexAttribs1fvNV) X(glVertexAttribs1svNV) \
+    X(glVertexAttribs2dvNV) X(glVertexAttribs2fvNV) X(glVertexAttribs2svNV) X(glVertexAttribs3dvNV) \
+    X(glVertexAttribs3fvNV) X(glVertexAttribs3svNV) X(glVertexAttribs4dvNV) X(glVertexAttribs4fvNV) \
+    X(glVertexAttribs4svNV) X(glVertexAttribs4ubvNV) X(glBeginVideoCaptureNV) X(glBindVideoCaptureStreamBufferNV) \
+    X(glBindVideoCaptureStreamTextureNV) X(glEndVideoCaptureNV) X(glGetVideoCaptureivNV) \
+    X(glGetVideoCaptureStreamivNV) X(glGetVideoCaptureStreamfvNV) X(glGetVideoCaptureStreamdvNV) X(glVideoCaptureNV) \
+    X(glVideoCaptureStreamParameterivNV) X(glVideoCaptureStreamParameterfvNV) X(glVideoCaptureStreamParameterdvNV) \
+    X(glViewportSwizzleNV) X(glMultiTexCoord1bOES) X(glMultiTexCoord1bvOES) X(glMultiTexCoord2bOES) \
+    X(glMultiTexCoord2bvOES) X(glMultiTexCoord3bOES) X(glMultiTexCoord3bvOES) X(glMultiTexCoord4bOES) \
+    X(glMultiTexCoord4bvOES) X(glTexCoord1bOES) X(glTexCoord1bvOES) X(glTexCoord2bOES) X(glTexCoord2bvOES) \
+    X(glTexCoord3bOES) X(glTexCoord3bvOES) X(glTexCoord4bOES) X(glTexCoord4bvOES) X(glVertex2bOES) X(glVertex2bvOES) \
+    X(glVertex3bOES) X(glVertex3bvOES) X(glVertex4bOES) X(glVertex4bvOES) X(glAlphaFuncxOES) X(glClearColorxOES) \
+    X(glClearDepthxOES) X(glClipPlanexOES) X(glColor4xOES) X(glDepthRangexOES) X(glFogxOES) X(glFogxvOES) \
+    X(glFrustumxOES) X(glGetClipPlanexOES) X(glGetFixedvOES) X(glGetTexEnvxvOES) X(glGetTexParameterxvOES) \
+    X(glLightModelxOES) X(glLightModelxvOES) X(glLightxOES) X(glLightxvOES) X(glLineWidthxOES) X(glLoadMatrixxOES) \
+    X(glMaterialxOES) X(glMaterialxvOES) X(glMultMatrixxOES) X(glMultiTexCoord4xOES) X(glNormal3xOES) X(glOrthoxOES) \
+    X(glPointParameterxvOES) X(glPointSizexOES) X(glPolygonOffsetxOES) X(glRotatexOES) X(glScalexOES) \
+    X(glTexEnvxOES) X(glTexEnvxvOES) X(glTexParameterxOES) X(glTexParameterxvOES) X(glTranslatexOES) \
+    X(glGetLightxvOES) X(glGetMaterialxvOES) X(glPointParameterxOES) X(glSampleCoveragexOES) X(glAccumxOES) \
+    X(glBitmapxOES) X(glBlendColorxOES) X(glClearAccumxOES) X(glColor3xOES) X(glColor3xvOES) X(glColor4xvOES) \
+    X(glConvolutionParameterxOES) X(glConvolutionParameterxvOES) X(glEvalCoord1xOES) X(glEvalCoord1xvOES) \
+    X(glEvalCoord2xOES) X(glEvalCoord2xvOES) X(glFeedbackBufferxOES) X(glGetConvolutionParameterxvOES) \
+    X(glGetHistogramParameterxvOES) X(glGetLightxOES) X(glGetMapxvOES) X(glGetMaterialxOES) X(glGetPixelMapxv) \
+    X(glGetTexGenxvOES) X(glGetTexLevelParameterxvOES) X(glIndexxOES) X(glIndexxvOES) X(glLoadTransposeMatrixxOES) \
+    X(glMap1xOES) X(glMap2xOES) X(glMapGrid1xOES) X(glMapGrid2xOES) X(glMultTransposeMatrixxOES) \
+    X(glMultiTexCoord1xOES) X(glMultiTexCoord1xvOES) X(glMultiTexCoord2xOES) X(glMultiTexCoord2xvOES) \
+    X(glMultiTexCoord3xOES) X(glMultiTexCoord3xvOES) X(glMultiTexCoord4xvOES) X(glNormal3xvOES) X(glPassThroughxOES) \
+    X(glPixelMapx) X(glPixelStorex) X(glPixelTransferxOES) X(glPixelZoomxOES) X(glPrioritizeTexturesxOES) \
+    X(glRasterPos2xOES) X(glRasterPos2xvOES) X(glRasterPos3xOES) X(glRasterPos3xvOES) X(glRasterPos4xOES) \
+    X(glRasterPos4xvOES) X(glRectxOES) X(glRectxvOES) X(glTexCoord1xOES) X(glTexCoord1xvOES) X(glTexCoord2xOES) \
+    X(glTexCoord2xvOES) X(glTexCoord3xOES) X(glTexCoord3xvOES) X(glTexCoord4xOES) X(glTexCoord4xvOES) \
+    X(glTexGenxOES) X(glTexGenxvOES) X(glVertex2xOES) X(glVertex2xvOES) X(glVertex3xOES) X(glVertex3xvOES) \
+    X(glVertex4xOES) X(glVertex4xvOES) X(glQueryMatrixxOES) X(glClearDepthfOES) X(glClipPlanefOES) \
+    X(glDepthRangefOES) X(glFrustumfOES) X(glGetClipPlanefOES) X(glOrthofOES) X(glFramebufferTextureMultiviewOVR) \
+    X(glHintPGI) X(glDetailTexFuncSGIS) X(glGetDetailTexFuncSGIS) X(glFogFuncSGIS) X(glGetFogFuncSGIS) \
+    X(glSampleMaskSGIS) X(glSamplePatternSGIS) X(glPixelTexGenParameteriSGIS) X(glPixelTexGenParameterivSGIS) \
+    X(glPixelTexGenParameterfSGIS) X(glPixelTexGenParameterfvSGIS) X(glGetPixelTexGenParameterivSGIS) \
+    X(glGetPixelTexGenParameterfvSGIS) X(glPointParameterfSGIS) X(glPointParameterfvSGIS) X(glSharpenTexFuncSGIS) \
+    X(glGetSharpenTexFuncSGIS) X(glTexImage4DSGIS) X(glTexSubImage4DSGIS) X(glTextureColorMaskSGIS) \
+    X(glGetTexFilterFuncSGIS) X(glTexFilterFuncSGIS) X(glAsyncMarkerSGIX) X(glFinishAsyncSGIX) X(glPollAsyncSGIX) \
+    X(glGenAsyncMarkersSGIX) X(glDeleteAsyncMarkersSGIX) X(glIsAsyncMarkerSGIX) X(glFlushRasterSGIX) \
+    X(glFragmentColorMaterialSGIX) X(glFragmentLightfSGIX) X(glFragmentLightfvSGIX) X(glFragmentLightiSGIX) \
+    X(glFragmentLightivSGIX) X(glFragmentLightModelfSGIX) X(glFragmentLightModelfvSGIX) X(glFragmentLightModeliSGIX) \
+    X(glFragmentLightModelivSGIX) X(glFragmentMaterialfSGIX) X(glFragmentMaterialfvSGIX) X(glFragmentMaterialiSGIX) \
+    X(glFragmentMaterialivSGIX) X(glGetFragmentLightfvSGIX) X(glGetFragmentLightivSGIX) \
+    X(glGetFragmentMaterialfvSGIX) X(glGetFragmentMaterialivSGIX) X(glLightEnviSGIX) X(glFrameZoomSGIX) \
+    X(glIglooInterfaceSGIX) X(glGetInstrumentsSGIX) X(glInstrumentsBufferSGIX) X(glPollInstrumentsSGIX) \
+    X(glReadInstrumentsSGIX) X(glStartInstrumentsSGIX) X(glStopInstrumentsSGIX) X(glGetListParameterfvSGIX) \
+    X(glGetListParameterivSGIX) X(glListParameterfSGIX) X(glListParameterfvSGIX) X(glListParameteriSGIX) \
+    X(glListParameterivSGIX) X(glPixelTexGenSGIX) X(glDeformationMap3dSGIX) X(glDeformationMap3fSGIX) \
+    X(glDeformSGIX) X(glLoadIdentityDeformationMapSGIX) X(glReferencePlaneSGIX) X(glSpriteParameterfSGIX) \
+    X(glSpriteParameterfvSGIX) X(glSpriteParameteriSGIX) X(glSpriteParameterivSGIX) X(glTagSampleBufferSGIX) \
+    X(glColorTableSGI) X(glColorTableParameterfvSGI) X(glColorTableParameterivSGI) X(glCopyColorTableSGI) \
+    X(glGetColorTableSGI) X(glGetColorTableParameterfvSGI) X(glGetColorTableParameterivSGI) X(glFinishTextureSUNX) \
+    X(glGlobalAlphaFactorbSUN) X(glGlobalAlphaFactorsSUN) X(glGlobalAlphaFactoriSUN) X(glGlobalAlphaFactorfSUN) \
+    X(glGlobalAlphaFactordSUN) X(glGlobalAlphaFactorubSUN) X(glGlobalAlphaFactorusSUN) X(glGlobalAlphaFactoruiSUN) \
+    X(glDrawMeshArraysSUN) X(glReplacementCodeuiSUN) X(glReplacementCodeusSUN) X(glReplacementCodeubSUN) \
+    X(glReplacementCodeuivSUN) X(glReplacementCodeusvSUN) X(glReplacementCodeubvSUN) X(glReplacementCodePointerSUN) \
+    X(glColor4ubVertex2fSUN) X(glColor4ubVertex2fvSUN) X(glColor4ubVertex3fSUN) X(glColor4ubVertex3fvSUN) \
+    X(glColor3fVertex3fSUN) X(glColor3fVertex3fvSUN) X(glNormal3fVertex3fSUN) X(glNormal3fVertex3fvSUN) \
+    X(glColor4fNormal3fVertex3fSUN) X(glColor4fNormal3fVertex3fvSUN) X(glTexCoord2fVertex3fSUN) \
+    X(glTexCoord2fVertex3fvSUN) X(glTexCoord4fVertex4fSUN) X(glTexCoord4fVertex4fvSUN) \
+    X(glTexCoord2fColor4ubVertex3fSUN) X(glTexCoord2fColor4ubVertex3fvSUN) X(glTexCoord2fColor3fVertex3fSUN) \
+    X(glTexCoord2fColor3fVertex3fvSUN) X(glTexCoord2fNormal3fVertex3fSUN) X(glTexCoord2fNormal3fVertex3fvSUN) \
+    X(glTexCoord2fColor4fNormal3fVertex3fSUN) X(glTexCoord2fColor4fNormal3fVertex3fvSUN) \
+    X(glTexCoord4fColor4fNormal3fVertex4fSUN) X(glTexCoord4fColor4fNormal3fVertex4fvSUN) \
+    X(glReplacementCodeuiVertex3fSUN) X(glReplacementCodeuiVertex3fvSUN) X(glReplacementCodeuiColor4ubVertex3fSUN) \
+    X(glReplacementCodeuiColor4ubVertex3fvSUN) X(glReplacementCodeuiColor3fVertex3fSUN) \
+    X(glReplacementCodeuiColor3fVertex3fvSUN) X(glReplacementCodeuiNormal3fVertex3fSUN) \
+    X(glReplacementCodeuiNormal3fVertex3fvSUN) X(glReplacementCodeuiColor4fNormal3fVertex3fSUN) \
+    X(glReplacementCodeuiColor4fNormal3fVertex3fvSUN) X(glReplacementCodeuiTexCoord2fVertex3fSUN) \
+    X(glReplacementCodeuiTexCoord2fVertex3fvSUN) X(glReplacementCodeuiTexCoord2fNormal3fVertex3fSUN) \
+    X(glReplacementCodeuiTexCoord2fNormal3fVertex3fvSUN) X(glReplacementCodeuiTexCoord2fColor4fNormal3fVertex3fSUN) \
+    X(glReplacementCodeuiTexCoord2fColor4fNormal3fVertex3fvSUN)
@@ -0,0 +1,276 @@
+#include "gpu_culling.h"
+
+#include <algorithm>
+
+#include "profiler.h"
+
+// Invocations per work group, must match the local sizes of gpu_cull.comp and depth_pyramid.comp
+static const size_t cull_group_size = 64;
+static const int pyramid_group_size = 8;
+
+GpuCuller::GpuCuller():
+    entity_count(0), sphere_buffer(0), batch_buffer(0), transform_buffer(0), transform_texture(0), occluded_buffer(0),
+    command_buffer(0), empty_command_buffer(0), instance_buffer(0), pyramid(0), pyramid_width(0), pyramid_height(0), pyramid_levels(0),
+    screen_width(0), screen_height(0), pyramid_view_projection(1.f), view_projection(1.f), has_pyramid(false), readback_frame(0),
+    counters(), cull_shader("Shaders/gpu_cull.comp"), pyramid_shader("Shaders/depth_pyramid.comp") {
+    // One counter for each field of GpuCullCounters
+    glGenBuffers(1, &counter_buffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, counter_buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GpuCullCounters), NULL, GL_DYNAMIC_COPY);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    glGenBuffers(GPU_CULL_READBACK_FRAMES, readback_buffers);
+    for (int i = 0; i < GPU_CULL_READBACK_FRAMES; i++) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, readback_buffers[i]);
+        glBufferData(GL_COPY_WRITE_BUFFER, sizeof(GpuCullCounters), NULL, GL_STREAM_READ);
+        readback_fences[i] = 0;
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    cull_shader.setInt("pyramid", GPU_CULL_PYRAMID_UNIT);
+    pyramid_shader.setInt("depth_texture", GPU_CULL_PYRAMID_UNIT);
+    glUseProgram(0);
+}
+
+// Deconstructor to free the buffers and the pyramid
+GpuCuller::~GpuCuller() {
+    freeEntityBuffers();
+    glDeleteTextures(1, &pyramid);
+    glDeleteBuffers(1, &counter_buffer);
+    glDeleteBuffers(GPU_CULL_READBACK_FRAMES, readback_buffers);
+    for (int i = 0; i < GPU_CULL_READBACK_FRAMES; i++)
+        if (readback_fences[i])
+            glDeleteSync(readback_fences[i]);
+}
+
+// Frees the buffers sized by the entities
+void GpuCuller::freeEntityBuffers() {
+    GLuint buffers[7] = {sphere_buffer, batch_buffer, transform_buffer, occluded_buffer, command_buffer, empty_command_buffer, instance_buffer};
+    glDeleteBuffers(7, buffers);
+    glDeleteTextures(1, &transform_texture);
+    if (!batch_VAOs.empty())
+        glDeleteVertexArrays((GLsizei) batch_VAOs.size(), batch_VAOs.data());
+    sphere_buffer = batch_buffer = transform_buffer = occluded_buffer = command_buffer = empty_command_buffer = instance_buffer = 0;
+    transform_texture = 0;
+    batch_VAOs.clear();
+    batches.clear();
+    entity_count = 0;
+}
+
+// Copies the world bounds and matrices of the entities that are not hidden to the GPU and sorts them into batches,
+// entities that move or are added later are only seen once this is called again
+void GpuCuller::upload(EntityStore& entities) {
+    PROFILE_SCOPE("Upload culled entities");
+    freeEntityBuffers();
+
+    // Sorted like draw packets, so the entities of a batch are next to each other
+    std::vector<uint32_t> shown;
+    for (uint32_t i = 0; i < entities.size(); i++)
+        if (!(entities.flags[i] & ENTITY_HIDDEN))
+            shown.push_back(i);
+    std::vector<DrawPacket> order;
+    entities.buildDrawPackets(shown, order);
+    entity_count = (uint32_t) order.size();
+    if (entity_count == 0)
+        return;
+
+    std::vector<glm::vec4> spheres(entity_count);
+    std::vector<GLuint> entity_batches(entity_count);
+    std::vector<glm::mat4> transforms(entity_count);
+    for (uint32_t i = 0; i < entity_count; i++) {
+        uint32_t entity = order[i].entity;
+        if (batches.empty() || order[i].key != order[i - 1].key)
+            batches.push_back({entities.mesh_ids[entity], entities.material_ids[entity], i, 0});
+        batches.back().count++;
+        const AABB& bounds = entities.bounds[entity];
+        spheres[i] = glm::vec4(bounds.getCenter(), glm::length(bounds.getExtents()));
+        entity_batches[i] = (GLuint) batches.size() - 1;
+        transforms[i] = entities.world_matrices[entity];
+    }
+
+    // Each phase's draw of a batch starts empty and draws its instances from its own range of the instance buffer
+    std::vector<DrawCommand> empty_commands;
+    for (int phase = 0; phase < 2; phase++)
+        for (const GpuCullBatch& batch : batches)
+            empty_commands.push_back({(GLuint) entities.meshes[batch.mesh_id]->count, 0, 0, phase * entity_count + batch.first});
+
+    GLuint* buffers[7] = {&sphere_buffer, &batch_buffer, &transform_buffer, &occluded_buffer, &command_buffer, &empty_command_buffer, &instance_buffer};
+    for (GLuint* buffer : buffers)
+        glGenBuffers(1, buffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, sphere_buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, entity_count * sizeof(glm::vec4), spheres.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, batch_buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, entity_count * sizeof(GLuint), entity_batches.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, occluded_buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, entity_count * sizeof(GLuint), NULL, GL_DYNAMIC_COPY);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, command_buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, empty_commands.size() * sizeof(DrawCommand), NULL, GL_DYNAMIC_COPY);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, empty_command_buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, empty_commands.size() * sizeof(DrawCommand), empty_commands.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, instance_buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, 2 * entity_count * sizeof(GLuint), NULL, GL_DYNAMIC_COPY);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    // The vertex shader reads each world matrix as four texels
+    glBindBuffer(GL_TEXTURE_BUFFER, transform_buffer);
+    glBufferData(GL_TEXTURE_BUFFER, entity_count * sizeof(glm::mat4), transforms.data(), GL_STATIC_DRAW);
+    glGenTextures(1, &transform_texture);
+    glBindTexture(GL_TEXTURE_BUFFER, transform_texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, transform_buffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    // Each batch's mesh laid out like VertexAttribs, with the index of the entity as an attribute advancing once per instance
+    static const int sizes[3] = {3, 3, 2};
+    batch_VAOs.resize(batches.size());
+    glGenVertexArrays((GLsizei) batch_VAOs.size(), batch_VAOs.data());
+    for (size_t i = 0; i < batches.size(); i++) {
+        glBindVertexArray(batch_VAOs[i]);
+        glBindBuffer(GL_ARRAY_BUFFER, entities.meshes[batches[i].mesh_id]->VBO);
+        int offset = 0;
+        for (int j = 0; j < 3; j++) {
+            glVertexAttribPointer(j, sizes[j], GL_FLOAT, GL_FALSE, 14 * sizeof(GL_FLOAT), (void*) (offset * sizeof(GL_FLOAT)));
+            glEnableVertexAttribArray(j);
+            offset += sizes[j];
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, instance_buffer);
+        glVertexAttribIPointer(5, 1, GL_UNSIGNED_INT, sizeof(GLuint), (void*) 0);
+        glVertexAttribDivisor(5, 1);
+        glEnableVertexAttribArray(5);
+    }
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// Tests the entities for a phase, 0 or 1, seen by a camera, writing the draws CulledShader makes of the ones that pass
+void GpuCuller::cull(int phase, Camera& camera) {
+    PROFILE_GPU_SCOPE("GPU cull");
+    if (phase == 0)
+        readCounters();
+    if (entity_count == 0)
+        return;
+
+    // The first phase starts every draw empty, the second adds to its own draws
+    if (phase == 0) {
+        view_projection = camera.getProjectionMatrix() * camera.getViewMatrix();
+        glBindBuffer(GL_COPY_READ_BUFFER, empty_command_buffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, command_buffer);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, 2 * batches.size() * sizeof(DrawCommand));
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        GLuint zero = 0;
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, counter_buffer);
+        glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    }
+
+    Frustum frustum(view_projection);
+    cull_shader.setInt("phase", phase);
+    cull_shader.setUint("entity_count", entity_count);
+    cull_shader.setUint("batch_count", (GLuint) batches.size());
+    cull_shader.setVec4Array("frustum_planes", frustum.planes, 6);
+    cull_shader.setInt("has_pyramid", has_pyramid);
+    cull_shader.setMat4("pyramid_view_projection", pyramid_view_projection);
+    cull_shader.setIvec2("screen_size", glm::ivec2(screen_width, screen_height));
+    cull_shader.setInt("pyramid_levels", pyramid_levels);
+    glActiveTexture(GL_TEXTURE0 + GPU_CULL_PYRAMID_UNIT);
+    glBindTexture(GL_TEXTURE_2D, pyramid);
+
+    GLuint buffers[6] = {sphere_buffer, batch_buffer, command_buffer, instance_buffer, occluded_buffer, counter_buffer};
+    for (int i = 0; i < 6; i++)
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, i, buffers[i]);
+    cull_shader.dispatch(entity_count, cull_group_size);
+
+    // The draws read the commands and instances next, and the second phase the entities the first found hidden
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+    glUseProgram(0);
+
+    // The frame's counters are complete, they go to the next readback buffer and are read once its fence has passed
+    if (phase == 1) {
+        glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+        if (readback_fences[readback_frame])
+            glDeleteSync(readback_fences[readback_frame]);
+        glBindBuffer(GL_COPY_READ_BUFFER, counter_buffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, readback_buffers[readback_frame]);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, sizeof(GpuCullCounters));
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        readback_fences[readback_frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        readback_frame = (readback_frame + 1) % GPU_CULL_READBACK_FRAMES;
+    }
+}
+
+// Reads the counters of every frame the GPU has finished, without waiting on the ones it has not
+void GpuCuller::readCounters() {
+    // Starting from the oldest frame in flight, a frame that is not done means the ones after it are not either
+    for (int i = 0; i < GPU_CULL_READBACK_FRAMES; i++) {
+        int frame = (readback_frame + i) % GPU_CULL_READBACK_FRAMES;
+        if (!readback_fences[frame])
+            continue;
+        GLenum status = glClientWaitSync(readback_fences[frame], 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+            break;
+        glBindBuffer(GL_COPY_READ_BUFFER, readback_buffers[frame]);
+        glGetBufferSubData(GL_COPY_READ_BUFFER, 0, sizeof(GpuCullCounters), &counters);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glDeleteSync(readback_fences[frame]);
+        readback_fences[frame] = 0;
+    }
+}
+
+// Rebuilds the pyramid from the depth texture drawn so far this frame, between the two phases
+void GpuCuller::buildPyramid(GLuint depth_texture, int width, int height) {
+    PROFILE_GPU_SCOPE("Depth pyramid");
+
+    // Level 0 is half the screen rounded up to a power of two, so each level after is exactly half the last and every texel
+    // of a level covers the same pixels as the 2x2 texels under it, the texels past the edge repeat the last row and column
+    if (width != screen_width || height != screen_height) {
+        screen_width = width;
+        screen_height = height;
+        pyramid_width = pyramid_height = 1;
+        while (pyramid_width * 2 < width)
+            pyramid_width *= 2;
+        while (pyramid_height * 2 < height)
+            pyramid_height *= 2;
+        pyramid_levels = 1;
+        while ((std::max(pyramid_width, pyramid_height) >> pyramid_levels) > 0)
+            pyramid_levels++;
+        glDeleteTextures(1, &pyramid);
+        glGenTextures(1, &pyramid);
+        glBindTexture(GL_TEXTURE_2D, pyramid);
+        glTexStorage2D(GL_TEXTURE_2D, pyramid_levels, GL_R32F, pyramid_width, pyramid_height);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    // Level 0 reads the depth texture, every level after it the level before
+    glActiveTexture(GL_TEXTURE0 + GPU_CULL_PYRAMID_UNIT);
+    glBindTexture(GL_TEXTURE_2D, depth_texture);
+    glm::ivec2 source_size(width, height);
+    glm::ivec2 level_size(pyramid_width, pyramid_height);
+    for (int level = 0; level < pyramid_levels; level++) {
+        pyramid_shader.setInt("from_depth", level == 0);
+        pyramid_shader.setIvec2("source_size", source_size);
+        pyramid_shader.setIvec2("destination_size", level_size);
+        glBindImageTexture(0, pyramid, std::max(level - 1, 0), GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+        glBindImageTexture(1, pyramid, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+        glDispatchCompute((level_size.x + pyramid_group_size - 1) / pyramid_group_size, (level_size.y + pyramid_group_size - 1) / pyramid_group_size, 1);
+        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+        source_size = level_size;
+        level_size = glm::max(level_size / 2, glm::ivec2(1));
+    }
+    glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glUseProgram(0);
+
+    // The depth was drawn with this frame's camera
+    pyramid_view_projection = view_projection;
+    has_pyramid = true;
+}
+
+// Binds the draws and the world matrices the vertex shader of culled draws reads
+void GpuCuller::bindDraws() {
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, command_buffer);
+    glActiveTexture(GL_TEXTURE0 + GPU_CULL_TRANSFORMS_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, transform_texture);
+}
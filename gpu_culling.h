@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common.h"
+#include "camera.h"
+#include "entity.h"
+#include "shader.h"
+
+// Texture unit of the buffer of world matrices the vertex shader of culled draws reads, below the point shadow atlas
+#define GPU_CULL_TRANSFORMS_UNIT 10
+// Texture unit the culling shaders read the depth and the pyramid from
+#define GPU_CULL_PYRAMID_UNIT 9
+// Frames of counters in flight, they are read once the GPU is done with them instead of waiting for it
+#define GPU_CULL_READBACK_FRAMES 3
+
+// What the two culling phases of a frame found
+struct GpuCullCounters {
+    uint32_t frustum_culled;    // Outside the view
+    uint32_t first_drawn;       // In view and in front of the depth of the last frame, drawn by the first phase
+    uint32_t first_occluded;    // In view but behind the depth of the last frame, tested again by the second phase
+    uint32_t second_drawn;      // Of those, the ones in front of the depth of the first phase, come into view since the last frame
+};
+
+// Entities of one mesh and material, drawn by one indirect instanced draw per phase
+struct GpuCullBatch {
+    uint32_t mesh_id;
+    uint32_t material_id;
+    // Where the batch's instances start among those of every batch, and how many entities it has
+    uint32_t first;
+    uint32_t count;
+};
+
+// Culls the entities on the GPU and draws the ones left with indirect draws, so the CPU does the same work however many there are
+// A frame culls in two phases: the first tests every entity against the frustum and a pyramid of the farthest depth drawn last frame,
+// and the ones in front of it are drawn, then the pyramid is rebuilt from the depth drawn so far and the second phase tests the
+// entities the first found hidden against it, drawing the ones that have come into view
+// A compute shader adds each entity that passes to the instance count of its batch's draw and writes its index where the draw reads it
+class GpuCuller {
+public:
+    GpuCuller();
+
+    // Deconstructor to free the buffers and the pyramid
+    ~GpuCuller();
+
+    // Copies the world bounds and matrices of the entities that are not hidden to the GPU and sorts them into batches,
+    // entities that move or are added later are only seen once this is called again
+    void upload(EntityStore& entities);
+
+    // Tests the entities for a phase, 0 or 1, seen by a camera, writing the draws CulledShader makes of the ones that pass
+    void cull(int phase, Camera& camera);
+
+    // Rebuilds the pyramid from the depth texture drawn so far this frame, between the two phases
+    void buildPyramid(GLuint depth_texture, int width, int height);
+
+    // Binds the draws and the world matrices the vertex shader of culled draws reads
+    void bindDraws();
+
+    inline const std::vector<GpuCullBatch>& getBatches() const {
+        return batches;
+    }
+
+    // Vertex array of a batch, its mesh's vertices with the indices of the entities drawn as an instance attribute
+    inline GLuint getBatchVAO(size_t batch) const {
+        return batch_VAOs[batch];
+    }
+
+    // Offset of a batch's draw for a phase in the bound draw buffer
+    inline size_t getCommandOffset(int phase, size_t batch) const {
+        return (phase * batches.size() + batch) * sizeof(DrawCommand);
+    }
+
+    inline uint32_t getEntityCount() const {
+        return entity_count;
+    }
+
+    // Counters of the newest frame the GPU has finished, some frames behind the one being drawn
+    inline const GpuCullCounters& getCounters() const {
+        return counters;
+    }
+
+private:
+    // Layout of glDrawArraysIndirect's commands
+    struct DrawCommand {
+        GLuint count;
+        GLuint instance_count;
+        GLuint first;
+        GLuint base_instance;
+    };
+
+    uint32_t entity_count;
+    std::vector<GpuCullBatch> batches;
+    std::vector<GLuint> batch_VAOs;
+
+    // Bounding sphere, batch and world matrix of each entity, and whether the first phase found it hidden
+    GLuint sphere_buffer;
+    GLuint batch_buffer;
+    GLuint transform_buffer;
+    GLuint transform_texture;
+    GLuint occluded_buffer;
+    // Draws of both phases, the empty ones they start from each frame, and the entities each draws
+    GLuint command_buffer;
+    GLuint empty_command_buffer;
+    GLuint instance_buffer;
+
+    // Farthest depth of each 2x2 pixels of the screen, then of each 2x2 texels of the level before, as a mip chain
+    GLuint pyramid;
+    int pyramid_width, pyramid_height, pyramid_levels;
+    int screen_width, screen_height;
+    glm::mat4 pyramid_view_projection;
+    glm::mat4 view_projection;
+    bool has_pyramid;
+
+    // The counters written by the shaders, copied each frame into the next readback buffer with a fence to tell when it is done
+    GLuint counter_buffer;
+    GLuint readback_buffers[GPU_CULL_READBACK_FRAMES];
+    GLsync readback_fences[GPU_CULL_READBACK_FRAMES];
+    int readback_frame;
+    GpuCullCounters counters;
+
+    ComputeShader cull_shader;
+    ComputeShader pyramid_shader;
+
+    // Frees the buffers sized by the entities
+    void freeEntityBuffers();
+
+    // Reads the counters of every frame the GPU has finished, without waiting on the ones it has not
+    void readCounters();
+};
@@ -1,83 +1,162 @@
-#include "player.h"
+#include "input.h"
+#include "profiler.h"
 
-static bool mouse_clicked = false; // Flag indicating whether the left mouse button is beeing held
-static float last_mouse_x = 0;	// Last saved position of the mouse on the x-axis
-static float last_mouse_y = 0;	// Last saved position of the mouse on the y-axis
+// Pushes an event into the queue the window was set up with, events are dropped if the simulation falls far behind
+static inline void pushEvent(GLFWwindow* window, uint8_t type, int code, int action, float x = 0, float y = 0) {
+	InputQueue* queue = (InputQueue*) glfwGetWindowUserPointer(window);
+	InputEvent event;
+	event.time = (float) glfwGetTime();
+	event.x = x;
+	event.y = y;
+	event.code = (int16_t) code;
+	event.type = type;
+	event.action = (uint8_t) action;
+	queue->push(event);
+}
 
-// Handles the user keyboard inputs and makes the program repond accordingly.
+// Queues the user keyboard inputs for the simulation to respond to.
 void keyboardControl(GLFWwindow* window, int key, int scanCode, int action, int mods) {
-	Player* player = (Player*) glfwGetWindowUserPointer(window);
-	static const float amount = 1.2f;
-	if (action == GLFW_REPEAT || action == GLFW_PRESS) {
-		// If the player is in 1st or 3rd person pov, allow them to control the ship
-		if (!player->is_ortho) {
-			switch (key) {
-				case GLFW_KEY_D: player->turnYaw(amount); break;
-				case GLFW_KEY_A: player->turnYaw(-amount); break;
-				case GLFW_KEY_S: player->moveForward(-amount);  break;
-				case GLFW_KEY_W: player->moveForward(amount); break;
-				case GLFW_KEY_Q: player->moveVertically(amount); break;
-				case GLFW_KEY_E: player->moveVertically(-amount); break;
-				case GLFW_KEY_1: player->is_third_ppov = !player->is_third_ppov; break;
+	if (key < 0 || key > GLFW_KEY_LAST)
+		return;
+	pushEvent(window, INPUT_KEY, key, action);
+}
+
+// Queues the user's mouse movements for the simulation to respond to.
+void mouseControl(GLFWwindow* window, double xPos, double yPos) {
+	pushEvent(window, INPUT_MOUSE_MOVE, 0, 0, (float) xPos, (float) yPos);
+}
+
+// Queues the user mouse inputs for the simulation to respond to.
+void mouseButtonControl(GLFWwindow* window, int button, int action, int mods) {
+	pushEvent(window, INPUT_MOUSE_BUTTON, button, action);
+}
+
+// Moves every pending event out of the queue, returns the number of events written to events.
+size_t drainInput(InputQueue& queue, InputEvent* events, size_t max_count) {
+	size_t count = 0;
+	while (count < max_count && !queue.isEmpty())
+		count += queue.popAll(events + count, max_count - count);
+	return count;
+}
+
+// Handles a key event and makes the program repond accordingly.
+static void applyKey(InputState& state, Player* player, const InputEvent& event) {
+	// Replayed events come from a file, so codes GLFW never sends are ignored rather than indexing past the keys
+	if (event.code < 0 || event.code > GLFW_KEY_LAST)
+		return;
+
+	// Movement keys are only tracked here and applied at a fixed rate by updatePlayer
+	if (event.action == GLFW_PRESS)
+		state.held_keys[event.code] = true;
+	else if (event.action == GLFW_RELEASE)
+		state.held_keys[event.code] = false;
+
+	if (event.action != GLFW_PRESS)
+		return;
+
+	// Toggle between camera modes and light intensities
+	switch (event.code) {
+		case GLFW_KEY_1:
+			if (!player->is_ortho)
+				player->is_third_ppov = !player->is_third_ppov;
+			break;
+
+		case GLFW_KEY_2:
+			player->is_ortho = !player->is_ortho;
+			// If the player is switching to orthographic view, reset the camera's position
+			if (player->is_ortho) {
+				player->cam_birdppov.moveXZ(player->pos.x, player->pos.z);
+				player->cam_birdppov.lookDown();
+				// Do not blend the jump of the camera across frames
+				player->saveState();
 			}
-		}
-		// Otherwise, allow them to the orthographical camera
-		else {
-            switch (key) {
-				case GLFW_KEY_D: player->moveOrtho(-amount, 0); break;
-				case GLFW_KEY_A: player->moveOrtho(amount, 0); break;
-				case GLFW_KEY_S: player->moveOrtho(0, -amount);  break;
-				case GLFW_KEY_W: player->moveOrtho(0, amount); break;
-            }
-		}
-		// Toggle between camera modes and light intensities
-        switch (key) {
-			case GLFW_KEY_2:	
-				player->is_ortho = !player->is_ortho;
-				// If the player is switching to orthographic view, reset the camera's position
-				if (player->is_ortho) {
-					player->cam_birdppov.moveXZ(player->pos.x, player->pos.z);
-					player->cam_birdppov.lookDown();
-				}
-				break;
-
-			case GLFW_KEY_F: player->nextIntensity(); break;
-        }
+			break;
+
+		case GLFW_KEY_F: player->nextIntensity(); break;
 	}
-	if (player->is_ortho)
-		glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
-	else if (player->is_third_ppov)
-		glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-	else
-		glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
 }
 
-// Tracks the user's mouse movements and makes the program repond accordingly.
-void mouseControl(GLFWwindow* window, double xPos, double yPos) {
-	Player* player = (Player*) glfwGetWindowUserPointer(window);
+// Handles a mouse movement event and makes the program repond accordingly.
+static void applyMouseMove(InputState& state, Player* player, const InputEvent& event) {
 	static const float amount = 0.05f;
 	if (!player->is_ortho && player->is_third_ppov)
-		player->cam_3rdppov.rotate((xPos - last_mouse_x) * amount, (yPos - last_mouse_y) * amount);
-	else if (player->is_ortho && mouse_clicked)
-		player->cam_birdppov.tiltView((xPos - last_mouse_x) * amount, (yPos - last_mouse_y) * amount);
-	last_mouse_x = xPos;
-	last_mouse_y = yPos;
-
-	if (player->is_third_ppov && !player->is_ortho)
-		glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+		player->cam_3rdppov.rotate((event.x - state.last_mouse_x) * amount, (event.y - state.last_mouse_y) * amount);
+	else if (player->is_ortho && state.mouse_clicked)
+		player->cam_birdppov.tiltView((event.x - state.last_mouse_x) * amount, (event.y - state.last_mouse_y) * amount);
+	state.last_mouse_x = event.x;
+	state.last_mouse_y = event.y;
 }
 
-// Handles the user mouse inputs and makes the program repond accordingly.
-void mouseButtonControl(GLFWwindow* window, int button, int action, int mods) {
-	Player* player = (Player*) glfwGetWindowUserPointer(window);
-	if (player->is_ortho) {
-		if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS) {
-			mouse_clicked = true;
-			glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-		}
-		else if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_RELEASE) {
-			mouse_clicked = false;
-			glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+// Handles a mouse button event and makes the program repond accordingly.
+static void applyMouseButton(InputState& state, Player* player, const InputEvent& event) {
+	if (player->is_ortho && event.code == GLFW_MOUSE_BUTTON_LEFT) {
+		if (event.action == GLFW_PRESS)
+			state.mouse_clicked = true;
+		else if (event.action == GLFW_RELEASE)
+			state.mouse_clicked = false;
+	}
+}
+
+// Applies a batch of drained events to the input state and the player, in the order they were received.
+void applyInput(InputState& state, Player* player, const InputEvent* events, size_t count) {
+	PROFILE_SCOPE("Apply input");
+	for (size_t i = 0; i < count; i++) {
+		switch (events[i].type) {
+			case INPUT_KEY: applyKey(state, player, events[i]); break;
+			case INPUT_MOUSE_MOVE: applyMouseMove(state, player, events[i]); break;
+			case INPUT_MOUSE_BUTTON: applyMouseButton(state, player, events[i]); break;
 		}
 	}
-}
\ No newline at end of file
+}
+
+// Moves the player according to the keys being held, called once per fixed simulation step of dt seconds.
+void updatePlayer(InputState& state, Player* player, float dt) {
+	PROFILE_SCOPE("Update player");
+	// Units or degrees per second, matching the former 1.2 per key repeat at a typical 30 Hz repeat rate
+	static const float speed = 36.f;
+	float amount = speed * dt;
+	bool* held_keys = state.held_keys;
+
+	// If the player is in 1st or 3rd person pov, allow them to control the ship
+	if (!player->is_ortho) {
+		if (held_keys[GLFW_KEY_D])
+			player->turnYaw(amount);
+		if (held_keys[GLFW_KEY_A])
+			player->turnYaw(-amount);
+		if (held_keys[GLFW_KEY_S])
+			player->moveForward(-amount);
+		if (held_keys[GLFW_KEY_W])
+			player->moveForward(amount);
+		if (held_keys[GLFW_KEY_Q])
+			player->moveVertically(amount);
+		if (held_keys[GLFW_KEY_E])
+			player->moveVertically(-amount);
+	}
+	// Otherwise, allow them to the orthographical camera
+	else {
+		if (held_keys[GLFW_KEY_D])
+			player->moveOrtho(-amount, 0);
+		if (held_keys[GLFW_KEY_A])
+			player->moveOrtho(amount, 0);
+		if (held_keys[GLFW_KEY_S])
+			player->moveOrtho(0, -amount);
+		if (held_keys[GLFW_KEY_W])
+			player->moveOrtho(0, amount);
+	}
+}
+
+// Shows or captures the cursor depending on the player's view, only touching the window when the mode changes.
+void updateCursor(GLFWwindow* window, InputState& state, Player* player) {
+	int mode;
+	if (player->is_ortho)
+		mode = state.mouse_clicked ? GLFW_CURSOR_DISABLED : GLFW_CURSOR_NORMAL;
+	else if (player->is_third_ppov)
+		mode = GLFW_CURSOR_DISABLED;
+	else
+		mode = GLFW_CURSOR_NORMAL;
+
+	if (mode != state.cursor_mode) {
+		glfwSetInputMode(window, GLFW_CURSOR, mode);
+		state.cursor_mode = mode;
+	}
+}
@@ -1,6 +1,22 @@
 #pragma once
 #include "player.h"
+#include "input_queue.h"
+
+// Input state owned by the simulation, built up from the events drained from the input queue
+struct InputState {
+	bool held_keys[GLFW_KEY_LAST + 1];	// Flags indicating which keys are being held down
+	bool mouse_clicked;					// Flag indicating whether the left mouse button is beeing held
+	float last_mouse_x;					// Last saved position of the mouse on the x-axis
+	float last_mouse_y;					// Last saved position of the mouse on the y-axis
+	int cursor_mode;					// Cursor mode last applied to the window
+
+	InputState(): held_keys(), mouse_clicked(false), last_mouse_x(0), last_mouse_y(0), cursor_mode(-1) {}
+};
 
 void keyboardControl(GLFWwindow* window, int key, int scanCode, int action, int mods);
 void mouseControl(GLFWwindow* window, double xPos, double yPos);
-void mouseButtonControl(GLFWwindow* window, int button, int action, int mods);
\ No newline at end of file
+void mouseButtonControl(GLFWwindow* window, int button, int action, int mods);
+size_t drainInput(InputQueue& queue, InputEvent* events, size_t max_count);
+void applyInput(InputState& state, Player* player, const InputEvent* events, size_t count);
+void updatePlayer(InputState& state, Player* player, float dt);
+void updateCursor(GLFWwindow* window, InputState& state, Player* player);
\ No newline at end of file
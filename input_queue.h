@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Kinds of input events captured by the window callbacks
+enum InputEventType : uint8_t {
+    INPUT_KEY,
+    INPUT_MOUSE_MOVE,
+    INPUT_MOUSE_BUTTON
+};
+
+// A compact timestamped input event, kept at 16 bytes so a burst of events stays within a few cache lines
+struct InputEvent {
+    float time;     // Seconds since the window was created
+    float x, y;     // Cursor position for mouse movement events
+    int16_t code;   // Key or mouse button
+    uint8_t type;   // One of InputEventType
+    uint8_t action; // GLFW_PRESS, GLFW_RELEASE, or GLFW_REPEAT
+};
+
+// Lock-free ring buffer with a single producer and a single consumer, capacity must be a power of two
+template <class T, size_t Capacity>
+class SpscRing {
+    static_assert((Capacity & (Capacity - 1)) == 0, "SpscRing capacity must be a power of two");
+
+public:
+    SpscRing(): head(0), tail(0) {}
+
+    // Adds an item at the back of the ring, returns false and drops the item if the ring is full
+    inline bool push(const T& item) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == Capacity)
+            return false;
+        items[t & (Capacity - 1)] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Moves up to max_count items from the front of the ring into out, returns how many were moved
+    inline size_t popAll(T* out, size_t max_count) {
+        size_t h = head.load(std::memory_order_relaxed);
+        size_t count = tail.load(std::memory_order_acquire) - h;
+        if (count > max_count)
+            count = max_count;
+        for (size_t i = 0; i < count; i++)
+            out[i] = items[(h + i) & (Capacity - 1)];
+        head.store(h + count, std::memory_order_release);
+        return count;
+    }
+
+    // Whether there are no items waiting to be consumed
+    inline bool isEmpty() {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+private:
+    T items[Capacity];
+    // Producer and consumer indices are kept on separate cache lines so they do not contend
+    alignas(64) std::atomic<size_t> head;
+    alignas(64) std::atomic<size_t> tail;
+};
+
+// Queue of input events written by the window callbacks and drained by the simulation step
+typedef SpscRing<InputEvent, 1024> InputQueue;
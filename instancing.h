@@ -0,0 +1,111 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+#include "common.h"
+#include "model.h"
+
+// Per instance attributes of the instanced renderer, the model faces along dir and is placed at pos
+struct InstanceData {
+    glm::vec3 pos;
+    glm::vec3 dir;
+};
+
+// Streams the attributes of many instances of a mesh to the GPU so they can be drawn with a single call
+typedef struct InstanceBuffer {
+    GLuint VAO;
+    GLuint VBO;
+    // Reads only the mesh's positions with the same instance attributes, for passes that only write depth
+    GLuint position_VAO;
+    VertexAttribs& mesh;
+    size_t capacity;
+    int count;
+
+    // Creates a VAO reading the vertices of a mesh and the attributes of up to capacity instances
+    InstanceBuffer(VertexAttribs& mesh, size_t capacity): mesh(mesh), capacity(capacity), count(0) {
+        glGenVertexArrays(1, &VAO);
+        glGenBuffers(1, &VBO);
+        glBindVertexArray(VAO);
+
+        // Same layout as VertexAttribs XYZ,NXNYNZ,UV,TXTYTZ,BXBYBZ
+        static const int sizes[] {3, 3, 2, 3, 3};
+        int vector_size = 14;
+        int offset = 0;
+        glBindBuffer(GL_ARRAY_BUFFER, mesh.VBO);
+        for (int i = 0; i < 5; i++) {
+            glVertexAttribPointer(i, sizes[i], GL_FLOAT, GL_FALSE, vector_size * sizeof(GL_FLOAT), (void*) (offset * sizeof(GL_FLOAT)));
+            glEnableVertexAttribArray(i);
+            offset += sizes[i];
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(InstanceData), NULL, GL_STREAM_DRAW);
+        bindInstanceAttribs(VBO, sizeof(InstanceData), offsetof(InstanceData, pos), offsetof(InstanceData, dir));
+
+        glGenVertexArrays(1, &position_VAO);
+        glBindVertexArray(position_VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, mesh.position_VBO);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GL_FLOAT), (void*) 0);
+        glEnableVertexAttribArray(0);
+        bindInstanceAttribs(VBO, sizeof(InstanceData), offsetof(InstanceData, pos), offsetof(InstanceData, dir));
+
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindVertexArray(0);
+    }
+
+    // Deconstructor to free the VAOs and instance VBO, the mesh's VBOs belong to the mesh
+    ~InstanceBuffer() {
+        glDeleteVertexArrays(1, &VAO);
+        glDeleteVertexArrays(1, &position_VAO);
+        glDeleteBuffers(1, &VBO);
+    }
+
+    // Maps the buffer to write the attributes of instance_count instances into, orphaning the storage the GPU may still be reading
+    // Returns NULL when there is nothing to write, in which case unmap does not need to be called
+    inline InstanceData* map(size_t instance_count) {
+        count = (int) std::min(instance_count, capacity);
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(InstanceData), NULL, GL_STREAM_DRAW);
+        if (count == 0)
+            return NULL;
+        InstanceData* instances = (InstanceData*) glMapBufferRange(GL_ARRAY_BUFFER, 0, count * sizeof(InstanceData),
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        // Nothing is drawn if the buffer could not be mapped
+        if (!instances)
+            count = 0;
+        return instances;
+    }
+
+    // Reads the instance attributes from another buffer instead, such as one written by a compute shader
+    // Each instance's position and heading are three floats at the given offsets in a record stride bytes long
+    inline void setSource(GLuint buffer, int instance_count, GLsizei stride, size_t pos_offset, size_t dir_offset) {
+        count = instance_count;
+        glBindVertexArray(VAO);
+        bindInstanceAttribs(buffer, stride, pos_offset, dir_offset);
+        glBindVertexArray(position_VAO);
+        bindInstanceAttribs(buffer, stride, pos_offset, dir_offset);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindVertexArray(0);
+    }
+
+    // Points the bound VAO's instance attributes at a buffer, they advance once per instance instead of once per vertex
+    inline void bindInstanceAttribs(GLuint buffer, GLsizei stride, size_t pos_offset, size_t dir_offset) {
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        glVertexAttribPointer(5, 3, GL_FLOAT, GL_FALSE, stride, (void*) pos_offset);
+        glVertexAttribPointer(6, 3, GL_FLOAT, GL_FALSE, stride, (void*) dir_offset);
+        glVertexAttribDivisor(5, 1);
+        glVertexAttribDivisor(6, 1);
+        glEnableVertexAttribArray(5);
+        glEnableVertexAttribArray(6);
+    }
+
+    // Finishes writing the mapped instances
+    inline void unmap() {
+        if (count == 0)
+            return;
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+} InstanceBuffer;
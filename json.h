@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdio>
+#include <ostream>
+#include <string>
+
+// Writes a string as a JSON string literal, escaping quotes, backslashes and control characters
+// Asset paths on Windows are full of backslashes and names can hold anything the user typed
+inline void writeJsonString(std::ostream& out, const std::string& text) {
+    out << '"';
+    for (char c : text) {
+        switch (c) {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\r': out << "\\r"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if ((unsigned char) c < 0x20) {
+                    char escaped[8];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned char) c);
+                    out << escaped;
+                }
+                else
+                    out << c;
+                break;
+        }
+    }
+    out << '"';
+}
@@ -1,6 +1,16 @@
 #pragma once
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
 #include <glm/glm.hpp>
 
+// Fraction of a point light's strength below which it is treated as having no effect, bounding its reach, must match the shaders
+#define POINT_LIGHT_CUTOFF 0.05f
+
+// Nearest and farthest distances a point light's shadow map covers, so lights with a huge reach keep some depth precision, the nearest must match the shaders
+#define POINT_SHADOW_NEAR 0.1f
+#define POINT_SHADOW_MAX_RANGE 60.f
+
 // Represents the base attributes needed to represent a light source, should not be instantiated
 class Light {
 public:
@@ -22,19 +32,36 @@ class PointLight: public Light {
 public:
     float linear;
     float quadratic;
+    // Whether the light is given a slot of the point shadow atlas, and the slot it was given this frame, -1 if none
+    bool casts_shadows;
+    int shadow_slot;
 
     PointLight(float linear, float quadratic, glm::vec3 pos, glm::vec3 diff_color,
         float ambient_str, glm::vec3 ambient_color, float spec_str, float spec_phong):
         Light(pos, diff_color, ambient_str, ambient_color, spec_str, spec_phong),
-        linear(linear), quadratic(quadratic) {}
+        linear(linear), quadratic(quadratic), casts_shadows(false), shadow_slot(-1) {}
     
     // Overloaded constructor that takes strengthe instead of indiviual linear and quadratic values
     PointLight(float strength, glm::vec3 pos, glm::vec3 color, float ambient_str, float spec_str, float spec_phong):
-        Light(pos, color, ambient_str, color, spec_str, spec_phong) {
+        Light(pos, color, ambient_str, color, spec_str, spec_phong), casts_shadows(false), shadow_slot(-1) {
         linear = 1 / strength * 0.14f;
         quadratic = 1 / strength * 0.0007;
     }
 
+    // Gets the distance at which the light's attenuation falls to cutoff, beyond which it can be treated as having no effect
+    inline float getRadius(float cutoff = POINT_LIGHT_CUTOFF) const {
+        // Solve 1 / (1 + linear * d + quadratic * d^2) = cutoff for d
+        float c = 1.f - 1.f / cutoff;
+        if (quadratic <= 0.f)
+            return linear > 0.f ? -c / linear : FLT_MAX;
+        return (-linear + std::sqrt(linear * linear - 4.f * quadratic * c)) / (2.f * quadratic);
+    }
+
+    // Gets how far the light's shadow map reaches, past which it casts no shadows
+    inline float getShadowRange() const {
+        return std::min(getRadius(), POINT_SHADOW_MAX_RANGE);
+    }
+
     // A function that will adjust the quadratic and linear values by a given strength
     inline void adjustStrength(float strength) {
 		linear = 1 / strength * 0.14f;
@@ -0,0 +1,182 @@
+#include "light_clusters.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "profiler.h"
+
+LightClusters::LightClusters(): view_forward(0.f, 0.f, -1.f), depth_scale(0.f), depth_bias(0.f), tile_scale(0.f), cull_lights(true), light_count(0), index_count(0) {
+    GLint max_texels = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &max_texels);
+    max_indices = (size_t) std::max(max_texels, 65536);
+    grid.resize(CLUSTER_COUNT * 2, 0);
+
+    // Every buffer starts out holding one zeroed texel, so reading it before the first update finds no lights
+    static const GLenum formats[3] = {GL_RGBA32F, GL_RG32UI, GL_R32UI};
+    static const glm::vec4 empty(0.f);
+    glGenBuffers(3, buffers);
+    glGenTextures(3, textures);
+    for (int i = 0; i < 3; i++) {
+        capacities[i] = 0;
+        upload(i, &empty, sizeof(empty));
+        glBindTexture(GL_TEXTURE_BUFFER, textures[i]);
+        glTexBuffer(GL_TEXTURE_BUFFER, formats[i], buffers[i]);
+    }
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+}
+
+// Deconstructor to free the buffers and their textures
+LightClusters::~LightClusters() {
+    glDeleteTextures(3, textures);
+    glDeleteBuffers(3, buffers);
+}
+
+// Uploads data to one of the buffers, reallocating it when it has to grow
+void LightClusters::upload(int index, const void* data, size_t size) {
+    glBindBuffer(GL_TEXTURE_BUFFER, buffers[index]);
+    if (size > capacities[index]) {
+        // Grows by half again so lists that change size every frame settle on one allocation
+        capacities[index] = size + size / 2;
+        glBufferData(GL_TEXTURE_BUFFER, capacities[index], NULL, GL_STREAM_DRAW);
+    }
+    glBufferSubData(GL_TEXTURE_BUFFER, 0, size, data);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+// Bins the lights into the froxels of a camera, the lights' attenuation is cut off at POINT_LIGHT_CUTOFF so each has a radius
+void LightClusters::update(const std::vector<PointLight>& lights, Camera& camera) {
+    PROFILE_SCOPE("Light clusters");
+    glm::mat4 view = camera.getViewMatrix();
+    glm::mat4 projection = camera.getProjectionMatrix();
+    view_forward = glm::normalize(camera.camera_center - camera.camera_pos);
+
+    // Slices get deeper the further they are, so every froxel is about as deep as it is wide
+    float log_depth = std::log(camera.zfar / camera.znear);
+    depth_scale = CLUSTER_SLICES / log_depth;
+    depth_bias = -std::log(camera.znear) * depth_scale;
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    tile_scale = glm::vec2((float) CLUSTER_TILES_X / viewport[2], (float) CLUSTER_TILES_Y / viewport[3]);
+
+    light_data.clear();
+    spans.clear();
+    if (!cull_lights) {
+        // One list holding every light, which every cluster points to
+        for (const PointLight& light : lights)
+            addLight(light);
+        light_count = std::min(light_data.size() / 3, max_indices);
+        indices.resize(light_count);
+        for (size_t i = 0; i < light_count; i++)
+            indices[i] = (GLuint) i;
+        for (size_t cluster = 0; cluster < CLUSTER_COUNT; cluster++) {
+            grid[cluster * 2] = 0;
+            grid[cluster * 2 + 1] = (GLuint) light_count;
+        }
+        index_count = light_count * CLUSTER_COUNT;
+        uploadLists();
+        return;
+    }
+
+    // Find the tiles each light's sphere covers slice by slice, cutting the sphere at each slice's depths
+    std::fill(grid.begin(), grid.end(), 0);
+    glm::ivec2 tiles(CLUSTER_TILES_X, CLUSTER_TILES_Y);
+    for (const PointLight& light : lights) {
+        float radius = light.getRadius();
+        glm::vec3 center = glm::vec3(view * glm::vec4(light.pos, 1.f));
+        float depth = -center.z;
+        if (depth + radius < camera.znear || depth - radius > camera.zfar)
+            continue;
+
+        float min_depth = std::max(depth - radius, camera.znear);
+        float max_depth = std::min(depth + radius, camera.zfar);
+        int min_slice = std::max((int) std::floor(std::log(min_depth) * depth_scale + depth_bias), 0);
+        int max_slice = std::min((int) std::floor(std::log(max_depth) * depth_scale + depth_bias), CLUSTER_SLICES - 1);
+
+        GLuint index = (GLuint) (light_data.size() / 3);
+        bool in_view = false;
+        for (int slice = min_slice; slice <= max_slice; slice++) {
+            float slice_near = std::max(std::exp((slice - depth_bias) / depth_scale), min_depth);
+            float slice_far = std::min(std::exp((slice + 1 - depth_bias) / depth_scale), max_depth);
+            float offset = depth < slice_near ? slice_near - depth : (depth > slice_far ? depth - slice_far : 0.f);
+            float section = std::sqrt(std::max(radius * radius - offset * offset, 0.f));
+
+            // The corners of the box around the cross section, between the slice's depths, project to a rectangle holding it
+            glm::vec2 ndc_min(FLT_MAX), ndc_max(-FLT_MAX);
+            for (int corner = 0; corner < 8; corner++) {
+                float x = center.x + ((corner & 1) ? section : -section);
+                float y = center.y + ((corner & 2) ? section : -section);
+                float z = (corner & 4) ? -slice_near : -slice_far;
+                glm::vec4 clip = projection * glm::vec4(x, y, z, 1.f);
+                glm::vec2 ndc = glm::vec2(clip) / clip.w;
+                ndc_min = glm::min(ndc_min, ndc);
+                ndc_max = glm::max(ndc_max, ndc);
+            }
+            if (ndc_max.x < -1.f || ndc_max.y < -1.f || ndc_min.x > 1.f || ndc_min.y > 1.f)
+                continue;
+
+            ClusterSpan span;
+            span.light = index;
+            span.slice = slice;
+            span.min_tile = glm::clamp(glm::ivec2(glm::floor((ndc_min * 0.5f + 0.5f) * glm::vec2(tiles))), glm::ivec2(0), tiles - 1);
+            span.max_tile = glm::clamp(glm::ivec2(glm::floor((ndc_max * 0.5f + 0.5f) * glm::vec2(tiles))), glm::ivec2(0), tiles - 1);
+            spans.push_back(span);
+            for (int y = span.min_tile.y; y <= span.max_tile.y; y++)
+                for (int x = span.min_tile.x; x <= span.max_tile.x; x++)
+                    grid[((slice * CLUSTER_TILES_Y + y) * CLUSTER_TILES_X + x) * 2 + 1]++;
+            in_view = true;
+        }
+
+        if (in_view)
+            addLight(light);
+    }
+    light_count = light_data.size() / 3;
+
+    // Lay the lists out one after another, then fill them in light order
+    GLuint total = 0;
+    for (size_t cluster = 0; cluster < CLUSTER_COUNT; cluster++) {
+        GLuint count = std::min(grid[cluster * 2 + 1], (GLuint) (max_indices - total));
+        grid[cluster * 2] = total;
+        grid[cluster * 2 + 1] = count;
+        total += count;
+    }
+    indices.resize(total);
+    index_count = total;
+    filled.assign(CLUSTER_COUNT, 0);
+    for (const ClusterSpan& span : spans) {
+        for (int y = span.min_tile.y; y <= span.max_tile.y; y++) {
+            for (int x = span.min_tile.x; x <= span.max_tile.x; x++) {
+                size_t cluster = (span.slice * CLUSTER_TILES_Y + y) * CLUSTER_TILES_X + x;
+                if (filled[cluster] < grid[cluster * 2 + 1])
+                    indices[grid[cluster * 2] + filled[cluster]++] = span.light;
+            }
+        }
+    }
+    uploadLists();
+}
+
+// Adds a light's three texels to the light data
+void LightClusters::addLight(const PointLight& light) {
+    light_data.push_back(glm::vec4(light.pos, light.linear));
+    light_data.push_back(glm::vec4(light.diff_color, light.quadratic));
+    light_data.push_back(glm::vec4((float) light.shadow_slot, light.getShadowRange(), 0.f, 0.f));
+}
+
+// Uploads the lights, the grid and the lists built by the last update
+void LightClusters::uploadLists() {
+    if (!light_data.empty())
+        upload(0, light_data.data(), light_data.size() * sizeof(glm::vec4));
+    upload(1, grid.data(), grid.size() * sizeof(GLuint));
+    if (!indices.empty())
+        upload(2, indices.data(), indices.size() * sizeof(GLuint));
+}
+
+// Binds the buffers to their texture units, they stay bound until something else is bound there
+void LightClusters::bind() {
+    static const GLenum units[3] = {CLUSTER_LIGHTS_UNIT, CLUSTER_GRID_UNIT, CLUSTER_INDICES_UNIT};
+    for (int i = 0; i < 3; i++) {
+        glActiveTexture(GL_TEXTURE0 + units[i]);
+        glBindTexture(GL_TEXTURE_BUFFER, textures[i]);
+    }
+    glActiveTexture(GL_TEXTURE0);
+}
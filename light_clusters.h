@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common.h"
+#include "camera.h"
+#include "light.h"
+
+// Size of the froxel grid, tiles across the screen and slices along the view depth, must match the shaders
+#define CLUSTER_TILES_X 16
+#define CLUSTER_TILES_Y 16
+#define CLUSTER_SLICES 24
+#define CLUSTER_COUNT (CLUSTER_TILES_X * CLUSTER_TILES_Y * CLUSTER_SLICES)
+
+// Texture units the cluster buffers are bound to, above the ones materials use
+#define CLUSTER_LIGHTS_UNIT 13
+#define CLUSTER_GRID_UNIT 14
+#define CLUSTER_INDICES_UNIT 15
+
+// Splits the view of a camera into froxels and lists the point lights that reach each one,
+// so lit shaders only loop over the lights that can affect a fragment
+// The lists are built on the CPU every frame and read by the shaders as texture buffers
+class LightClusters {
+public:
+    // Values the shaders map a fragment to its cluster with, the camera's forward axis,
+    // the scale and bias turning the log of a view depth into a slice, and the scale turning a pixel into a tile
+    glm::vec3 view_forward;
+    float depth_scale;
+    float depth_bias;
+    glm::vec2 tile_scale;
+    // Whether lights are binned at all, otherwise every cluster shares one list of all the lights,
+    // which shades like a forward renderer looping over every light
+    bool cull_lights;
+
+    LightClusters();
+
+    // Deconstructor to free the buffers and their textures
+    ~LightClusters();
+
+    // Bins the lights into the froxels of a camera, the lights' attenuation is cut off at POINT_LIGHT_CUTOFF so each has a radius
+    void update(const std::vector<PointLight>& lights, Camera& camera);
+
+    // Binds the buffers to their texture units, they stay bound until something else is bound there
+    void bind();
+
+    inline size_t getLightCount() const {
+        return light_count;
+    }
+
+    // Sum of the lengths of every cluster's list, how many light evaluations the froxels would cost if every one was shaded once
+    inline size_t getIndexCount() const {
+        return index_count;
+    }
+
+private:
+    size_t light_count;
+    size_t index_count;
+    // Entries past the largest texture buffer the driver allows are left out of the lists
+    size_t max_indices;
+
+    // Three RGBA32F texels per light, position and linear factor, then color and quadratic factor,
+    // then the slot of its shadows in the point shadow atlas, -1 if it has none, and their range
+    std::vector<glm::vec4> light_data;
+    // Offset into indices and count of every cluster, RG32UI
+    std::vector<GLuint> grid;
+    std::vector<GLuint> indices;
+    // Tiles a light's sphere covers within one slice, its cross section there decides how many
+    struct ClusterSpan {
+        GLuint light;
+        int slice;
+        glm::ivec2 min_tile;
+        glm::ivec2 max_tile;
+    };
+    std::vector<ClusterSpan> spans;
+    // How much of every cluster's list has been filled in while building them
+    std::vector<GLuint> filled;
+
+    GLuint buffers[3];
+    GLuint textures[3];
+    size_t capacities[3];
+
+    // Uploads data to one of the buffers, reallocating it when it has to grow
+    void upload(int index, const void* data, size_t size);
+
+    // Adds a light's three texels to the light data
+    void addLight(const PointLight& light);
+
+    // Uploads the lights, the grid and the lists built by the last update
+    void uploadLists();
+};
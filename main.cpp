@@ -3,26 +3,93 @@
 
 #include "common.h"
 
+#include <fstream>
 #include <iostream>
+#include <memory>
 using namespace std;
 
 #include "input.h"
 #include "camera.h"
 #include "light.h"
+#include "light_clusters.h"
+#include "shadow_map.h"
+#include "point_shadows.h"
+#include "post_process.h"
+#include "depth_prepass.h"
+#include "occlusion.h"
+#include "gpu_culling.h"
+#include "gbuffer.h"
 #include "texture.h"
 #include "model.h"
+#include "entity.h"
+#include "collision.h"
+#include "boids.h"
+#include "boids_gpu.h"
+#include "particles.h"
+#include "profiler.h"
+#include "gl_stats.h"
+#include "instancing.h"
 #include "shader.h"
 #include "skybox.h"
 #include "player.h"
-
-int main(void) {
+#include "settings.h"
+#include "timing.h"
+#include "replay.h"
+#include "benchmark.h"
+#include "asset_cache.h"
+#include "scene.h"
+#include "asset_pack.h"
+#include "startup_timeline.h"
+
+int main(int argc, char** argv) {
+    Settings settings(argc, argv);
     GLFWwindow* window;
 
+#if !GRAPHIX_PROFILE
+    if (!settings.profile_path.empty())
+        cout << "Profiling is not built in, build with GRAPHIX_PROFILE=1 to use --profile\n";
+#endif
+    PROFILE_THREAD("Main");
+
+    // The packer runs in place of the program, from the loose files so an older pack is never packed into a new one
+    if (!settings.built_pack_path.empty())
+        return AssetPack::build(settings.built_pack_path, { "3D", "Skybox", "Shaders" }, !settings.pack_uncompressed) ? 0 : -1;
+
+    // Assets are read from the pack when there is one, by benchmarks too, and from loose files otherwise
+    AssetPack::open(settings.pack_path);
+
+    // Benchmarks run in place of the program
+    if (!settings.bench_name.empty())
+        return runBenchmark(settings) ? 0 : -1;
+
+    // Everything from here until the first frame is timed as startup
+    StartupTimeline::begin();
+
+    // The scene is read before making the window, so a scene that fails to load or is only being compiled never opens one
+    SceneFile scene_file;
+    if (!scene_file.load(settings.scene_path))
+        return -1;
+    if (!settings.compiled_scene_path.empty()) {
+        if (!scene_file.saveCompiled(settings.compiled_scene_path)) {
+            cout << "Could not write the compiled scene " << settings.compiled_scene_path << '\n';
+            return -1;
+        }
+        cout << "Compiled " << settings.scene_path << " to " << settings.compiled_scene_path << '\n';
+        return 0;
+    }
+
     // Initialize the library
+    double init_start = StartupTimeline::now();
     if (!glfwInit())
         return -1;
+    StartupTimeline::record("Initialize GLFW", "", init_start, 0, 0);
+
+    // Headless runs render into a window that is never shown
+    if (settings.headless)
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
 
     // Create a windowed mode window and its OpenGL context
+    init_start = StartupTimeline::now();
     window = glfwCreateWindow(SCREEN_HT, SCREEN_WT, "Final Project 4", NULL, NULL);
     if (!window) {
         glfwTerminate();
@@ -31,7 +98,14 @@ int main(void) {
 
     // Make the window's context current
     glfwMakeContextCurrent(window);
+    StartupTimeline::record("Create window", "", init_start, 0, 0);
+    init_start = StartupTimeline::now();
     gladLoadGL();
+    GLStats::install();
+    StartupTimeline::record("Load GL functions", "", init_start, 0, 0);
+
+    // Render either synchronized to the display or uncapped, the simulation rate is unaffected either way
+    glfwSwapInterval(settings.vsync && !settings.headless ? 1 : 0);
 
     glViewport(0, 0, SCREEN_WT, SCREEN_HT);
 
@@ -39,186 +113,511 @@ int main(void) {
     TexLightingShader texlighting_shader("Shaders/objshader.vert", "Shaders/objshader.frag");
     SkyboxShader skybox_shader("Shaders/skybox.vert", "Shaders/skybox.frag");
     NormalMapShader normalmap_shader("Shaders/normalmapped.vert", "Shaders/normalmapped.frag");
+    InstancedShader instanced_shader("Shaders/instanced.vert", "Shaders/objshader.frag");
+    ParticleShader particle_shader("Shaders/particle.vert", "Shaders/particle.frag");
+    // The G-buffer and its shaders are only made when the scene is lit deferred
+    std::unique_ptr<DeferredRenderer> deferred;
+    if (settings.deferred)
+        deferred.reset(new DeferredRenderer());
+    // Depth only shaders drawing the scene ahead of shading it, made when the pre-pass is on
+    std::unique_ptr<DepthPrepass> depth_prepass;
+    if (settings.depth_prepass)
+        depth_prepass.reset(new DepthPrepass());
+    // Depth buffer on the CPU the largest entities in view are drawn into to hide the ones behind them
+    std::unique_ptr<OcclusionCuller> occlusion;
+    if (settings.occlusion_culling)
+        occlusion.reset(new OcclusionCuller());
+    // The entities are culled and drawn by the GPU when asked, which needs OpenGL 4.3 and draws them in the forward path without a pre-pass
+    std::unique_ptr<GpuCuller> gpu_culler;
+    std::unique_ptr<CulledShader> culled_shader;
+    if (settings.gpu_culling && GLAD_GL_VERSION_4_3 && !deferred && !depth_prepass) {
+        gpu_culler.reset(new GpuCuller());
+        culled_shader.reset(new CulledShader("Shaders/culled.vert", "Shaders/objshader.frag"));
+    }
+    else if (settings.gpu_culling)
+        cout << "Culling on the GPU needs OpenGL 4.3 and the forward renderer without a depth pre-pass, culling on the CPU instead\n";
+    // Every view is drawn into a half float target and finished by full screen passes
+    PostProcessChain post_process;
+    // Casters are drawn into the cascades by a depth only shader, the fish by one that places them like instanced.vert
+    std::unique_ptr<ShadowShader> shadow_shader, instanced_shadow_shader;
+    if (settings.shadows) {
+        shadow_shader.reset(new ShadowShader("Shaders/shadow.vert", "Shaders/shadow.frag"));
+        instanced_shadow_shader.reset(new ShadowShader("Shaders/instanced.vert", "Shaders/shadow.frag"));
+    }
+    // Point lights draw all six faces of their shadows in one pass, a geometry shader sending each triangle to the faces it covers
+    std::unique_ptr<PointShadowShader> point_shadow_shader;
+    if (settings.shadows)
+        point_shadow_shader.reset(new PointShadowShader("Shaders/point_shadow.vert", "Shaders/shadow.frag", "Shaders/point_shadow.geom"));
+
+    /* MESHES, TEXTURES, CREATURES AND LIGHTS OF THE SCENE */
+    AssetCache assets;
+    ThreadPool thread_pool;
+    EntityStore entities;
+    Scene scene;
+    scene.instantiate(scene_file, assets, entities);
+    // The creatures stay where the scene puts them, so the GPU is given them once
+    if (gpu_culler) {
+        entities.updateTransforms(thread_pool);
+        gpu_culler->upload(entities);
+    }
 
-    /* PLAYER MODEL TEXTURE */
-    Texture submarine_tex("3D/player_submarine.png", 0);
-    Texture submarine_decaltex("3D/player_submarine_decal.png", 1);
-    Texture submarine_normtex("3D/player_submarine_normal.png", 2);
-    std::vector<Texture> submarine_textures {submarine_tex, submarine_decaltex, submarine_normtex};
-
-    /* ENEMY MODEL TEXTURES */
-    Texture crab_tex("3D/crab.jpg");
-    std::vector<Texture> crab_textures{ crab_tex };
-
-    Texture lobster_tex("3D/lobster.jpg");
-    std::vector<Texture> lobster_textures{ lobster_tex };
-
-    Texture turtle_tex("3D/turtle.jpg");
-    std::vector<Texture> turtle_textures{ turtle_tex };
-
-    Texture shark_tex("3D/shark.jpg");
-    std::vector<Texture> shark_textures{ shark_tex };
-
-    Texture bomb_tex("3D/bomb.png");
-    std::vector<Texture> bomb_textures{ bomb_tex };
-
-    Texture fish_tex("3D/fish.jpg");
-    std::vector<Texture> fish_textures{ fish_tex };
-
-    /* PLAYER MODEL ATTRIBUTES */
-    VertexAttribs submarine_res("3D/player_submarine.obj");
-
-    /* ENEMY MODEL ATTRIBUTES */
-    VertexAttribs crab_res("3D/crab.obj");
-
-    VertexAttribs lobster_res("3D/lobster.obj");
-
-    VertexAttribs turtle_res("3D/turtle.obj");
-
-    VertexAttribs shark_res("3D/shark.obj");
-
-    VertexAttribs bomb_res("3D/bomb.obj");
-
-    VertexAttribs fish_res("3D/fish.obj");
-    
     /* REPRESENTS AN INSTANCE OF A PLAYER SUBMARINE IN THE SCENE */
-    Model3D submarine {
-        submarine_res,          // Vertex information object
-        submarine_textures,     // 
-        {0.f, -30.f, 0.f},      // Position
-        {0.f, 0.f, 0.f},              // XYZ rotation
-        {0.5f, 0.5f, 0.5f}         // XYZ scale
-    };
-
-    /* REPRESENTS AN INSTANCE OF THE ENEMY SUBMARINES IN THE SCENE */
-    Model3D crab{
-        crab_res,        // Vertex information object
-        crab_textures,
-        {-10.f, -45.f, 0.f},        // Position
-        {90.f, 180.f, 0.f},        // XYZ rotation
-        {0.08f, 0.08f, 0.08f}   // XYZ scale
-    };
-
-    Model3D lobster{
-        lobster_res,        // Vertex information object
-        lobster_textures,
-        {-5.f, -45.f, -12.f},        // Position
-        {90.f, 180.f, 0.f},        // XYZ rotation
-        {0.2f, 0.2f, 0.2f}   // XYZ scale
-    };
-
-    Model3D turtle{
-        turtle_res,        // Vertex information object
-        turtle_textures,
-        {10.f, -14.f, 0.f},        // Position
-        {90.f, 180.f, 0.f},        // XYZ rotation
-        {0.2f, 0.2f, 0.2f}   // XYZ scale
-    };
-
-    Model3D shark{
-        shark_res,        // Vertex information object
-        shark_textures,
-        {15.f, -28.f, 8.f},        // Position
-        {0.f, 0.f, 0.f},        // XYZ rotation
-        {0.05f, 0.05f, 0.05f}   // XYZ scale
-    };
-
-    Model3D bomb{
-        bomb_res,        // Vertex information object
-        bomb_textures,
-        {10.f, -33.f, -15.f},        // Position
-        {0.f, 0.f, 0.f},        // XYZ rotation
-        {0.5f, 0.5f, 0.5f}   // XYZ scale
-    };
-
-    Model3D fish{
-        fish_res,        // Vertex information object
-        fish_textures,
-        {0.f, -9.f, -10.f},        // Position
-        {0.f, 0.f, 0.f},        // XYZ rotation
-        {0.3f, 0.3f, 0.3f}   // XYZ scale
-    };
+    Model3D submarine = scene.makePlayerModel(scene_file, assets);
+    VertexAttribs& submarine_res = submarine.vertex_attribs;
 
     /* REPRESENTS AN INSTANCE OF A PLAYER ENTITY THAT CONTROLS THE GAME */
-    Player player(submarine, 90.f, 4.5f);
+    const ScenePlayerRecord& player_record = scene_file.header->player;
+    Player player(submarine, player_record.rot_offset, player_record.point_offset, glm::make_vec3(player_record.spawn));
+
+    // Lights placed by the scene are binned into the froxels of the camera every frame and added on top of the submarine's light
+    LightClusters light_clusters;
+    // The sun's shadows, fit to the camera every frame
+    std::unique_ptr<CascadedShadowMap> shadow_map;
+    if (settings.shadows)
+        shadow_map.reset(new CascadedShadowMap());
+    // Shadows of the submarine's headlight and any other light that casts them, kept until something near the light moves
+    std::unique_ptr<PointShadowAtlas> point_shadows;
+    std::vector<PointLight*> shadow_lights;
+    if (settings.shadows)
+        point_shadows.reset(new PointShadowAtlas());
+
+    /* COLLIDERS OF THE SUBMARINE AND THE CREATURES */
+    CollisionWorld collision_world;
+    uint32_t player_body = collision_world.addBody(COLLIDER_CAPSULE, submarine_res.bounds, 0);
+
+    // Shapes roughly following each creature's mesh, in the order the creatures were created
+    std::vector<uint32_t> creature_bodies;
+    for (uint32_t i = 0; i < entities.size(); i++) {
+        VertexAttribs& mesh = *entities.meshes[entities.mesh_ids[i]];
+        creature_bodies.push_back(collision_world.addBody(Scene::getCollider(scene_file, i), mesh.bounds, entities.handleOf(i).slot));
+    }
+
+    /* SCHOOLS OF FISH FLOCKING AROUND THE SCENE */
+    double school_start = StartupTimeline::now();
+    FishSchool fish_school(settings.fish_count);
+    StartupTimeline::record("Create fish school", "", school_start, 0, fish_school.size() * 6 * sizeof(float));
+    VertexAttribs& fish_res = assets.getMesh("3D/fish.obj");
+    Texture& fish_tex = assets.getTexture("3D/fish.jpg");
+    InstanceBuffer fish_instances(fish_res, fish_school.size());
+    // Compute shaders need OpenGL 4.3, the school stays on the CPU without it
+    std::unique_ptr<GpuFishSchool> gpu_fish_school;
+    if (settings.gpu_boids && GLAD_GL_VERSION_4_3)
+        gpu_fish_school.reset(new GpuFishSchool(fish_school));
+    else if (settings.gpu_boids)
+        cout << "Simulating the fish on the GPU needs OpenGL 4.3, simulating them on the CPU instead\n";
+    // Centers the fish model, scales it like the lone fish, and turns its nose from -X to +Z
+    glm::mat4 fish_transform =
+        glm::rotate(glm::mat4(1.f), glm::radians(90.f), glm::vec3(0.f, 1.f, 0.f)) *
+        glm::scale(glm::mat4(1.f), glm::vec3(0.3f)) *
+        glm::translate(glm::mat4(1.f), -fish_res.bounds.getCenter());
+
+    /* BUBBLES FROM THE PROPELLER AND MARINE SNOW DRIFTING AROUND THE PLAYER */
+    // Particles are moved by compute shaders, which need OpenGL 4.3, the scene goes without them otherwise
+    std::unique_ptr<ParticleSystem> bubbles, marine_snow;
+    // Bubbles let out per unit the propeller pushes the submarine
+    const float bubbles_per_unit = 12.f;
+    if (GLAD_GL_VERSION_4_3) {
+        ParticleSettings bubble_settings;
+        bubble_settings.acceleration = glm::vec3(0.f, 3.f, 0.f);
+        bubble_settings.drag = 1.5f;
+        bubble_settings.wobble = 0.4f;
+        bubble_settings.min_life = 2.f, bubble_settings.max_life = 4.f;
+        bubble_settings.min_size = 0.05f, bubble_settings.max_size = 0.2f;
+        bubble_settings.color = glm::vec4(0.8f, 0.9f, 1.f, 0.5f);
+        bubbles.reset(new ParticleSystem(16384, bubble_settings));
+
+        // Snow sinks slowly and lives forever, wrapping around the player instead of being let out
+        ParticleSettings snow_settings;
+        snow_settings.acceleration = glm::vec3(0.f, -0.2f, 0.f);
+        snow_settings.drag = 0.5f;
+        snow_settings.wobble = 0.1f;
+        snow_settings.surface_y = 1e30f;
+        snow_settings.wrap_size = glm::vec3(40.f);
+        snow_settings.min_life = snow_settings.max_life = 1e30f;
+        snow_settings.min_size = 0.04f, snow_settings.max_size = 0.1f;
+        snow_settings.color = glm::vec4(0.9f, 0.95f, 1.f, 0.35f);
+        marine_snow.reset(new ParticleSystem(20000, snow_settings, 4321));
+        marine_snow->emitBurst(marine_snow->getCapacity(), player.pos, snow_settings.wrap_size * 0.5f, glm::vec3(0.f), 0.1f);
+    }
+    else
+        cout << "Particles need OpenGL 4.3, the scene is drawn without them\n";
 
     /* DIRECTION LIGHT FROM THE TOP OF THE OCEAN */
-    DirectionLight dlight(
-        glm::vec3(0.f, 10.f, 0.f),     // Light source position
-        glm::vec3(1.0f, 1.0f, 1.0f),    // Diffuse color
-        0.4f,                           // Ambient strength
-        glm::vec3(1.0f, 1.0f, 1.0f),    // Ambient color
-        0.7f,                           // Specular strength
-        40.f,                            // Specular phong
-        0.25f                             // Intensity
-    );
+    DirectionLight dlight = Scene::makeDirectionLight(scene_file);
 
     /* FACES OF THE SKYBOX */
-    const std::string face_skybox[] {
-        "Skybox/uw_rt.jpg", // RIGHT
-        "Skybox/uw_lf.jpg", // LEFT
-        "Skybox/uw_up.jpg", // UP
-        "Skybox/uw_dn.jpg", // DOWN
-        "Skybox/uw_ft.jpg", // FRONT
-        "Skybox/uw_bk.jpg" // BACK
-    };
+    std::string face_skybox[6];
+    for (int i = 0; i < 6; i++)
+        face_skybox[i] = scene_file.getString(scene_file.header->skybox_faces[i]);
 
     Skybox skybox(face_skybox);
 
-    // Pass state object to input control functions
-    glfwSetWindowUserPointer(window, &player);
+    // The sky lights the scene from every side in place of the direction light's flat ambient color, which is only used without it
+    if (!skybox.has_lighting)
+        skybox.lighting.setFlat(dlight.ambient_color);
+    texlighting_shader.setSkyLighting(skybox.lighting);
+    if (culled_shader)
+        culled_shader->setSkyLighting(skybox.lighting);
+    instanced_shader.setSkyLighting(skybox.lighting);
+    normalmap_shader.setSkyLighting(skybox.lighting);
+    if (deferred)
+        deferred->lighting_shader.setSkyLighting(skybox.lighting);
+
+    // Input callbacks only queue events, the simulation drains and applies them at a fixed rate
+    InputQueue input_queue;
+    InputState input_state;
+    std::vector<InputEvent> input_events(1024);
+    glfwSetWindowUserPointer(window, &input_queue);
 
     // Set input controls to appropriate callback functions
     glfwSetKeyCallback(window, keyboardControl);
     glfwSetCursorPosCallback(window, mouseControl);
     glfwSetMouseButtonCallback(window, mouseButtonControl);
 
-    /* ENABLES OPENGL BLENDING FUNCTION */
-    glEnable(GL_BLEND);
+    /* OPENGL BLENDING FUNCTION, ONLY ENABLED BY THE PASSES THAT BLEND */
+    // Surfaces are drawn in any order, so blending them would add a nearer one to whatever was drawn behind it first
+    glDisable(GL_BLEND);
 	glBlendEquation(GL_FUNC_ADD);
-	glBlendColor(0.f, 1.f, 0.f, 1.f);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    // Either record the input of this session or replay a previous recording in place of the user
+    InputRecorder recorder;
+    InputPlayer replay;
+    bool replaying = !settings.replay_path.empty();
+    if (replaying && !replay.open(settings.replay_path)) {
+        cout << "Could not load the replay " << settings.replay_path << '\n';
+        glfwTerminate();
+        return -1;
+    }
+    if (!replaying && !settings.record_path.empty() && !recorder.open(settings.record_path, SIM_STEP))
+        cout << "Could not create the recording " << settings.record_path << '\n';
+
+    FrameTimingLog timing_log;
+    if (!settings.timing_path.empty() && !timing_log.open(settings.timing_path))
+        cout << "Could not create the timing log " << settings.timing_path << '\n';
+
+    // Per frame lists of the entities to draw, kept across frames to reuse their memory
+    std::vector<uint32_t> visible_entities;
+    std::vector<DrawPacket> draw_packets;
+
+    FixedTimestep timestep;
+    FrameStats frame_stats;
+    double start_time = glfwGetTime();
+    double frame_start = start_time;
+    double last_recorded_time = 0.0;
+    double last_frame_time = 0.0;
+    uint32_t last_steps = 0;
+    timestep.reset(frame_start);
+    frame_stats.window_start = frame_start;
+
+    // Startup ends here, report where its time went
+    StartupTimeline::finish();
+    if (settings.print_stats || settings.startup_only)
+        StartupTimeline::writeSummary(cout);
+    if (!settings.startup_report_path.empty()) {
+        std::ofstream startup_report(settings.startup_report_path, std::ios::trunc);
+        StartupTimeline::writeJson(startup_report);
+        if (!startup_report)
+            cout << "Could not write the startup report " << settings.startup_report_path << '\n';
+    }
+    if (settings.startup_only) {
+        glfwTerminate();
+        return 0;
+    }
 
-    glm::vec4 color_green(0.f, 1.f, 0.f, 1.f);
+#if GRAPHIX_PROFILE
+    bool trace_key_held = false;
+#endif
+    bool gl_stats_key_held = false;
+    // Creature the submarine last ran into, shown with the statistics instead of printed as it happens
+    std::string last_contact;
 
     // Loop until the user closes the window
     while (!glfwWindowShouldClose(window)) {
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        PROFILE_SCOPE("Frame");
+        ReplayFrame frame;
+        double step = timestep.step;
+        if (replaying) {
+            // Run the same steps with the same events as the recorded frame, ignoring any live input
+            if (!replay.nextFrame(frame))
+                break;
+            // A recorded frame's duration is only known once the start of the next one has been read
+            if (frame.time > 0.0)
+                timing_log.write(frame.time - last_recorded_time, last_frame_time, last_steps);
+            last_recorded_time = frame.time;
+            step = replay.header.step;
+            drainInput(input_queue, input_events.data(), input_events.size());
+        }
+        else {
+            // Advance the simulation by as many fixed steps as fit in the time elapsed since the last frame
+            frame.time = frame_start - start_time;
+            frame.steps = timestep.beginFrame(glfwGetTime());
+            frame.alpha = timestep.getAlpha();
+            recorder.recordFrame(frame);
+        }
 
-        // Update lighting and objects based on program state
-        if (player.is_ortho || player.is_third_ppov) {
-			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-            skybox_shader.render(skybox, player.getActiveCam());
-            normalmap_shader.render(player.sub_model, player.getActiveCam(), player.front_light, dlight);
+        for (uint32_t i = 0; i < frame.steps; i++) {
+            PROFILE_SCOPE("Simulation step");
+            player.saveState();
+            const InputEvent* events = input_events.data();
+            size_t event_count;
+            if (replaying)
+                event_count = replay.nextStep(events);
+            else {
+                event_count = drainInput(input_queue, input_events.data(), input_events.size());
+                recorder.recordStep(events, event_count);
+            }
+            applyInput(input_state, &player, events, event_count);
+            updatePlayer(input_state, &player, (float) step);
+
+            // Collide the submarine with the creatures, stopping it at whatever it runs into
+            entities.updateTransforms(thread_pool);
+            for (uint32_t entity = 0; entity < entities.size(); entity++)
+                collision_world.setTransform(creature_bodies[entity], entities.world_matrices[entity]);
+            collision_world.setTransform(player_body, player.getTransform());
+            collision_world.findContacts(thread_pool);
+            player.resolveCollisions(collision_world, player_body);
+
+            for (const Contact& contact : collision_world.contacts) {
+                if (contact.began && contact.a == player_body) {
+                    uint32_t creature = entities.indexOfSlot(collision_world.user_data[contact.b]);
+                    last_contact = scene_file.getString(scene_file.entities[creature].name);
+                }
+            }
+
+            if (gpu_fish_school)
+                gpu_fish_school->step((float) step, player.pos);
+            else
+                fish_school.step((float) step, player.pos, thread_pool);
+
+            // The propeller leaves a trail of bubbles for as long as it pushes the submarine along
+            if (bubbles) {
+                const Collider& hull = collision_world.colliders[player_body];
+                size_t bubble_count = player.takeWake(bubbles_per_unit);
+                bubbles->emitBurst(bubble_count, player.getPropellerPos(hull), glm::vec3(hull.radius * 0.5f), glm::vec3(0.f), 1.f);
+                bubbles->update((float) step, player.pos);
+                marine_snow->update((float) step, player.pos);
+            }
+        }
+        updateCursor(window, input_state, &player);
+
+        // Blend the last two simulation states so rendering stays smooth at any frame rate
+        player.interpolate(frame.alpha);
+        Camera& camera = player.getRenderCam();
+        PointLight& front_light = player.render_light;
+
+        // Refresh the transforms of moved entities and gather the ones the camera can see, unless the GPU culls them as it draws them
+        entities.updateTransforms(thread_pool);
+        if (!gpu_culler) {
+            entities.cull(camera.getFrustum(), visible_entities);
+            if (occlusion) {
+                // The submarine hides what is behind it in the views that show it
+                occlusion->begin(camera);
+                if (player.is_ortho || player.is_third_ppov)
+                    occlusion->addOccluder(player.sub_model.vertex_attribs.occluder, player.sub_model.getTransformationMatrix());
+                occlusion->cull(entities, visible_entities, thread_pool);
+            }
+            entities.buildDrawPackets(visible_entities, draw_packets);
+        }
 
-            /* RENDERING MODELS WITH THEIR APPROPRIATE SHADERS */
-            texlighting_shader.render(crab, player.getActiveCam(), player.front_light, dlight);
-            texlighting_shader.render(lobster, player.getActiveCam(), player.front_light, dlight);
-            texlighting_shader.render(turtle, player.getActiveCam(), player.front_light, dlight);
-            texlighting_shader.render(shark, player.getActiveCam(), player.front_light, dlight);
-            texlighting_shader.render(bomb, player.getActiveCam(), player.front_light, dlight);
-            texlighting_shader.render(fish, player.getActiveCam(), player.front_light, dlight);
+        // Lights get their shadow slots before they are binned, since the clusters carry the slots to the shaders
+        if (point_shadows) {
+            shadow_lights.clear();
+            shadow_lights.push_back(&front_light);
+            for (PointLight& light : scene.point_lights)
+                shadow_lights.push_back(&light);
+            point_shadows->update(shadow_lights, camera.camera_pos, entities, *point_shadow_shader);
+            point_shadows->bind();
+        }
+
+        // Every lit shader reads the same froxel grid
+        light_clusters.update(scene.point_lights, camera);
+        light_clusters.bind();
+        texlighting_shader.setLightClusters(light_clusters);
+        if (culled_shader)
+            culled_shader->setLightClusters(light_clusters);
+        instanced_shader.setLightClusters(light_clusters);
+        normalmap_shader.setLightClusters(light_clusters);
+        if (deferred)
+            deferred->lighting_shader.setLightClusters(light_clusters);
+
+        // Fish simulated on the GPU are drawn straight from the buffer of the last step, otherwise they are copied over
+        if (gpu_fish_school) {
+            fish_instances.setSource(gpu_fish_school->getCurrentBuffer(), (int) gpu_fish_school->size(), sizeof(GpuFish),
+                offsetof(GpuFish, pos), offsetof(GpuFish, vel));
         }
         else {
-            glBlendFunc(GL_CONSTANT_COLOR, GL_CONSTANT_COLOR);
-			skybox_shader.render(skybox, player.getActiveCam());
-            glBlendFunc(GL_CONSTANT_COLOR, GL_ONE_MINUS_SRC_ALPHA);
+            InstanceData* fish_data = fish_instances.map(fish_school.size());
+            if (fish_data) {
+                fish_school.writeInstances(fish_data, thread_pool);
+                fish_instances.unmap();
+            }
+        }
+        // Fish are drawn where they were between the last two steps
+        float fish_rewind = (1.f - frame.alpha) * (float) step;
+
+        // Draw the creatures, the submarine and the fish into the cascades that cover the view, seen from the sun
+        if (shadow_map) {
+            shadow_map->update(dlight, camera);
+            shadow_map->render(entities, *shadow_shader, [&](glm::mat4& view, glm::mat4& projection) -> uint32_t {
+                shadow_shader->render(player.sub_model, view, projection);
+                instanced_shadow_shader->render(fish_instances, fish_transform, fish_rewind, view, projection);
+                return 2;
+            });
+            shadow_map->bind();
+            texlighting_shader.setShadowMap(*shadow_map);
+            if (culled_shader)
+                culled_shader->setShadowMap(*shadow_map);
+            instanced_shader.setShadowMap(*shadow_map);
+            normalmap_shader.setShadowMap(*shadow_map);
+            if (deferred)
+                deferred->lighting_shader.setShadowMap(*shadow_map);
+        }
+
+        // The scene is drawn once with the same shaders in every view, the first person view's night vision is a pass over it
+        bool first_person = !player.is_ortho && !player.is_third_ppov;
+        post_process.night_vision = first_person;
+        post_process.beginScene();
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        // Lays down the nearest depth of every pixel, so the passes drawing the surfaces only shade each pixel once
+        auto draw_depth = [&]() {
+            glm::mat4 view = camera.getViewMatrix();
+            glm::mat4 projection = camera.getProjectionMatrix();
+            depth_prepass->beginDepth();
+            if (!first_person)
+                depth_prepass->shader.render(player.sub_model, view, projection);
+            depth_prepass->shader.render(entities, draw_packets, view, projection);
+            depth_prepass->instanced_shader.render(fish_instances, fish_transform, fish_rewind, view, projection);
+            depth_prepass->beginShading();
+        };
+
+        // Update lighting and objects based on program state, the submarine is only seen from outside
+        if (deferred) {
+            // Draw the surfaces into the G-buffer, then light each covered pixel once
+            deferred->gbuffer.beginGeometry();
+            if (depth_prepass)
+                draw_depth();
+            if (!first_person)
+                deferred->normalmap_geometry_shader.render(player.sub_model, camera, front_light, dlight);
+            deferred->geometry_shader.render(entities, draw_packets, camera, front_light, dlight);
+            deferred->instanced_geometry_shader.render(fish_instances, fish_tex, fish_transform, fish_rewind, camera, front_light, dlight);
+            if (depth_prepass)
+                depth_prepass->endShading();
+            deferred->gbuffer.endGeometry();
+            deferred->lighting_shader.render(deferred->gbuffer, camera, front_light, dlight);
+
+            // The lighting pass wrote the surfaces' depth, so the skybox only fills the pixels left empty
+            skybox_shader.render(skybox, camera);
+        }
+        else if (depth_prepass) {
+            draw_depth();
+            if (!first_person)
+                normalmap_shader.render(player.sub_model, camera, front_light, dlight);
+            texlighting_shader.render(entities, draw_packets, camera, front_light, dlight);
+            instanced_shader.render(fish_instances, fish_tex, fish_transform, fish_rewind, camera, front_light, dlight);
+            depth_prepass->endShading();
+
+            // The skybox goes behind the depth already drawn
+            skybox_shader.render(skybox, camera);
+        }
+        else {
+            if (!first_person)
+                normalmap_shader.render(player.sub_model, camera, front_light, dlight);
 
             /* RENDERING MODELS WITH THEIR APPROPRIATE SHADERS */
-            texlighting_shader.render(crab, player.getActiveCam(), player.front_light, dlight, color_green);
-            texlighting_shader.render(lobster, player.getActiveCam(), player.front_light, dlight, color_green);
-            texlighting_shader.render(turtle, player.getActiveCam(), player.front_light, dlight, color_green);
-            texlighting_shader.render(shark, player.getActiveCam(), player.front_light, dlight, color_green);
-            texlighting_shader.render(bomb, player.getActiveCam(), player.front_light, dlight, color_green);
-            texlighting_shader.render(fish, player.getActiveCam(), player.front_light, dlight, color_green);
+            if (gpu_culler) {
+                // The entities in front of the last frame's depth first, then the ones the depth drawn so far shows have come into view
+                gpu_culler->cull(0, camera);
+                culled_shader->render(entities, *gpu_culler, 0, camera, front_light, dlight);
+                gpu_culler->buildPyramid(post_process.getDepthTexture(), SCREEN_WT, SCREEN_HT);
+                gpu_culler->cull(1, camera);
+                culled_shader->render(entities, *gpu_culler, 1, camera, front_light, dlight);
+            }
+            else
+                texlighting_shader.render(entities, draw_packets, camera, front_light, dlight);
+            instanced_shader.render(fish_instances, fish_tex, fish_transform, fish_rewind, camera, front_light, dlight);
+
+            // The sky goes last, so it only shades the pixels nothing was drawn to
+            skybox_shader.render(skybox, camera);
         }
+
+        // Particles go last so they are added on top of everything behind them
+        if (bubbles) {
+            particle_shader.render(*marine_snow, camera);
+            particle_shader.render(*bubbles, camera);
+        }
+
+        // Fog, tonemap, night vision and vignette on the way to the screen
+        post_process.apply(camera, (float) frame.time);
         
         // Swap front and back buffers
-        glfwSwapBuffers(window);
+        {
+            PROFILE_SCOPE("Swap buffers");
+            glfwSwapBuffers(window);
+        }
 
         // Poll for and process events
-        glfwPollEvents();
+        {
+            PROFILE_SCOPE("Poll events");
+            glfwPollEvents();
+        }
+        PROFILE_FRAME();
+        GLStats::endFrame();
+
+#if GRAPHIX_PROFILE
+        // F12 writes out the trace recorded so far
+        bool trace_key = glfwGetKey(window, GLFW_KEY_F12) == GLFW_PRESS;
+        if (trace_key && !trace_key_held) {
+            std::string trace_path = settings.profile_path.empty() ? "trace.json" : settings.profile_path;
+            if (Profiler::writeTrace(trace_path))
+                cout << "Wrote the profile to " << trace_path << '\n';
+        }
+        trace_key_held = trace_key;
+#endif
+
+        // F11 prints the GL calls of the last frame and every live GL object
+        bool gl_stats_key = GLStats::isEnabled() && glfwGetKey(window, GLFW_KEY_F11) == GLFW_PRESS;
+        if (gl_stats_key && !gl_stats_key_held)
+            GLStats::dump(cout);
+        gl_stats_key_held = gl_stats_key;
+
+        // Record how long the frame took and periodically report the statistics
+        double frame_end = glfwGetTime();
+        frame_stats.addFrame(frame_end - frame_start, frame.steps);
+        if (!replaying)
+            timing_log.write(frame_end - frame_start, frame_end - frame_start, frame.steps);
+        last_frame_time = frame_end - frame_start;
+        last_steps = frame.steps;
+        frame_start = frame_end;
+        if (frame_stats.isReady(frame_end)) {
+            std::string report = frame_stats.report(frame_end) + " | Submarine Depth: " + std::to_string(player.pos.y);
+            if (!last_contact.empty())
+                report += " | Ran into: " + last_contact;
+            if (shadow_map)
+                report += " | " + shadow_map->report();
+            if (point_shadows)
+                report += " | Point shadows: " + std::to_string(point_shadows->getDrawnCount()) + " drawn, " + std::to_string(point_shadows->getCachedCount()) + " cached";
+            if (occlusion)
+                report += " | Occluded: " + std::to_string(occlusion->getCulledCount());
+            if (gpu_culler) {
+                const GpuCullCounters& counters = gpu_culler->getCounters();
+                report += " | GPU culled: " + std::to_string(counters.frustum_culled) + " outside, " +
+                    std::to_string(counters.first_occluded - counters.second_drawn) + " occluded, " + std::to_string(counters.second_drawn) + " disoccluded";
+            }
+            if (GLStats::isEnabled())
+                report += " | GL calls: " + std::to_string(GLStats::getCalls()) + " | Uploaded: " + std::to_string(GLStats::getUploadedBytes() / 1024) + " KB";
+            glfwSetWindowTitle(window, ("Final Project 4 | " + report).c_str());
+            if (settings.print_stats)
+                cout << report << '\n';
+        }
     }
 
+    recorder.close();
+#if GRAPHIX_PROFILE
+    if (!settings.profile_path.empty() && !Profiler::writeTrace(settings.profile_path))
+        cout << "Could not write the profile " << settings.profile_path << '\n';
+#endif
     glfwTerminate();
     return 0;
 }
\ No newline at end of file
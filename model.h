@@ -2,14 +2,26 @@
 
 #include "common.h"
 #include "texture.h"
+#include "bounds.h"
+#include "occluder_mesh.h"
+#include "startup_timeline.h"
+#include "asset_pack.h"
+#include <istream>
 #include <vector>
 
 // Object wrapper for VAO, VBO, and other vertex data information for a 3D model
 typedef struct VertexAttribs {
     GLuint VAO;
     GLuint VBO;
+    // The positions alone, packed tightly for passes that only write depth
+    GLuint position_VAO;
+    GLuint position_VBO;
     std::vector<GLfloat> full_vertex_data;
     int count;
+    // Bounds of the vertex positions in model space
+    AABB bounds;
+    // Coarse copy of the mesh the occlusion culler draws on the CPU
+    OccluderMesh occluder;
 
     // Load vertex attributes from obj file path
     VertexAttribs(const char* model_path) {
@@ -19,9 +31,27 @@ typedef struct VertexAttribs {
         std::string warning, error;
         tinyobj::attrib_t attributes;
 
-        bool success = tinyobj::LoadObj(&attributes, &shapes, &materials, &warning, &error, model_path);
+        // The OBJ is parsed straight out of the asset pack when it has it
+        double load_start = StartupTimeline::now();
+        AssetBlob blob;
+        bool success = AssetPack::load(model_path, blob);
+        if (success) {
+            AssetStreamBuf blob_buf(blob);
+            std::istream blob_stream(&blob_buf);
+            tinyobj::MaterialFileReader material_reader("");
+            success = tinyobj::LoadObj(&attributes, &shapes, &materials, &warning, &error, &blob_stream, &material_reader);
+        } else {
+            error = std::string("Cannot open file [") + model_path + "]\n";
+        }
+        size_t index_count = 0;
+        for (auto& shape : shapes)
+            index_count += shape.mesh.indices.size();
+        uint64_t attribute_bytes = sizeof(tinyobj::real_t) * (attributes.vertices.size() + attributes.normals.size() + attributes.texcoords.size());
+        uint64_t index_bytes = sizeof(tinyobj::index_t) * index_count;
+        StartupTimeline::record("Load OBJ", model_path, load_start, blob.bytes_read, attribute_bytes + index_bytes);
 
         // Calculate global normals
+        double tangent_start = StartupTimeline::now();
         std::vector<glm::vec3> tangents;
         std::vector<glm::vec3> bitangents;
 
@@ -88,6 +118,10 @@ typedef struct VertexAttribs {
             }
         }
 
+        StartupTimeline::record("Generate tangents", model_path, tangent_start, attribute_bytes + index_bytes,
+            sizeof(glm::vec3) * (tangents.size() + bitangents.size()));
+
+        double build_start = StartupTimeline::now();
         auto tan_it = std::begin(tangents);
 		auto bitan_it = std::begin(bitangents);
 
@@ -105,6 +139,12 @@ typedef struct VertexAttribs {
                 // UV
                 int uvIndex = vData.texcoord_index * 2; // multiplied by 2 cause of u and v
 
+                bounds.expand(glm::vec3(
+                    attributes.vertices[vertexIndex],
+                    attributes.vertices[vertexIndex + 1],
+                    attributes.vertices[vertexIndex + 2]
+                ));
+
                 // XYZ
                 full_vertex_data.push_back(attributes.vertices[vertexIndex]);
                 full_vertex_data.push_back(attributes.vertices[vertexIndex + 1]);
@@ -134,7 +174,21 @@ typedef struct VertexAttribs {
             }
         }
 
+        // Models that failed to load still get a valid point sized box
+        if (bounds.isEmpty())
+            bounds = AABB(glm::vec3(0.f), glm::vec3(0.f));
+        uint64_t vertex_bytes = sizeof(GLfloat) * full_vertex_data.size();
+        StartupTimeline::record("Build vertex data", model_path, build_start,
+            attribute_bytes + index_bytes + sizeof(glm::vec3) * (tangents.size() + bitangents.size()), vertex_bytes);
+
+        double occluder_start = StartupTimeline::now();
+        occluder = OccluderMesh(full_vertex_data.data(), full_vertex_data.size() / 14, 14, bounds);
+        StartupTimeline::record("Simplify occluder", model_path, occluder_start, vertex_bytes,
+            sizeof(glm::vec3) * occluder.vertices.size() + sizeof(uint32_t) * occluder.indices.size());
+
         // Initialize VAO and VBO
+        StartupScope upload_step("Upload vertex buffer", model_path);
+        upload_step.bytes_read = upload_step.bytes_produced = vertex_bytes;
         glGenVertexArrays(1, &VAO);
         glGenBuffers(1, &VBO);
 
@@ -222,6 +276,20 @@ typedef struct VertexAttribs {
         glEnableVertexAttribArray(3);
         glEnableVertexAttribArray(4);
 
+        // Depth only passes fetch a quarter of the bytes per vertex from a stream of just the positions
+        std::vector<GLfloat> positions;
+        positions.reserve(count * 3);
+        for (int i = 0; i < count; i++)
+            positions.insert(positions.end(), &full_vertex_data[i * vector_size], &full_vertex_data[i * vector_size + 3]);
+        upload_step.bytes_produced += sizeof(GLfloat) * positions.size();
+        glGenVertexArrays(1, &position_VAO);
+        glGenBuffers(1, &position_VBO);
+        glBindVertexArray(position_VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, position_VBO);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * positions.size(), positions.data(), GL_STATIC_DRAW);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), (void*) 0);
+        glEnableVertexAttribArray(0);
+
         glBindBuffer(GL_ARRAY_BUFFER, 0);
         glBindVertexArray(0);
     }
@@ -230,6 +298,8 @@ typedef struct VertexAttribs {
     ~VertexAttribs() {
         glDeleteVertexArrays(1, &VAO);
         glDeleteBuffers(1, &VBO);
+        glDeleteVertexArrays(1, &position_VAO);
+        glDeleteBuffers(1, &position_VBO);
     }
 } VertexAttribs;
 
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "bounds.h"
+
+// Cells along the longest side of a mesh's bounds its vertices are merged into when it is simplified into an occluder
+#define OCCLUDER_GRID 16
+// Most triangles an occluder keeps, the grid is made coarser until it fits
+#define OCCLUDER_MAX_TRIANGLES 384
+
+// Coarse stand in for a mesh, drawn into the occlusion culler's depth buffer on the CPU instead of the mesh itself
+// Made by merging the vertices that fall in the same cell of a grid over the mesh and dropping the triangles that collapse
+struct OccluderMesh {
+    std::vector<glm::vec3> vertices;
+    std::vector<uint32_t> indices;
+
+    OccluderMesh() {}
+
+    // Simplifies a list of triangles, whose vertices start with their position and are stride floats apart
+    OccluderMesh(const float* vertex_data, size_t vertex_count, size_t stride, const AABB& bounds);
+
+    inline size_t getTriangleCount() const {
+        return indices.size() / 3;
+    }
+};
@@ -0,0 +1,383 @@
+#include "occlusion.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "profiler.h"
+#include "timing.h"
+
+// Spans of a row are filled 8 pixels at a time with AVX, 4 with SSE2, which every x64 processor has, and 1 otherwise
+#if defined(__AVX2__) || defined(__AVX__)
+#define OCCLUSION_AVX 1
+#define OCCLUSION_LANES 8
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OCCLUSION_SSE2 1
+#define OCCLUSION_LANES 4
+#include <emmintrin.h>
+#else
+#define OCCLUSION_LANES 1
+#endif
+
+// Vertices closer to the camera plane than this are treated as crossing the near plane
+#define OCCLUSION_MIN_W 1e-4f
+
+// Simplifies a list of triangles, whose vertices start with their position and are stride floats apart
+OccluderMesh::OccluderMesh(const float* vertex_data, size_t vertex_count, size_t stride, const AABB& bounds) {
+    glm::vec3 size = bounds.max - bounds.min;
+    float longest = std::max(std::max(size.x, size.y), size.z);
+    if (longest <= 0.f || vertex_count < 3)
+        return;
+    glm::vec3 center = bounds.getCenter();
+
+    std::unordered_map<uint64_t, uint32_t> cell_clusters;
+    std::unordered_set<uint64_t> kept_triangles;
+    std::vector<uint32_t> clusters(vertex_count);
+    std::vector<float> center_distances;
+    for (int grid = OCCLUDER_GRID; grid >= 1; grid /= 2) {
+        float cell = longest / grid;
+        cell_clusters.clear();
+        kept_triangles.clear();
+        vertices.clear();
+        indices.clear();
+        center_distances.clear();
+
+        // Each cell keeps the vertex of it nearest the middle of the mesh, so the occluder is made of points on the surface
+        // and tends to sit inside the mesh rather than stick out of it
+        for (size_t i = 0; i < vertex_count; i++) {
+            glm::vec3 pos(vertex_data[i * stride], vertex_data[i * stride + 1], vertex_data[i * stride + 2]);
+            glm::ivec3 cell_index = glm::clamp(glm::ivec3(glm::floor((pos - bounds.min) / cell)), glm::ivec3(0), glm::ivec3(grid));
+            uint64_t key = ((uint64_t) cell_index.z * (grid + 1) + cell_index.y) * (grid + 1) + cell_index.x;
+            float center_distance = glm::dot(pos - center, pos - center);
+            auto found = cell_clusters.find(key);
+            if (found == cell_clusters.end()) {
+                clusters[i] = (uint32_t) vertices.size();
+                cell_clusters.emplace(key, clusters[i]);
+                vertices.push_back(pos);
+                center_distances.push_back(center_distance);
+            }
+            else {
+                clusters[i] = found->second;
+                if (center_distance < center_distances[found->second]) {
+                    vertices[found->second] = pos;
+                    center_distances[found->second] = center_distance;
+                }
+            }
+        }
+
+        // Triangles whose corners merged are gone, and ones left over the same three cells are kept once
+        for (size_t i = 0; i + 2 < vertex_count; i += 3) {
+            uint32_t a = clusters[i], b = clusters[i + 1], c = clusters[i + 2];
+            if (a == b || b == c || a == c)
+                continue;
+            uint32_t sorted[3] = {a, b, c};
+            std::sort(sorted, sorted + 3);
+            uint64_t key = ((uint64_t) sorted[0] << 42) | ((uint64_t) sorted[1] << 21) | sorted[2];
+            if (!kept_triangles.insert(key).second)
+                continue;
+            indices.push_back(a);
+            indices.push_back(b);
+            indices.push_back(c);
+        }
+        if (indices.size() / 3 <= OCCLUDER_MAX_TRIANGLES)
+            break;
+    }
+
+    // Drop the vertices no triangle is left using
+    std::vector<uint32_t> remap(vertices.size(), UINT32_MAX);
+    std::vector<glm::vec3> used;
+    for (uint32_t& index : indices) {
+        if (remap[index] == UINT32_MAX) {
+            remap[index] = (uint32_t) used.size();
+            used.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+    vertices.swap(used);
+}
+
+OcclusionCuller::OcclusionCuller():
+    min_occluder_size(0.1f), max_occluders(32), view_projection(1.f), triangle_count(0), culled_count(0), raster_ms(0.0), test_ms(0.0) {
+    size_t total = 0;
+    for (int level = 0; level < OCCLUSION_LEVELS; level++) {
+        level_offsets[level] = total;
+        total += (size_t) (OCCLUSION_WIDTH >> level) * (OCCLUSION_HEIGHT >> level);
+    }
+    depth.assign(total, 1.f);
+}
+
+// Starts a frame seen by a camera, forgetting the occluders of the last frame
+void OcclusionCuller::begin(Camera& camera) {
+    view_projection = camera.getProjectionMatrix() * camera.getViewMatrix();
+    occluders.clear();
+}
+
+// Adds an occluder placed by a world matrix, such as one that is not an entity, it must outlive the next cull
+void OcclusionCuller::addOccluder(const OccluderMesh& mesh, const glm::mat4& world) {
+    if (!mesh.indices.empty())
+        occluders.push_back({&mesh, world});
+}
+
+// Adds the largest of the visible entities as occluders, draws every occluder, then removes the entities they hide from visible,
+// clearing their visible flag
+void OcclusionCuller::cull(EntityStore& entities, std::vector<uint32_t>& visible, ThreadPool& pool) {
+    PROFILE_SCOPE("Occlusion culling");
+
+    // An entity's size on screen is about its bounding radius over its depth, scaled by the projection,
+    // which the second row of the view projection carries for perspective and orthographic cameras alike
+    float projection_scale = glm::length(glm::vec3(view_projection[0][1], view_projection[1][1], view_projection[2][1]));
+    candidates.clear();
+    for (uint32_t entity : visible) {
+        if (entities.meshes[entities.mesh_ids[entity]]->occluder.indices.empty())
+            continue;
+        const AABB& bounds = entities.bounds[entity];
+        glm::vec4 clip = view_projection * glm::vec4(bounds.getCenter(), 1.f);
+        if (clip.w <= OCCLUSION_MIN_W)
+            continue;
+        float size = glm::length(bounds.getExtents()) * projection_scale / clip.w;
+        if (size >= min_occluder_size)
+            candidates.push_back(std::make_pair(size, entity));
+    }
+    if (candidates.size() > (size_t) max_occluders) {
+        std::nth_element(candidates.begin(), candidates.begin() + max_occluders, candidates.end(),
+            [](const std::pair<float, uint32_t>& a, const std::pair<float, uint32_t>& b) { return a.first > b.first; });
+        candidates.resize(max_occluders);
+    }
+    for (const auto& candidate : candidates)
+        addOccluder(entities.meshes[entities.mesh_ids[candidate.second]]->occluder, entities.world_matrices[candidate.second]);
+
+    rasterize(pool);
+
+    Stopwatch test_time;
+    culled_count = 0;
+    if (triangle_count > 0) {
+        hidden.assign(visible.size(), 0);
+        pool.parallelFor(visible.size(), 256, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++)
+                hidden[i] = !isVisible(entities.bounds[visible[i]]);
+        });
+
+        size_t kept = 0;
+        for (size_t i = 0; i < visible.size(); i++) {
+            if (hidden[i])
+                entities.flags[visible[i]] &= ~ENTITY_VISIBLE;
+            else
+                visible[kept++] = visible[i];
+        }
+        culled_count = (uint32_t) (visible.size() - kept);
+        visible.resize(kept);
+    }
+    test_ms = test_time.getMilliseconds();
+}
+
+// Draws the occluders added since begin and builds the depth pyramid, cull does this itself
+void OcclusionCuller::rasterize(ThreadPool& pool) {
+    Stopwatch raster_time;
+    if (triangles.size() < occluders.size())
+        triangles.resize(occluders.size());
+    pool.parallelFor(occluders.size(), 1, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+            setupTriangles(occluders[i], triangles[i]);
+    });
+    triangle_count = 0;
+    for (size_t i = 0; i < occluders.size(); i++)
+        triangle_count += (uint32_t) triangles[i].size();
+
+    // Bands of rows never share a pixel, so each thread draws every triangle into its own bands
+    std::fill(depth.begin(), depth.begin() + OCCLUSION_WIDTH * OCCLUSION_HEIGHT, 1.f);
+    if (triangle_count > 0) {
+        pool.parallelFor(OCCLUSION_HEIGHT / OCCLUSION_BAND_HEIGHT, 1, [this](size_t begin, size_t end) {
+            for (size_t band = begin; band < end; band++)
+                rasterizeBand((int) band * OCCLUSION_BAND_HEIGHT, (int) (band + 1) * OCCLUSION_BAND_HEIGHT);
+        });
+    }
+    buildPyramid();
+    raster_ms = raster_time.getMilliseconds();
+}
+
+// Projects an occluder's triangles into the buffer, keeping the ones facing the camera
+void OcclusionCuller::setupTriangles(const Occluder& occluder, std::vector<ScreenTriangle>& screen_triangles) const {
+    screen_triangles.clear();
+    const OccluderMesh& mesh = *occluder.mesh;
+    glm::mat4 transform = view_projection * occluder.world;
+    std::vector<glm::vec4> clip(mesh.vertices.size());
+    for (size_t i = 0; i < mesh.vertices.size(); i++)
+        clip[i] = transform * glm::vec4(mesh.vertices[i], 1.f);
+
+    glm::vec3 buffer_size(OCCLUSION_WIDTH, OCCLUSION_HEIGHT, 1.f);
+    for (size_t i = 0; i < mesh.indices.size(); i += 3) {
+        // Triangles crossing the near plane are left out, which only ever lets more through
+        ScreenTriangle triangle;
+        bool crosses_near = false;
+        for (int corner = 0; corner < 3; corner++) {
+            const glm::vec4& pos = clip[mesh.indices[i + corner]];
+            if (pos.w <= OCCLUSION_MIN_W || pos.z < -pos.w) {
+                crosses_near = true;
+                break;
+            }
+            triangle.vertices[corner] = (glm::vec3(pos) / pos.w * 0.5f + 0.5f) * buffer_size;
+        }
+        if (crosses_near)
+            continue;
+
+        // Back faces are always behind a front face of the same occluder
+        const glm::vec3& a = triangle.vertices[0];
+        const glm::vec3& b = triangle.vertices[1];
+        const glm::vec3& c = triangle.vertices[2];
+        if ((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x) <= 0.f)
+            continue;
+
+        float min_x = std::min(std::min(a.x, b.x), c.x), max_x = std::max(std::max(a.x, b.x), c.x);
+        float min_y = std::min(std::min(a.y, b.y), c.y), max_y = std::max(std::max(a.y, b.y), c.y);
+        if (max_x < 0.f || max_y < 0.f || min_x >= OCCLUSION_WIDTH || min_y >= OCCLUSION_HEIGHT)
+            continue;
+        triangle.min_x = std::max((int) std::floor(min_x), 0);
+        triangle.max_x = std::min((int) std::floor(max_x), OCCLUSION_WIDTH - 1);
+        triangle.min_y = std::max((int) std::floor(min_y), 0);
+        triangle.max_y = std::min((int) std::floor(max_y), OCCLUSION_HEIGHT - 1);
+        screen_triangles.push_back(triangle);
+    }
+}
+
+// Edge functions of a triangle, a * x + b * y + c is positive inside all three, and the plane of its depth
+struct TriangleSetup {
+    float edge_a[3], edge_b[3], edge_c[3];
+    float depth_a, depth_b, depth_c;
+};
+
+// Keeps the nearer depth of the pixels of a row from x_begin to x_last whose centers are inside the triangle,
+// x_begin is a multiple of OCCLUSION_LANES and the row is a whole number of lanes wide
+static inline void rasterizeSpan(float* row, int x_begin, int x_last, float y, const TriangleSetup& setup) {
+    float row_edges[3];
+    for (int i = 0; i < 3; i++)
+        row_edges[i] = setup.edge_b[i] * y + setup.edge_c[i];
+    float row_depth = setup.depth_b * y + setup.depth_c;
+
+#if OCCLUSION_AVX
+    const __m256 centers = _mm256_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f);
+    const __m256 zero = _mm256_setzero_ps();
+    __m256 edge_a0 = _mm256_set1_ps(setup.edge_a[0]), edge_a1 = _mm256_set1_ps(setup.edge_a[1]), edge_a2 = _mm256_set1_ps(setup.edge_a[2]);
+    __m256 row_edge0 = _mm256_set1_ps(row_edges[0]), row_edge1 = _mm256_set1_ps(row_edges[1]), row_edge2 = _mm256_set1_ps(row_edges[2]);
+    __m256 depth_a = _mm256_set1_ps(setup.depth_a), depth_row = _mm256_set1_ps(row_depth);
+    for (int x = x_begin; x <= x_last; x += 8) {
+        __m256 px = _mm256_add_ps(_mm256_set1_ps((float) x), centers);
+        __m256 inside = _mm256_and_ps(
+            _mm256_and_ps(
+                _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(edge_a0, px), row_edge0), zero, _CMP_GE_OQ),
+                _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(edge_a1, px), row_edge1), zero, _CMP_GE_OQ)),
+            _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(edge_a2, px), row_edge2), zero, _CMP_GE_OQ));
+        if (_mm256_movemask_ps(inside) == 0)
+            continue;
+        __m256 pixel_depth = _mm256_add_ps(_mm256_mul_ps(depth_a, px), depth_row);
+        __m256 old_depth = _mm256_loadu_ps(row + x);
+        _mm256_storeu_ps(row + x, _mm256_blendv_ps(old_depth, _mm256_min_ps(old_depth, pixel_depth), inside));
+    }
+#elif OCCLUSION_SSE2
+    const __m128 centers = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+    const __m128 zero = _mm_setzero_ps();
+    __m128 edge_a0 = _mm_set1_ps(setup.edge_a[0]), edge_a1 = _mm_set1_ps(setup.edge_a[1]), edge_a2 = _mm_set1_ps(setup.edge_a[2]);
+    __m128 row_edge0 = _mm_set1_ps(row_edges[0]), row_edge1 = _mm_set1_ps(row_edges[1]), row_edge2 = _mm_set1_ps(row_edges[2]);
+    __m128 depth_a = _mm_set1_ps(setup.depth_a), depth_row = _mm_set1_ps(row_depth);
+    for (int x = x_begin; x <= x_last; x += 4) {
+        __m128 px = _mm_add_ps(_mm_set1_ps((float) x), centers);
+        __m128 inside = _mm_and_ps(
+            _mm_and_ps(
+                _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edge_a0, px), row_edge0), zero),
+                _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edge_a1, px), row_edge1), zero)),
+            _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edge_a2, px), row_edge2), zero));
+        if (_mm_movemask_ps(inside) == 0)
+            continue;
+        __m128 pixel_depth = _mm_add_ps(_mm_mul_ps(depth_a, px), depth_row);
+        __m128 old_depth = _mm_loadu_ps(row + x);
+        __m128 nearer = _mm_min_ps(old_depth, pixel_depth);
+        _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, old_depth)));
+    }
+#else
+    for (int x = x_begin; x <= x_last; x++) {
+        float px = x + 0.5f;
+        if (setup.edge_a[0] * px + row_edges[0] >= 0.f && setup.edge_a[1] * px + row_edges[1] >= 0.f && setup.edge_a[2] * px + row_edges[2] >= 0.f)
+            row[x] = std::min(row[x], setup.depth_a * px + row_depth);
+    }
+#endif
+}
+
+// Draws every triangle touching a band of rows into it
+void OcclusionCuller::rasterizeBand(int first_row, int end_row) {
+    for (size_t occluder = 0; occluder < occluders.size(); occluder++) {
+        for (const ScreenTriangle& triangle : triangles[occluder]) {
+            if (triangle.max_y < first_row || triangle.min_y >= end_row)
+                continue;
+
+            // The edges run counterclockwise, so each edge function is positive on the inner side of its edge
+            const glm::vec3* v = triangle.vertices;
+            TriangleSetup setup;
+            for (int i = 0; i < 3; i++) {
+                const glm::vec3& p = v[i];
+                const glm::vec3& q = v[(i + 1) % 3];
+                setup.edge_a[i] = p.y - q.y;
+                setup.edge_b[i] = q.x - p.x;
+                setup.edge_c[i] = -(setup.edge_a[i] * p.x + setup.edge_b[i] * p.y);
+            }
+            glm::vec3 ab = v[1] - v[0], ac = v[2] - v[0];
+            float area = ab.x * ac.y - ab.y * ac.x;
+            setup.depth_a = (ab.z * ac.y - ac.z * ab.y) / area;
+            setup.depth_b = (ac.z * ab.x - ab.z * ac.x) / area;
+            setup.depth_c = v[0].z - setup.depth_a * v[0].x - setup.depth_b * v[0].y;
+
+            int x_begin = triangle.min_x & ~(OCCLUSION_LANES - 1);
+            int last_row = std::min(end_row - 1, triangle.max_y);
+            for (int y = std::max(first_row, triangle.min_y); y <= last_row; y++)
+                rasterizeSpan(&depth[y * OCCLUSION_WIDTH], x_begin, triangle.max_x, y + 0.5f, setup);
+        }
+    }
+}
+
+// Fills each level of the pyramid with the farthest depth of the 2x2 texels under each of its texels
+void OcclusionCuller::buildPyramid() {
+    for (int level = 1; level < OCCLUSION_LEVELS; level++) {
+        int width = OCCLUSION_WIDTH >> level, height = OCCLUSION_HEIGHT >> level;
+        const float* below = &depth[level_offsets[level - 1]];
+        float* texels = &depth[level_offsets[level]];
+        for (int y = 0; y < height; y++) {
+            const float* row0 = below + (y * 2) * width * 2;
+            const float* row1 = row0 + width * 2;
+            for (int x = 0; x < width; x++)
+                texels[y * width + x] = std::max(std::max(row0[x * 2], row0[x * 2 + 1]), std::max(row1[x * 2], row1[x * 2 + 1]));
+        }
+    }
+}
+
+// Whether any part of a box may be in front of the occluders drawn, boxes crossing the near plane always are
+bool OcclusionCuller::isVisible(const AABB& bounds) const {
+    glm::vec2 screen_min(FLT_MAX), screen_max(-FLT_MAX);
+    float nearest = FLT_MAX;
+    glm::vec2 buffer_size(OCCLUSION_WIDTH, OCCLUSION_HEIGHT);
+    for (int corner = 0; corner < 8; corner++) {
+        glm::vec3 pos((corner & 1) ? bounds.max.x : bounds.min.x, (corner & 2) ? bounds.max.y : bounds.min.y, (corner & 4) ? bounds.max.z : bounds.min.z);
+        glm::vec4 clip = view_projection * glm::vec4(pos, 1.f);
+        if (clip.w <= OCCLUSION_MIN_W || clip.z < -clip.w)
+            return true;
+        glm::vec3 ndc = glm::vec3(clip) / clip.w;
+        glm::vec2 screen = (glm::vec2(ndc) * 0.5f + 0.5f) * buffer_size;
+        screen_min = glm::min(screen_min, screen);
+        screen_max = glm::max(screen_max, screen);
+        nearest = std::min(nearest, ndc.z * 0.5f + 0.5f);
+    }
+    int min_x = std::max((int) std::floor(screen_min.x), 0), max_x = std::min((int) std::floor(screen_max.x), OCCLUSION_WIDTH - 1);
+    int min_y = std::max((int) std::floor(screen_min.y), 0), max_y = std::min((int) std::floor(screen_max.y), OCCLUSION_HEIGHT - 1);
+    if (min_x > max_x || min_y > max_y)
+        return true;
+
+    // Go up the pyramid until the box covers a few texels, each holding the farthest depth of the block under it
+    int level = 0;
+    while (level < OCCLUSION_LEVELS - 1 && std::max((max_x >> level) - (min_x >> level), (max_y >> level) - (min_y >> level)) >= 4)
+        level++;
+    for (int y = min_y >> level; y <= max_y >> level; y++)
+        for (int x = min_x >> level; x <= max_x >> level; x++)
+            if (getDepth(level, x, y) >= nearest)
+                return true;
+    return false;
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common.h"
+#include "camera.h"
+#include "entity.h"
+#include "occluder_mesh.h"
+#include "thread_pool.h"
+
+// Size of the CPU depth buffer occluders are drawn into, and of the bands of rows it is split into between threads
+#define OCCLUSION_WIDTH 256
+#define OCCLUSION_HEIGHT 128
+#define OCCLUSION_BAND_HEIGHT 8
+// Levels of the depth pyramid, each half the size of the last, down to 8x4 texels
+#define OCCLUSION_LEVELS 6
+
+// Hides the entities that are behind others without asking the GPU: the largest entities in view, and any other occluders added,
+// are drawn as their coarse occluder meshes into a small depth buffer on the CPU, which is reduced to a pyramid of the farthest
+// depth of each texel's block, and the bounds of every entity in view are tested against the level their size on screen covers
+class OcclusionCuller {
+public:
+    // How large an entity has to look to occlude others, its bounding radius over its depth scaled by the projection,
+    // and how many of the largest are drawn
+    float min_occluder_size;
+    int max_occluders;
+
+    OcclusionCuller();
+
+    // Starts a frame seen by a camera, forgetting the occluders of the last frame
+    void begin(Camera& camera);
+
+    // Adds an occluder placed by a world matrix, such as one that is not an entity, it must outlive the next cull
+    void addOccluder(const OccluderMesh& mesh, const glm::mat4& world);
+
+    // Adds the largest of the visible entities as occluders, draws every occluder, then removes the entities they hide from visible,
+    // clearing their visible flag
+    void cull(EntityStore& entities, std::vector<uint32_t>& visible, ThreadPool& pool);
+
+    // Draws the occluders added since begin and builds the depth pyramid, cull does this itself
+    void rasterize(ThreadPool& pool);
+
+    // Whether any part of a box may be in front of the occluders drawn, boxes crossing the near plane always are
+    bool isVisible(const AABB& bounds) const;
+
+    // Depth of a texel of a level of the pyramid, 0 at the near plane and 1 where nothing was drawn
+    inline float getDepth(int level, int x, int y) const {
+        return depth[level_offsets[level] + y * (OCCLUSION_WIDTH >> level) + x];
+    }
+
+    inline uint32_t getOccluderCount() const {
+        return (uint32_t) occluders.size();
+    }
+
+    // Triangles of the occluders that faced the camera and were in front of the near plane
+    inline uint32_t getTriangleCount() const {
+        return triangle_count;
+    }
+
+    inline uint32_t getCulledCount() const {
+        return culled_count;
+    }
+
+    // Milliseconds the last cull spent drawing the occluders and testing the entities
+    inline double getRasterMilliseconds() const {
+        return raster_ms;
+    }
+
+    inline double getTestMilliseconds() const {
+        return test_ms;
+    }
+
+private:
+    // A triangle in the pixels of the buffer, with its depth
+    struct ScreenTriangle {
+        glm::vec3 vertices[3];
+        int min_x, max_x, min_y, max_y;
+    };
+
+    struct Occluder {
+        const OccluderMesh* mesh;
+        glm::mat4 world;
+    };
+
+    glm::mat4 view_projection;
+    std::vector<Occluder> occluders;
+    // Triangles of each occluder, so each can be set up on its own thread
+    std::vector<std::vector<ScreenTriangle>> triangles;
+    // Every level of the pyramid one after another, level 0 is the buffer itself
+    std::vector<float> depth;
+    size_t level_offsets[OCCLUSION_LEVELS];
+
+    std::vector<std::pair<float, uint32_t>> candidates;
+    std::vector<uint8_t> hidden;
+    uint32_t triangle_count;
+    uint32_t culled_count;
+    double raster_ms;
+    double test_ms;
+
+    // Projects an occluder's triangles into the buffer, keeping the ones facing the camera
+    void setupTriangles(const Occluder& occluder, std::vector<ScreenTriangle>& screen_triangles) const;
+
+    // Draws every triangle touching a band of rows into it
+    void rasterizeBand(int first_row, int end_row);
+
+    // Fills each level of the pyramid with the farthest depth of the 2x2 texels under each of its texels
+    void buildPyramid();
+};
@@ -0,0 +1,110 @@
+#include "particles.h"
+
+#include <algorithm>
+#include <cstddef>
+
+#include "profiler.h"
+#include "startup_timeline.h"
+
+// Invocations per work group, must match local_size_x in the shader
+static const size_t group_size = 256;
+
+// Creates room for capacity particles, none of them alive
+ParticleSystem::ParticleSystem(size_t capacity, const ParticleSettings& settings, uint32_t seed):
+    settings(settings), capacity(std::max(capacity, (size_t) 1)), used(0), head(0), time(0.f), rng(seed),
+    update_shader("Shaders/particles_update.comp") {
+    // Start out with every particle dead
+    std::vector<Particle> dead(this->capacity);
+    for (Particle& particle : dead) {
+        particle.pos_life = glm::vec4(0.f);
+        particle.vel_size = glm::vec4(0.f);
+    }
+
+    StartupScope upload_step("Upload particle buffer");
+    upload_step.bytes_read = upload_step.bytes_produced = this->capacity * sizeof(Particle);
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &buffer);
+    glBindVertexArray(VAO);
+
+    // The compute shader writes the particles as storage and the renderer reads them as points
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glBufferData(GL_ARRAY_BUFFER, this->capacity * sizeof(Particle), dead.data(), GL_DYNAMIC_DRAW);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(Particle), (void*) offsetof(Particle, pos_life));
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Particle), (void*) offsetof(Particle, vel_size));
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    // Settings that never change are passed once
+    update_shader.setVec3("acceleration", settings.acceleration);
+    update_shader.setFloat("drag", settings.drag);
+    update_shader.setFloat("wobble", settings.wobble);
+    update_shader.setFloat("surface_y", settings.surface_y);
+    update_shader.setVec3("wrap_size", settings.wrap_size);
+    glUseProgram(0);
+}
+
+// Deconstructor to free the VAO and buffer
+ParticleSystem::~ParticleSystem() {
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &buffer);
+}
+
+// Adds particles, replacing the oldest ones when the system is full
+void ParticleSystem::emit(const Particle* particles, size_t count) {
+    // Only the newest particles would survive a burst larger than the system
+    if (count > capacity) {
+        particles += count - capacity;
+        count = capacity;
+    }
+
+    // Write up to the end of the buffer, then wrap around to its start
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    size_t first = std::min(count, capacity - head);
+    glBufferSubData(GL_ARRAY_BUFFER, head * sizeof(Particle), first * sizeof(Particle), particles);
+    if (first < count)
+        glBufferSubData(GL_ARRAY_BUFFER, 0, (count - first) * sizeof(Particle), particles + first);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    head = (head + count) % capacity;
+    used = std::min(used + count, capacity);
+}
+
+// Adds count particles scattered through a box around center, with life and size picked from the settings
+void ParticleSystem::emitBurst(size_t count, glm::vec3 center, glm::vec3 extents, glm::vec3 velocity, float velocity_spread) {
+    if (count == 0)
+        return;
+
+    std::uniform_real_distribution<float> unit(-1.f, 1.f);
+    std::uniform_real_distribution<float> life(settings.min_life, settings.max_life);
+    std::uniform_real_distribution<float> size(settings.min_size, settings.max_size);
+    staging.resize(count);
+    for (Particle& particle : staging) {
+        glm::vec3 offset(unit(rng), unit(rng), unit(rng));
+        glm::vec3 spread(unit(rng), unit(rng), unit(rng));
+        particle.pos_life = glm::vec4(center + offset * extents, life(rng));
+        particle.vel_size = glm::vec4(velocity + spread * velocity_spread, size(rng));
+    }
+    emit(staging.data(), count);
+}
+
+// Advances every particle by dt seconds, wrapping them around wrap_center if the settings say so
+void ParticleSystem::update(float dt, glm::vec3 wrap_center) {
+    PROFILE_GPU_SCOPE("Particle compute");
+    time += dt;
+    if (used == 0)
+        return;
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, buffer);
+    update_shader.setUint("particle_count", (GLuint) used);
+    update_shader.setFloat("dt", dt);
+    update_shader.setFloat("time", time);
+    update_shader.setVec3("wrap_center", wrap_center);
+    update_shader.dispatch(used, group_size);
+
+    // The renderer reads the particles as vertex attributes and the next emit overwrites some of them
+    glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+    glUseProgram(0);
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "common.h"
+#include "shader.h"
+
+// State of one particle as laid out in the shader storage buffer, padded to vec4s for std430
+struct Particle {
+    // Position, and seconds left to live in w, a particle with no life left is not updated or drawn
+    glm::vec4 pos_life;
+    // Velocity, and diameter in world units in w
+    glm::vec4 vel_size;
+};
+
+// Behaviour and look of the particles of a system
+struct ParticleSettings {
+    // Constant acceleration, such as bubbles rising
+    glm::vec3 acceleration;
+    // Fraction of the velocity lost per second
+    float drag;
+    // Speed of the side to side drift, each particle drifts out of phase with the others
+    float wobble;
+    // Particles above this height die, like bubbles reaching the surface
+    float surface_y;
+    // Size of the box around a point that particles wrap around in, zero if they do not wrap
+    glm::vec3 wrap_size;
+    // Range of seconds a new particle lives for and of its diameter
+    float min_life, max_life;
+    float min_size, max_size;
+    // Particles fade out over their last seconds of life
+    float fade_time;
+    // Color and opacity the particles are drawn with, added on top of the scene
+    glm::vec4 color;
+
+    ParticleSettings():
+        acceleration(0.f), drag(0.f), wobble(0.f), surface_y(0.f), wrap_size(0.f),
+        min_life(1.f), max_life(1.f), min_size(0.1f), max_size(0.1f), fade_time(0.5f), color(1.f) {}
+};
+
+// Fixed number of particles updated by a compute shader, new particles replace the oldest ones like a ring
+class ParticleSystem {
+public:
+    ParticleSettings settings;
+    GLuint VAO;
+    GLuint buffer;
+
+    // Creates room for capacity particles, none of them alive
+    ParticleSystem(size_t capacity, const ParticleSettings& settings, uint32_t seed = 1234);
+
+    // Deconstructor to free the VAO and buffer
+    ~ParticleSystem();
+
+    // Number of slots that have ever held a particle, which are the only ones updated and drawn
+    inline size_t getUsed() {
+        return used;
+    }
+
+    inline size_t getCapacity() {
+        return capacity;
+    }
+
+    // Adds particles, replacing the oldest ones when the system is full
+    void emit(const Particle* particles, size_t count);
+
+    // Adds count particles scattered through a box of half size extents around center,
+    // moving at velocity plus up to velocity_spread in any direction, with life and size picked from the settings
+    void emitBurst(size_t count, glm::vec3 center, glm::vec3 extents, glm::vec3 velocity, float velocity_spread);
+
+    // Advances every particle by dt seconds, wrapping them around wrap_center if the settings say so
+    void update(float dt, glm::vec3 wrap_center);
+
+private:
+    size_t capacity;
+    size_t used;
+    // Slot the next particle is written to
+    size_t head;
+    // Seconds simulated so far, for the drift
+    float time;
+    std::mt19937 rng;
+    // Particles made by emitBurst before they are uploaded
+    std::vector<Particle> staging;
+
+    ComputeShader update_shader;
+};
@@ -8,6 +8,9 @@ using namespace std;
 #include "camera.h"
 #include "texture.h"
 #include "light.h"
+#include "entity.h"
+#include "collision.h"
+#include "profiler.h"
 
 // Represents the plaeyr in the world
 class Player {
@@ -29,16 +32,39 @@ public:
 	float rot_offset;
 	// Offset of the point light from the center of the first person camera
 	float point_offset;
+	// Distance the propeller has pushed the player that has not been turned into bubbles yet
+	float wake_distance;
 
-	Player(Model3D& sub_model, float rot_offset, float point_offset):
-		pos(0, -5, 0), is_ortho(false), is_third_ppov(true), light_intensity(1), sub_model(sub_model),
+	// State of the previous simulation step, blended with the current state when rendering
+	glm::vec3 prev_pos;
+	float prev_rot_y;
+	ThirdPersonCamera prev_3rdppov;
+	FirstPersonCamera prev_1stppov;
+	OrthographicCamera prev_birdppov;
+	glm::vec3 prev_light_pos;
+
+	// Interpolated copies of the cameras and light used for rendering between simulation steps
+	ThirdPersonCamera render_3rdppov;
+	FirstPersonCamera render_1stppov;
+	OrthographicCamera render_birdppov;
+	PointLight render_light;
+
+	Player(Model3D& sub_model, float rot_offset, float point_offset, glm::vec3 spawn = glm::vec3(0, -5, 0)):
+		pos(spawn), is_ortho(false), is_third_ppov(true), light_intensity(1), sub_model(sub_model),
 		front_light(light_intensity, pos, {1.f, 1.f, 1.f}, 0.1f, 0.3f, 80.f),
 		cam_3rdppov(15.f, pos, 60.f, 0.1f, 30.f), cam_1stppov(pos, glm::vec3(pos.x, pos.y, pos.z - 1), 60.f, 0.1f, 100.f),
-		cam_birdppov(glm::vec3(pos.x, 5, pos.z), 100.f), rot_offset(rot_offset), point_offset(point_offset) {
+		cam_birdppov(glm::vec3(pos.x, 5, pos.z), 100.f), rot_offset(rot_offset), point_offset(point_offset), wake_distance(0.f),
+		prev_3rdppov(cam_3rdppov), prev_1stppov(cam_1stppov), prev_birdppov(cam_birdppov),
+		render_3rdppov(cam_3rdppov), render_1stppov(cam_1stppov), render_birdppov(cam_birdppov),
+		render_light(front_light) {
 		sub_model.pos = pos;
 		sub_model.rot.y = -cam_1stppov.yaw + rot_offset;
 		glm::vec3 offset = point_offset * glm::normalize(cam_1stppov.camera_center - cam_1stppov.camera_pos);
 		front_light.pos = cam_1stppov.camera_center + offset;
+		// The headlight is the one light whose shadows are always worth a slot of the point shadow atlas
+		front_light.casts_shadows = true;
+		saveState();
+		interpolate(1.f);
 	}
 
 	// Get the current camera the player should be using based on their current state
@@ -51,6 +77,45 @@ public:
 			return cam_1stppov;
 	}
 
+	// Get the interpolated copy of the camera the player should be rendered with
+	Camera& getRenderCam() {
+		if (is_ortho)
+			return render_birdppov;
+		else if (is_third_ppov)
+			return render_3rdppov;
+		else
+			return render_1stppov;
+	}
+
+	// Save the current simulation state, to be called before each simulation step
+	inline void saveState() {
+		prev_pos = pos;
+		// The model's yaw is overwritten by interpolate, so the simulation's own yaw is saved instead
+		prev_rot_y = -cam_1stppov.yaw + rot_offset;
+		prev_3rdppov = cam_3rdppov;
+		prev_1stppov = cam_1stppov;
+		prev_birdppov = cam_birdppov;
+		prev_light_pos = front_light.pos;
+	}
+
+	// Blend the previous and current simulation states for rendering, alpha is how far into the next step the frame is
+	inline void interpolate(float alpha) {
+		sub_model.pos = glm::mix(prev_pos, pos, alpha);
+
+		// Snap the rotation instead of spinning the long way around when the yaw wraps
+		float rot_y = -cam_1stppov.yaw + rot_offset;
+		if (std::abs(rot_y - prev_rot_y) < 180.f)
+			rot_y = glm::mix(prev_rot_y, rot_y, alpha);
+		sub_model.rot.y = rot_y;
+
+		interpolateCam(render_3rdppov, prev_3rdppov, cam_3rdppov, alpha);
+		interpolateCam(render_1stppov, prev_1stppov, cam_1stppov, alpha);
+		interpolateCam(render_birdppov, prev_birdppov, cam_birdppov, alpha);
+
+		render_light = front_light;
+		render_light.pos = glm::mix(prev_light_pos, front_light.pos, alpha);
+	}
+
 	// Cycle to the next light intensity
 	inline void nextIntensity() {
 		light_intensity = (light_intensity + 1) % 4;
@@ -66,6 +131,7 @@ public:
 
 	// Move the player forward
 	inline void moveForward(float amount) {
+		wake_distance += std::abs(amount);
 		cam_1stppov.moveForward(amount);
 		pos = cam_1stppov.camera_pos;
 		sub_model.pos = pos;
@@ -76,6 +142,21 @@ public:
 		front_light.pos = cam_1stppov.camera_center + offset;
 	}
 
+	// Get how many whole bubbles the propeller has churned up since the last call, at a number of bubbles per unit moved
+	// The distance short of the next bubble is kept, so slow steps still add up to bubbles instead of being dropped
+	inline size_t takeWake(float bubbles_per_unit) {
+		size_t bubbles = (size_t) (wake_distance * bubbles_per_unit);
+		wake_distance -= bubbles / bubbles_per_unit;
+		return bubbles;
+	}
+
+	// Get the point behind the hull where the propeller churns up bubbles
+	inline glm::vec3 getPropellerPos(const Collider& hull) {
+		glm::vec3 forward = glm::normalize(cam_1stppov.camera_center - cam_1stppov.camera_pos);
+		glm::vec3 start = hull.getStart(), end = hull.getEnd();
+		return glm::dot(start - end, forward) < 0.f ? start : end;
+	}
+
 	// Move the player up and down
 	inline void moveVertically(float amount) {
 		// Prevent the player from going above y level 0
@@ -88,12 +169,88 @@ public:
 		cam_3rdppov.move(pos);
 		cam_birdppov.moveXZ(pos.x, pos.z);
 
-		cout << "Submarine Depth: " << cam_1stppov.camera_pos.y << endl;
-
 		glm::vec3 offset = point_offset * glm::normalize(cam_1stppov.camera_center - cam_1stppov.camera_pos);
 		front_light.pos = cam_1stppov.camera_center + offset;
 	}
 
+	// Move the player by an offset, keeping it below y level 0
+	inline void moveBy(glm::vec3 offset) {
+		if (cam_1stppov.camera_pos.y + offset.y > 0)
+			offset.y = 0 - cam_1stppov.camera_pos.y;
+
+		cam_1stppov.move(cam_1stppov.camera_pos + offset);
+		pos = cam_1stppov.camera_pos;
+		sub_model.pos = pos;
+		cam_3rdppov.move(pos);
+		cam_birdppov.moveXZ(pos.x, pos.z);
+
+		glm::vec3 light_offset = point_offset * glm::normalize(cam_1stppov.camera_center - cam_1stppov.camera_pos);
+		front_light.pos = cam_1stppov.camera_center + light_offset;
+	}
+
+	// Get the transformation matrix of the submarine at the current simulation state
+	inline glm::mat4 getTransform() {
+		glm::vec3 rot(sub_model.rot.x, -cam_1stppov.yaw + rot_offset, sub_model.rot.z);
+		return composeTransform(pos, rot, sub_model.scale);
+	}
+
+	// Stop the last step's movement at the first body the submarine runs into, then push it out of anything it still overlaps
+	inline void resolveCollisions(CollisionWorld& world, uint32_t body) {
+		PROFILE_SCOPE("Resolve collisions");
+		// Distance kept between the hull and what it runs into
+		static const float skin = 0.01f;
+
+		// Sweep spheres at both ends and the middle of the hull, which covers the capsule for moves shorter than its radius
+		world.setTransform(body, getTransform());
+		const Collider& hull = world.colliders[body];
+		glm::vec3 points[] = {hull.getStart() - pos, hull.center - pos, hull.getEnd() - pos};
+		glm::vec3 start = prev_pos;
+		glm::vec3 remaining = pos - prev_pos;
+
+		// The first pass stops at what is hit, the second slides the rest of the way along it
+		for (int pass = 0; pass < 2; pass++) {
+			// Moves shorter than the skin are left to the push out below
+			float length = glm::length(remaining);
+			if (length < skin) {
+				start += remaining;
+				break;
+			}
+
+			SweepHit nearest;
+			nearest.time = 1.f;
+			bool hit = false;
+			for (glm::vec3 point : points) {
+				SweepHit point_hit;
+				if (world.sweepSphere(start + point, hull.radius, remaining, body, point_hit) && point_hit.time < nearest.time) {
+					nearest = point_hit;
+					hit = true;
+				}
+			}
+			if (!hit) {
+				start += remaining;
+				break;
+			}
+
+			float time = std::max(0.f, nearest.time - skin / length);
+			start += remaining * time;
+			remaining *= 1.f - time;
+			remaining -= std::min(glm::dot(remaining, nearest.normal), 0.f) * nearest.normal;
+		}
+		moveBy(start - pos);
+
+		// Turning in place can still swing the hull into something, move straight back out of it
+		world.setTransform(body, getTransform());
+		std::vector<Contact> contacts;
+		world.findBodyContacts(body, contacts);
+		glm::vec3 push(0.f);
+		for (const Contact& contact : contacts)
+			push -= contact.normal * contact.depth;
+		if (!contacts.empty()) {
+			moveBy(push);
+			world.setTransform(body, getTransform());
+		}
+	}
+
 	// Turn the player to the left or to the right
 	inline void turnYaw(float amount) {
 		cam_1stppov.turnYaw(amount);
@@ -107,4 +264,13 @@ public:
 	inline void moveOrtho(float x_amount, float z_amount) {
 		cam_birdppov.moveXZ(cam_birdppov.camera_pos.x + x_amount, cam_birdppov.camera_pos.z + z_amount);
 	}
+
+private:
+	// Set a render camera to the current camera with its position and center blended from the previous step
+	template <class CameraType>
+	static inline void interpolateCam(CameraType& render_cam, CameraType& prev_cam, CameraType& cam, float alpha) {
+		render_cam = cam;
+		render_cam.camera_pos = glm::mix(prev_cam.camera_pos, cam.camera_pos, alpha);
+		render_cam.camera_center = glm::mix(prev_cam.camera_center, cam.camera_center, alpha);
+	}
 };
@@ -0,0 +1,159 @@
+#include "point_shadows.h"
+
+#include <algorithm>
+
+#include "profiler.h"
+#include "shader.h"
+
+PointShadowAtlas::PointShadowAtlas(size_t budget, int size): size(size), drawn_count(0), cached_count(0) {
+    // As many lights as fit in the budget, six layers of four bytes a texel each, and as the driver allows layers for
+    GLint max_layers = 0;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &max_layers);
+    size_t slot_size = 6 * (size_t) size * size * 4;
+    size_t slot_count = std::min(std::max(budget / slot_size, (size_t) 1), (size_t) max_layers / 6);
+    Slot empty = {nullptr, glm::vec3(0.f), 0.f, 0, false, false};
+    slots.assign(slot_count, empty);
+
+    glGenTextures(1, &depth_maps);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, depth_maps);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT24, size, size, (GLsizei) slot_count * 6, 0,
+        GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, NULL);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    GLint bound_framebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &bound_framebuffer);
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+    glBindFramebuffer(GL_FRAMEBUFFER, bound_framebuffer);
+}
+
+// Deconstructor to free the framebuffer and the depth maps
+PointShadowAtlas::~PointShadowAtlas() {
+    glDeleteFramebuffers(1, &framebuffer);
+    glDeleteTextures(1, &depth_maps);
+}
+
+// Sums up the casters near a light and where they are, so a map is only drawn again when something in it moved
+uint64_t PointShadowAtlas::hashCasters(const EntityStore& entities) const {
+    // FNV-1a over the indices and world matrices of the casters
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t bytes) {
+        const unsigned char* bytes_in = (const unsigned char*) data;
+        for (size_t i = 0; i < bytes; i++)
+            hash = (hash ^ bytes_in[i]) * 1099511628211ull;
+    };
+    for (uint32_t entity : casters) {
+        mix(&entity, sizeof(entity));
+        mix(&entities.world_matrices[entity], sizeof(glm::mat4));
+    }
+    return hash;
+}
+
+// Gives the lights that cast shadows their slots and draws the maps that are out of date, the lights' shadow_slot is set either way
+void PointShadowAtlas::update(const std::vector<PointLight*>& lights, glm::vec3 camera_pos, EntityStore& entities, PointShadowShader& shader) {
+    PROFILE_SCOPE("Point shadows");
+    drawn_count = 0;
+    cached_count = 0;
+
+    // The lights nearest the camera get the slots when there are more lights than slots
+    ranked.clear();
+    for (PointLight* light : lights) {
+        light->shadow_slot = -1;
+        if (light->casts_shadows)
+            ranked.push_back(light);
+    }
+    std::sort(ranked.begin(), ranked.end(), [camera_pos](const PointLight* a, const PointLight* b) {
+        glm::vec3 to_a = a->pos - camera_pos, to_b = b->pos - camera_pos;
+        return glm::dot(to_a, to_a) < glm::dot(to_b, to_b);
+    });
+    if (ranked.size() > slots.size())
+        ranked.resize(slots.size());
+
+    // Lights keep the slot they had last frame, so their maps can be reused, and the rest take the slots left over
+    for (Slot& slot : slots)
+        slot.claimed = false;
+    for (PointLight* light : ranked) {
+        for (size_t i = 0; i < slots.size(); i++) {
+            if (slots[i].owner == light) {
+                slots[i].claimed = true;
+                light->shadow_slot = (int) i;
+                break;
+            }
+        }
+    }
+    size_t next_free = 0;
+    for (PointLight* light : ranked) {
+        if (light->shadow_slot >= 0)
+            continue;
+        while (slots[next_free].claimed)
+            next_free++;
+        slots[next_free].owner = light;
+        slots[next_free].claimed = true;
+        slots[next_free].drawn = false;
+        light->shadow_slot = (int) next_free;
+    }
+
+    GLint output_framebuffer;
+    GLint viewport[4];
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &output_framebuffer);
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    bool bound = false;
+    for (PointLight* light : ranked) {
+        Slot& slot = slots[light->shadow_slot];
+        float range = light->getShadowRange();
+        entities.querySphere(light->pos, range, casters);
+        uint64_t caster_hash = hashCasters(entities);
+        if (slot.drawn && slot.pos == light->pos && slot.range == range && slot.caster_hash == caster_hash) {
+            cached_count++;
+            continue;
+        }
+
+        if (!bound) {
+            glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+            glViewport(0, 0, size, size);
+            glEnable(GL_POLYGON_OFFSET_FILL);
+            glPolygonOffset(2.f, 4.f);
+            bound = true;
+        }
+        draw(light->shadow_slot, *light, entities, shader);
+        slot.pos = light->pos;
+        slot.range = range;
+        slot.caster_hash = caster_hash;
+        slot.drawn = true;
+        drawn_count++;
+    }
+    if (bound) {
+        glDisable(GL_POLYGON_OFFSET_FILL);
+        glBindFramebuffer(GL_FRAMEBUFFER, output_framebuffer);
+        glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    }
+}
+
+// Clears a slot's six layers and draws the casters into them
+void PointShadowAtlas::draw(int slot, const PointLight& light, EntityStore& entities, PointShadowShader& shader) {
+    // Clearing a layered attachment would clear every slot, so the six layers are attached and cleared one at a time
+    for (int face = 0; face < 6; face++) {
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depth_maps, 0, slot * 6 + face);
+        glClear(GL_DEPTH_BUFFER_BIT);
+    }
+
+    // The geometry shader sends every triangle to the faces it lands on, so the casters are drawn once for all six
+    glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depth_maps, 0);
+    entities.buildDrawPackets(casters, packets);
+    shader.render(entities, packets, light.pos, light.getShadowRange(), slot * 6);
+}
+
+// Binds the depth maps to their texture unit
+void PointShadowAtlas::bind() {
+    glActiveTexture(GL_TEXTURE0 + POINT_SHADOW_UNIT);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, depth_maps);
+    glActiveTexture(GL_TEXTURE0);
+}
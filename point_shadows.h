@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common.h"
+#include "light.h"
+#include "entity.h"
+
+// Size of each face of a point light's shadow map, and how much memory the atlas of them may take
+#define POINT_SHADOW_SIZE 256
+#define POINT_SHADOW_BUDGET (12 * 1024 * 1024)
+
+// Texture unit the atlas is bound to, below the direction light's shadow map
+#define POINT_SHADOW_UNIT 11
+
+class PointShadowShader;
+
+// Six face shadow maps of the point lights that cast shadows, packed as layers of one depth texture array that never grows
+// A map is kept from frame to frame and only drawn again when its light or one of the entities within its reach moves,
+// and when there are more lights than the budget has room for, the ones nearest the camera get the slots
+class PointShadowAtlas {
+public:
+    PointShadowAtlas(size_t budget = POINT_SHADOW_BUDGET, int size = POINT_SHADOW_SIZE);
+
+    // Deconstructor to free the framebuffer and the depth maps
+    ~PointShadowAtlas();
+
+    // Gives the lights that cast shadows their slots and draws the maps that are out of date, the lights' shadow_slot is set either way
+    void update(const std::vector<PointLight*>& lights, glm::vec3 camera_pos, EntityStore& entities, PointShadowShader& shader);
+
+    // Binds the depth maps to their texture unit
+    void bind();
+
+    inline int getSlotCount() const {
+        return (int) slots.size();
+    }
+
+    inline size_t getMemorySize() const {
+        return slots.size() * 6 * (size_t) size * size * 4;
+    }
+
+    // Maps drawn again and maps reused as they were by the last update
+    inline uint32_t getDrawnCount() const {
+        return drawn_count;
+    }
+
+    inline uint32_t getCachedCount() const {
+        return cached_count;
+    }
+
+private:
+    // What a slot's map was drawn from, it is up to date while all of it stays the same
+    struct Slot {
+        const PointLight* owner;
+        glm::vec3 pos;
+        float range;
+        uint64_t caster_hash;
+        bool drawn;
+        bool claimed;
+    };
+
+    int size;
+    GLuint framebuffer;
+    GLuint depth_maps;
+    std::vector<Slot> slots;
+
+    std::vector<PointLight*> ranked;
+    std::vector<uint32_t> casters;
+    std::vector<DrawPacket> packets;
+    uint32_t drawn_count;
+    uint32_t cached_count;
+
+    // Sums up the casters near a light and where they are, so a map is only drawn again when something in it moved
+    uint64_t hashCasters(const EntityStore& entities) const;
+
+    // Clears a slot's six layers and draws the casters into them
+    void draw(int slot, const PointLight& light, EntityStore& entities, PointShadowShader& shader);
+};
@@ -0,0 +1,96 @@
+#include "post_process.h"
+
+#include <iostream>
+
+#include "profiler.h"
+
+PostProcessChain::PostProcessChain(int width, int height):
+    fog_color(0.01f, 0.09f, 0.14f), fog_density(0.012f), exposure(1.f), night_vision(false), noise_strength(0.08f),
+    vignette_strength(0.35f), width(width), height(height), output_framebuffer(0), pass_count(0),
+    fog_shader("Shaders/fullscreen.vert", "Shaders/post_fog.frag"),
+    tonemap_shader("Shaders/fullscreen.vert", "Shaders/post_tonemap.frag"),
+    night_vision_shader("Shaders/fullscreen.vert", "Shaders/post_night_vision.frag"),
+    vignette_shader("Shaders/fullscreen.vert", "Shaders/post_vignette.frag") {
+    GLint bound_framebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &bound_framebuffer);
+
+    // The scene keeps its light above 1 until it is tonemapped, and its depth is read by the fog
+    glGenFramebuffers(1, &scene_framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, scene_framebuffer);
+    scene_color = makeColorTarget();
+    glGenTextures(1, &depth);
+    glBindTexture(GL_TEXTURE_2D, depth);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, width, height, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, depth, 0);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        std::cout << "The scene target is incomplete, nothing will be drawn\n";
+
+    // The passes only read and write color
+    glGenFramebuffers(2, pass_framebuffers);
+    for (int i = 0; i < 2; i++) {
+        glBindFramebuffer(GL_FRAMEBUFFER, pass_framebuffers[i]);
+        pass_colors[i] = makeColorTarget();
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, bound_framebuffer);
+}
+
+// Deconstructor to free the targets
+PostProcessChain::~PostProcessChain() {
+    GLuint textures[4] = {scene_color, depth, pass_colors[0], pass_colors[1]};
+    glDeleteTextures(4, textures);
+    glDeleteFramebuffers(1, &scene_framebuffer);
+    glDeleteFramebuffers(2, pass_framebuffers);
+}
+
+// Makes a half float color texture the size of the chain, attached to the bound framebuffer
+GLuint PostProcessChain::makeColorTarget() {
+    // Every pixel is read back at its own position, so nothing is filtered or mipmapped
+    GLuint texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0, GL_RGBA, GL_HALF_FLOAT, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+    return texture;
+}
+
+// Draws into the scene target, remembering the framebuffer the chain ends in
+void PostProcessChain::beginScene() {
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &output_framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, scene_framebuffer);
+}
+
+// Runs the passes over the scene drawn since beginScene, ending in the framebuffer bound then, time moves the noise along
+void PostProcessChain::apply(Camera& camera, float time) {
+    PROFILE_GPU_SCOPE("Post process");
+    PostProcessShader* passes[4];
+    pass_count = 0;
+    if (fog_density > 0.f)
+        passes[pass_count++] = &fog_shader;
+    passes[pass_count++] = &tonemap_shader;
+    if (night_vision)
+        passes[pass_count++] = &night_vision_shader;
+    if (vignette_strength > 0.f)
+        passes[pass_count++] = &vignette_shader;
+
+    // Every pass covers every pixel, so nothing is tested or blended
+    GLboolean depth_test = glIsEnabled(GL_DEPTH_TEST);
+    GLboolean blend = glIsEnabled(GL_BLEND);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_BLEND);
+    GLuint input = scene_color;
+    for (int i = 0; i < pass_count; i++) {
+        bool last = i == pass_count - 1;
+        glBindFramebuffer(GL_FRAMEBUFFER, last ? output_framebuffer : pass_framebuffers[i % 2]);
+        passes[i]->render(*this, input, camera, time);
+        input = pass_colors[i % 2];
+    }
+    if (depth_test)
+        glEnable(GL_DEPTH_TEST);
+    if (blend)
+        glEnable(GL_BLEND);
+}
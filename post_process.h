@@ -0,0 +1,61 @@
+#pragma once
+
+#include "common.h"
+#include "shader.h"
+
+// Renders the frame into a floating point target, then runs full screen passes over it on the way to the screen:
+// underwater fog from the depth, tonemapping down to the screen's range, the night vision look of the first person view, and a vignette
+// Each pass reads the last one's output, the passes that are turned off are skipped, and the last one draws into the output framebuffer
+class PostProcessChain {
+public:
+    // Color the water fades to with distance and how quickly, 0 turns the fog off
+    glm::vec3 fog_color;
+    float fog_density;
+    // Scale of the scene's light before it is tonemapped
+    float exposure;
+    // Whether the night vision pass runs, and how much noise it adds
+    bool night_vision;
+    float noise_strength;
+    // How much the corners are darkened, 0 turns the vignette off
+    float vignette_strength;
+
+    PostProcessChain(int width = SCREEN_WT, int height = SCREEN_HT);
+
+    // Deconstructor to free the targets
+    ~PostProcessChain();
+
+    // Draws into the scene target, remembering the framebuffer the chain ends in
+    void beginScene();
+
+    // Runs the passes over the scene drawn since beginScene, ending in the framebuffer bound then, time moves the noise along
+    void apply(Camera& camera, float time);
+
+    // Depth of the scene target, which the passes can read
+    inline GLuint getDepthTexture() const {
+        return depth;
+    }
+
+    // Passes the last apply ran
+    inline int getPassCount() const {
+        return pass_count;
+    }
+
+private:
+    int width, height;
+    // The scene's target, a half float color and a depth texture, then two half float targets the passes go back and forth between
+    GLuint scene_framebuffer;
+    GLuint scene_color;
+    GLuint depth;
+    GLuint pass_framebuffers[2];
+    GLuint pass_colors[2];
+    GLint output_framebuffer;
+    int pass_count;
+
+    PostProcessShader fog_shader;
+    PostProcessShader tonemap_shader;
+    PostProcessShader night_vision_shader;
+    PostProcessShader vignette_shader;
+
+    // Makes a half float color texture the size of the chain, attached to the bound framebuffer
+    GLuint makeColorTarget();
+};
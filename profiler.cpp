@@ -0,0 +1,163 @@
+#include "profiler.h"
+
+#if GRAPHIX_PROFILE
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+
+#include "json.h"
+
+// Events kept per thread, older ones are overwritten
+static const size_t track_capacity = 1 << 16;
+// GPU passes that can be timed per frame
+static const int max_gpu_passes = 64;
+
+// Every track ever made, tracks outlive their threads so their events can still be written out
+static std::mutex tracks_mutex;
+static std::vector<std::unique_ptr<ProfileTrack>> tracks;
+static thread_local ProfileTrack* thread_track = nullptr;
+
+// Queries of the passes of one frame, with the CPU time each pass was submitted at
+struct GpuFrame {
+    GLuint queries[max_gpu_passes];
+    const char* names[max_gpu_passes];
+    int64_t starts[max_gpu_passes];
+    int count;
+};
+
+// Frames alternate between two sets of queries, so a frame's results are read a frame later once the GPU is done with them
+static GpuFrame gpu_frames[2];
+static int gpu_frame = 0;
+static bool gpu_ready = false;
+static bool gpu_pass_open = false;
+static bool gpu_timing_enabled = true;
+static ProfileTrack* gpu_track = nullptr;
+
+// Adds a track for events that are not recorded by the calling thread itself
+static ProfileTrack* addTrack(const char* name) {
+    std::lock_guard<std::mutex> lock(tracks_mutex);
+    tracks.emplace_back(new ProfileTrack((int) tracks.size() + 1, track_capacity));
+    tracks.back()->name = name;
+    return tracks.back().get();
+}
+
+// Gets the calling thread's track, making it on the thread's first event
+static inline ProfileTrack* getThreadTrack() {
+    if (!thread_track)
+        thread_track = addTrack("Thread");
+    return thread_track;
+}
+
+// Gets the nanoseconds elapsed since the profiler started
+int64_t Profiler::now() {
+    static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+// Adds an event to the calling thread's track
+void Profiler::record(const char* name, int64_t start, int64_t end) {
+    getThreadTrack()->record(name, start, end);
+}
+
+// Names the calling thread's track in the trace
+void Profiler::setThreadName(const char* name) {
+    ProfileTrack* track = getThreadTrack();
+    std::lock_guard<std::mutex> lock(tracks_mutex);
+    track->name = name;
+}
+
+// Starts timing a pass of GPU work, returns false if it is not timed
+bool Profiler::beginGpuPass(const char* name) {
+    if (!gpu_timing_enabled)
+        return false;
+
+    if (!gpu_ready) {
+        for (GpuFrame& frame : gpu_frames) {
+            glGenQueries(max_gpu_passes, frame.queries);
+            frame.count = 0;
+        }
+        gpu_track = addTrack("GPU");
+        gpu_ready = true;
+    }
+
+    GpuFrame& frame = gpu_frames[gpu_frame];
+    if (gpu_pass_open || frame.count == max_gpu_passes)
+        return false;
+
+    frame.names[frame.count] = name;
+    frame.starts[frame.count] = now();
+    glBeginQuery(GL_TIME_ELAPSED, frame.queries[frame.count]);
+    gpu_pass_open = true;
+    return true;
+}
+
+// Turns GPU timing on or off, code timing the GPU with its own queries turns it off so the queries do not nest
+void Profiler::setGpuTimingEnabled(bool enabled) {
+    gpu_timing_enabled = enabled;
+}
+
+// Ends timing the current pass of GPU work
+void Profiler::endGpuPass() {
+    glEndQuery(GL_TIME_ELAPSED);
+    gpu_frames[gpu_frame].count++;
+    gpu_pass_open = false;
+}
+
+// Collects the GPU timings of the previous frame, called once per frame after swapping buffers
+void Profiler::endFrame() {
+    if (!gpu_ready)
+        return;
+
+    gpu_frame = 1 - gpu_frame;
+    GpuFrame& frame = gpu_frames[gpu_frame];
+    for (int i = 0; i < frame.count; i++) {
+        // Results that are still not in are dropped instead of waiting on the GPU for them
+        GLint available = 0;
+        glGetQueryObjectiv(frame.queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            continue;
+
+        // Only durations are measured, so passes are placed at the time the CPU submitted them
+        GLuint64 elapsed;
+        glGetQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT, &elapsed);
+        gpu_track->record(frame.names[i], frame.starts[i], frame.starts[i] + (int64_t) elapsed);
+    }
+    frame.count = 0;
+}
+
+// Writes every event still held in the rings as Chrome trace JSON, which Perfetto also opens
+bool Profiler::writeTrace(const std::string& path) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out)
+        return false;
+
+    std::lock_guard<std::mutex> lock(tracks_mutex);
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    for (auto& track : tracks) {
+        out << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << track->id
+            << ",\"args\":{\"name\":";
+        writeJsonString(out, track->name);
+        out << "}}";
+        first = false;
+
+        // Timestamps are in microseconds
+        uint64_t recorded = track->recorded.load(std::memory_order_acquire);
+        uint64_t oldest = recorded > track->events.size() ? recorded - track->events.size() : 0;
+        for (uint64_t i = oldest; i < recorded; i++) {
+            const ProfileEvent& event = track->events[i % track->events.size()];
+            out << ",\n{\"name\":";
+            writeJsonString(out, event.name);
+            out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << track->id << ",\"ts\":" << event.start / 1000.0
+                << ",\"dur\":" << (event.end - event.start) / 1000.0 << '}';
+        }
+    }
+    out << "\n]}\n";
+    return (bool) out;
+}
+
+#endif
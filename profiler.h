@@ -0,0 +1,117 @@
+#pragma once
+
+// Timings are only recorded in builds that define GRAPHIX_PROFILE as 1, otherwise every macro below compiles to nothing
+#ifndef GRAPHIX_PROFILE
+#define GRAPHIX_PROFILE 0
+#endif
+
+#if GRAPHIX_PROFILE
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common.h"
+
+// A timed span of work, in nanoseconds since the profiler started
+struct ProfileEvent {
+    const char* name;
+    int64_t start;
+    int64_t end;
+};
+
+// Events recorded by one thread, the newest ones overwrite the oldest once the ring is full
+struct ProfileTrack {
+    std::string name;
+    int id;
+    std::vector<ProfileEvent> events;
+    // Number of events ever recorded, only the owning thread adds to it
+    std::atomic<uint64_t> recorded;
+
+    ProfileTrack(int id, size_t capacity): id(id), events(capacity), recorded(0) {}
+
+    inline void record(const char* name, int64_t start, int64_t end) {
+        uint64_t index = recorded.load(std::memory_order_relaxed);
+        ProfileEvent& event = events[index % events.size()];
+        event.name = name;
+        event.start = start;
+        event.end = end;
+        recorded.store(index + 1, std::memory_order_release);
+    }
+};
+
+// Records spans of CPU work on every thread and of GPU work on the rendering thread, and writes them as a Chrome trace
+class Profiler {
+public:
+    // Gets the nanoseconds elapsed since the profiler started
+    static int64_t now();
+
+    // Adds an event to the calling thread's track
+    static void record(const char* name, int64_t start, int64_t end);
+
+    // Names the calling thread's track in the trace
+    static void setThreadName(const char* name);
+
+    // Starts and ends timing a pass of GPU work on the calling thread, which must own the GL context
+    // Passes can not be nested, a pass started inside another is only timed on the CPU
+    static bool beginGpuPass(const char* name);
+    static void endGpuPass();
+
+    // Turns GPU timing on or off, code timing the GPU with its own queries turns it off so the queries do not nest
+    static void setGpuTimingEnabled(bool enabled);
+
+    // Collects the GPU timings of the previous frame, called once per frame after swapping buffers
+    static void endFrame();
+
+    // Writes every event still held in the rings as Chrome trace JSON, which Perfetto also opens
+    // Call it from the rendering thread between frames, while no other thread is recording
+    static bool writeTrace(const std::string& path);
+};
+
+// Times the enclosing scope on the CPU
+class ProfileScope {
+public:
+    ProfileScope(const char* name): name(name), start(Profiler::now()) {}
+
+    ~ProfileScope() {
+        Profiler::record(name, start, Profiler::now());
+    }
+
+private:
+    const char* name;
+    int64_t start;
+};
+
+// Times the enclosing scope on both the CPU and the GPU
+class GpuProfileScope {
+public:
+    GpuProfileScope(const char* name): cpu_scope(name), timing_gpu(Profiler::beginGpuPass(name)) {}
+
+    ~GpuProfileScope() {
+        if (timing_gpu)
+            Profiler::endGpuPass();
+    }
+
+private:
+    ProfileScope cpu_scope;
+    bool timing_gpu;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+#define PROFILE_GPU_SCOPE(name) GpuProfileScope PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+#define PROFILE_THREAD(name) Profiler::setThreadName(name)
+#define PROFILE_FRAME() Profiler::endFrame()
+#define PROFILE_GPU_TIMING(enabled) Profiler::setGpuTimingEnabled(enabled)
+
+#else
+
+#define PROFILE_SCOPE(name)
+#define PROFILE_GPU_SCOPE(name)
+#define PROFILE_THREAD(name)
+#define PROFILE_FRAME()
+#define PROFILE_GPU_TIMING(enabled)
+
+#endif
@@ -0,0 +1,122 @@
+#include "replay.h"
+
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+
+#include "timing.h"
+
+// Size at which the buffered records are written out to the file
+static const size_t flush_size = 1 << 16;
+
+// Creates the recording file, returns false if it could not be opened
+bool InputRecorder::open(const std::string& path, double step) {
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        return false;
+
+    ReplayHeader header;
+    memcpy(header.magic, REPLAY_MAGIC, 4);
+    header.version = REPLAY_VERSION;
+    header.step = step;
+    buffer.reserve(flush_size * 2);
+    write(&header, sizeof(header));
+    return true;
+}
+
+// Starts a new frame record, must be followed by exactly frame.steps calls to recordStep
+void InputRecorder::recordFrame(const ReplayFrame& frame) {
+    write(&frame, sizeof(frame));
+}
+
+// Records the events applied in one simulation step
+void InputRecorder::recordStep(const InputEvent* events, size_t count) {
+    uint32_t event_count = (uint32_t) count;
+    write(&event_count, sizeof(event_count));
+    write(events, sizeof(InputEvent) * count);
+}
+
+// Writes any buffered records and closes the file
+void InputRecorder::close() {
+    if (!file.is_open())
+        return;
+    file.write(buffer.data(), buffer.size());
+    buffer.clear();
+    file.close();
+}
+
+// Appends raw bytes to the record buffer, flushing it to the file once it grows large enough
+void InputRecorder::write(const void* data, size_t size) {
+    if (!file.is_open())
+        return;
+    const char* bytes = (const char*) data;
+    buffer.insert(buffer.end(), bytes, bytes + size);
+    if (buffer.size() >= flush_size) {
+        file.write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+}
+
+// Loads a recording file, returns false if it is missing or not a valid recording
+bool InputPlayer::open(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    offset = 0;
+
+    if (!read(&header, sizeof(header)) ||
+        memcmp(header.magic, REPLAY_MAGIC, 4) != 0 ||
+        header.version != REPLAY_VERSION)
+        return false;
+
+    // The step length is handed straight to the simulation, so anything that could not have been recorded is refused
+    if (!std::isfinite(header.step) || header.step <= 0.0) {
+        std::cout << "The recording is corrupt, its simulation step is not a positive length\n";
+        return false;
+    }
+    return true;
+}
+
+// Reads the next frame record, returns false once the recording has ended
+bool InputPlayer::nextFrame(ReplayFrame& frame) {
+    if (!read(&frame, sizeof(frame)))
+        return false;
+
+    // A recorded frame never runs more steps than the fixed timestep allows, nor blends outside the two states
+    if (frame.steps > MAX_STEPS_PER_FRAME || !(frame.alpha >= 0.f && frame.alpha <= 1.f)) {
+        std::cout << "The recording is corrupt, a frame has " << frame.steps << " steps and alpha " << frame.alpha << '\n';
+        offset = data.size();
+        return false;
+    }
+    return true;
+}
+
+// Reads the events of the next simulation step of the current frame, returns how many there are
+size_t InputPlayer::nextStep(const InputEvent*& events) {
+    uint32_t event_count = 0;
+    if (!read(&event_count, sizeof(event_count)))
+        event_count = 0;
+
+    // The count comes from the file, so it is checked against the bytes left before anything is allocated for it
+    if ((uint64_t) event_count * sizeof(InputEvent) > data.size() - offset) {
+        std::cout << "The recording is corrupt, a step has more events than the file holds\n";
+        offset = data.size();
+        event_count = 0;
+    }
+
+    step_events.resize(event_count);
+    read(step_events.data(), sizeof(InputEvent) * event_count);
+    events = step_events.data();
+    return step_events.size();
+}
+
+// Copies the next bytes of the recording, returns false if the recording is too short
+bool InputPlayer::read(void* out, size_t size) {
+    if (data.size() - offset < size)
+        return false;
+    memcpy(out, data.data() + offset, size);
+    offset += size;
+    return true;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "input_queue.h"
+
+// Identifies input recording files and the layout version they were written with
+#define REPLAY_MAGIC "GXRP"
+#define REPLAY_VERSION 1
+
+// Written once at the start of a recording
+struct ReplayHeader {
+    char magic[4];
+    uint32_t version;
+    double step;    // Length in seconds of a simulation step when the recording was made
+};
+
+// Written at the start of every rendered frame, followed by one step record per simulation step
+// Each step record is a uint32_t event count followed by that many InputEvents
+struct ReplayFrame {
+    double time;        // Seconds since the recording started at which the frame began
+    float alpha;        // Interpolation factor the frame was rendered with
+    uint32_t steps;     // Simulation steps run before the frame was rendered
+};
+
+// Writes the input events drained by every simulation step into a compact binary file
+class InputRecorder {
+public:
+    // Creates the recording file, returns false if it could not be opened
+    bool open(const std::string& path, double step);
+
+    // Starts a new frame record, must be followed by exactly frame.steps calls to recordStep
+    void recordFrame(const ReplayFrame& frame);
+
+    // Records the events applied in one simulation step
+    void recordStep(const InputEvent* events, size_t count);
+
+    // Writes any buffered records and closes the file
+    void close();
+
+    ~InputRecorder() {
+        close();
+    }
+
+private:
+    std::ofstream file;
+    // Records are batched in memory so recording does not touch the file every frame
+    std::vector<char> buffer;
+
+    void write(const void* data, size_t size);
+};
+
+// Reads back a recording made by InputRecorder, the whole file is loaded up front so playback does no I/O
+class InputPlayer {
+public:
+    ReplayHeader header;
+
+    InputPlayer(): offset(0) {}
+
+    // Loads a recording file, returns false if it is missing or not a valid recording
+    bool open(const std::string& path);
+
+    // Reads the next frame record, returns false once the recording has ended
+    bool nextFrame(ReplayFrame& frame);
+
+    // Reads the events of the next simulation step of the current frame, returns how many there are
+    size_t nextStep(const InputEvent*& events);
+
+private:
+    std::vector<char> data;
+    size_t offset;
+    // Events are copied out so they are correctly aligned regardless of their position in the file
+    std::vector<InputEvent> step_events;
+
+    bool read(void* out, size_t size);
+};
@@ -0,0 +1,372 @@
+#include "scene.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "startup_timeline.h"
+
+static const size_t record_sizes[SCENE_SECTION_COUNT] {
+    sizeof(SceneMeshRecord), sizeof(SceneTextureRecord), sizeof(SceneMaterialRecord),
+    sizeof(SceneEntityRecord), sizeof(ScenePointLightRecord), 1
+};
+
+static const char* collider_names[] {"sphere", "capsule", "box"};
+
+// Records of a scene read from its text form, before they are laid out as the compiled image
+struct SceneBuilder {
+    SceneHeader header;
+    std::vector<SceneMeshRecord> meshes;
+    std::vector<SceneTextureRecord> textures;
+    std::vector<SceneMaterialRecord> materials;
+    std::vector<SceneEntityRecord> entities;
+    std::vector<ScenePointLightRecord> point_lights;
+    std::string strings;
+
+    SceneBuilder(): strings(1, '\0') {
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, SCENE_MAGIC, 4);
+        header.version = SCENE_VERSION;
+    }
+
+    // Adds a string to the string section, returns its offset
+    uint32_t addString(const std::string& text) {
+        uint32_t offset = (uint32_t) strings.size();
+        strings += text;
+        strings += '\0';
+        return offset;
+    }
+
+    // Finds a mesh or material by name, returns false if there is none
+    template<typename Record>
+    bool find(const std::vector<Record>& records, const std::string& name, uint32_t& index) {
+        for (size_t i = 0; i < records.size(); i++) {
+            if (name == strings.c_str() + records[i].name) {
+                index = (uint32_t) i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Appends a section to the image, aligned to 4 bytes
+    template<typename Record>
+    void addSection(std::vector<char>& data, SceneSection section, const Record* records, size_t count) {
+        data.resize((data.size() + 3) & ~(size_t) 3);
+        header.offsets[section] = (uint32_t) data.size();
+        header.counts[section] = (uint32_t) count;
+        const char* bytes = (const char*) records;
+        data.insert(data.end(), bytes, bytes + count * sizeof(Record));
+    }
+
+    // Lays out the compiled image
+    std::vector<char> pack() {
+        std::vector<char> data(sizeof(SceneHeader));
+        addSection(data, SCENE_MESHES, meshes.data(), meshes.size());
+        addSection(data, SCENE_TEXTURES, textures.data(), textures.size());
+        addSection(data, SCENE_MATERIALS, materials.data(), materials.size());
+        addSection(data, SCENE_ENTITIES, entities.data(), entities.size());
+        addSection(data, SCENE_POINT_LIGHTS, point_lights.data(), point_lights.size());
+        addSection(data, SCENE_STRINGS, strings.data(), strings.size());
+        memcpy(data.data(), &header, sizeof(header));
+        return data;
+    }
+};
+
+// Reads count floats, returns false if there are not enough of them
+static bool readFloats(std::istream& in, float* values, int count) {
+    for (int i = 0; i < count; i++) {
+        if (!(in >> values[i]))
+            return false;
+    }
+    return true;
+}
+
+SceneFile::SceneFile():
+    header(NULL), meshes(NULL), textures(NULL), materials(NULL), entities(NULL), point_lights(NULL), strings(NULL) {}
+
+// Reads a scene in either form, telling them apart by the magic of the compiled form
+bool SceneFile::load(const std::string& path) {
+    char magic[4] = {};
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cout << "Could not open the scene " << path << '\n';
+        return false;
+    }
+    file.read(magic, 4);
+    file.close();
+    return memcmp(magic, SCENE_MAGIC, 4) == 0 ? loadCompiled(path) : loadText(path);
+}
+
+// Reads the text form, reporting the first error with its line
+bool SceneFile::loadText(const std::string& path) {
+    StartupScope step("Parse scene", path);
+    std::ifstream file(path);
+    if (!file) {
+        std::cout << "Could not open the scene " << path << '\n';
+        return false;
+    }
+
+    SceneBuilder builder;
+    bool has_player = false, has_sun = false, has_skybox = false;
+    std::string line;
+    int line_number = 0;
+    while (std::getline(file, line)) {
+        line_number++;
+        step.bytes_read += line.size() + 1;
+        line = line.substr(0, line.find('#'));
+        std::istringstream in(line);
+        std::string kind;
+        if (!(in >> kind))
+            continue;
+
+        // Reports an error at the current line
+        auto fail = [&](const std::string& message) {
+            std::cout << path << ':' << line_number << ": " << message << '\n';
+            return false;
+        };
+
+        if (kind == "mesh") {
+            std::string name, mesh_path;
+            if (!(in >> name >> mesh_path))
+                return fail("expected mesh <name> <obj path>");
+            builder.meshes.push_back({builder.addString(name), builder.addString(mesh_path)});
+        }
+        else if (kind == "material") {
+            std::string name, texture_path;
+            if (!(in >> name))
+                return fail("expected material <name> <texture path>...");
+            SceneMaterialRecord material {builder.addString(name), (uint32_t) builder.textures.size(), 0};
+            while (in >> texture_path) {
+                builder.textures.push_back({builder.addString(texture_path)});
+                material.texture_count++;
+            }
+            if (material.texture_count == 0)
+                return fail("material " + name + " has no textures");
+            builder.materials.push_back(material);
+        }
+        else if (kind == "entity" || kind == "player") {
+            std::string name, mesh, material, collider;
+            if (kind == "entity" && !(in >> name))
+                return fail("expected entity <name> <mesh> <material> <collider> <position> <rotation> <scale>");
+            if (!(in >> mesh >> material))
+                return fail("expected the names of a mesh and a material");
+
+            uint32_t mesh_index, material_index;
+            if (!builder.find(builder.meshes, mesh, mesh_index))
+                return fail("no mesh named " + mesh + " before this line");
+            if (!builder.find(builder.materials, material, material_index))
+                return fail("no material named " + material + " before this line");
+
+            if (kind == "entity") {
+                SceneEntityRecord entity;
+                entity.name = builder.addString(name);
+                entity.mesh = mesh_index;
+                entity.material = material_index;
+                if (!(in >> collider))
+                    return fail("expected a collider of sphere, capsule or box");
+                entity.collider = 3;
+                for (uint32_t i = 0; i < 3; i++) {
+                    if (collider == collider_names[i])
+                        entity.collider = i;
+                }
+                if (entity.collider == 3)
+                    return fail("unknown collider " + collider + ", expected sphere, capsule or box");
+                if (!readFloats(in, entity.pos, 3) || !readFloats(in, entity.rot, 3) || !readFloats(in, entity.scale, 3))
+                    return fail("expected a position, rotation and scale of 3 numbers each");
+                builder.entities.push_back(entity);
+            }
+            else {
+                ScenePlayerRecord& player = builder.header.player;
+                player.mesh = mesh_index;
+                player.material = material_index;
+                if (!readFloats(in, player.spawn, 3) || !readFloats(in, player.rot, 3) || !readFloats(in, player.scale, 3) ||
+                    !readFloats(in, &player.rot_offset, 1) || !readFloats(in, &player.point_offset, 1))
+                    return fail("expected player <mesh> <material> <spawn> <rotation> <scale> <rotation offset> <light offset>");
+                has_player = true;
+            }
+        }
+        else if (kind == "point_light") {
+            ScenePointLightRecord light;
+            if (!readFloats(in, light.pos, 3) || !readFloats(in, light.color, 3) || !readFloats(in, &light.strength, 1) ||
+                !readFloats(in, &light.ambient_str, 1) || !readFloats(in, &light.spec_str, 1) || !readFloats(in, &light.spec_phong, 1))
+                return fail("expected point_light <position> <color> <strength> <ambient> <specular> <phong>");
+            builder.point_lights.push_back(light);
+        }
+        else if (kind == "direction_light") {
+            SceneDirectionLightRecord& sun = builder.header.sun;
+            if (!readFloats(in, sun.pos, 3) || !readFloats(in, sun.diff_color, 3) || !readFloats(in, &sun.ambient_str, 1) ||
+                !readFloats(in, sun.ambient_color, 3) || !readFloats(in, &sun.spec_str, 1) || !readFloats(in, &sun.spec_phong, 1) ||
+                !readFloats(in, &sun.intensity, 1))
+                return fail("expected direction_light <position> <color> <ambient> <ambient color> <specular> <phong> <intensity>");
+            has_sun = true;
+        }
+        else if (kind == "skybox") {
+            for (int i = 0; i < 6; i++) {
+                std::string face;
+                if (!(in >> face))
+                    return fail("expected skybox <right> <left> <up> <down> <front> <back>");
+                builder.header.skybox_faces[i] = builder.addString(face);
+            }
+            has_skybox = true;
+        }
+        else
+            return fail("unknown record " + kind);
+    }
+
+    if (!has_player || !has_sun || !has_skybox) {
+        std::cout << path << ": a scene needs a player, a direction_light and a skybox\n";
+        return false;
+    }
+
+    data = builder.pack();
+    step.bytes_produced = data.size();
+    return bind(path);
+}
+
+// Reads the compiled form, the whole file is read in one go and used in place
+bool SceneFile::loadCompiled(const std::string& path) {
+    StartupScope step("Load compiled scene", path);
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        std::cout << "Could not open the scene " << path << '\n';
+        return false;
+    }
+    std::streamoff size = file.tellg();
+    file.seekg(0);
+    data.resize((size_t) std::max(size, (std::streamoff) 0));
+    if (!file.read(data.data(), data.size())) {
+        std::cout << "Could not read the scene " << path << '\n';
+        return false;
+    }
+    step.bytes_read = step.bytes_produced = data.size();
+    return bind(path);
+}
+
+// Writes the compiled form
+bool SceneFile::saveCompiled(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(data.data(), data.size());
+    return (bool) file;
+}
+
+// Checks the image in data and points the records into it
+bool SceneFile::bind(const std::string& path) {
+    header = NULL;
+    const SceneHeader* image = (const SceneHeader*) data.data();
+    if (data.size() < sizeof(SceneHeader) || memcmp(image->magic, SCENE_MAGIC, 4) != 0 || image->version != SCENE_VERSION) {
+        std::cout << path << " is not a scene of version " << SCENE_VERSION << '\n';
+        return false;
+    }
+
+    // Every section must be aligned and lie within the file, and the strings must end in a terminator
+    for (int section = 0; section < SCENE_SECTION_COUNT; section++) {
+        uint64_t end = (uint64_t) image->offsets[section] + (uint64_t) image->counts[section] * record_sizes[section];
+        if (image->offsets[section] % 4 != 0 || end > data.size()) {
+            std::cout << path << " is corrupt, section " << section << " is out of bounds\n";
+            return false;
+        }
+    }
+    uint32_t string_bytes = image->counts[SCENE_STRINGS];
+    strings = data.data() + image->offsets[SCENE_STRINGS];
+    if (string_bytes == 0 || strings[string_bytes - 1] != '\0') {
+        std::cout << path << " is corrupt, its strings are not terminated\n";
+        return false;
+    }
+
+    meshes = (const SceneMeshRecord*) (data.data() + image->offsets[SCENE_MESHES]);
+    textures = (const SceneTextureRecord*) (data.data() + image->offsets[SCENE_TEXTURES]);
+    materials = (const SceneMaterialRecord*) (data.data() + image->offsets[SCENE_MATERIALS]);
+    entities = (const SceneEntityRecord*) (data.data() + image->offsets[SCENE_ENTITIES]);
+    point_lights = (const ScenePointLightRecord*) (data.data() + image->offsets[SCENE_POINT_LIGHTS]);
+
+    // References between records are checked once here, so using the scene needs no checks
+    uint32_t mesh_count = image->counts[SCENE_MESHES];
+    uint32_t material_count = image->counts[SCENE_MATERIALS];
+    bool valid = image->player.mesh < mesh_count && image->player.material < material_count;
+    for (int i = 0; i < 6; i++)
+        valid = valid && image->skybox_faces[i] < string_bytes;
+    for (uint32_t i = 0; i < mesh_count; i++)
+        valid = valid && meshes[i].name < string_bytes && meshes[i].path < string_bytes;
+    for (uint32_t i = 0; i < image->counts[SCENE_TEXTURES]; i++)
+        valid = valid && textures[i].path < string_bytes;
+    for (uint32_t i = 0; i < material_count; i++) {
+        valid = valid && materials[i].name < string_bytes && materials[i].texture_count > 0 &&
+            (uint64_t) materials[i].first_texture + materials[i].texture_count <= image->counts[SCENE_TEXTURES];
+    }
+    for (uint32_t i = 0; i < image->counts[SCENE_ENTITIES]; i++) {
+        const SceneEntityRecord& entity = entities[i];
+        valid = valid && entity.name < string_bytes && entity.mesh < mesh_count && entity.material < material_count &&
+            entity.collider <= COLLIDER_BOX;
+    }
+    if (!valid) {
+        std::cout << path << " is corrupt, a record refers to something that is not there\n";
+        return false;
+    }
+
+    header = image;
+    return true;
+}
+
+// Loads the meshes and textures of a scene through the cache and creates its entities, in the order of the file
+void Scene::instantiate(const SceneFile& file, AssetCache& assets, EntityStore& entities) {
+    mesh_ids.clear();
+    for (uint32_t i = 0; i < file.getCount(SCENE_MESHES); i++)
+        mesh_ids.push_back(entities.addMesh(assets.getMesh(file.getString(file.meshes[i].path))));
+
+    // Entities refer to the texture lists of materials, so the list of them must never grow after this
+    materials.clear();
+    materials.reserve(file.getCount(SCENE_MATERIALS));
+    material_ids.clear();
+    for (uint32_t i = 0; i < file.getCount(SCENE_MATERIALS); i++) {
+        const SceneMaterialRecord& record = file.materials[i];
+        materials.emplace_back();
+        for (uint32_t t = 0; t < record.texture_count; t++) {
+            materials.back().push_back(assets.getTexture(file.getString(file.textures[record.first_texture + t].path)));
+            materials.back().back().tex_unit = (int) t;
+        }
+        material_ids.push_back(entities.addMaterial(materials.back()));
+    }
+
+    // Every entity goes straight from its record into the store's arrays, which are grown once up front
+    uint32_t entity_count = file.getCount(SCENE_ENTITIES);
+    entities.reserve(entities.size() + entity_count);
+    for (uint32_t i = 0; i < entity_count; i++) {
+        const SceneEntityRecord& entity = file.entities[i];
+        entities.create(mesh_ids[entity.mesh], material_ids[entity.material],
+            glm::make_vec3(entity.pos), glm::make_vec3(entity.rot), glm::make_vec3(entity.scale));
+    }
+
+    point_lights.clear();
+    point_lights.reserve(file.getCount(SCENE_POINT_LIGHTS));
+    for (uint32_t i = 0; i < file.getCount(SCENE_POINT_LIGHTS); i++) {
+        const ScenePointLightRecord& light = file.point_lights[i];
+        point_lights.push_back(PointLight(light.strength, glm::make_vec3(light.pos), glm::make_vec3(light.color),
+            light.ambient_str, light.spec_str, light.spec_phong));
+    }
+}
+
+// Gets the model of the submarine the player drives, instantiate must have been called first
+Model3D Scene::makePlayerModel(const SceneFile& file, AssetCache& assets) {
+    const ScenePlayerRecord& player = file.header->player;
+    return Model3D {
+        assets.getMesh(file.getString(file.meshes[player.mesh].path)),
+        materials[player.material],
+        glm::make_vec3(player.spawn),
+        glm::make_vec3(player.rot),
+        glm::make_vec3(player.scale)
+    };
+}
+
+DirectionLight Scene::makeDirectionLight(const SceneFile& file) {
+    const SceneDirectionLightRecord& sun = file.header->sun;
+    return DirectionLight(glm::make_vec3(sun.pos), glm::make_vec3(sun.diff_color), sun.ambient_str,
+        glm::make_vec3(sun.ambient_color), sun.spec_str, sun.spec_phong, sun.intensity);
+}
+
+// Gets the collider shape of the entity at an index of the file
+ColliderShape Scene::getCollider(const SceneFile& file, uint32_t entity) {
+    return (ColliderShape) file.entities[entity].collider;
+}
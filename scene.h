@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common.h"
+#include "asset_cache.h"
+#include "collision.h"
+#include "entity.h"
+#include "light.h"
+#include "model.h"
+
+// Identifies compiled scene files and the layout version they were written with
+#define SCENE_MAGIC "GXSC"
+#define SCENE_VERSION 1
+
+// Arrays of records a compiled scene is made of, after its header
+enum SceneSection {
+    SCENE_MESHES,
+    SCENE_TEXTURES,
+    SCENE_MATERIALS,
+    SCENE_ENTITIES,
+    SCENE_POINT_LIGHTS,
+    SCENE_STRINGS,      // Null terminated strings the other records refer to by offset, starting with an empty one
+    SCENE_SECTION_COUNT
+};
+
+// Every record is made of 4 byte fields so the file can be used in place once it is read
+struct SceneMeshRecord {
+    uint32_t name;
+    uint32_t path;
+};
+
+// A texture of a material, bound to the tex_unit of its position in the material
+struct SceneTextureRecord {
+    uint32_t path;
+};
+
+struct SceneMaterialRecord {
+    uint32_t name;
+    uint32_t first_texture;
+    uint32_t texture_count;
+};
+
+// A creature of the scene, rotations are XYZ euler angles in degrees like Model3D
+struct SceneEntityRecord {
+    uint32_t name;
+    uint32_t mesh;
+    uint32_t material;
+    uint32_t collider;
+    float pos[3];
+    float rot[3];
+    float scale[3];
+};
+
+struct ScenePointLightRecord {
+    float pos[3];
+    float color[3];
+    float strength;
+    float ambient_str;
+    float spec_str;
+    float spec_phong;
+};
+
+struct SceneDirectionLightRecord {
+    float pos[3];
+    float diff_color[3];
+    float ambient_str;
+    float ambient_color[3];
+    float spec_str;
+    float spec_phong;
+    float intensity;
+};
+
+// The submarine the player drives and where it starts out
+struct ScenePlayerRecord {
+    uint32_t mesh;
+    uint32_t material;
+    float spawn[3];
+    float rot[3];
+    float scale[3];
+    float rot_offset;
+    float point_offset;
+};
+
+// Start of a compiled scene, the sections follow it in any order
+struct SceneHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t offsets[SCENE_SECTION_COUNT];
+    uint32_t counts[SCENE_SECTION_COUNT];
+    SceneDirectionLightRecord sun;
+    ScenePlayerRecord player;
+    uint32_t skybox_faces[6];
+};
+
+// A scene description, read from its text form for authoring or its compiled form for loading
+// Either way the scene ends up as the compiled image in one buffer, and the records point into it
+class SceneFile {
+public:
+    const SceneHeader* header;
+    const SceneMeshRecord* meshes;
+    const SceneTextureRecord* textures;
+    const SceneMaterialRecord* materials;
+    const SceneEntityRecord* entities;
+    const ScenePointLightRecord* point_lights;
+
+    SceneFile();
+
+    // Reads a scene in either form, telling them apart by the magic of the compiled form
+    bool load(const std::string& path);
+
+    // Reads the text form, reporting the first error with its line
+    bool loadText(const std::string& path);
+
+    // Reads the compiled form, the whole file is read in one go and used in place
+    bool loadCompiled(const std::string& path);
+
+    // Writes the compiled form
+    bool saveCompiled(const std::string& path) const;
+
+    inline uint32_t getCount(SceneSection section) const {
+        return header->counts[section];
+    }
+
+    // Gets a string the records refer to
+    inline const char* getString(uint32_t offset) const {
+        return strings + offset;
+    }
+
+private:
+    std::vector<char> data;
+    const char* strings;
+
+    // Checks the image in data and points the records into it
+    bool bind(const std::string& path);
+};
+
+// The materials, entities and lights a scene file made, materials are kept here since entities and models only refer to them
+class Scene {
+public:
+    std::vector<std::vector<Texture>> materials;
+    // Ids the scene's meshes and materials were given by the entity store, by their index in the file
+    std::vector<uint32_t> mesh_ids;
+    std::vector<uint32_t> material_ids;
+    std::vector<PointLight> point_lights;
+
+    // Loads the meshes and textures of a scene through the cache and creates its entities, in the order of the file
+    void instantiate(const SceneFile& file, AssetCache& assets, EntityStore& entities);
+
+    // Gets the model of the submarine the player drives, instantiate must have been called first
+    Model3D makePlayerModel(const SceneFile& file, AssetCache& assets);
+
+    static DirectionLight makeDirectionLight(const SceneFile& file);
+
+    // Gets the collider shape of the entity at an index of the file
+    static ColliderShape getCollider(const SceneFile& file, uint32_t entity);
+};
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// Runtime options of the program, parsed from the command line
+struct Settings {
+    // Whether buffer swaps wait for the display's vertical sync, otherwise frames are rendered uncapped
+    bool vsync;
+    // Whether frame timing statistics are also printed to the console
+    bool print_stats;
+    // Whether the window is kept hidden, for unattended runs such as replays
+    bool headless;
+    // File the input of the session is recorded to, empty if not recording
+    std::string record_path;
+    // Recording whose input drives the session instead of the user, empty if not replaying
+    std::string replay_path;
+    // CSV file the timing of every frame is written to, empty if not needed
+    std::string timing_path;
+    // Name of the benchmark to run instead of the program, empty if not benchmarking
+    std::string bench_name;
+    // CSV file the benchmark results are written to, they are only printed if empty
+    std::string bench_out;
+    // Number of fish in the schools swimming around the scene
+    int fish_count;
+    // Whether the fish are simulated by compute shaders instead of the CPU, needs OpenGL 4.3
+    bool gpu_boids;
+    // File the profiler's Chrome trace is written to on exit, empty if not needed, only used by profiling builds
+    std::string profile_path;
+    // JSON file the timeline of startup is written to once the first frame is about to start, empty if not needed
+    std::string startup_report_path;
+    // Whether the program exits as soon as it has started up, for timing startup on its own
+    bool startup_only;
+    // Scene file loaded at startup, in its text or compiled form
+    std::string scene_path;
+    // File the scene is compiled to instead of running the program, empty if not compiling
+    std::string compiled_scene_path;
+    // Asset pack read from in place of the loose files it holds, used only if it exists
+    std::string pack_path;
+    // File a new asset pack is built to instead of running the program, empty if not building one
+    std::string built_pack_path;
+    // Whether the pack being built stores every asset as is, so each one is read as a slice of the mapping
+    bool pack_uncompressed;
+    // Seed of the scenes generated by the stress benchmark
+    uint32_t scene_seed;
+    // Path the camera follows through generated scenes, orbit, flythrough or static
+    std::string camera_path;
+    // Largest number of copies of each mesh and of lights the stress benchmark goes up to
+    int stress_copies;
+    int stress_lights;
+    // Whether the scene is drawn into a G-buffer and lit in one pass over the screen instead of lit as it is drawn
+    bool deferred;
+    // Whether the direction light casts shadows through a cascaded shadow map
+    bool shadows;
+    // Whether the depth of the scene is drawn before it is shaded, so each pixel is shaded once
+    bool depth_prepass;
+    // Whether entities hidden behind the largest ones in view are culled on the CPU before they are drawn
+    bool occlusion_culling;
+    // Whether the entities are culled against the frustum and the depth of the last frame on the GPU and drawn with indirect draws
+    bool gpu_culling;
+
+    Settings(): vsync(true), print_stats(false), headless(false), fish_count(2000), gpu_boids(false), startup_only(false),
+        scene_path("Scenes/ocean.scene"), pack_path("assets.pack"), pack_uncompressed(false), scene_seed(1), camera_path("orbit"), stress_copies(256), stress_lights(1024), deferred(false), shadows(true), depth_prepass(false),
+        occlusion_culling(false), gpu_culling(false) {}
+
+    // Reads the options given through the command line arguments
+    Settings(int argc, char** argv): Settings() {
+        for (int i = 1; i < argc; i++) {
+            if (strcmp(argv[i], "--no-vsync") == 0)
+                vsync = false;
+            else if (strcmp(argv[i], "--stats") == 0)
+                print_stats = true;
+            else if (strcmp(argv[i], "--headless") == 0)
+                headless = true;
+            else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+                record_path = argv[++i];
+            else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+                replay_path = argv[++i];
+            else if (strcmp(argv[i], "--timing") == 0 && i + 1 < argc)
+                timing_path = argv[++i];
+            else if (strcmp(argv[i], "--bench") == 0 && i + 1 < argc)
+                bench_name = argv[++i];
+            else if (strcmp(argv[i], "--bench-out") == 0 && i + 1 < argc)
+                bench_out = argv[++i];
+            else if (strcmp(argv[i], "--fish") == 0 && i + 1 < argc)
+                fish_count = std::max(atoi(argv[++i]), 0);
+            else if (strcmp(argv[i], "--boids") == 0 && i + 1 < argc)
+                gpu_boids = strcmp(argv[++i], "gpu") == 0;
+            else if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc)
+                profile_path = argv[++i];
+            else if (strcmp(argv[i], "--startup-report") == 0 && i + 1 < argc)
+                startup_report_path = argv[++i];
+            else if (strcmp(argv[i], "--startup-only") == 0)
+                startup_only = true;
+            else if (strcmp(argv[i], "--scene") == 0 && i + 1 < argc)
+                scene_path = argv[++i];
+            else if (strcmp(argv[i], "--compile-scene") == 0 && i + 1 < argc)
+                compiled_scene_path = argv[++i];
+            else if (strcmp(argv[i], "--pack") == 0 && i + 1 < argc)
+                pack_path = argv[++i];
+            else if (strcmp(argv[i], "--build-pack") == 0 && i + 1 < argc)
+                built_pack_path = argv[++i];
+            else if (strcmp(argv[i], "--pack-uncompressed") == 0)
+                pack_uncompressed = true;
+            else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+                scene_seed = (uint32_t) strtoul(argv[++i], NULL, 10);
+            else if (strcmp(argv[i], "--camera-path") == 0 && i + 1 < argc)
+                camera_path = argv[++i];
+            else if (strcmp(argv[i], "--copies") == 0 && i + 1 < argc)
+                stress_copies = std::max(atoi(argv[++i]), 1);
+            else if (strcmp(argv[i], "--lights") == 0 && i + 1 < argc)
+                stress_lights = std::max(atoi(argv[++i]), 0);
+            else if (strcmp(argv[i], "--renderer") == 0 && i + 1 < argc)
+                deferred = strcmp(argv[++i], "deferred") == 0;
+            else if (strcmp(argv[i], "--no-shadows") == 0)
+                shadows = false;
+            else if (strcmp(argv[i], "--depth-prepass") == 0)
+                depth_prepass = true;
+            else if (strcmp(argv[i], "--occlusion") == 0)
+                occlusion_culling = true;
+            else if (strcmp(argv[i], "--gpu-culling") == 0)
+                gpu_culling = true;
+        }
+    }
+};
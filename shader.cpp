@@ -1,6 +1,11 @@
 #pragma once
 
 #include "shader.h"
+#include "particles.h"
+#include "gbuffer.h"
+#include "post_process.h"
+#include "gpu_culling.h"
+#include "profiler.h"
 
 // Pass a transform matrix for the shader to use
 void Shader::setTransform(glm::mat4& transformation_matrix) {
@@ -20,30 +25,99 @@ void Shader::setProjection(glm::mat4& projection_matrix) {
     glUniformMatrix4fv(projection_loc, 1, GL_FALSE, glm::value_ptr(projection_matrix));
 }
 
-// Render a skybox object
+// Compiles one stage of a shader from its code, timed as a step of startup
+GLuint Shader::compileStage(GLenum type, const char* path, const char* code, size_t code_size) {
+    StartupScope step("Compile shader", path);
+    GLuint shader = glCreateShader(type);
+    // Sources sliced from the asset pack are not null terminated, so their length is passed along
+    GLint length = (GLint) code_size;
+    glShaderSource(shader, 1, &code, &length);
+    glCompileShader(shader);
+
+    // Asking for the status waits for drivers that compile in the background, so the step covers the whole compile
+    GLint compiled;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+    step.bytes_read = code_size;
+    return shader;
+}
+
+// Waits for a program to finish linking, since drivers may build it in the background, and gets the size of its binary
+uint64_t Shader::waitForLink(GLuint program) {
+    GLint linked;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+
+    // Program binaries can only be asked for since OpenGL 4.1
+    GLint binary_size = 0;
+    if (linked && GLAD_GL_VERSION_4_1)
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binary_size);
+    return (uint64_t) binary_size;
+}
+
+// Pass an integer variable for the shader to use
+void ComputeShader::setInt(const char* name, GLint value) {
+    glUseProgram(shader_program);
+    glUniform1i(glGetUniformLocation(shader_program, name), value);
+}
+
+// Pass an unsigned integer variable for the shader to use
+void ComputeShader::setUint(const char* name, GLuint value) {
+    glUseProgram(shader_program);
+    glUniform1ui(glGetUniformLocation(shader_program, name), value);
+}
+
+// Pass a float variable for the shader to use
+void ComputeShader::setFloat(const char* name, float value) {
+    glUseProgram(shader_program);
+    glUniform1f(glGetUniformLocation(shader_program, name), value);
+}
+
+// Pass a vector variable for the shader to use
+void ComputeShader::setVec3(const char* name, glm::vec3 value) {
+    glUseProgram(shader_program);
+    glUniform3fv(glGetUniformLocation(shader_program, name), 1, glm::value_ptr(value));
+}
+
+// Pass an integer vector variable for the shader to use
+void ComputeShader::setIvec2(const char* name, glm::ivec2 value) {
+    glUseProgram(shader_program);
+    glUniform2iv(glGetUniformLocation(shader_program, name), 1, glm::value_ptr(value));
+}
+
+// Pass an array of vectors for the shader to use
+void ComputeShader::setVec4Array(const char* name, const glm::vec4* values, int count) {
+    glUseProgram(shader_program);
+    glUniform4fv(glGetUniformLocation(shader_program, name), count, glm::value_ptr(values[0]));
+}
+
+// Pass a matrix variable for the shader to use
+void ComputeShader::setMat4(const char* name, const glm::mat4& value) {
+    glUseProgram(shader_program);
+    glUniformMatrix4fv(glGetUniformLocation(shader_program, name), 1, GL_FALSE, glm::value_ptr(value));
+}
+
+// Render a skybox object behind everything drawn so far, only the pixels left at the far plane are shaded
 void SkyboxShader::render(Skybox& skybox, Camera& camera) {
-    // Temporarily disable depth testing
+    PROFILE_GPU_SCOPE("Skybox");
+    // The triangle sits at depth 1, so it passes only where the depth buffer is still cleared and never needs writing
     glDepthMask(GL_FALSE);
     glDepthFunc(GL_LEQUAL);
-    
-    glUseProgram(shader_program);
 
-    // Get the given skybox view and projection matrix
-    glm::mat4 skybox_view = skybox.getSkyblockViewMatrix(camera);
-    glm::mat4 projection_matrix = camera.getProjectionMatrix();
+    glUseProgram(shader_program);
 
-    // Pass variables to shader
-    setProjection(projection_matrix);
-    setView(skybox_view);
+    // Each pixel's view ray is rebuilt from the inverse of the camera's matrices, translation included
+    glm::mat4 inverse_view_projection = glm::inverse(camera.getProjectionMatrix() * camera.getViewMatrix());
+    glUniformMatrix4fv(glGetUniformLocation(shader_program, "inverse_view_projection"), 1, GL_FALSE, glm::value_ptr(inverse_view_projection));
+    glUniform3fv(glGetUniformLocation(shader_program, "camera_pos"), 1, glm::value_ptr(camera.camera_pos));
 
     // Pass the texture to the shader
-    glBindVertexArray(skybox.skybox_vao);
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_CUBE_MAP, skybox.skybox_tex);
+    glUniform1i(glGetUniformLocation(shader_program, "skybox"), 0);
 
-    glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
+    glBindVertexArray(empty_vao);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
 
-    // Temporarily reenable depth testing
+    // Reenable depth writes and the default depth test
     glDepthMask(GL_TRUE);
     glDepthFunc(GL_LESS);
 }
@@ -84,6 +158,10 @@ void TexLightingShader::setPointLight(PointLight& light_source, glm::vec3& camer
 
     unsigned int quadratic_loc = glGetUniformLocation(shader_program, "quadratic");
     glUniform1f(quadratic_loc, light_source.quadratic);
+
+    // Slot of the point shadow atlas the light's shadows are in, which must be bound when it has one
+    glUniform1i(glGetUniformLocation(shader_program, "plight_shadow_slot"), light_source.shadow_slot);
+    glUniform1f(glGetUniformLocation(shader_program, "plight_shadow_range"), light_source.getShadowRange());
 }
 
 // Pass a direction light for the shader to use
@@ -104,9 +182,6 @@ void TexLightingShader::setDirectionLight(DirectionLight& light_source, glm::vec
     unsigned int dlight_amb_str_loc = glGetUniformLocation(shader_program, "dlight_amb_str");
     glUniform1f(dlight_amb_str_loc, light_source.ambient_str);
 
-    unsigned int dlight_amb_color_loc = glGetUniformLocation(shader_program, "dlight_amb_color");
-    glUniform3fv(dlight_amb_color_loc, 1, glm::value_ptr(light_source.ambient_color));
-
     unsigned int dlight_spec_str_loc = glGetUniformLocation(shader_program, "dlight_spec_str");
     glUniform1f(dlight_spec_str_loc, light_source.spec_str);
 
@@ -114,17 +189,37 @@ void TexLightingShader::setDirectionLight(DirectionLight& light_source, glm::vec
     glUniform1f(dlight_spec_phong_loc, light_source.spec_phong);
 }
 
-void TexLightingShader::setColor(bool use_color, glm::vec4& tex) {
-    unsigned int use_color_loc = glGetUniformLocation(shader_program, "use_color");
-    glUniform1i(use_color_loc, use_color);
+// Pass the froxel grid of the frame, whose point lights are added on top of the main one, the clusters must be bound
+void TexLightingShader::setLightClusters(const LightClusters& clusters) {
+    glUseProgram(shader_program);
+    glm::vec2 depth(clusters.depth_scale, clusters.depth_bias);
+    glUniform3fv(glGetUniformLocation(shader_program, "cluster_forward"), 1, glm::value_ptr(clusters.view_forward));
+    glUniform2fv(glGetUniformLocation(shader_program, "cluster_depth"), 1, glm::value_ptr(depth));
+    glUniform2fv(glGetUniformLocation(shader_program, "cluster_tile_scale"), 1, glm::value_ptr(clusters.tile_scale));
+}
 
-    unsigned int color_loc = glGetUniformLocation(shader_program, "color");
-    glUniform4fv(color_loc, 1, glm::value_ptr(tex));
+// Pass the cascades of the direction light's shadow map, which must be bound, shadows are left out until this is called
+void TexLightingShader::setShadowMap(const CascadedShadowMap& shadow_map) {
+    glUseProgram(shader_program);
+    glm::mat4 matrices[SHADOW_CASCADES];
+    for (int cascade = 0; cascade < SHADOW_CASCADES; cascade++)
+        matrices[cascade] = shadow_map.light_projections[cascade] * shadow_map.light_views[cascade];
+    glUniform1i(glGetUniformLocation(shader_program, "shadow_cascades"), SHADOW_CASCADES);
+    glUniform3fv(glGetUniformLocation(shader_program, "shadow_forward"), 1, glm::value_ptr(shadow_map.view_forward));
+    glUniformMatrix4fv(glGetUniformLocation(shader_program, "shadow_matrices"), SHADOW_CASCADES, GL_FALSE, glm::value_ptr(matrices[0]));
+    glUniform4fv(glGetUniformLocation(shader_program, "shadow_splits"), 1, shadow_map.split_depths);
+    glUniform4fv(glGetUniformLocation(shader_program, "shadow_texel_sizes"), 1, shadow_map.texel_sizes);
+}
+
+// Pass the light the sky sheds from every side, which stands in for the direction light's flat ambient color
+void TexLightingShader::setSkyLighting(const SkyLighting& sky) {
+    glUseProgram(shader_program);
+    glUniform3fv(glGetUniformLocation(shader_program, "sky_sh"), SKY_SH_COEFFICIENTS, glm::value_ptr(sky.coefficients[0]));
 }
 
 // Render a model 3d object with lighting and texture
-void TexLightingShader::render(Model3D& object, Camera& camera, PointLight& point_light,
-    DirectionLight& dir_light, glm::vec4 color) {
+void TexLightingShader::render(Model3D& object, Camera& camera, PointLight& point_light, DirectionLight& dir_light) {
+    PROFILE_GPU_SCOPE("Lit model");
     glUseProgram(shader_program);
 
     // Get transformation, projection, and view matrixes
@@ -139,10 +234,6 @@ void TexLightingShader::render(Model3D& object, Camera& camera, PointLight& poin
     setTransform(transformation);
     setProjection(projection);
     setView(view);
-    if (color.x != -1 && color.y != -1 && color.z != -1)
-        setColor(true, color);
-    else
-        setColor(false, color);
     setTexture(object.textures[0]); // For the moment, only the first value will be used as the base texture
     setPointLight(point_light, camera.camera_pos);
     setDirectionLight(dir_light, camera.camera_pos);
@@ -151,6 +242,106 @@ void TexLightingShader::render(Model3D& object, Camera& camera, PointLight& poin
     glDrawArrays(GL_TRIANGLES, 0, object.vertex_attribs.count);
 }
 
+// Render the entities of a list of draw packets with lighting and texture
+void TexLightingShader::render(EntityStore& entities, const std::vector<DrawPacket>& packets, Camera& camera,
+    PointLight& point_light, DirectionLight& dir_light) {
+    PROFILE_GPU_SCOPE("Lit entities");
+    glUseProgram(shader_program);
+
+    // Get projection and view matrixes
+    glm::mat4 projection = camera.getProjectionMatrix();
+    glm::mat4 view = camera.getViewMatrix();
+
+    // Pass variables shared by every entity to shader
+    setProjection(projection);
+    setView(view);
+    setPointLight(point_light, camera.camera_pos);
+    setDirectionLight(dir_light, camera.camera_pos);
+
+    // Packets are sorted by material and mesh, so only rebind them when they change
+    GLint transformation_loc = glGetUniformLocation(shader_program, "transform");
+    uint32_t bound_mesh = UINT32_MAX;
+    uint32_t bound_material = UINT32_MAX;
+    for (const DrawPacket& packet : packets) {
+        uint32_t entity = packet.entity;
+        VertexAttribs* mesh = entities.meshes[entities.mesh_ids[entity]];
+        if (entities.mesh_ids[entity] != bound_mesh) {
+            bound_mesh = entities.mesh_ids[entity];
+            glBindVertexArray(mesh->VAO);
+        }
+        if (entities.material_ids[entity] != bound_material) {
+            bound_material = entities.material_ids[entity];
+            setTexture((*entities.materials[bound_material].textures)[0]);
+        }
+
+        glUniformMatrix4fv(transformation_loc, 1, GL_FALSE, glm::value_ptr(entities.world_matrices[entity]));
+        glDrawArrays(GL_TRIANGLES, 0, mesh->count);
+    }
+}
+
+// Render the instances, base_transform turns and scales the mesh to face along +Z
+void InstancedShader::render(InstanceBuffer& instances, Texture& texture, glm::mat4& base_transform, float rewind, Camera& camera,
+    PointLight& point_light, DirectionLight& dir_light) {
+    PROFILE_GPU_SCOPE("Instanced");
+    if (instances.count == 0)
+        return;
+
+    glUseProgram(shader_program);
+
+    // Get projection and view matrixes
+    glm::mat4 projection = camera.getProjectionMatrix();
+    glm::mat4 view = camera.getViewMatrix();
+
+    // Pass variables shared by every instance to shader
+    setTransform(base_transform);
+    glUniform1f(glGetUniformLocation(shader_program, "rewind"), rewind);
+    setProjection(projection);
+    setView(view);
+    setTexture(texture);
+    setPointLight(point_light, camera.camera_pos);
+    setDirectionLight(dir_light, camera.camera_pos);
+
+    // Draw every instance in one call
+    glBindVertexArray(instances.VAO);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, instances.mesh.count, instances.count);
+}
+
+CulledShader::CulledShader(const char* vert_path, const char* frag_path): TexLightingShader(vert_path, frag_path) {
+    glUseProgram(shader_program);
+    glUniform1i(glGetUniformLocation(shader_program, "entity_transforms"), GPU_CULL_TRANSFORMS_UNIT);
+}
+
+// Render the draws of one culling phase with lighting and texture, one indirect draw per batch
+void CulledShader::render(EntityStore& entities, GpuCuller& culler, int phase, Camera& camera, PointLight& point_light,
+    DirectionLight& dir_light) {
+    PROFILE_GPU_SCOPE("Culled entities");
+    glUseProgram(shader_program);
+
+    // Get projection and view matrixes
+    glm::mat4 projection = camera.getProjectionMatrix();
+    glm::mat4 view = camera.getViewMatrix();
+
+    // Pass variables shared by every entity to shader
+    setProjection(projection);
+    setView(view);
+    setPointLight(point_light, camera.camera_pos);
+    setDirectionLight(dir_light, camera.camera_pos);
+
+    // The culling shader filled in how many instances each draw has, the CPU only walks the batches
+    culler.bindDraws();
+    const std::vector<GpuCullBatch>& batches = culler.getBatches();
+    uint32_t bound_material = UINT32_MAX;
+    for (size_t i = 0; i < batches.size(); i++) {
+        if (batches[i].material_id != bound_material) {
+            bound_material = batches[i].material_id;
+            setTexture((*entities.materials[bound_material].textures)[0]);
+        }
+        glBindVertexArray(culler.getBatchVAO(i));
+        glDrawArraysIndirect(GL_TRIANGLES, (void*) culler.getCommandOffset(phase, i));
+    }
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
 // Set the normal texture
 void NormalMapShader::setNormalTexture(Texture& norm_tex) {
     glActiveTexture(GL_TEXTURE0 + norm_tex.tex_unit);
@@ -173,6 +364,7 @@ void NormalMapShader::setTexture(Texture& tex0, Texture& tex1) {
 
 // Render a model 3d object with lighting, texture, and normal mapping
 void NormalMapShader::render(Model3D& object, Camera& camera, PointLight& point_light, DirectionLight& dir_light) {
+    PROFILE_GPU_SCOPE("Normal mapped model");
     glUseProgram(shader_program);
 
     // Get transformation, projection, and view matrixes
@@ -195,3 +387,161 @@ void NormalMapShader::render(Model3D& object, Camera& camera, PointLight& point_
     // Draw the elements
     glDrawArrays(GL_TRIANGLES, 0, object.vertex_attribs.count);
 }
+
+// Render the entities of a list of draw packets from a light's or the camera's view, returns how many draws it made
+uint32_t ShadowShader::render(EntityStore& entities, const std::vector<DrawPacket>& packets, glm::mat4& view, glm::mat4& projection) {
+    glUseProgram(shader_program);
+    setProjection(projection);
+    setView(view);
+
+    // Only the mesh matters for depth, and packets of the same mesh are next to each other within a material
+    GLint transformation_loc = glGetUniformLocation(shader_program, "transform");
+    uint32_t bound_mesh = UINT32_MAX;
+    for (const DrawPacket& packet : packets) {
+        uint32_t entity = packet.entity;
+        VertexAttribs* mesh = entities.meshes[entities.mesh_ids[entity]];
+        if (entities.mesh_ids[entity] != bound_mesh) {
+            bound_mesh = entities.mesh_ids[entity];
+            glBindVertexArray(mesh->position_VAO);
+        }
+
+        glUniformMatrix4fv(transformation_loc, 1, GL_FALSE, glm::value_ptr(entities.world_matrices[entity]));
+        glDrawArrays(GL_TRIANGLES, 0, mesh->count);
+    }
+    return (uint32_t) packets.size();
+}
+
+// Render a model 3d object from a light's or the camera's view
+void ShadowShader::render(Model3D& object, glm::mat4& view, glm::mat4& projection) {
+    glUseProgram(shader_program);
+    glm::mat4 transformation = object.getTransformationMatrix();
+    setTransform(transformation);
+    setProjection(projection);
+    setView(view);
+
+    glBindVertexArray(object.vertex_attribs.position_VAO);
+    glDrawArrays(GL_TRIANGLES, 0, object.vertex_attribs.count);
+}
+
+// Render the instances from a light's or the camera's view, the shader must place them like instanced.vert
+void ShadowShader::render(InstanceBuffer& instances, glm::mat4& base_transform, float rewind, glm::mat4& view, glm::mat4& projection) {
+    if (instances.count == 0)
+        return;
+
+    glUseProgram(shader_program);
+    setTransform(base_transform);
+    glUniform1f(glGetUniformLocation(shader_program, "rewind"), rewind);
+    setProjection(projection);
+    setView(view);
+
+    glBindVertexArray(instances.position_VAO);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, instances.mesh.count, instances.count);
+}
+
+// Render the entities of a list of draw packets into the six layers from first_layer on, seen from a light out to range
+void PointShadowShader::render(EntityStore& entities, const std::vector<DrawPacket>& packets, glm::vec3 light_pos, float range, int first_layer) {
+    glUseProgram(shader_program);
+
+    // The faces look along the axes the way cube maps do, so the lit shaders pick a face and its texel the same way
+    static const glm::vec3 targets[6] = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+    static const glm::vec3 ups[6] = {{0, -1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}, {0, -1, 0}, {0, -1, 0}};
+    glm::mat4 projection = glm::perspective(glm::radians(90.f), 1.f, POINT_SHADOW_NEAR, range);
+    glm::mat4 faces[6];
+    for (int face = 0; face < 6; face++)
+        faces[face] = projection * glm::lookAt(light_pos, light_pos + targets[face], ups[face]);
+    glUniformMatrix4fv(glGetUniformLocation(shader_program, "faces"), 6, GL_FALSE, glm::value_ptr(faces[0]));
+    glUniform1i(glGetUniformLocation(shader_program, "first_layer"), first_layer);
+
+    GLint transformation_loc = glGetUniformLocation(shader_program, "transform");
+    uint32_t bound_mesh = UINT32_MAX;
+    for (const DrawPacket& packet : packets) {
+        uint32_t entity = packet.entity;
+        VertexAttribs* mesh = entities.meshes[entities.mesh_ids[entity]];
+        if (entities.mesh_ids[entity] != bound_mesh) {
+            bound_mesh = entities.mesh_ids[entity];
+            glBindVertexArray(mesh->position_VAO);
+        }
+
+        glUniformMatrix4fv(transformation_loc, 1, GL_FALSE, glm::value_ptr(entities.world_matrices[entity]));
+        glDrawArrays(GL_TRIANGLES, 0, mesh->count);
+    }
+}
+
+// Render the living particles of a system, tinted by a color
+void ParticleShader::render(ParticleSystem& particles, Camera& camera, glm::vec4 tint) {
+    PROFILE_GPU_SCOPE("Particles");
+    if (particles.getUsed() == 0)
+        return;
+
+    glUseProgram(shader_program);
+
+    // Get projection and view matrixes
+    glm::mat4 projection = camera.getProjectionMatrix();
+    glm::mat4 view = camera.getViewMatrix();
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    // Pass variables to shader
+    setProjection(projection);
+    setView(view);
+    glUniform1f(glGetUniformLocation(shader_program, "viewport_height"), (float) viewport[3]);
+    glUniform1f(glGetUniformLocation(shader_program, "fade_time"), particles.settings.fade_time);
+    glUniform4fv(glGetUniformLocation(shader_program, "color"), 1, glm::value_ptr(particles.settings.color * tint));
+
+    // Particles are added on top of the scene, so they need no sorting but must not hide each other in the depth buffer
+    // Blending is only on for the particles, every other pass draws opaque surfaces
+    glEnable(GL_PROGRAM_POINT_SIZE);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+    glDepthMask(GL_FALSE);
+
+    glBindVertexArray(particles.VAO);
+    glDrawArrays(GL_POINTS, 0, (GLsizei) particles.getUsed());
+
+    glDepthMask(GL_TRUE);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDisable(GL_BLEND);
+}
+
+// Light every pixel a surface was drawn to, writing its depth along so later passes are hidden behind it
+void DeferredLightingShader::render(GBuffer& gbuffer, Camera& camera, PointLight& point_light, DirectionLight& dir_light) {
+    PROFILE_GPU_SCOPE("Deferred lighting");
+    glUseProgram(shader_program);
+    gbuffer.bindTextures();
+
+    glm::mat4 inverse_view_projection = glm::inverse(camera.getProjectionMatrix() * camera.getViewMatrix());
+    glUniformMatrix4fv(glGetUniformLocation(shader_program, "inverse_view_projection"), 1, GL_FALSE,
+        glm::value_ptr(inverse_view_projection));
+    setPointLight(point_light, camera.camera_pos);
+    setDirectionLight(dir_light, camera.camera_pos);
+
+    // The depth written is the surface's own, so it always passes
+    glDepthFunc(GL_ALWAYS);
+    glBindVertexArray(empty_vao);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glDepthFunc(GL_LESS);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+// Run the pass over a color texture into the bound framebuffer, with the chain's settings and the camera the scene was seen from
+void PostProcessShader::render(PostProcessChain& chain, GLuint color, Camera& camera, float time) {
+    glUseProgram(shader_program);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, color);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, chain.getDepthTexture());
+    glActiveTexture(GL_TEXTURE0);
+
+    // Every pass gets every setting, each only reads the ones it needs
+    glm::mat4 inverse_projection = glm::inverse(camera.getProjectionMatrix());
+    glUniformMatrix4fv(glGetUniformLocation(shader_program, "inverse_projection"), 1, GL_FALSE, glm::value_ptr(inverse_projection));
+    glUniform3fv(glGetUniformLocation(shader_program, "fog_color"), 1, glm::value_ptr(chain.fog_color));
+    glUniform1f(glGetUniformLocation(shader_program, "fog_density"), chain.fog_density);
+    glUniform1f(glGetUniformLocation(shader_program, "exposure"), chain.exposure);
+    glUniform1f(glGetUniformLocation(shader_program, "noise_strength"), chain.noise_strength);
+    glUniform1f(glGetUniformLocation(shader_program, "vignette_strength"), chain.vignette_strength);
+    glUniform1f(glGetUniformLocation(shader_program, "time"), time);
+
+    glBindVertexArray(empty_vao);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+}
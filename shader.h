@@ -1,60 +1,85 @@
 #pragma once
 
 #include <fstream>
+#include <iostream>
 #include <sstream>
 
 #include "common.h"
+#include "startup_timeline.h"
+#include "asset_pack.h"
 
 #include "light.h"
+#include "light_clusters.h"
+#include "shadow_map.h"
+#include "point_shadows.h"
 #include "texture.h"
 #include "model.h"
+#include "entity.h"
+#include "instancing.h"
 #include "camera.h"
 #include "skybox.h"
 
+class ParticleSystem;
+class GBuffer;
+class PostProcessChain;
+class GpuCuller;
+
 // Base wrapper object for a shader
 class Shader {
 public:
     GLuint vertex_shader;
     GLuint fragment_shader;
+    // 0 unless the shader was given a geom file
+    GLuint geometry_shader;
     GLuint shader_program;
 
-    // Compile shader using vert file path and frag file path
-    Shader(const char* vert_path, const char* frag_path) {
+    // Compile shader using vert file path and frag file path, and geom file path if the shader has a geometry stage
+    Shader(const char* vert_path, const char* frag_path, const char* geom_path = nullptr): geometry_shader(0) {
         // Load vert file code
-        std::fstream vertSrc(vert_path);
-        std::stringstream vertBuff;
-        vertBuff << vertSrc.rdbuf();
-        std::string vertString = vertBuff.str();
-        const char* v = vertString.c_str();
+        double read_start = StartupTimeline::now();
+        AssetBlob vertSrc;
+        AssetPack::load(vert_path, vertSrc);
+        StartupTimeline::record("Read shader source", vert_path, read_start, vertSrc.bytes_read, vertSrc.size);
 
         // Load frag file code
-        std::fstream fragSrc(frag_path);
-        std::stringstream fragBuff;
-        fragBuff << fragSrc.rdbuf();
-        std::string fragString = fragBuff.str();
-        const char* f = fragString.c_str();
+        read_start = StartupTimeline::now();
+        AssetBlob fragSrc;
+        AssetPack::load(frag_path, fragSrc);
+        StartupTimeline::record("Read shader source", frag_path, read_start, fragSrc.bytes_read, fragSrc.size);
 
-        // Compile shader code
-        vertex_shader = glCreateShader(GL_VERTEX_SHADER);
-        glShaderSource(vertex_shader, 1, &v, NULL);
-        glCompileShader(vertex_shader);
+        // Load geom file code
+        AssetBlob geomSrc;
+        if (geom_path) {
+            read_start = StartupTimeline::now();
+            AssetPack::load(geom_path, geomSrc);
+            StartupTimeline::record("Read shader source", geom_path, read_start, geomSrc.bytes_read, geomSrc.size);
+        }
 
-        fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
-        glShaderSource(fragment_shader, 1, &f, NULL);
-        glCompileShader(fragment_shader);
+        // Compile shader code
+        vertex_shader = compileStage(GL_VERTEX_SHADER, vert_path, (const char*) vertSrc.data, vertSrc.size);
+        fragment_shader = compileStage(GL_FRAGMENT_SHADER, frag_path, (const char*) fragSrc.data, fragSrc.size);
+        if (geom_path)
+            geometry_shader = compileStage(GL_GEOMETRY_SHADER, geom_path, (const char*) geomSrc.data, geomSrc.size);
 
         // Pair shader code
+        StartupScope link_step("Link program", std::string(vert_path) + " + " + frag_path);
         shader_program = glCreateProgram();
         glAttachShader(shader_program, vertex_shader);
         glAttachShader(shader_program, fragment_shader);
+        if (geometry_shader)
+            glAttachShader(shader_program, geometry_shader);
 
         glLinkProgram(shader_program);
+        link_step.bytes_read = vertSrc.size + fragSrc.size + geomSrc.size;
+        link_step.bytes_produced = waitForLink(shader_program);
     }
 
     // Deconstructor to free shader program
     ~Shader() {
         glDeleteShader(vertex_shader);
         glDeleteShader(fragment_shader);
+        if (geometry_shader)
+            glDeleteShader(geometry_shader);
         glDeleteProgram(shader_program);
     }
 
@@ -66,40 +91,199 @@ public:
 
     // Pass a projection matrix for the shader to use
     void setProjection(glm::mat4& projection_matrix);
+
+    // Compiles one stage of a shader from its code, timed as a step of startup
+    static GLuint compileStage(GLenum type, const char* path, const char* code, size_t code_size);
+
+    // Waits for a program to finish linking, since drivers may build it in the background, and gets the size of its binary
+    static uint64_t waitForLink(GLuint program);
+};
+
+// Wrapper object for a compute shader, which runs on its own outside of the rendering pipeline
+class ComputeShader {
+public:
+    GLuint compute_shader;
+    GLuint shader_program;
+
+    // Compile shader using comp file path
+    ComputeShader(const char* comp_path) {
+        // Load comp file code
+        double read_start = StartupTimeline::now();
+        AssetBlob compSrc;
+        AssetPack::load(comp_path, compSrc);
+        StartupTimeline::record("Read shader source", comp_path, read_start, compSrc.bytes_read, compSrc.size);
+
+        // Compile shader code
+        compute_shader = Shader::compileStage(GL_COMPUTE_SHADER, comp_path, (const char*) compSrc.data, compSrc.size);
+
+        double link_start = StartupTimeline::now();
+        shader_program = glCreateProgram();
+        glAttachShader(shader_program, compute_shader);
+        glLinkProgram(shader_program);
+        StartupTimeline::record("Link program", comp_path, link_start, compSrc.size, Shader::waitForLink(shader_program));
+
+        // Nothing is drawn by compute shaders to show that they failed, so report it
+        GLint compiled, linked;
+        glGetShaderiv(compute_shader, GL_COMPILE_STATUS, &compiled);
+        glGetProgramiv(shader_program, GL_LINK_STATUS, &linked);
+        if (!compiled || !linked) {
+            char log[1024];
+            if (!compiled)
+                glGetShaderInfoLog(compute_shader, sizeof(log), NULL, log);
+            else
+                glGetProgramInfoLog(shader_program, sizeof(log), NULL, log);
+            std::cout << "Could not build " << comp_path << ": " << log << '\n';
+        }
+    }
+
+    // Deconstructor to free shader program
+    ~ComputeShader() {
+        glDeleteShader(compute_shader);
+        glDeleteProgram(shader_program);
+    }
+
+    // Runs enough groups of group_size invocations to cover count items, the shader must skip the extra invocations
+    inline void dispatch(size_t count, size_t group_size) {
+        glUseProgram(shader_program);
+        glDispatchCompute((GLuint) ((count + group_size - 1) / group_size), 1, 1);
+    }
+
+    // Pass an integer variable for the shader to use
+    void setInt(const char* name, GLint value);
+
+    // Pass an unsigned integer variable for the shader to use
+    void setUint(const char* name, GLuint value);
+
+    // Pass a float variable for the shader to use
+    void setFloat(const char* name, float value);
+
+    // Pass a vector variable for the shader to use
+    void setVec3(const char* name, glm::vec3 value);
+
+    // Pass an integer vector variable for the shader to use
+    void setIvec2(const char* name, glm::ivec2 value);
+
+    // Pass an array of vectors for the shader to use
+    void setVec4Array(const char* name, const glm::vec4* values, int count);
+
+    // Pass a matrix variable for the shader to use
+    void setMat4(const char* name, const glm::mat4& value);
 };
 
 // Shader program for rendering the skybox
 class SkyboxShader: public Shader {
 public:
-    SkyboxShader(const char* vert_path, const char* frag_path): Shader(vert_path, frag_path) {}
+    SkyboxShader(const char* vert_path, const char* frag_path): Shader(vert_path, frag_path) {
+        // The sky is one triangle covering the screen made from the vertex ids, but a VAO still has to be bound to draw it
+        glGenVertexArrays(1, &empty_vao);
+    }
+
+    // Deconstructor to free the empty VAO
+    ~SkyboxShader() {
+        glDeleteVertexArrays(1, &empty_vao);
+    }
 
     // Delete the set transformation function because it is not needed for rendering the skybox
     void setTransform(glm::mat4& transformation_matrix) = delete;
 
-    // Render a skybox object
+    // Render a skybox object behind everything drawn so far, only the pixels left at the far plane are shaded
     void render(Skybox& skybox, Camera& camera);
+
+private:
+    GLuint empty_vao;
 };
 
 // Shader program that applies a texture, point lighting, and directional lighting to an object
 class TexLightingShader: public Shader {
 public:
-    TexLightingShader(const char* vert_path, const char* frag_path): Shader(vert_path, frag_path) {}
+    TexLightingShader(const char* vert_path, const char* frag_path): Shader(vert_path, frag_path) {
+        // The cluster buffers have units of their own, so their samplers never share a unit with a material's textures
+        glUseProgram(shader_program);
+        glUniform1i(glGetUniformLocation(shader_program, "cluster_lights"), CLUSTER_LIGHTS_UNIT);
+        glUniform1i(glGetUniformLocation(shader_program, "cluster_grid"), CLUSTER_GRID_UNIT);
+        glUniform1i(glGetUniformLocation(shader_program, "cluster_indices"), CLUSTER_INDICES_UNIT);
+        glUniform1i(glGetUniformLocation(shader_program, "shadow_map"), SHADOW_MAP_UNIT);
+        glUniform1i(glGetUniformLocation(shader_program, "point_shadow_maps"), POINT_SHADOW_UNIT);
+    }
 
     // Pass a texture variable for the shader to use
     void setTexture(Texture& tex);
 
-    // Pass a color variable for the shader to use instead of the texture
-    void setColor(bool use_color, glm::vec4& tex);
-
     // Pass a point light for the shader to use
     void setPointLight(PointLight& light_source, glm::vec3& camera_pos);
 
     // Pass a direction light for the shader to use
     void setDirectionLight(DirectionLight& light_source, glm::vec3& camera_pos);
 
+    // Pass the froxel grid of the frame, whose point lights are added on top of the main one, the clusters must be bound
+    void setLightClusters(const LightClusters& clusters);
+
+    // Pass the cascades of the direction light's shadow map, which must be bound, shadows are left out until this is called
+    void setShadowMap(const CascadedShadowMap& shadow_map);
+
+    // Pass the light the sky sheds from every side, which stands in for the direction light's flat ambient color
+    void setSkyLighting(const SkyLighting& sky);
+
     // Render a model 3d object with lighting and texture
-    void render(Model3D& object, Camera& camera, PointLight& point_light,
-        DirectionLight& dir_light, glm::vec4 color = {-1, -1, -1, -1});
+    void render(Model3D& object, Camera& camera, PointLight& point_light, DirectionLight& dir_light);
+
+    // Render the entities of a list of draw packets with lighting and texture
+    void render(EntityStore& entities, const std::vector<DrawPacket>& packets, Camera& camera,
+        PointLight& point_light, DirectionLight& dir_light);
+};
+
+// Shader program that draws every instance of an instance buffer with a texture, point lighting, and directional lighting
+class InstancedShader: public TexLightingShader {
+public:
+    InstancedShader(const char* vert_path, const char* frag_path): TexLightingShader(vert_path, frag_path) {}
+
+    // Render the instances, base_transform turns and scales the mesh to face along +Z
+    // Instances are moved back along their heading by rewind seconds, to draw them between simulation steps
+    void render(InstanceBuffer& instances, Texture& texture, glm::mat4& base_transform, float rewind, Camera& camera,
+        PointLight& point_light, DirectionLight& dir_light);
+};
+
+// Shader program that draws the entities a GpuCuller let through with a texture, point lighting, and directional lighting,
+// each instance reading its entity's world matrix from the culler's buffer
+class CulledShader: public TexLightingShader {
+public:
+    CulledShader(const char* vert_path, const char* frag_path);
+
+    // Render the draws of one culling phase with lighting and texture, one indirect draw per batch
+    void render(EntityStore& entities, GpuCuller& culler, int phase, Camera& camera, PointLight& point_light, DirectionLight& dir_light);
+};
+
+// Shader program that only writes depth, for drawing shadow casters into a cascade of a shadow map and for the depth pre-pass
+class ShadowShader: public Shader {
+public:
+    ShadowShader(const char* vert_path, const char* frag_path): Shader(vert_path, frag_path) {}
+
+    // Render the entities of a list of draw packets from a light's or the camera's view, returns how many draws it made
+    uint32_t render(EntityStore& entities, const std::vector<DrawPacket>& packets, glm::mat4& view, glm::mat4& projection);
+
+    // Render a model 3d object from a light's or the camera's view
+    void render(Model3D& object, glm::mat4& view, glm::mat4& projection);
+
+    // Render the instances from a light's or the camera's view, the shader must place them like instanced.vert
+    void render(InstanceBuffer& instances, glm::mat4& base_transform, float rewind, glm::mat4& view, glm::mat4& projection);
+};
+
+// Shader program that draws shadow casters into the six faces of a point light's shadow map at once, through a geometry shader
+class PointShadowShader: public Shader {
+public:
+    PointShadowShader(const char* vert_path, const char* frag_path, const char* geom_path): Shader(vert_path, frag_path, geom_path) {}
+
+    // Render the entities of a list of draw packets into the six layers from first_layer on, seen from a light out to range
+    void render(EntityStore& entities, const std::vector<DrawPacket>& packets, glm::vec3 light_pos, float range, int first_layer);
+};
+
+// Shader program for rendering particles as soft points added on top of the scene
+class ParticleShader: public Shader {
+public:
+    ParticleShader(const char* vert_path, const char* frag_path): Shader(vert_path, frag_path) {}
+
+    // Render the living particles of a system, tinted by a color
+    void render(ParticleSystem& particles, Camera& camera, glm::vec4 tint = {1, 1, 1, 1});
 };
 
 // Shader program that applies a texture, normal mapping, point lighting, and directional lighting to an object
@@ -116,3 +300,52 @@ public:
     // Render a model 3d object with lighting, texture, and normal mapping
     void render(Model3D& object, Camera& camera, PointLight& point_light, DirectionLight& dir_light);
 };
+
+// Shader program that lights a filled G-buffer in one pass over the screen, with the same lights as TexLightingShader
+class DeferredLightingShader: public TexLightingShader {
+public:
+    DeferredLightingShader(const char* vert_path, const char* frag_path): TexLightingShader(vert_path, frag_path) {
+        // The triangle covering the screen is made from the vertex ids, but a VAO still has to be bound to draw it
+        glGenVertexArrays(1, &empty_vao);
+        glUniform1i(glGetUniformLocation(shader_program, "gbuffer_albedo"), 0);
+        glUniform1i(glGetUniformLocation(shader_program, "gbuffer_normal"), 1);
+        glUniform1i(glGetUniformLocation(shader_program, "gbuffer_depth"), 2);
+    }
+
+    // Deconstructor to free the empty VAO
+    ~DeferredLightingShader() {
+        glDeleteVertexArrays(1, &empty_vao);
+    }
+
+    // Delete the set texture function because the G-buffer's textures are bound instead
+    void setTexture(Texture& tex) = delete;
+
+    // Light every pixel a surface was drawn to, writing its depth along so later passes are hidden behind it
+    void render(GBuffer& gbuffer, Camera& camera, PointLight& point_light, DirectionLight& dir_light);
+
+private:
+    GLuint empty_vao;
+};
+
+// Shader program for one full screen pass of a post process chain, reading the last pass's color and the scene's depth
+class PostProcessShader: public Shader {
+public:
+    PostProcessShader(const char* vert_path, const char* frag_path): Shader(vert_path, frag_path) {
+        // Like the deferred lighting pass, the triangle is made from the vertex ids but a VAO has to be bound
+        glGenVertexArrays(1, &empty_vao);
+        glUseProgram(shader_program);
+        glUniform1i(glGetUniformLocation(shader_program, "scene_color"), 0);
+        glUniform1i(glGetUniformLocation(shader_program, "scene_depth"), 1);
+    }
+
+    // Deconstructor to free the empty VAO
+    ~PostProcessShader() {
+        glDeleteVertexArrays(1, &empty_vao);
+    }
+
+    // Run the pass over a color texture into the bound framebuffer, with the chain's settings and the camera the scene was seen from
+    void render(PostProcessChain& chain, GLuint color, Camera& camera, float time);
+
+private:
+    GLuint empty_vao;
+};
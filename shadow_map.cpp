@@ -0,0 +1,179 @@
+#include "shadow_map.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+#include "profiler.h"
+#include "shader.h"
+
+CascadedShadowMap::CascadedShadowMap(int size): view_forward(0.f, 0.f, -1.f), max_distance(100.f), split_lambda(0.75f), size(size), query_set(0) {
+    // Samples outside every cascade read as lit, and comparing in the sampler filters four texels per lookup
+    glGenTextures(1, &depth_maps);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, depth_maps);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT24, size, size, SHADOW_CASCADES, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, NULL);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+    float border[4] = {1.f, 1.f, 1.f, 1.f};
+    glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, border);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    GLint bound_framebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &bound_framebuffer);
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depth_maps, 0, 0);
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+    glBindFramebuffer(GL_FRAMEBUFFER, bound_framebuffer);
+
+    glGenQueries(2 * SHADOW_CASCADES, &queries[0][0]);
+    queries_issued[0] = queries_issued[1] = false;
+    for (int cascade = 0; cascade < SHADOW_CASCADES; cascade++) {
+        split_depths[cascade] = 0.f;
+        texel_sizes[cascade] = 0.f;
+        draw_counts[cascade] = 0;
+        gpu_ms[cascade] = 0.0;
+    }
+}
+
+// Deconstructor to free the framebuffer, the depth maps and the queries
+CascadedShadowMap::~CascadedShadowMap() {
+    glDeleteQueries(2 * SHADOW_CASCADES, &queries[0][0]);
+    glDeleteFramebuffers(1, &framebuffer);
+    glDeleteTextures(1, &depth_maps);
+}
+
+// Fits the cascades to the view of a camera, looking along the direction of a light
+void CascadedShadowMap::update(DirectionLight& light, Camera& camera) {
+    PROFILE_SCOPE("Fit shadow cascades");
+    view_forward = glm::normalize(camera.camera_center - camera.camera_pos);
+
+    // The corners of the near and far planes, points between a pair are at a depth proportional to how far along they are
+    glm::mat4 inverse_view_projection = glm::inverse(camera.getProjectionMatrix() * camera.getViewMatrix());
+    glm::vec3 near_corners[4], far_corners[4];
+    for (int corner = 0; corner < 4; corner++) {
+        glm::vec2 ndc((corner & 1) ? 1.f : -1.f, (corner & 2) ? 1.f : -1.f);
+        glm::vec4 near_point = inverse_view_projection * glm::vec4(ndc, -1.f, 1.f);
+        glm::vec4 far_point = inverse_view_projection * glm::vec4(ndc, 1.f, 1.f);
+        near_corners[corner] = glm::vec3(near_point) / near_point.w;
+        far_corners[corner] = glm::vec3(far_point) / far_point.w;
+    }
+
+    // Every cascade looks from the same rotation, so moving one only slides its map over the scene
+    glm::vec3 direction = light.getLightDirection();
+    glm::vec3 up = std::abs(direction.y) > 0.99f ? glm::vec3(0.f, 0.f, 1.f) : glm::vec3(0.f, 1.f, 0.f);
+    glm::mat4 light_view = glm::lookAt(glm::vec3(0.f), direction, up);
+
+    float view_near = camera.znear;
+    float view_far = std::min(camera.zfar, max_distance);
+    float view_depth = camera.zfar - camera.znear;
+    float slice_start = view_near;
+    for (int cascade = 0; cascade < SHADOW_CASCADES; cascade++) {
+        // Splits between evenly spaced and growing by a constant ratio, the latter keeping texels a constant size on screen
+        float t = (float) (cascade + 1) / SHADOW_CASCADES;
+        float log_split = view_near * std::pow(view_far / view_near, t);
+        float linear_split = view_near + (view_far - view_near) * t;
+        float slice_end = split_lambda * log_split + (1.f - split_lambda) * linear_split;
+        split_depths[cascade] = slice_end;
+
+        // The sphere around the slice keeps the same size however the camera turns, rounded so it does not flicker either
+        glm::vec3 corners[8];
+        glm::vec3 center(0.f);
+        for (int corner = 0; corner < 4; corner++) {
+            glm::vec3 edge = far_corners[corner] - near_corners[corner];
+            corners[corner] = near_corners[corner] + edge * ((slice_start - camera.znear) / view_depth);
+            corners[corner + 4] = near_corners[corner] + edge * ((slice_end - camera.znear) / view_depth);
+            center += corners[corner] + corners[corner + 4];
+        }
+        center /= 8.f;
+        float radius = 0.f;
+        for (const glm::vec3& corner : corners)
+            radius = std::max(radius, glm::length(corner - center));
+        radius = std::ceil(radius * 16.f) / 16.f;
+        float texel_size = 2.f * radius / size;
+        texel_sizes[cascade] = texel_size;
+
+        // Moving the center in whole texels keeps every texel over the same spot of the scene as the camera moves
+        glm::vec3 light_center = glm::vec3(light_view * glm::vec4(center, 1.f));
+        light_center.x = std::floor(light_center.x / texel_size) * texel_size;
+        light_center.y = std::floor(light_center.y / texel_size) * texel_size;
+        light_views[cascade] = light_view;
+        light_projections[cascade] = glm::ortho(light_center.x - radius, light_center.x + radius,
+            light_center.y - radius, light_center.y + radius,
+            -light_center.z - radius - SHADOW_CASTER_DISTANCE, -light_center.z + radius);
+        slice_start = slice_end;
+    }
+}
+
+// Draws the entities that can cast a shadow into each cascade, culled by the cascade's volume,
+// and whatever else draw_others draws with the cascade's view and projection, which returns how many draws it made
+void CascadedShadowMap::render(EntityStore& entities, ShadowShader& shader,
+    const std::function<uint32_t(glm::mat4&, glm::mat4&)>& draw_others) {
+    PROFILE_SCOPE("Shadow cascades");
+    // The queries of the render before last are read only once their results are in, so this never waits on the GPU,
+    // a cascade whose result is not in yet keeps its last time
+    query_set = 1 - query_set;
+    if (queries_issued[query_set]) {
+        for (int cascade = 0; cascade < SHADOW_CASCADES; cascade++) {
+            GLint available = 0;
+            glGetQueryObjectiv(queries[query_set][cascade], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available)
+                continue;
+
+            GLuint64 elapsed;
+            glGetQueryObjectui64v(queries[query_set][cascade], GL_QUERY_RESULT, &elapsed);
+            gpu_ms[cascade] = elapsed / 1e6;
+        }
+    }
+
+    GLint output_framebuffer;
+    GLint viewport[4];
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &output_framebuffer);
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, size, size);
+    // Surfaces are pushed back a little, more so when they slope away from the light, so they do not shadow themselves
+    glEnable(GL_POLYGON_OFFSET_FILL);
+    glPolygonOffset(2.f, 4.f);
+
+    for (int cascade = 0; cascade < SHADOW_CASCADES; cascade++) {
+        // The volume reaches back towards the light, so casters outside the view still shadow what is in it
+        entities.queryFrustum(Frustum(light_projections[cascade] * light_views[cascade]), casters);
+        entities.buildDrawPackets(casters, packets);
+
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depth_maps, 0, cascade);
+        glClear(GL_DEPTH_BUFFER_BIT);
+        glBeginQuery(GL_TIME_ELAPSED, queries[query_set][cascade]);
+        draw_counts[cascade] = shader.render(entities, packets, light_views[cascade], light_projections[cascade]);
+        if (draw_others)
+            draw_counts[cascade] += draw_others(light_views[cascade], light_projections[cascade]);
+        glEndQuery(GL_TIME_ELAPSED);
+    }
+    queries_issued[query_set] = true;
+
+    glDisable(GL_POLYGON_OFFSET_FILL);
+    glBindFramebuffer(GL_FRAMEBUFFER, output_framebuffer);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+}
+
+// Binds the depth maps to their texture unit
+void CascadedShadowMap::bind() {
+    glActiveTexture(GL_TEXTURE0 + SHADOW_MAP_UNIT);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, depth_maps);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+// Summarizes the draws and GPU time of every cascade in one line
+std::string CascadedShadowMap::report() const {
+    std::ostringstream out;
+    out.precision(2);
+    out << std::fixed << "Shadow cascades:";
+    for (int cascade = 0; cascade < SHADOW_CASCADES; cascade++)
+        out << (cascade ? ", " : " ") << draw_counts[cascade] << " draws " << gpu_ms[cascade] << " ms";
+    return out.str();
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "common.h"
+#include "camera.h"
+#include "light.h"
+#include "entity.h"
+
+// Number of cascades the view is split into and the size of each one's depth map, the count must match the shaders
+#define SHADOW_CASCADES 4
+#define SHADOW_MAP_SIZE 1024
+
+// Texture unit the shadow map is bound to, below the cluster buffers and above the ones materials use
+#define SHADOW_MAP_UNIT 12
+
+// How far towards the light from a cascade shadow casters are still drawn into it
+#define SHADOW_CASTER_DISTANCE 100.f
+
+class ShadowShader;
+
+// Depth of the scene seen from the direction light in cascades that cover the camera's view from near to far,
+// so nearby shadows get as many texels as distant ones
+// Each cascade is a square that fits its slice of the view whichever way the camera turns, moved in whole texels so edges do not shimmer
+class CascadedShadowMap {
+public:
+    // View and projection of each cascade, and the view depth each one reaches to
+    glm::mat4 light_views[SHADOW_CASCADES];
+    glm::mat4 light_projections[SHADOW_CASCADES];
+    float split_depths[SHADOW_CASCADES];
+    // World size of a texel of each cascade
+    float texel_sizes[SHADOW_CASCADES];
+    // Forward axis of the camera the cascades were fit to, which view depths are measured along
+    glm::vec3 view_forward;
+    // Farthest view depth that gets shadows, the camera's far plane when it is nearer
+    float max_distance;
+    // How far the splits lean from evenly spaced at 0 to growing by a constant ratio at 1
+    float split_lambda;
+
+    CascadedShadowMap(int size = SHADOW_MAP_SIZE);
+
+    // Deconstructor to free the framebuffer, the depth maps and the queries
+    ~CascadedShadowMap();
+
+    // Fits the cascades to the view of a camera, looking along the direction of a light
+    void update(DirectionLight& light, Camera& camera);
+
+    // Draws the entities that can cast a shadow into each cascade, culled by the cascade's volume,
+    // and whatever else draw_others draws with the cascade's view and projection, which returns how many draws it made
+    void render(EntityStore& entities, ShadowShader& shader,
+        const std::function<uint32_t(glm::mat4&, glm::mat4&)>& draw_others = nullptr);
+
+    // Binds the depth maps to their texture unit
+    void bind();
+
+    inline int getSize() const {
+        return size;
+    }
+
+    // Draws made into a cascade by the last render
+    inline uint32_t getDrawCount(int cascade) const {
+        return draw_counts[cascade];
+    }
+
+    // GPU time of drawing a cascade, from the newest render whose timings have come back
+    inline double getGpuMilliseconds(int cascade) const {
+        return gpu_ms[cascade];
+    }
+
+    // Summarizes the draws and GPU time of every cascade in one line
+    std::string report() const;
+
+private:
+    int size;
+    GLuint framebuffer;
+    // One layer per cascade, compared against in the shaders
+    GLuint depth_maps;
+
+    std::vector<uint32_t> casters;
+    std::vector<DrawPacket> packets;
+    uint32_t draw_counts[SHADOW_CASCADES];
+
+    // Timer queries of the last two renders, so the older one's results are read back without waiting
+    GLuint queries[2][SHADOW_CASCADES];
+    bool queries_issued[2];
+    int query_set;
+    double gpu_ms[SHADOW_CASCADES];
+};
@@ -0,0 +1,264 @@
+#include "sky_lighting.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include <glm/gtc/constants.hpp>
+
+#include "asset_pack.h"
+
+// SSE2 is part of every x64 processor, other targets fall back to the scalar sums
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SKY_LIGHTING_SSE2 1
+#include <emmintrin.h>
+#else
+#define SKY_LIGHTING_SSE2 0
+#endif
+
+// Constant factors of the spherical harmonics of each band
+static const float sh_band0 = 0.282095f;
+static const float sh_band1 = 0.488603f;
+static const float sh_band2 = 1.092548f;
+static const float sh_band2_zz = 0.315392f;
+static const float sh_band2_xy = 0.546274f;
+
+// Convolving with the cosine lobe and dividing by pi scales the bands by 1, 2/3 and 1/4
+static const float band_scales[SKY_SH_COEFFICIENTS] = { 1.f, 2.f / 3.f, 2.f / 3.f, 2.f / 3.f, 0.25f, 0.25f, 0.25f, 0.25f, 0.25f };
+
+// Direction of the center of each face, and the directions the texels' columns and rows run along it
+static const glm::vec3 face_normals[6] = {
+    glm::vec3(1.f, 0.f, 0.f), glm::vec3(-1.f, 0.f, 0.f), glm::vec3(0.f, 1.f, 0.f),
+    glm::vec3(0.f, -1.f, 0.f), glm::vec3(0.f, 0.f, 1.f), glm::vec3(0.f, 0.f, -1.f)
+};
+static const glm::vec3 face_columns[6] = {
+    glm::vec3(0.f, 0.f, -1.f), glm::vec3(0.f, 0.f, 1.f), glm::vec3(1.f, 0.f, 0.f),
+    glm::vec3(1.f, 0.f, 0.f), glm::vec3(1.f, 0.f, 0.f), glm::vec3(-1.f, 0.f, 0.f)
+};
+static const glm::vec3 face_rows[6] = {
+    glm::vec3(0.f, -1.f, 0.f), glm::vec3(0.f, -1.f, 0.f), glm::vec3(0.f, 0.f, 1.f),
+    glm::vec3(0.f, 0.f, -1.f), glm::vec3(0.f, -1.f, 0.f), glm::vec3(0.f, -1.f, 0.f)
+};
+
+// Values of the 9 spherical harmonics in a direction
+static inline void evaluateBasis(glm::vec3 d, float basis[SKY_SH_COEFFICIENTS]) {
+    basis[0] = sh_band0;
+    basis[1] = sh_band1 * d.y;
+    basis[2] = sh_band1 * d.z;
+    basis[3] = sh_band1 * d.x;
+    basis[4] = sh_band2 * d.x * d.y;
+    basis[5] = sh_band2 * d.y * d.z;
+    basis[6] = sh_band2_zz * (3.f * d.z * d.z - 1.f);
+    basis[7] = sh_band2 * d.x * d.z;
+    basis[8] = sh_band2_xy * (d.x * d.x - d.y * d.y);
+}
+
+// Color of a texel from 0 to 1, grey images give the same value to every channel
+static inline glm::vec3 texelColor(const unsigned char* texel, int channels) {
+    if (channels >= 3)
+        return glm::vec3(texel[0], texel[1], texel[2]) * (1.f / 255.f);
+    return glm::vec3(texel[0] * (1.f / 255.f));
+}
+
+#if SKY_LIGHTING_SSE2
+// Adds up the four lanes of a register
+static inline float horizontalSum(__m128 v) {
+    __m128 shuffled = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 sums = _mm_add_ps(v, shuffled);
+    shuffled = _mm_movehl_ps(shuffled, sums);
+    return _mm_cvtss_f32(_mm_add_ss(sums, shuffled));
+}
+#endif
+
+// Starts with no light from anywhere
+SkyLighting::SkyLighting(): total_weight(0.0) {
+    for (int i = 0; i < SKY_SH_COEFFICIENTS; i++) {
+        coefficients[i] = glm::vec3(0.f);
+        sums[i][0] = sums[i][1] = sums[i][2] = 0.0;
+    }
+}
+
+// Lights every side with one color, for when there is no sky to project
+void SkyLighting::setFlat(glm::vec3 color) {
+    for (int i = 0; i < SKY_SH_COEFFICIENTS; i++)
+        coefficients[i] = glm::vec3(0.f);
+    // The first harmonic is constant, so only it is needed, scaled to give back the color once evaluated
+    coefficients[0] = color / sh_band0;
+}
+
+// Adds the texels of a face of the cube map, in the order of GL_TEXTURE_CUBE_MAP_POSITIVE_X onwards, rows from the top
+// A texel at s and t on the face, both from -1 to 1, looks along normal + s * column + t * row and covers a solid angle
+// of its area over the cube of the length of that direction
+void SkyLighting::addFace(int face, const unsigned char* pixels, int width, int height, int channels) {
+    glm::vec3 normal = face_normals[face], column = face_columns[face], row = face_rows[face];
+    float step_s = 2.f / width, step_t = 2.f / height;
+    float area = step_s * step_t;
+
+    for (int y = 0; y < height; y++) {
+        float t = -1.f + (y + 0.5f) * step_t;
+        glm::vec3 row_origin = normal + row * t;
+        const unsigned char* row_pixels = pixels + (size_t) y * width * channels;
+        // Each row is summed on its own in floats, then added to the doubles, so the sums keep their precision over big faces
+        float row_sums[SKY_SH_COEFFICIENTS][3] = {};
+        float row_weight = 0.f;
+        int x = 0;
+
+#if SKY_LIGHTING_SSE2
+        // Four texels at a time, the sums stay in registers across the row and are only added up across lanes at its end
+        __m128 acc[SKY_SH_COEFFICIENTS][3];
+        for (int i = 0; i < SKY_SH_COEFFICIENTS; i++)
+            acc[i][0] = acc[i][1] = acc[i][2] = _mm_setzero_ps();
+        __m128 weight_acc = _mm_setzero_ps();
+        __m128 one = _mm_set1_ps(1.f), three = _mm_set1_ps(3.f), lane_s = _mm_set_ps(3.f * step_s, 2.f * step_s, step_s, 0.f);
+        __m128 to_unit = _mm_set1_ps(1.f / 255.f);
+
+        for (; x + 4 <= width; x += 4) {
+            __m128 s = _mm_add_ps(_mm_set1_ps(-1.f + (x + 0.5f) * step_s), lane_s);
+            __m128 dx = _mm_add_ps(_mm_set1_ps(row_origin.x), _mm_mul_ps(_mm_set1_ps(column.x), s));
+            __m128 dy = _mm_add_ps(_mm_set1_ps(row_origin.y), _mm_mul_ps(_mm_set1_ps(column.y), s));
+            __m128 dz = _mm_add_ps(_mm_set1_ps(row_origin.z), _mm_mul_ps(_mm_set1_ps(column.z), s));
+            __m128 length2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+            __m128 inverse = _mm_div_ps(one, _mm_sqrt_ps(length2));
+            dx = _mm_mul_ps(dx, inverse);
+            dy = _mm_mul_ps(dy, inverse);
+            dz = _mm_mul_ps(dz, inverse);
+            __m128 weight = _mm_mul_ps(_mm_set1_ps(area), _mm_mul_ps(inverse, _mm_mul_ps(inverse, inverse)));
+            weight_acc = _mm_add_ps(weight_acc, weight);
+
+            // The texels' bytes are spread over lanes one by one, the weight and the scale to 0 to 1 are applied once
+            const unsigned char* p = row_pixels + (size_t) x * channels;
+            int g = channels >= 3 ? 1 : 0, b = channels >= 3 ? 2 : 0;
+            __m128 scale = _mm_mul_ps(weight, to_unit);
+            __m128 color[3] = {
+                _mm_mul_ps(scale, _mm_set_ps(p[3 * channels], p[2 * channels], p[channels], p[0])),
+                _mm_mul_ps(scale, _mm_set_ps(p[3 * channels + g], p[2 * channels + g], p[channels + g], p[g])),
+                _mm_mul_ps(scale, _mm_set_ps(p[3 * channels + b], p[2 * channels + b], p[channels + b], p[b]))
+            };
+
+            __m128 basis[SKY_SH_COEFFICIENTS];
+            basis[0] = _mm_set1_ps(sh_band0);
+            basis[1] = _mm_mul_ps(_mm_set1_ps(sh_band1), dy);
+            basis[2] = _mm_mul_ps(_mm_set1_ps(sh_band1), dz);
+            basis[3] = _mm_mul_ps(_mm_set1_ps(sh_band1), dx);
+            basis[4] = _mm_mul_ps(_mm_set1_ps(sh_band2), _mm_mul_ps(dx, dy));
+            basis[5] = _mm_mul_ps(_mm_set1_ps(sh_band2), _mm_mul_ps(dy, dz));
+            basis[6] = _mm_mul_ps(_mm_set1_ps(sh_band2_zz), _mm_sub_ps(_mm_mul_ps(three, _mm_mul_ps(dz, dz)), one));
+            basis[7] = _mm_mul_ps(_mm_set1_ps(sh_band2), _mm_mul_ps(dx, dz));
+            basis[8] = _mm_mul_ps(_mm_set1_ps(sh_band2_xy), _mm_sub_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+
+            for (int i = 0; i < SKY_SH_COEFFICIENTS; i++) {
+                acc[i][0] = _mm_add_ps(acc[i][0], _mm_mul_ps(basis[i], color[0]));
+                acc[i][1] = _mm_add_ps(acc[i][1], _mm_mul_ps(basis[i], color[1]));
+                acc[i][2] = _mm_add_ps(acc[i][2], _mm_mul_ps(basis[i], color[2]));
+            }
+        }
+
+        for (int i = 0; i < SKY_SH_COEFFICIENTS; i++) {
+            for (int c = 0; c < 3; c++)
+                row_sums[i][c] = horizontalSum(acc[i][c]);
+        }
+        row_weight = horizontalSum(weight_acc);
+#endif
+
+        // Whatever the vectors leave, or the whole row without them
+        for (; x < width; x++) {
+            float s = -1.f + (x + 0.5f) * step_s;
+            glm::vec3 direction = row_origin + column * s;
+            float inverse = 1.f / glm::length(direction);
+            float weight = area * inverse * inverse * inverse;
+            glm::vec3 color = texelColor(row_pixels + (size_t) x * channels, channels) * weight;
+
+            float basis[SKY_SH_COEFFICIENTS];
+            evaluateBasis(direction * inverse, basis);
+            for (int i = 0; i < SKY_SH_COEFFICIENTS; i++) {
+                row_sums[i][0] += basis[i] * color.r;
+                row_sums[i][1] += basis[i] * color.g;
+                row_sums[i][2] += basis[i] * color.b;
+            }
+            row_weight += weight;
+        }
+
+        for (int i = 0; i < SKY_SH_COEFFICIENTS; i++) {
+            for (int c = 0; c < 3; c++)
+                sums[i][c] += row_sums[i][c];
+        }
+        total_weight += row_weight;
+    }
+}
+
+// Turns the sums of the faces added into the coefficients, once every face is in, false if no texels were added
+bool SkyLighting::finish() {
+    if (total_weight <= 0.0)
+        return false;
+
+    // The solid angles of the texels add up to a little off the whole sphere, so they are scaled to cover it exactly
+    double scale = 4.0 * glm::pi<double>() / total_weight;
+    for (int i = 0; i < SKY_SH_COEFFICIENTS; i++)
+        coefficients[i] = glm::vec3(sums[i][0], sums[i][1], sums[i][2]) * (float) (scale * band_scales[i]);
+    return true;
+}
+
+// Color a surface facing a direction is lit with
+glm::vec3 SkyLighting::evaluate(glm::vec3 normal) const {
+    float basis[SKY_SH_COEFFICIENTS];
+    evaluateBasis(normal, basis);
+    glm::vec3 color(0.f);
+    for (int i = 0; i < SKY_SH_COEFFICIENTS; i++)
+        color += coefficients[i] * basis[i];
+    return color;
+}
+
+// Reads the coefficients cached for the faces with a hash, false if there are none or they are of other faces
+// The cache is read through the asset pack, so a packed skybox carries its lighting with it
+bool SkyLighting::loadCache(const std::string& path, uint64_t source_hash) {
+    AssetBlob blob;
+    if (!AssetPack::load(path.c_str(), blob))
+        return false;
+
+    size_t expected = sizeof(SkyLightingHeader) + sizeof(float) * 3 * SKY_SH_COEFFICIENTS;
+    SkyLightingHeader header;
+    if (blob.size != expected)
+        return false;
+    memcpy(&header, blob.data, sizeof(header));
+    if (memcmp(header.magic, SKY_LIGHTING_MAGIC, 4) != 0 || header.version != SKY_LIGHTING_VERSION || header.source_hash != source_hash)
+        return false;
+
+    float values[3 * SKY_SH_COEFFICIENTS];
+    memcpy(values, blob.data + sizeof(header), sizeof(values));
+    for (int i = 0; i < SKY_SH_COEFFICIENTS; i++)
+        coefficients[i] = glm::vec3(values[i * 3], values[i * 3 + 1], values[i * 3 + 2]);
+    return true;
+}
+
+// Writes the coefficients and the hash of the faces they are of
+bool SkyLighting::saveCache(const std::string& path, uint64_t source_hash) const {
+    SkyLightingHeader header;
+    memcpy(header.magic, SKY_LIGHTING_MAGIC, 4);
+    header.version = SKY_LIGHTING_VERSION;
+    header.source_hash = source_hash;
+
+    float values[3 * SKY_SH_COEFFICIENTS];
+    for (int i = 0; i < SKY_SH_COEFFICIENTS; i++) {
+        values[i * 3] = coefficients[i].r;
+        values[i * 3 + 1] = coefficients[i].g;
+        values[i * 3 + 2] = coefficients[i].b;
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write((const char*) &header, sizeof(header));
+    file.write((const char*) values, sizeof(values));
+    if (!file) {
+        std::cout << "Could not write the sky lighting cache " << path << '\n';
+        return false;
+    }
+    return true;
+}
+
+// Folds bytes into an FNV-1a hash, start from hashSeed
+uint64_t SkyLighting::hashBytes(const unsigned char* data, size_t size, uint64_t hash) {
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <glm/glm.hpp>
+
+// Identifies the files the sky lighting of a skybox is cached in and the layout version they were written with
+#define SKY_LIGHTING_MAGIC "GXSH"
+#define SKY_LIGHTING_VERSION 1
+// Coefficients of the spherical harmonics up to the second band
+#define SKY_SH_COEFFICIENTS 9
+
+// Start of a cache file, followed by the coefficients as SKY_SH_COEFFICIENTS rgb triples
+struct SkyLightingHeader {
+    char magic[4];
+    uint32_t version;
+    // Hash of the encoded images of the six faces the coefficients were projected from
+    uint64_t source_hash;
+};
+
+// Light the skybox sheds on a surface from every side, as the first 9 spherical harmonics of the cube map's colors
+// The coefficients are convolved with the cosine lobe and divided by pi, so evaluating them at a normal gives the color
+// a white surface facing that way is lit with, and a sky of one color gives back that color whichever way the surface faces
+// Projecting the faces reads every texel, so the coefficients are cached in a file next to the faces, keyed by a hash of their images
+class SkyLighting {
+public:
+    glm::vec3 coefficients[SKY_SH_COEFFICIENTS];
+
+    // Starts with no light from anywhere
+    SkyLighting();
+
+    // Lights every side with one color, for when there is no sky to project
+    void setFlat(glm::vec3 color);
+
+    // Adds the texels of a face of the cube map, in the order of GL_TEXTURE_CUBE_MAP_POSITIVE_X onwards, rows from the top
+    void addFace(int face, const unsigned char* pixels, int width, int height, int channels);
+
+    // Turns the sums of the faces added into the coefficients, once every face is in, false if no texels were added
+    bool finish();
+
+    // Color a surface facing a direction is lit with
+    glm::vec3 evaluate(glm::vec3 normal) const;
+
+    // Reads the coefficients cached for the faces with a hash, false if there are none or they are of other faces
+    bool loadCache(const std::string& path, uint64_t source_hash);
+
+    // Writes the coefficients and the hash of the faces they are of
+    bool saveCache(const std::string& path, uint64_t source_hash) const;
+
+    // Folds bytes into an FNV-1a hash, start from hashSeed
+    static uint64_t hashBytes(const unsigned char* data, size_t size, uint64_t hash);
+
+    static inline uint64_t hashSeed() {
+        return 14695981039346656037ull;
+    }
+
+private:
+    // Radiance of every texel added, weighted by its solid angle, and the solid angle they cover
+    double sums[SKY_SH_COEFFICIENTS][3];
+    double total_weight;
+};
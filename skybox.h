@@ -3,63 +3,18 @@
 #include "common.h"
 #include "shader.h"
 #include "camera.h"
-
-// Vertices for the cube
-static const float skybox_vertices[] {
-        -50.f, -50.f, 50.f, //0
-        50.f, -50.f, 50.f,  //1
-        50.f, -50.f, -50.f, //2
-        -50.f, -50.f, -50.f,//3
-        -50.f, 50.f, 50.f,  //4
-        50.f, 50.f, 50.f,   //5
-        50.f, 50.f, -50.f,  //6
-        -50.f, 50.f, -50.f  //7
-};
-
-// Skybox indices
-static const unsigned int skybox_indices[] {
-    1,2,6,
-    6,5,1,
-
-    0,4,7,
-    7,3,0,
-
-    4,5,6,
-    6,7,4,
-
-    0,3,2,
-    2,1,0,
-
-    0,1,5,
-    5,4,0,
-
-    3,7,6,
-    6,2,3
-};
+#include "startup_timeline.h"
+#include "asset_pack.h"
+#include "sky_lighting.h"
 
 class Skybox {
 public:
-    unsigned int skybox_vao, skybox_vbo, skybox_ebo;
     unsigned int skybox_tex;
+    // Light the sky sheds on the scene from every side, projected from the faces or read from their cache
+    SkyLighting lighting;
+    bool has_lighting;
 
     Skybox(const std::string face_skybox[6]) {
-        // Generate VAO, VBO, and EBO
-        glGenVertexArrays(1, &skybox_vao);
-        glGenBuffers(1, &skybox_vbo);
-        glGenBuffers(1, &skybox_ebo);
-
-        // Bind data to VBO
-        glBindVertexArray(skybox_vao);
-        glBindBuffer(GL_ARRAY_BUFFER, skybox_vbo);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(skybox_vertices), &skybox_vertices, GL_STATIC_DRAW);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GL_FLOAT), (void*) 0);
-
-        // Bind data to EBO
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, skybox_ebo);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GL_INT) * 36, &skybox_indices, GL_STATIC_DRAW);
-        
-        glEnableVertexAttribArray(0);
-
         // Set up skybox textures
         glGenTextures(1, &skybox_tex);
         glBindTexture(GL_TEXTURE_CUBE_MAP, skybox_tex);
@@ -73,31 +28,66 @@ public:
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-        // Load skybox textures from file
-        stbi_set_flip_vertically_on_load(false);
+        // The encoded faces are read first, so the hash of them can tell whether the cached sky lighting is still theirs
+        AssetBlob blobs[6];
+        uint64_t source_hash = SkyLighting::hashSeed();
         for (unsigned int i = 0; i < 6; i++) {
-            int w, h, sky_channel;
+            StartupScope step("Read image", face_skybox[i]);
+            if (AssetPack::load(face_skybox[i].c_str(), blobs[i]))
+                source_hash = SkyLighting::hashBytes(blobs[i].data, blobs[i].size, source_hash);
+            step.bytes_read = blobs[i].bytes_read;
+            step.bytes_produced = blobs[i].size;
+        }
 
-            unsigned char* data = stbi_load(face_skybox[i].c_str(), &w, &h, &sky_channel, 0);
+        std::string cache_path = face_skybox[0] + ".sh";
+        bool cached;
+        int projected_faces = 0;
+        {
+            StartupScope step("Load sky lighting", cache_path);
+            cached = lighting.loadCache(cache_path, source_hash);
+        }
 
-            if (data)
+        // Load skybox textures from file
+        stbi_set_flip_vertically_on_load(false);
+        for (unsigned int i = 0; i < 6; i++) {
+            int w = 0, h = 0, sky_channel = 0;
+            const char* face_path = face_skybox[i].c_str();
+
+            unsigned char* data;
+            {
+                StartupScope step("Decode image", face_path);
+                data = blobs[i].data ? stbi_load_from_memory(blobs[i].data, (int) blobs[i].size, &w, &h, &sky_channel, 0) : nullptr;
+                step.bytes_read = blobs[i].size;
+                step.bytes_produced = data ? (uint64_t) w * h * sky_channel : 0;
+            }
+
+            if (data) {
+                StartupScope step("Upload cube face", face_path);
                 glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB, w, h, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
+                step.bytes_read = step.bytes_produced = (uint64_t) w * h * sky_channel;
+            }
+
+            if (data && !cached) {
+                StartupScope step("Project sky lighting", face_path);
+                lighting.addFace(i, data, w, h, sky_channel);
+                step.bytes_read = (uint64_t) w * h * sky_channel;
+                projected_faces++;
+            }
 
             stbi_image_free(data);
         }
         stbi_set_flip_vertically_on_load(true);
-    }
 
-    // Deconstructor to free buffers
-    ~Skybox() {
-        glDeleteVertexArrays(1, (GLuint*) skybox_vao);
-        glDeleteVertexArrays(1, (GLuint*) skybox_vbo);
-        glDeleteVertexArrays(1, (GLuint*) skybox_ebo);
+        // A sky missing faces would light the scene from the sides it has only, so it is left unlit and not cached
+        has_lighting = cached;
+        if (!cached && projected_faces == 6) {
+            has_lighting = lighting.finish();
+            lighting.saveCache(cache_path, source_hash);
+        }
     }
 
-    // To remove the position of the camera, only the rotation of the camera for the skybox
-    inline glm::mat4 getSkyblockViewMatrix(Camera& camera) {
-        glm::mat4 skybox_view = glm::mat4(1.f);
-        return glm::mat4(glm::mat3(camera.getViewMatrix()));
+    // Deconstructor to free the cube map
+    ~Skybox() {
+        glDeleteTextures(1, &skybox_tex);
     }
 };
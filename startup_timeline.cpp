@@ -0,0 +1,170 @@
+#include "startup_timeline.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+
+#include "json.h"
+
+static std::mutex steps_mutex;
+static std::vector<StartupStep> steps;
+static std::atomic<bool> finished(false);
+static double total_ms = 0.0;
+static int thread_count = 0;
+static thread_local int thread_index = -1;
+
+// Clock startup is timed against, started by begin or by the first step recorded before it
+static std::chrono::steady_clock::time_point getEpoch() {
+    static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    return epoch;
+}
+
+// Gets the calling thread's index, giving it the next one on its first step, steps_mutex must be held
+static int getThreadIndex() {
+    if (thread_index < 0)
+        thread_index = thread_count++;
+    return thread_index;
+}
+
+// Marks the start of startup, the calling thread becomes thread 0
+void StartupTimeline::begin() {
+    getEpoch();
+    std::lock_guard<std::mutex> lock(steps_mutex);
+    getThreadIndex();
+}
+
+// Gets the milliseconds elapsed since startup began
+double StartupTimeline::now() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - getEpoch()).count();
+}
+
+// Adds a finished step, thread safe
+void StartupTimeline::record(const std::string& name, const std::string& asset, double start_ms, uint64_t bytes_read, uint64_t bytes_produced) {
+    if (finished.load(std::memory_order_acquire))
+        return;
+
+    double end_ms = now();
+    std::lock_guard<std::mutex> lock(steps_mutex);
+    StartupStep step;
+    step.name = name;
+    step.asset = asset;
+    step.thread = getThreadIndex();
+    step.start_ms = start_ms;
+    step.duration_ms = end_ms - start_ms;
+    step.bytes_read = bytes_read;
+    step.bytes_produced = bytes_produced;
+    steps.push_back(step);
+}
+
+// Marks the end of startup, no more steps are recorded after it
+void StartupTimeline::finish() {
+    std::lock_guard<std::mutex> lock(steps_mutex);
+    if (!finished.load(std::memory_order_relaxed)) {
+        total_ms = now();
+        finished.store(true, std::memory_order_release);
+    }
+}
+
+// Gets how long startup took, or how long it has taken so far if it is not finished
+double StartupTimeline::getTotalMilliseconds() {
+    std::lock_guard<std::mutex> lock(steps_mutex);
+    return finished.load(std::memory_order_relaxed) ? total_ms : now();
+}
+
+// Gets a copy of every step recorded, in the order they finished
+std::vector<StartupStep> StartupTimeline::getSteps() {
+    std::lock_guard<std::mutex> lock(steps_mutex);
+    return steps;
+}
+
+// Gets the size of a file in bytes, 0 if it can not be opened
+uint64_t StartupTimeline::getFileSize(const char* path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+        return 0;
+    std::streamoff size = file.tellg();
+    return size > 0 ? (uint64_t) size : 0;
+}
+
+// Writes every step and the totals as JSON
+void StartupTimeline::writeJson(std::ostream& out) {
+    std::vector<StartupStep> recorded = getSteps();
+    double total = getTotalMilliseconds();
+
+    uint64_t total_read = 0, total_produced = 0;
+    for (const StartupStep& step : recorded) {
+        total_read += step.bytes_read;
+        total_produced += step.bytes_produced;
+    }
+
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+    out << "{\n\"total_ms\": " << total << ",\n\"bytes_read\": " << total_read << ",\n\"bytes_produced\": " << total_produced
+        << ",\n\"steps\": [\n";
+    for (size_t i = 0; i < recorded.size(); i++) {
+        const StartupStep& step = recorded[i];
+        out << "{\"name\": ";
+        writeJsonString(out, step.name);
+        out << ", \"asset\": ";
+        writeJsonString(out, step.asset);
+        out << ", \"thread\": " << step.thread << ", \"start_ms\": " << step.start_ms << ", \"duration_ms\": " << step.duration_ms
+            << ", \"bytes_read\": " << step.bytes_read << ", \"bytes_produced\": " << step.bytes_produced << '}'
+            << (i + 1 < recorded.size() ? ",\n" : "\n");
+    }
+    out << "]\n}\n";
+    out.flags(flags);
+    out.precision(precision);
+}
+
+// Writes the totals per kind of step and the slowest steps as a readable table
+void StartupTimeline::writeSummary(std::ostream& out, size_t slowest) {
+    std::vector<StartupStep> recorded = getSteps();
+    double total = getTotalMilliseconds();
+
+    // Steps of the same kind are added up, such as every texture upload
+    struct Kind {
+        int count;
+        double ms;
+        uint64_t bytes_read;
+        uint64_t bytes_produced;
+    };
+    std::map<std::string, Kind> kinds;
+    for (const StartupStep& step : recorded) {
+        Kind& kind = kinds.emplace(step.name, Kind{0, 0.0, 0, 0}).first->second;
+        kind.count++;
+        kind.ms += step.duration_ms;
+        kind.bytes_read += step.bytes_read;
+        kind.bytes_produced += step.bytes_produced;
+    }
+
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(2);
+    out << "Startup took " << total << " ms\n";
+    out << std::left << std::setw(28) << "Step" << std::right << std::setw(6) << "Count" << std::setw(12) << "ms"
+        << std::setw(12) << "KB read" << std::setw(12) << "KB made" << '\n';
+    for (auto& kind : kinds) {
+        out << std::left << std::setw(28) << kind.first << std::right << std::setw(6) << kind.second.count
+            << std::setw(12) << kind.second.ms << std::setw(12) << kind.second.bytes_read / 1024.0
+            << std::setw(12) << kind.second.bytes_produced / 1024.0 << '\n';
+    }
+
+    std::sort(recorded.begin(), recorded.end(), [](const StartupStep& a, const StartupStep& b) {
+        return a.duration_ms > b.duration_ms;
+    });
+    out << "Slowest steps:\n";
+    for (size_t i = 0; i < std::min(slowest, recorded.size()); i++) {
+        const StartupStep& step = recorded[i];
+        out << std::right << std::setw(10) << step.duration_ms << " ms  " << step.name;
+        if (!step.asset.empty())
+            out << " (" << step.asset << ')';
+        out << " on thread " << step.thread << '\n';
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// One timed step of starting up, such as compiling a shader or decoding an image
+struct StartupStep {
+    std::string name;
+    // File the step worked on, empty if it did not work on one
+    std::string asset;
+    // Index of the thread the step ran on, in the order threads first recorded a step
+    int thread;
+    // Milliseconds since startup began
+    double start_ms;
+    double duration_ms;
+    // Bytes the step read, from disk for loads and from memory otherwise, and bytes of data it made
+    uint64_t bytes_read;
+    uint64_t bytes_produced;
+};
+
+// Collects the steps taken from the start of main until the first frame, so slow assets stand out
+// Steps are recorded from any thread until startup is finished, later ones are dropped
+class StartupTimeline {
+public:
+    // Marks the start of startup, the calling thread becomes thread 0
+    static void begin();
+
+    // Gets the milliseconds elapsed since startup began
+    static double now();
+
+    // Adds a finished step, thread safe
+    static void record(const std::string& name, const std::string& asset, double start_ms, uint64_t bytes_read, uint64_t bytes_produced);
+
+    // Marks the end of startup, no more steps are recorded after it
+    static void finish();
+
+    // Gets how long startup took, or how long it has taken so far if it is not finished
+    static double getTotalMilliseconds();
+
+    // Gets a copy of every step recorded, in the order they finished
+    static std::vector<StartupStep> getSteps();
+
+    // Gets the size of a file in bytes, 0 if it can not be opened
+    static uint64_t getFileSize(const char* path);
+
+    // Writes every step and the totals as JSON
+    static void writeJson(std::ostream& out);
+
+    // Writes the totals per kind of step and the slowest steps as a readable table
+    static void writeSummary(std::ostream& out, size_t slowest = 8);
+};
+
+// Times the enclosing scope as a step of startup, set the byte counts before it ends
+class StartupScope {
+public:
+    uint64_t bytes_read;
+    uint64_t bytes_produced;
+
+    StartupScope(const char* name, const std::string& asset = std::string()):
+        bytes_read(0), bytes_produced(0), name(name), asset(asset), start_ms(StartupTimeline::now()) {}
+
+    ~StartupScope() {
+        StartupTimeline::record(name, asset, start_ms, bytes_read, bytes_produced);
+    }
+
+private:
+    const char* name;
+    std::string asset;
+    double start_ms;
+};
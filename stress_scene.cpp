@@ -0,0 +1,106 @@
+#include "stress_scene.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include <glm/gtc/constants.hpp>
+
+static const char* camera_path_names[] {"orbit", "flythrough", "static"};
+
+// Adds copies_per_mesh entities of each mesh to the store with random transforms, and makes the lights
+void StressScene::generate(EntityStore& entities, const std::vector<StressMesh>& meshes) {
+    std::mt19937 rng(settings.seed);
+    std::uniform_real_distribution<float> unit(-1.f, 1.f);
+    std::uniform_real_distribution<float> angle(0.f, 360.f);
+    std::uniform_real_distribution<float> size(settings.min_size, settings.max_size);
+    std::uniform_real_distribution<float> strength(settings.min_light_strength, settings.max_light_strength);
+
+    // Copies are made mesh by mesh, so entities sharing a mesh sit next to each other in the store like a real scene
+    for (const StressMesh& mesh : meshes) {
+        VertexAttribs& attribs = *entities.meshes[mesh.mesh_id];
+        glm::vec3 mesh_extents = attribs.bounds.getExtents();
+        float mesh_size = std::max(2.f * std::max(mesh_extents.x, std::max(mesh_extents.y, mesh_extents.z)), 1e-4f);
+
+        for (int i = 0; i < settings.copies_per_mesh; i++) {
+            glm::vec3 pos = settings.center + settings.extents * glm::vec3(unit(rng), unit(rng), unit(rng));
+            glm::vec3 rot(angle(rng), angle(rng), angle(rng));
+            glm::vec3 scale(size(rng) / mesh_size);
+            entities.create(mesh.mesh_id, mesh.material_id, pos, rot, scale);
+            entity_count++;
+            triangle_count += attribs.count / 3;
+        }
+    }
+
+    // Lights take a random hue at full saturation, so overlapping lights are easy to tell apart
+    lights.clear();
+    light_origins.clear();
+    for (int i = 0; i < settings.light_count; i++) {
+        glm::vec3 pos = settings.center + settings.extents * glm::vec3(unit(rng), unit(rng), unit(rng));
+        float hue = (unit(rng) + 1.f) * 3.f;
+        glm::vec3 color = glm::clamp(glm::vec3(
+            std::fabs(hue - 3.f) - 1.f,
+            2.f - std::fabs(hue - 2.f),
+            2.f - std::fabs(hue - 4.f)
+        ), 0.f, 1.f);
+        lights.push_back(PointLight(strength(rng), pos, color, 0.f, 0.3f, 40.f));
+        lights.back().casts_shadows = i < settings.shadowed_lights;
+        light_origins.push_back(pos);
+    }
+}
+
+// Moves the lights that cast shadows to where their sway has them time seconds in
+void StressScene::placeLights(float time) {
+    float sway = settings.light_sway * std::sin(glm::two_pi<float>() * time / settings.path_period);
+    for (size_t i = 0; i < lights.size(); i++)
+        if (lights[i].casts_shadows)
+            lights[i].pos = light_origins[i] + glm::vec3(sway, 0.f, 0.f);
+}
+
+// Places the camera where the path has it time seconds in, the camera's far plane is left to the caller
+void StressScene::placeCamera(Camera& camera, float time) const {
+    float turn = glm::two_pi<float>() * time / settings.path_period;
+    float radius = 1.5f * std::max(settings.extents.x, settings.extents.z);
+
+    switch (settings.camera_path) {
+        case CAMERA_PATH_ORBIT:
+            camera.camera_pos = settings.center + glm::vec3(radius * std::cos(turn), settings.extents.y * 0.5f, radius * std::sin(turn));
+            camera.camera_center = settings.center;
+            break;
+        case CAMERA_PATH_FLYTHROUGH: {
+            // Goes along Z and back while swaying along X, always looking a little ahead
+            float along = std::sin(turn) * settings.extents.z;
+            float heading = std::cos(turn) >= 0.f ? 1.f : -1.f;
+            glm::vec3 pos = settings.center + glm::vec3(std::sin(turn * 3.f) * settings.extents.x * 0.5f, 0.f, along);
+            camera.camera_pos = pos;
+            camera.camera_center = pos + glm::vec3(0.f, 0.f, heading * 10.f);
+            break;
+        }
+        case CAMERA_PATH_STATIC:
+            camera.camera_pos = settings.center + glm::vec3(radius, settings.extents.y, radius);
+            camera.camera_center = settings.center;
+            break;
+    }
+}
+
+// Gets the far plane distance that keeps the whole scene in view from anywhere on the path
+float StressScene::getViewDistance() const {
+    float radius = 1.5f * std::max(settings.extents.x, settings.extents.z);
+    return glm::length(glm::vec3(radius, settings.extents.y, radius)) + glm::length(settings.extents);
+}
+
+// Reads a camera path from its name, returns false if there is no such path
+bool StressScene::parseCameraPath(const std::string& name, CameraPath& path) {
+    for (int i = 0; i < 3; i++) {
+        if (name == camera_path_names[i]) {
+            path = (CameraPath) i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Gets the name of a camera path
+const char* StressScene::getCameraPathName(CameraPath path) {
+    return camera_path_names[path];
+}
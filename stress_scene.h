@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common.h"
+#include "camera.h"
+#include "entity.h"
+#include "light.h"
+
+// Ways the camera can move through a stress scene
+enum CameraPath {
+    CAMERA_PATH_ORBIT,          // Circles the scene looking at its center
+    CAMERA_PATH_FLYTHROUGH,     // Weaves back and forth through the middle of the scene looking ahead
+    CAMERA_PATH_STATIC          // Stays outside a corner of the scene looking at its center
+};
+
+// Parameters of a generated scene, the same seed and parameters always make the same scene
+struct StressSceneSettings {
+    uint32_t seed;
+    // Copies made of each mesh the scene is generated from
+    int copies_per_mesh;
+    int light_count;
+    // Box the entities and lights are scattered in
+    glm::vec3 center;
+    glm::vec3 extents;
+    // Range of the largest size of an entity, meshes are scaled to it whatever their size in model space
+    float min_size, max_size;
+    // Range of the strength of the lights, see PointLight, dim like bioluminescence so each reaches a few units
+    float min_light_strength, max_light_strength;
+    // Lights that cast shadows, the first ones made, and how far they sway back and forth along X as the camera goes around its path
+    int shadowed_lights;
+    float light_sway;
+    CameraPath camera_path;
+    // Seconds the camera takes to go around its path once
+    float path_period;
+
+    StressSceneSettings():
+        seed(1), copies_per_mesh(16), light_count(8), center(0.f, -25.f, 0.f), extents(40.f, 20.f, 40.f),
+        min_size(1.f), max_size(4.f), min_light_strength(0.05f), max_light_strength(0.2f),
+        shadowed_lights(0), light_sway(0.f), camera_path(CAMERA_PATH_ORBIT), path_period(20.f) {}
+};
+
+// A mesh and the material a stress scene draws its copies with
+struct StressMesh {
+    uint32_t mesh_id;
+    uint32_t material_id;
+};
+
+// Generates scenes of many randomly placed entities and lights, for seeing how rendering scales with the size of a scene
+class StressScene {
+public:
+    StressSceneSettings settings;
+    // Lights scattered through the scene, drawn on top of the scene's own lights
+    std::vector<PointLight> lights;
+    // Entities and triangles generated
+    uint32_t entity_count;
+    uint64_t triangle_count;
+
+    StressScene(const StressSceneSettings& settings): settings(settings), entity_count(0), triangle_count(0) {}
+
+    // Adds copies_per_mesh entities of each mesh to the store with random transforms, and makes the lights
+    void generate(EntityStore& entities, const std::vector<StressMesh>& meshes);
+
+    // Places the camera where the path has it time seconds in, the camera's far plane is left to the caller
+    void placeCamera(Camera& camera, float time) const;
+
+    // Moves the lights that cast shadows to where their sway has them time seconds in
+    void placeLights(float time);
+
+    // Gets the far plane distance that keeps the whole scene in view from anywhere on the path
+    float getViewDistance() const;
+
+    // Reads a camera path from its name, returns false if there is no such path
+    static bool parseCameraPath(const std::string& name, CameraPath& path);
+
+    // Gets the name of a camera path
+    static const char* getCameraPathName(CameraPath path);
+
+private:
+    // Where each light was placed, the middle of its sway
+    std::vector<glm::vec3> light_origins;
+};
@@ -1,19 +1,33 @@
 #pragma once
 
 #include "common.h"
+#include "startup_timeline.h"
+#include "asset_pack.h"
 
 // A texture object, contains the address of the opengl texture and the tex_unit index
 typedef struct Texture {
     GLuint texture;
     int tex_unit;
+    // Whether this is the texture that loaded the image and frees it, copies only refer to it
+    bool owner;
+
     // Create a texture from a file path, optionally specify tex_unit index
-    Texture(const char* tex_path, int tex_unit = 0): tex_unit(tex_unit) {
+    Texture(const char* tex_path, int tex_unit = 0): tex_unit(tex_unit), owner(true) {
         // Load image
         stbi_set_flip_vertically_on_load(true);
-        int img_width, img_height, color_channels;
-        unsigned char* tex_bytes = stbi_load(tex_path, &img_width, &img_height, &color_channels, 0);
+        int img_width = 0, img_height = 0, color_channels = 0;
+        unsigned char* tex_bytes;
+        {
+            StartupScope step("Decode image", tex_path);
+            AssetBlob blob;
+            bool found = AssetPack::load(tex_path, blob);
+            tex_bytes = found ? stbi_load_from_memory(blob.data, (int) blob.size, &img_width, &img_height, &color_channels, 0) : nullptr;
+            step.bytes_read = blob.bytes_read;
+            step.bytes_produced = tex_bytes ? (uint64_t) img_width * img_height * color_channels : 0;
+        }
 
         // Create texture
+        StartupScope step("Upload texture", tex_path);
         glGenTextures(1, &texture);
         glActiveTexture(GL_TEXTURE0 + tex_unit);
         glBindTexture(GL_TEXTURE_2D, texture);
@@ -27,7 +41,33 @@ typedef struct Texture {
         glGenerateMipmap(GL_TEXTURE_2D);
         glEnable(GL_DEPTH_TEST);
 
+        // The mipmaps made from the image add up to about a third of it
+        if (tex_bytes) {
+            step.bytes_read = (uint64_t) img_width * img_height * color_channels;
+            step.bytes_produced = step.bytes_read + step.bytes_read / 3;
+        }
+
         // Cleanup
         stbi_image_free(tex_bytes);
     }
+
+    // Copies refer to the same texture, such as the ones in a model's list of textures
+    Texture(const Texture& other): texture(other.texture), tex_unit(other.tex_unit), owner(false) {}
+
+    Texture& operator=(const Texture& other) {
+        if (this != &other) {
+            if (owner)
+                glDeleteTextures(1, &texture);
+            texture = other.texture;
+            tex_unit = other.tex_unit;
+            owner = false;
+        }
+        return *this;
+    }
+
+    // Deconstructor to free the texture, only done by the texture that loaded it
+    ~Texture() {
+        if (owner)
+            glDeleteTextures(1, &texture);
+    }
 } Texture;
\ No newline at end of file
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "profiler.h"
+
+// A fixed set of worker threads that split loops over ranges of items between themselves and the calling thread
+class ThreadPool {
+public:
+    // Creates a pool that runs jobs on thread_count threads in total, including the thread that submits them
+    ThreadPool(unsigned int thread_count = std::thread::hardware_concurrency()):
+        job(nullptr), generation(0), busy_workers(0), chunk_count(0), chunks_done(0), stopping(false) {
+        for (unsigned int i = 1; i < thread_count; i++)
+            workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers)
+            worker.join();
+    }
+
+    // Number of threads that jobs run on, including the calling thread
+    inline unsigned int getThreadCount() {
+        return (unsigned int) workers.size() + 1;
+    }
+
+    // Calls fn(begin, end) over chunks of [0, count) of at least grain items each, returns once every chunk is done
+    inline void parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn) {
+        if (count == 0)
+            return;
+
+        // Small loops are not worth waking the workers for
+        size_t chunk_size = std::max(grain, (count + getThreadCount() * 4 - 1) / (getThreadCount() * 4));
+        if (workers.empty() || count <= chunk_size) {
+            fn(0, count);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = &fn;
+            job_count = count;
+            job_chunk_size = chunk_size;
+            chunk_count = (count + chunk_size - 1) / chunk_size;
+            chunks_done = 0;
+            next_chunk = 0;
+            generation++;
+        }
+        wake.notify_all();
+
+        runChunks(fn);
+
+        // Wait for the last chunks and for every worker to let go of the job before it goes out of scope
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return chunks_done == chunk_count && busy_workers == 0; });
+        job = nullptr;
+    }
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+
+    // State of the job being run, guarded by the mutex except for the chunk counter
+    const std::function<void(size_t, size_t)>* job;
+    size_t job_count;
+    size_t job_chunk_size;
+    unsigned long long generation;
+    int busy_workers;
+    size_t chunk_count;
+    size_t chunks_done;
+    std::atomic<size_t> next_chunk;
+    bool stopping;
+
+    // Takes chunks of the current job until there are none left
+    inline void runChunks(const std::function<void(size_t, size_t)>& fn) {
+        size_t finished = 0;
+        for (size_t chunk = next_chunk++; chunk < chunk_count; chunk = next_chunk++) {
+            PROFILE_SCOPE("Parallel chunk");
+            size_t begin = chunk * job_chunk_size;
+            fn(begin, std::min(begin + job_chunk_size, job_count));
+            finished++;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        chunks_done += finished;
+        if (chunks_done == chunk_count)
+            done.notify_all();
+    }
+
+    // Sleeps until a job is submitted and helps run it
+    inline void workerLoop() {
+        PROFILE_THREAD("Worker");
+        unsigned long long seen_generation = 0;
+        while (true) {
+            const std::function<void(size_t, size_t)>* current_job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || (job && generation != seen_generation); });
+                if (stopping)
+                    return;
+                seen_generation = generation;
+                current_job = job;
+                busy_workers++;
+            }
+
+            runChunks(*current_job);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            busy_workers--;
+            if (busy_workers == 0)
+                done.notify_all();
+        }
+    }
+};
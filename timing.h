@@ -0,0 +1,155 @@
+#pragma once
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+// Rate in hertz at which the simulation is stepped, independent of how fast frames are rendered
+#define SIM_RATE 120
+#define SIM_STEP (1.0 / SIM_RATE)
+// Upper bound of simulation steps per frame so a long stall cannot snowball into longer frames
+#define MAX_STEPS_PER_FRAME 8
+
+// Accumulates real elapsed time and hands it out to the simulation in fixed steps
+class FixedTimestep {
+public:
+    double step;
+    double accumulator;
+    double last_time;
+    int max_steps;
+
+    FixedTimestep(double step = SIM_STEP, int max_steps = MAX_STEPS_PER_FRAME):
+        step(step), accumulator(0.0), last_time(0.0), max_steps(max_steps) {}
+
+    // Restarts the clock from the given time, discarding any accumulated time
+    inline void reset(double now) {
+        last_time = now;
+        accumulator = 0.0;
+    }
+
+    // Adds the time elapsed since the last frame and returns how many fixed steps should be simulated
+    inline int beginFrame(double now) {
+        accumulator += now - last_time;
+        last_time = now;
+
+        int steps = (int) (accumulator / step);
+        // Drop the time that cannot be caught up on instead of simulating an ever growing backlog
+        if (steps > max_steps) {
+            steps = max_steps;
+            accumulator = steps * step;
+        }
+        accumulator -= steps * step;
+        return steps;
+    }
+
+    // Gets how far along the next step the current frame is, used to blend the previous and current states
+    inline float getAlpha() {
+        return (float) (accumulator / step);
+    }
+};
+
+// Measures elapsed wall time with a steady clock, usable where GLFW's timer is not available
+class Stopwatch {
+public:
+    std::chrono::steady_clock::time_point start;
+
+    Stopwatch() {
+        restart();
+    }
+
+    inline void restart() {
+        start = std::chrono::steady_clock::now();
+    }
+
+    // Gets the seconds elapsed since the stopwatch was started
+    inline double getSeconds() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Gets the milliseconds elapsed since the stopwatch was started
+    inline double getMilliseconds() {
+        return getSeconds() * 1000.0;
+    }
+};
+
+// Collects frame time statistics over a reporting window
+class FrameStats {
+public:
+    double window;
+    double window_start;
+    int frames;
+    int steps;
+    double total_time;
+    double min_time;
+    double max_time;
+
+    FrameStats(double window = 1.0): window(window), window_start(0.0) {
+        clear();
+    }
+
+    // Resets the collected statistics
+    inline void clear() {
+        frames = 0;
+        steps = 0;
+        total_time = 0.0;
+        min_time = DBL_MAX;
+        max_time = 0.0;
+    }
+
+    // Records a frame's duration in seconds and the number of simulation steps it ran
+    inline void addFrame(double frame_time, int frame_steps) {
+        frames++;
+        steps += frame_steps;
+        total_time += frame_time;
+        min_time = std::min(min_time, frame_time);
+        max_time = std::max(max_time, frame_time);
+    }
+
+    // Whether a full reporting window has elapsed since the last report
+    inline bool isReady(double now) {
+        return now - window_start >= window && frames > 0;
+    }
+
+    // Formats the statistics of the current window and starts a new one
+    inline std::string report(double now) {
+        double elapsed = now - window_start;
+        std::ostringstream out;
+        out.precision(2);
+        out << std::fixed << frames / elapsed << " fps | "
+            << total_time / frames * 1000.0 << " ms avg, "
+            << min_time * 1000.0 << " min, "
+            << max_time * 1000.0 << " max | "
+            << steps / elapsed << " sim steps/s";
+        window_start = now;
+        clear();
+        return out.str();
+    }
+};
+
+// Writes the timing of every frame as a row of a CSV file
+class FrameTimingLog {
+public:
+    std::ofstream file;
+    int frame;
+
+    FrameTimingLog(): frame(0) {}
+
+    // Creates the CSV file and writes its header row, returns false if it could not be opened
+    inline bool open(const std::string& path) {
+        file.open(path, std::ios::trunc);
+        if (!file)
+            return false;
+        file << "frame,recorded_ms,frame_ms,steps\n";
+        return true;
+    }
+
+    // Adds a row with the frame time as it was recorded and as it was measured now, both in seconds
+    inline void write(double recorded_time, double frame_time, int steps) {
+        if (!file.is_open())
+            return;
+        file << frame++ << ',' << recorded_time * 1000.0 << ',' << frame_time * 1000.0 << ',' << steps << '\n';
+    }
+};